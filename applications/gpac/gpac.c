@@ -1375,6 +1375,7 @@ restart:
 		signal(SIGINT, gpac_sig_handler);
 		signal(SIGTERM, gpac_sig_handler);
 		signal(SIGPIPE, gpac_sig_handler);
+		signal(SIGUSR1, gpac_sig_handler);
 #endif
 	}
 
@@ -2458,6 +2459,10 @@ static BOOL WINAPI gpac_sig_handler(DWORD sig)
 #include <signal.h>
 static void gpac_sig_handler(int sig)
 {
+	if (sig == SIGUSR1) {
+		if (session) gf_fs_request_trace_dump(session);
+		return;
+	}
 	if ((sig == SIGINT) || (sig == SIGTERM) || (sig == SIGABRT)) {
 		Bool is_inter = (sig == SIGINT) ? GF_TRUE : GF_FALSE;
 #endif
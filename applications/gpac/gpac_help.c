@@ -493,6 +493,11 @@ const char *gpac_doc =
 "- NCID: ID of netcap configuration to use (string)\n"
 "- LT: set additionnal log tools and levels for the filter usin same syntax as -logs, e.g. `:LT=filter@debug` (string value)\n"
 "- DBG: debug missing input PID property (`=pid`), missing input packet property (`=pck`) or both (`=all`)\n"
+"- TH: pin filter to the given session thread, 1-based, `0` picks the least loaded thread (unsigned int value)\n"
+"\n"
+"The `TH` option is inherited by filters loaded in the chain and is ignored if the session does not use extra threads ([-threads](CORE)).\n"
+"EX gpac -threads=4 -i src.mp4 -o dst.mp4:TH=2\n"
+"This will run the multiplexer and the file output on the second session thread.\n"
 "\n"
 "The buffer control options are used to change the default buffering of PIDs of a filter:\n"
 "- `FBT` controls the maximum buffer time of output PIDs of a filter\n"
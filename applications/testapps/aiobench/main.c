@@ -0,0 +1,169 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom ParisTech 2024
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - asynchronous file I/O remux benchmark
+ *
+ */
+
+#include <gpac/filters.h>
+#include <gpac/thread.h>
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: aiobench [OPTS] FILE [FILE ...]\n"
+	        "Remuxes input files in concurrent filter sessions, with synchronous or asynchronous (io_uring) file I/O\n"
+	        "Each input file is remuxed by N sessions, each writing to its own output file\n"
+	        "\n"
+	        "-n N:      number of sessions per input file (default 4)\n"
+	        "-aio N:    number of asynchronous blocks for fin and fout, 0 for synchronous I/O (default 0)\n"
+	        "-bs N:     block size in bytes for reads and writes (default 1048576)\n"
+	        "-odirect:  write using direct I/O\n"
+	        "-ext EXT:  output file extension (default mp4)\n"
+	        "-dir DIR:  output directory (default current directory)\n"
+	        "-keep:     do not delete output files\n"
+	       );
+}
+
+typedef struct
+{
+	char src[GF_MAX_PATH];
+	char dst[GF_MAX_PATH];
+	u32 aio, bs;
+	Bool odirect;
+	GF_Err e;
+	u64 size, duration;
+} BenchSession;
+
+static u32 bench_run(void *par)
+{
+	char szArgs[100];
+	GF_Filter *f;
+	FILE *out;
+	u64 start;
+	BenchSession *sess = (BenchSession *) par;
+	GF_FilterSession *fs = gf_fs_new_defaults(0);
+	if (!fs) {
+		sess->e = GF_OUT_OF_MEM;
+		return 0;
+	}
+	sess->e = GF_OK;
+	start = gf_sys_clock_high_res();
+
+	if (sess->aio) sprintf(szArgs, "aio=%u:block_size=%u", sess->aio, sess->bs);
+	else sprintf(szArgs, "block_size=%u", sess->bs);
+	f = gf_fs_load_source(fs, sess->src, szArgs, NULL, &sess->e);
+	if (f) {
+		sprintf(szArgs, "wblock=%u%s", sess->bs, sess->odirect ? ":odirect" : "");
+		if (sess->aio) sprintf(szArgs + strlen(szArgs), ":aio=%u", sess->aio);
+		f = gf_fs_load_destination(fs, sess->dst, szArgs, NULL, &sess->e);
+	}
+	if (f) sess->e = gf_fs_run(fs);
+	if (sess->e==GF_EOS) sess->e = GF_OK;
+	if (!sess->e) sess->e = gf_fs_get_last_connect_error(fs);
+	if (!sess->e) sess->e = gf_fs_get_last_process_error(fs);
+	gf_fs_del(fs);
+
+	sess->duration = gf_sys_clock_high_res() - start;
+	out = gf_fopen(sess->dst, "rb");
+	if (out) {
+		sess->size = gf_fsize(out);
+		gf_fclose(out);
+	}
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	u32 i, j, nb_src = 0, nb_sess = 4, aio = 0, bs = 1048576;
+	Bool odirect = GF_FALSE, keep = GF_FALSE;
+	const char *ext = "mp4", *dir = NULL;
+	char **srcs;
+	BenchSession *sessions;
+	GF_Thread **threads;
+	u64 start, total_dur, total_size = 0, max_dur = 0, sum_dur = 0;
+	u32 nb_err = 0;
+
+	srcs = gf_malloc(sizeof(char*) * argc);
+	if (!srcs) return 1;
+	for (i=1; i<(u32)argc; i++) {
+		char *arg = argv[i];
+		if ((i+1<(u32)argc) && !strcmp(arg, "-n")) nb_sess = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-aio")) aio = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-bs")) bs = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-ext")) ext = argv[++i];
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-dir")) dir = argv[++i];
+		else if (!strcmp(arg, "-odirect")) odirect = GF_TRUE;
+		else if (!strcmp(arg, "-keep")) keep = GF_TRUE;
+		else if (arg[0] != '-') srcs[nb_src++] = arg;
+		else {
+			PrintUsage();
+			gf_free(srcs);
+			return 1;
+		}
+	}
+	if (!nb_src || !nb_sess || !bs) {
+		PrintUsage();
+		gf_free(srcs);
+		return 1;
+	}
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	gf_log_set_tool_level(GF_LOG_ALL, GF_LOG_WARNING);
+
+	sessions = gf_malloc(sizeof(BenchSession) * nb_src * nb_sess);
+	threads = gf_malloc(sizeof(GF_Thread *) * nb_src * nb_sess);
+	if (!sessions || !threads) {
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	memset(sessions, 0, sizeof(BenchSession) * nb_src * nb_sess);
+	for (i=0; i<nb_src; i++) {
+		for (j=0; j<nb_sess; j++) {
+			BenchSession *sess = &sessions[i*nb_sess + j];
+			strncpy(sess->src, srcs[i], GF_MAX_PATH-1);
+			snprintf(sess->dst, GF_MAX_PATH-1, "%s%saiobench_%u_%u.%s", dir ? dir : "", (dir && !strchr("/\\", dir[strlen(dir)-1])) ? "/" : "", i, j, ext);
+			sess->aio = aio;
+			sess->bs = bs;
+			sess->odirect = odirect;
+		}
+	}
+
+	fprintf(stderr, "Remuxing %u file(s) in %u sessions - %s I/O - %u bytes blocks%s\n",
+		nb_src, nb_src * nb_sess, aio ? "asynchronous" : "synchronous", bs, odirect ? " - direct I/O" : "");
+
+	start = gf_sys_clock_high_res();
+	for (i=0; i<nb_src * nb_sess; i++) {
+		threads[i] = gf_th_new("aiobench");
+		gf_th_run(threads[i], bench_run, &sessions[i]);
+	}
+	for (i=0; i<nb_src * nb_sess; i++) {
+		gf_th_stop(threads[i]);
+		gf_th_del(threads[i]);
+	}
+	total_dur = gf_sys_clock_high_res() - start;
+
+	for (i=0; i<nb_src * nb_sess; i++) {
+		BenchSession *sess = &sessions[i];
+		if (sess->e) {
+			fprintf(stderr, "Session %u (%s) failed: %s\n", i, sess->src, gf_error_to_string(sess->e));
+			nb_err++;
+		}
+		total_size += sess->size;
+		sum_dur += sess->duration;
+		if (sess->duration > max_dur) max_dur = sess->duration;
+		if (!keep) gf_file_delete(sess->dst);
+	}
+
+	fprintf(stderr, "Total: "LLU" bytes written in %.03f s - %.02f MB/s\n", total_size, (Double) total_dur / 1000000, total_dur ? (Double) total_size / total_dur : 0.0);
+	fprintf(stderr, "Session time: average %.03f s - max %.03f s\n", (Double) sum_dur / 1000000 / (nb_src * nb_sess), (Double) max_dur / 1000000);
+
+	gf_free(sessions);
+	gf_free(threads);
+	gf_free(srcs);
+	gf_sys_close();
+	return nb_err ? 1 : 0;
+}
@@ -0,0 +1,205 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom ParisTech 2024
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - EVG rescaler benchmark
+ *
+ */
+
+#include <gpac/filters.h>
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: evgsbench [OPTS]\n"
+	        "Runs YUV 420 frames held in memory through the evgs filter and reports the number of frames rescaled per second\n"
+	        "\n"
+	        "-size WxH:    source size (default 1920x1080)\n"
+	        "-osize WxH:   output size (default 960x540)\n"
+	        "-kernel K:    evgs kernel, evg, bicubic or lanczos (default lanczos)\n"
+	        "-olist L:     additional output sizes, as in evgs olist option (default none)\n"
+	        "-frames N:    number of frames (default 100)\n"
+	        "-threads N:   number of extra session threads (default 0)\n"
+	        "-args ARGS:   extra options for evgs, e.g. hq or nbth=2\n"
+	       );
+}
+
+static GF_FilterPid *src_pid = NULL;
+static u8 *src_frame = NULL;
+static u32 src_w = 1920, src_h = 1080, src_size = 0;
+static u32 nb_frames = 100, nb_sent = 0, nb_received = 0;
+
+static GF_Err bsrc_process(GF_Filter *filter)
+{
+	while (nb_sent < nb_frames) {
+		GF_FilterPacket *pck;
+		if (gf_filter_pid_would_block(src_pid))
+			return GF_OK;
+		pck = gf_filter_pck_new_shared(src_pid, src_frame, src_size, NULL);
+		if (!pck) return GF_OUT_OF_MEM;
+		gf_filter_pck_set_cts(pck, nb_sent);
+		gf_filter_pck_set_sap(pck, GF_FILTER_SAP_1);
+		gf_filter_pck_send(pck);
+		nb_sent++;
+	}
+	gf_filter_pid_set_eos(src_pid);
+	return GF_EOS;
+}
+
+static GF_Err bsink_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
+{
+	GF_FilterEvent evt;
+	if (is_remove) return GF_OK;
+	GF_FEVT_INIT(evt, GF_FEVT_PLAY, pid);
+	gf_filter_pid_send_event(pid, &evt);
+	return GF_OK;
+}
+
+static GF_Err bsink_process(GF_Filter *filter)
+{
+	u32 i;
+	for (i=0; i<gf_filter_get_ipid_count(filter); i++) {
+		GF_FilterPid *pid = gf_filter_get_ipid(filter, i);
+		while (1) {
+			GF_FilterPacket *pck = gf_filter_pid_get_packet(pid);
+			if (!pck) break;
+			nb_received++;
+			gf_filter_pid_drop_packet(pid);
+		}
+	}
+	return GF_OK;
+}
+
+int main(int argc, char **argv)
+{
+	u32 i, o_w = 960, o_h = 540, nb_outputs;
+	s32 nb_threads = 0;
+	const char *kernel = "lanczos";
+	const char *olist = NULL;
+	const char *args = NULL;
+	char szArgs[GF_MAX_PATH];
+	GF_FilterSession *fsess;
+	GF_Filter *src, *evgs, *sink;
+	GF_Err e;
+	u64 start, time;
+
+	for (i=1; i<(u32)argc; i++) {
+		char *arg = argv[i];
+		if ((i+1<(u32)argc) && !strcmp(arg, "-size")) sscanf(argv[++i], "%ux%u", &src_w, &src_h);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-osize")) sscanf(argv[++i], "%ux%u", &o_w, &o_h);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-kernel")) kernel = argv[++i];
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-olist")) olist = argv[++i];
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-frames")) nb_frames = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-threads")) nb_threads = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-args")) args = argv[++i];
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!src_w || !src_h || (src_w%2) || (src_h%2) || !o_w || !o_h || !nb_frames) {
+		PrintUsage();
+		return 1;
+	}
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+
+	//gradient with some texture, content does not change the scaler cost
+	src_size = src_w * src_h * 3 / 2;
+	src_frame = gf_malloc(src_size);
+	if (!src_frame) {
+		fprintf(stderr, "Out of memory\n");
+		gf_sys_close();
+		return 1;
+	}
+	for (i=0; i<src_size; i++) {
+		src_frame[i] = (u8) ((i % src_w) + (i / src_w) * 3 + ((i * 7) & 15));
+	}
+
+	fsess = gf_fs_new(nb_threads, GF_FS_SCHEDULER_LOCK_FREE, 0, NULL);
+	if (!fsess) {
+		fprintf(stderr, "Cannot create filter session\n");
+		gf_free(src_frame);
+		gf_sys_close();
+		return 1;
+	}
+
+	src = gf_fs_new_filter(fsess, "bsrc", 0, &e);
+	if (src) e = gf_filter_push_caps(src, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_VISUAL), NULL, GF_CAPS_OUTPUT, 0);
+	if (src && !e) e = gf_filter_set_process_ckb(src, bsrc_process);
+	if (src && !e) {
+		src_pid = gf_filter_pid_new(src);
+		if (!src_pid) e = GF_OUT_OF_MEM;
+	}
+	if (!e) {
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_VISUAL));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_CODECID, &PROP_UINT(GF_CODECID_RAW));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_WIDTH, &PROP_UINT(src_w));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_HEIGHT, &PROP_UINT(src_h));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_STRIDE, &PROP_UINT(src_w));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_PIXFMT, &PROP_UINT(GF_PIXEL_YUV));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_TIMESCALE, &PROP_UINT(25));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_FPS, &PROP_FRAC_INT(25, 1));
+	}
+
+	evgs = NULL;
+	if (!e) {
+		snprintf(szArgs, GF_MAX_PATH, "evgs:osize=%ux%u:kernel=%s%s%s%s%s", o_w, o_h, kernel, olist ? ":olist=" : "", olist ? olist : "", args ? ":" : "", args ? args : "");
+		evgs = gf_fs_load_filter(fsess, szArgs, &e);
+	}
+	if (evgs) e = gf_filter_set_source(evgs, src, NULL);
+
+	sink = NULL;
+	if (!e) sink = gf_fs_new_filter(fsess, "bsink", 0, &e);
+	if (sink) e = gf_filter_push_caps(sink, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_VISUAL), NULL, GF_CAPS_INPUT, 0);
+	if (sink && !e) e = gf_filter_set_configure_ckb(sink, bsink_configure_pid);
+	if (sink && !e) e = gf_filter_set_process_ckb(sink, bsink_process);
+	if (sink && !e) e = gf_filter_set_source(sink, evgs, NULL);
+	//one input per output size
+	if (sink && !e) gf_filter_set_max_extra_input_pids(sink, (u32) -1);
+
+	if (e) {
+		fprintf(stderr, "Cannot setup session: %s\n", gf_error_to_string(e));
+		gf_fs_del(fsess);
+		gf_free(src_frame);
+		gf_sys_close();
+		return 1;
+	}
+	gf_filter_post_process_task(src);
+
+	//main output and olist outputs
+	nb_outputs = 1;
+	if (olist) {
+		const char *s = olist;
+		nb_outputs++;
+		while ((s = strchr(s, ','))) {
+			nb_outputs++;
+			s++;
+		}
+	}
+	fprintf(stderr, "Rescaling %u frames %ux%u to %ux%u%s%s - kernel %s - %d extra session threads\n", nb_frames, src_w, src_h, o_w, o_h,
+		olist ? " and " : "", olist ? olist : "", kernel, nb_threads);
+
+	start = gf_sys_clock_high_res();
+	e = gf_fs_run(fsess);
+	time = gf_sys_clock_high_res() - start;
+	if (e>GF_OK) e = GF_OK;
+	if (!e) e = gf_fs_get_last_connect_error(fsess);
+	if (!e) e = gf_fs_get_last_process_error(fsess);
+
+	if (e) {
+		fprintf(stderr, "Session error: %s\n", gf_error_to_string(e));
+	} else if (nb_received != nb_frames * nb_outputs) {
+		fprintf(stderr, "Received %u frames, %u expected\n", nb_received, nb_frames * nb_outputs);
+		e = GF_IO_ERR;
+	} else {
+		fprintf(stderr, "%.03f s - %.02f frames per second - %.02f ms per frame\n", (Double) time / 1000000, (Double) nb_frames * 1000000 / time, (Double) time / nb_frames / 1000);
+	}
+
+	gf_fs_del(fsess);
+	gf_free(src_frame);
+	gf_sys_close();
+	return e ? 1 : 0;
+}
@@ -0,0 +1,207 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom ParisTech 2024
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - ROUTE FEC loss simulation benchmark
+ *
+ */
+
+#include <gpac/tools.h>
+#include <gpac/internal/reedsolomon.h>
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: fecbench [OPTS]\n"
+	        "Simulates ROUTE object delivery with Reed-Solomon repair symbols over a lossy channel\n"
+	        "\n"
+	        "-size N:   object size in bytes (default 1000000)\n"
+	        "-sym N:    symbol size in bytes (default 1436, as used by routeout with 1472 bytes MTU)\n"
+	        "-blk N:    maximum number of source symbols per block (default 64)\n"
+	        "-fec N:    repair overhead in percent (default 20)\n"
+	        "-loss N:   packet loss rate in percent (default 5)\n"
+	        "-burst N:  average loss burst length in packets (default 1)\n"
+	        "-n N:      number of objects to simulate (default 100)\n"
+	        "-seed N:   random seed (default 1)\n"
+	       );
+}
+
+static u32 rand_state = 1;
+static u32 bench_rand()
+{
+	rand_state = rand_state * 1103515245 + 12345;
+	return (rand_state >> 16) & 0x7FFF;
+}
+
+int main(int argc, char **argv)
+{
+	u32 i, j, b, it;
+	u32 size = 1000000, sym_size = 1436, max_k = 64, fec = 20, nb_objs = 100;
+	Double loss = 5, burst = 1;
+	u32 nb_blocks, k_large, k_small, nb_large, nb_syms, nb_repair_max, nb_pck;
+	u32 nb_lossy = 0, nb_recovered = 0, nb_failed = 0, nb_corrupted = 0;
+	u64 nb_pck_sent = 0, nb_pck_lost = 0;
+	u64 enc_time = 0, dec_time = 0, enc_bytes = 0, dec_bytes = 0;
+	u8 *obj, *rx, *repair;
+	u8 *lost;
+	Bool in_burst = GF_FALSE;
+
+	for (i=1; i<(u32)argc; i++) {
+		char *arg = argv[i];
+		if ((i+1<(u32)argc) && !strcmp(arg, "-size")) size = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-sym")) sym_size = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-blk")) max_k = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-fec")) fec = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-loss")) loss = atof(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-burst")) burst = atof(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-n")) nb_objs = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-seed")) rand_state = atoi(argv[++i]);
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!size || !sym_size || !max_k || !nb_objs || (burst<1) || (loss<0) || (loss>=100)) {
+		PrintUsage();
+		return 1;
+	}
+	if (max_k * (100 + fec) > GF_RS_FEC_MAX_SYMBOLS * 100) {
+		max_k = GF_RS_FEC_MAX_SYMBOLS * 100 / (100 + fec);
+		if (!max_k) max_k = 1;
+		fprintf(stderr, "Block size too large for %u%% overhead, using %u source symbols per block\n", fec, max_k);
+	}
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+
+	gf_rs_fec_partition(size, sym_size, max_k, &nb_blocks, &k_large, &k_small, &nb_large);
+	nb_syms = k_large * nb_large + k_small * (nb_blocks - nb_large);
+	nb_repair_max = (k_large * fec + 99) / 100;
+	if (k_large + nb_repair_max > GF_RS_FEC_MAX_SYMBOLS) nb_repair_max = GF_RS_FEC_MAX_SYMBOLS - k_large;
+	nb_pck = nb_syms + nb_blocks * nb_repair_max;
+
+	//padded object, received object, repair symbols and per-packet loss flags
+	obj = gf_malloc((u64) nb_syms * sym_size);
+	rx = gf_malloc((u64) nb_syms * sym_size);
+	repair = gf_malloc((u64) nb_blocks * nb_repair_max * sym_size);
+	lost = gf_malloc(nb_pck);
+	if (!obj || !rx || !repair || !lost) {
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+
+	fprintf(stderr, "Object %u bytes - %u blocks of %u/%u symbols of %u bytes - %u%% repair - %g%% loss (burst %g) - GF(256) %s\n",
+		size, nb_blocks, k_large, k_small, sym_size, fec, loss, burst, gf_rs_fec_get_impl());
+
+	for (it=0; it<nb_objs; it++) {
+		u64 start;
+		u32 sym_start, pck_idx, nb_lost = 0;
+		Bool obj_ok = GF_TRUE;
+
+		for (i=0; i<size; i++) obj[i] = (u8) bench_rand();
+		memset(obj + size, 0, (u64) nb_syms * sym_size - size);
+
+		//encode
+		start = gf_sys_clock_high_res();
+		sym_start = 0;
+		for (b=0; b<nb_blocks; b++) {
+			const u8 *src[GF_RS_FEC_MAX_SYMBOLS];
+			u8 *rep[GF_RS_FEC_MAX_SYMBOLS];
+			u32 k = (b<nb_large) ? k_large : k_small;
+			for (i=0; i<k; i++) src[i] = obj + (u64) (sym_start+i) * sym_size;
+			for (i=0; i<nb_repair_max; i++) rep[i] = repair + (u64) (b*nb_repair_max + i) * sym_size;
+			gf_rs_fec_encode(src, k, rep, nb_repair_max, sym_size);
+			sym_start += k;
+		}
+		enc_time += gf_sys_clock_high_res() - start;
+		enc_bytes += (u64) nb_syms * sym_size;
+
+		//channel: source packets in order, then repair packets block by block (as sent by routeout)
+		for (i=0; i<nb_pck; i++) {
+			Double r = (Double) bench_rand() / 0x8000;
+			if (in_burst) {
+				//leave burst with probability 1/burst
+				if (r < 1 / burst) in_burst = GF_FALSE;
+			} else {
+				//enter burst so that the average loss rate is preserved
+				if (r < (loss / burst) / (100 - loss)) in_burst = GF_TRUE;
+			}
+			lost[i] = in_burst ? 1 : 0;
+			if (in_burst) nb_lost++;
+		}
+		nb_pck_sent += nb_pck;
+		nb_pck_lost += nb_lost;
+		for (i=0; i<nb_syms; i++) {
+			if (lost[i]) {
+				obj_ok = GF_FALSE;
+				break;
+			}
+		}
+		if (obj_ok) continue;
+		nb_lossy++;
+
+		//receive and decode
+		for (i=0; i<nb_syms; i++) {
+			if (lost[i]) memset(rx + (u64) i * sym_size, 0xAB, sym_size);
+			else memcpy(rx + (u64) i * sym_size, obj + (u64) i * sym_size, sym_size);
+		}
+		sym_start = 0;
+		pck_idx = nb_syms;
+		for (b=0; b<nb_blocks; b++) {
+			u8 *src[GF_RS_FEC_MAX_SYMBOLS];
+			const u8 *rep[GF_RS_FEC_MAX_SYMBOLS];
+			u32 missing[GF_RS_FEC_MAX_SYMBOLS], rep_idx[GF_RS_FEC_MAX_SYMBOLS];
+			u32 nb_missing = 0, nb_rep = 0;
+			u32 k = (b<nb_large) ? k_large : k_small;
+
+			for (i=0; i<k; i++) {
+				src[i] = rx + (u64) (sym_start+i) * sym_size;
+				if (lost[sym_start+i]) missing[nb_missing++] = i;
+			}
+			for (j=0; (j<nb_repair_max) && (nb_rep<nb_missing); j++) {
+				if (lost[pck_idx + j]) continue;
+				rep[nb_rep] = repair + (u64) (b*nb_repair_max + j) * sym_size;
+				rep_idx[nb_rep] = j;
+				nb_rep++;
+			}
+			pck_idx += nb_repair_max;
+			sym_start += k;
+			if (!nb_missing) continue;
+			if (nb_rep < nb_missing) {
+				obj_ok = GF_FALSE;
+				break;
+			}
+			start = gf_sys_clock_high_res();
+			gf_rs_fec_decode(src, k, missing, nb_missing, rep, rep_idx, sym_size);
+			dec_time += gf_sys_clock_high_res() - start;
+			dec_bytes += (u64) k * sym_size;
+			obj_ok = GF_TRUE;
+		}
+		if (!obj_ok) {
+			nb_failed++;
+		} else if (memcmp(rx, obj, size)) {
+			nb_corrupted++;
+		} else {
+			nb_recovered++;
+		}
+	}
+
+	fprintf(stderr, "Packets: "LLU" sent "LLU" lost (%.2f %%)\n", nb_pck_sent, nb_pck_lost, 100.0 * nb_pck_lost / nb_pck_sent);
+	fprintf(stderr, "Objects: %u total - %u with losses - %u recovered - %u unrecoverable - %u corrupted\n", nb_objs, nb_lossy, nb_recovered, nb_failed, nb_corrupted);
+	fprintf(stderr, "Object delivery rate: without FEC %.2f %% - with FEC %.2f %%\n",
+		100.0 * (nb_objs - nb_lossy) / nb_objs, 100.0 * (nb_objs - nb_failed - nb_corrupted) / nb_objs);
+	if (nb_lossy)
+		fprintf(stderr, "Recovered object rate: %.2f %%\n", 100.0 * nb_recovered / nb_lossy);
+	if (enc_time)
+		fprintf(stderr, "Encode throughput: %.2f MB/s\n", (Double) enc_bytes / enc_time);
+	if (dec_time)
+		fprintf(stderr, "Decode throughput: %.2f MB/s (source block data)\n", (Double) dec_bytes / dec_time);
+
+	gf_free(obj);
+	gf_free(rx);
+	gf_free(repair);
+	gf_free(lost);
+	gf_sys_close();
+	return nb_corrupted ? 1 : 0;
+}
@@ -0,0 +1,442 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom ParisTech 2024
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - NAL unit start code and emulation prevention scanning benchmark
+ *
+ */
+
+#include <gpac/tools.h>
+#include <gpac/internal/media_dev.h>
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: nalubench [OPTS]\n"
+	        "Benchmarks start code search and emulation prevention byte removal on a synthetic Annex-B buffer,\n"
+	        "against the byte-wise scanners used before SIMD scanning was added. Outputs of both are checked identical\n"
+	        "\n"
+	        "-size N:   buffer size in MB (default 64)\n"
+	        "-nal N:    NAL unit size in bytes (default 65536)\n"
+	        "-zeros N:  payload bytes are zero with a probability of 1/N (default 256, as in entropy coded data)\n"
+	        "-iter N:   number of iterations of each test (default 5)\n"
+	        "-seed N:   random seed (default 1)\n"
+	        "-avc FILE: write an AVC Annex-B stream of the same size made of one IDR slice of -nal bytes per frame and exit,\n"
+	        "           used to benchmark NAL reframing, e.g. gpac -i FILE:block_size=8192 rfnalu inspect:deep=0:log=null\n"
+	       );
+}
+
+static u32 rand_state = 1;
+static u32 bench_rand()
+{
+	rand_state = rand_state * 1103515245 + 12345;
+	return (rand_state >> 16) & 0x7FFF;
+}
+
+/*byte-wise scanners, as in av_parsers.c before SIMD scanning*/
+static u32 ref_next_start_code(const u8 *data, u32 data_len, u32 *sc_size)
+{
+	u32 avail = data_len;
+	const u8 *cur = data;
+
+	while (cur) {
+		u32 v, bpos;
+		u8 *next_zero = memchr(cur, 0, avail);
+		if (!next_zero) return data_len;
+
+		v = 0xffffff00;
+		bpos = (u32)(next_zero - data) + 1;
+		while (1) {
+			u8 cval;
+			if (bpos == (u32)data_len)
+				return data_len;
+
+			cval = data[bpos];
+			v = ((v << 8) & 0xFFFFFF00) | ((u32)cval);
+			bpos++;
+			if (v == 0x00000001) {
+				*sc_size = 4;
+				return bpos - 4;
+			}
+			else if ((v & 0x00FFFFFF) == 0x00000001) {
+				*sc_size = 3;
+				return bpos - 3;
+			}
+			if (cval)
+				break;
+		}
+		if (bpos >= data_len)
+			break;
+		cur = data + bpos;
+		avail = data_len - bpos;
+	}
+	return data_len;
+}
+
+static u32 ref_emulation_bytes_remove_count(const u8 *buffer, u32 nal_size)
+{
+	u32 i = 0, emulation_bytes_count = 0;
+	u8 num_zero = 0;
+	if (!buffer || !nal_size) return 0;
+
+	while (i < nal_size) {
+		if (num_zero == 2 && buffer[i] == 0x03 && i + 1 < nal_size && (u8)buffer[i + 1] < 0x04) {
+			num_zero = 0;
+			emulation_bytes_count++;
+			i++;
+		}
+		if (!buffer[i])
+			num_zero++;
+		else
+			num_zero = 0;
+		i++;
+	}
+	return emulation_bytes_count;
+}
+
+static u32 ref_remove_emulation_bytes(const u8 *buffer_src, u8 *buffer_dst, u32 nal_size)
+{
+	u32 i = 0, emulation_bytes_count = 0;
+	u8 num_zero = 0;
+
+	while (i < nal_size) {
+		if (num_zero == 2 && buffer_src[i] == 0x03 && i + 1 < nal_size && (u8)buffer_src[i + 1] < 0x04) {
+			num_zero = 0;
+			emulation_bytes_count++;
+			i++;
+		}
+		buffer_dst[i - emulation_bytes_count] = buffer_src[i];
+		if (!buffer_src[i])
+			num_zero++;
+		else
+			num_zero = 0;
+		i++;
+	}
+	return nal_size - emulation_bytes_count;
+}
+
+/*escaped payload as produced by an encoder, with bytes set to zero with a probability of 1/zeros
+returns the number of bytes written, len at most*/
+static u32 gen_payload(u8 *dst, u32 len, u32 zeros, u32 *nb_ep)
+{
+	u32 pos = 0, num_zero = 0;
+	while (pos < len) {
+		u8 val = (bench_rand() % zeros) ? (u8) (1 + bench_rand() % 255) : 0;
+		if ((num_zero == 2) && (val < 4)) {
+			//an emulation prevention byte cannot be the last byte
+			if (pos + 1 == len) {
+				val = 0x80;
+			} else {
+				dst[pos++] = 3;
+				(*nb_ep)++;
+				num_zero = 0;
+			}
+		}
+		dst[pos++] = val;
+		if (val) num_zero = 0;
+		else num_zero++;
+	}
+	//NAL units don't end with a zero byte
+	if (pos && !dst[pos-1]) dst[pos-1] = 0x80;
+	return pos;
+}
+
+static void bench_write_ue(GF_BitStream *bs, u32 val)
+{
+	u32 nb_bits = 0;
+	u32 v = val + 1;
+	while (v >> nb_bits) nb_bits++;
+	gf_bs_write_int(bs, 0, nb_bits - 1);
+	gf_bs_write_int(bs, val + 1, nb_bits);
+}
+
+static void write_rbsp_trailing(GF_BitStream *bs)
+{
+	gf_bs_write_int(bs, 1, 1);
+	gf_bs_align(bs);
+}
+
+static void write_nal(FILE *f, GF_BitStream *bs)
+{
+	u8 *data;
+	u32 size;
+	u8 sc[4] = {0, 0, 0, 1};
+	gf_bs_get_content(bs, &data, &size);
+	gf_fwrite(sc, 4, f);
+	gf_fwrite(data, size, f);
+	gf_free(data);
+}
+
+/*writes an AVC Annex-B stream of nb_frames IDR frames, each made of one slice of nal_size bytes with random data
+as seen by the reframer, which only parses parameter sets and slice headers*/
+static Bool write_avc(const char *path, u32 nb_frames, u32 nal_size, u32 zeros)
+{
+	u32 i, nb_ep = 0;
+	u8 *payload;
+	FILE *f = gf_fopen(path, "wb");
+	if (!f) return GF_FALSE;
+	payload = gf_malloc(nal_size);
+	if (!payload) {
+		gf_fclose(f);
+		return GF_FALSE;
+	}
+
+	for (i=0; i<nb_frames; i++) {
+		GF_BitStream *bs;
+		u32 size;
+		if (!i) {
+			//SPS: baseline, 320x240, frame_num on 4 bits, POC type 2
+			bs = gf_bs_new(NULL, 0, GF_BITSTREAM_WRITE);
+			gf_bs_write_u8(bs, 0x67);
+			gf_bs_write_u8(bs, 66);
+			gf_bs_write_u8(bs, 0);
+			gf_bs_write_u8(bs, 30);
+			bench_write_ue(bs, 0);
+			bench_write_ue(bs, 0);
+			bench_write_ue(bs, 2);
+			bench_write_ue(bs, 1);
+			gf_bs_write_int(bs, 0, 1);
+			bench_write_ue(bs, 19);
+			bench_write_ue(bs, 14);
+			gf_bs_write_int(bs, 1, 1);
+			gf_bs_write_int(bs, 1, 1);
+			gf_bs_write_int(bs, 0, 1);
+			gf_bs_write_int(bs, 0, 1);
+			write_rbsp_trailing(bs);
+			write_nal(f, bs);
+			gf_bs_del(bs);
+
+			//PPS: CAVLC, one slice group, deblocking control present
+			bs = gf_bs_new(NULL, 0, GF_BITSTREAM_WRITE);
+			gf_bs_write_u8(bs, 0x68);
+			bench_write_ue(bs, 0);
+			bench_write_ue(bs, 0);
+			gf_bs_write_int(bs, 0, 1);
+			gf_bs_write_int(bs, 0, 1);
+			bench_write_ue(bs, 0);
+			bench_write_ue(bs, 0);
+			bench_write_ue(bs, 0);
+			gf_bs_write_int(bs, 0, 1);
+			gf_bs_write_int(bs, 0, 2);
+			bench_write_ue(bs, 0);
+			bench_write_ue(bs, 0);
+			bench_write_ue(bs, 0);
+			gf_bs_write_int(bs, 1, 1);
+			gf_bs_write_int(bs, 0, 1);
+			gf_bs_write_int(bs, 0, 1);
+			write_rbsp_trailing(bs);
+			write_nal(f, bs);
+			gf_bs_del(bs);
+		}
+		//IDR slice header, idr_pic_id changes at each frame
+		bs = gf_bs_new(NULL, 0, GF_BITSTREAM_WRITE);
+		gf_bs_write_u8(bs, 0x65);
+		bench_write_ue(bs, 0);
+		bench_write_ue(bs, 7);
+		bench_write_ue(bs, 0);
+		gf_bs_write_int(bs, 0, 4);
+		bench_write_ue(bs, i % 2);
+		gf_bs_write_int(bs, 0, 1);
+		gf_bs_write_int(bs, 0, 1);
+		bench_write_ue(bs, 0);
+		bench_write_ue(bs, 1);
+		//slice data, not parsed
+		write_rbsp_trailing(bs);
+		size = gen_payload(payload, nal_size, zeros, &nb_ep);
+		gf_bs_write_data(bs, payload, size);
+		write_nal(f, bs);
+		gf_bs_del(bs);
+	}
+	gf_free(payload);
+	gf_fclose(f);
+	return GF_TRUE;
+}
+
+typedef u32 (*next_sc_fn)(const u8 *data, u32 data_len, u32 *sc_size);
+typedef u32 (*ep_count_fn)(const u8 *buffer, u32 nal_size);
+typedef u32 (*ep_remove_fn)(const u8 *buffer_src, u8 *buffer_dst, u32 nal_size);
+
+static u64 bench_start_codes(next_sc_fn next_sc, const u8 *buf, u32 size, u32 nb_iter, u64 *time)
+{
+	u32 it;
+	u64 check = 0;
+	u64 start = gf_sys_clock_high_res();
+	for (it=0; it<nb_iter; it++) {
+		u32 pos = 0;
+		check = 0;
+		while (pos < size) {
+			u32 sc_size = 0;
+			u32 sc_pos = next_sc(buf+pos, size-pos, &sc_size);
+			if (sc_pos == size-pos) break;
+			pos += sc_pos + sc_size;
+			check += pos;
+		}
+	}
+	*time = gf_sys_clock_high_res() - start;
+	return check;
+}
+
+static u64 bench_ep_count(ep_count_fn ep_count, const u8 *buf, u32 *nal_pos, u32 nb_nals, u32 nb_iter, u64 *time)
+{
+	u32 it, i;
+	u64 check = 0;
+	u64 start = gf_sys_clock_high_res();
+	for (it=0; it<nb_iter; it++) {
+		check = 0;
+		for (i=0; i<nb_nals; i++) {
+			check += ep_count(buf + nal_pos[2*i], nal_pos[2*i+1] - nal_pos[2*i]);
+		}
+	}
+	*time = gf_sys_clock_high_res() - start;
+	return check;
+}
+
+static u64 bench_ep_remove(ep_remove_fn ep_remove, const u8 *buf, u8 *dst, u32 *nal_pos, u32 nb_nals, u32 nb_iter, u64 *time)
+{
+	u32 it, i;
+	u64 check = 0;
+	u64 start = gf_sys_clock_high_res();
+	for (it=0; it<nb_iter; it++) {
+		check = 0;
+		for (i=0; i<nb_nals; i++) {
+			check += ep_remove(buf + nal_pos[2*i], dst + nal_pos[2*i], nal_pos[2*i+1] - nal_pos[2*i]);
+		}
+	}
+	*time = gf_sys_clock_high_res() - start;
+	return check;
+}
+
+static void print_result(const char *name, u64 size, u64 ref_time, u64 time)
+{
+	Double ref_rate = ref_time ? (Double) size / ref_time / 1000 : 0;
+	Double rate = time ? (Double) size / time / 1000 : 0;
+	fprintf(stderr, "%-28s ref %6.02f GB/s - gpac %6.02f GB/s - x%.02f\n", name, ref_rate, rate, ref_rate ? rate / ref_rate : 0);
+}
+
+int main(int argc, char **argv)
+{
+	u32 i, size_mb = 64, nal_size = 65536, zeros = 256, nb_iter = 5;
+	u32 size, pos, nb_nals, nb_ep;
+	const char *avc_out = NULL;
+	u32 *nal_pos;
+	u64 ref_time, time, ref_check, check;
+	u8 *buf, *ref_dst, *dst;
+	Bool ok = GF_TRUE;
+
+	for (i=1; i<(u32)argc; i++) {
+		char *arg = argv[i];
+		if ((i+1<(u32)argc) && !strcmp(arg, "-size")) size_mb = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-nal")) nal_size = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-zeros")) zeros = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-iter")) nb_iter = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-seed")) rand_state = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-avc")) avc_out = argv[++i];
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!size_mb || (size_mb>1024) || (nal_size<8) || !zeros || !nb_iter) {
+		PrintUsage();
+		return 1;
+	}
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+
+	size = size_mb * 1024 * 1024;
+	if (avc_out) {
+		u32 nb_frames = size / nal_size;
+		if (!nb_frames) nb_frames = 1;
+		if (!write_avc(avc_out, nb_frames, nal_size, zeros)) {
+			fprintf(stderr, "Cannot write %s\n", avc_out);
+			gf_sys_close();
+			return 1;
+		}
+		fprintf(stderr, "Wrote %u AVC frames of %u bytes to %s\n", nb_frames, nal_size, avc_out);
+		gf_sys_close();
+		return 0;
+	}
+
+	nb_nals = size / (nal_size + 4) + 1;
+	buf = gf_malloc(size);
+	ref_dst = gf_malloc(size);
+	dst = gf_malloc(size);
+	//start and end of each NAL unit payload
+	nal_pos = gf_malloc(sizeof(u32) * 2 * nb_nals);
+	if (!buf || !ref_dst || !dst || !nal_pos) {
+		fprintf(stderr, "Out of memory\n");
+		if (buf) gf_free(buf);
+		if (ref_dst) gf_free(ref_dst);
+		if (dst) gf_free(dst);
+		if (nal_pos) gf_free(nal_pos);
+		gf_sys_close();
+		return 1;
+	}
+
+	//Annex-B buffer: start code then escaped payload, as produced by an encoder
+	pos = 0;
+	nb_nals = 0;
+	nb_ep = 0;
+	while (pos + 4 + 2 < size) {
+		u32 end;
+		if (nb_nals % 2) {
+			buf[pos++] = 0;
+		}
+		buf[pos++] = 0;
+		buf[pos++] = 0;
+		buf[pos++] = 1;
+		nal_pos[2*nb_nals] = pos;
+		end = pos + nal_size;
+		if (end > size) end = size;
+		//NAL header
+		buf[pos++] = 0x41;
+		pos += gen_payload(buf+pos, end-pos, zeros, &nb_ep);
+		nal_pos[2*nb_nals+1] = pos;
+		nb_nals++;
+	}
+	size = pos;
+
+	fprintf(stderr, "%u NAL units of %u bytes - %.02f MB - zero byte probability 1/%u - %u emulation prevention bytes\n", nb_nals, nal_size, (Double) size / 1000000, zeros, nb_ep);
+
+	ref_check = bench_start_codes(ref_next_start_code, buf, size, nb_iter, &ref_time);
+	check = bench_start_codes(gf_media_nalu_next_start_code, buf, size, nb_iter, &time);
+	if (check != ref_check) {
+		fprintf(stderr, "start code positions mismatch\n");
+		ok = GF_FALSE;
+	}
+	print_result("next_start_code", (u64) size * nb_iter, ref_time, time);
+
+	ref_check = bench_ep_count(ref_emulation_bytes_remove_count, buf, nal_pos, nb_nals, nb_iter, &ref_time);
+	check = bench_ep_count(gf_media_nalu_emulation_bytes_remove_count, buf, nal_pos, nb_nals, nb_iter, &time);
+	if ((check != ref_check) || (check != nb_ep)) {
+		fprintf(stderr, "emulation bytes count mismatch - %u expected, ref "LLU" gpac "LLU"\n", nb_ep, ref_check, check);
+		ok = GF_FALSE;
+	}
+	print_result("emulation_bytes_count", (u64) size * nb_iter, ref_time, time);
+
+	ref_check = bench_ep_remove(ref_remove_emulation_bytes, buf, ref_dst, nal_pos, nb_nals, nb_iter, &ref_time);
+	check = bench_ep_remove(gf_media_nalu_remove_emulation_bytes, buf, dst, nal_pos, nb_nals, nb_iter, &time);
+	if (check != ref_check) {
+		fprintf(stderr, "unescaped size mismatch\n");
+		ok = GF_FALSE;
+	} else {
+		for (i=0; i<nb_nals; i++) {
+			u32 len = ref_remove_emulation_bytes(buf + nal_pos[2*i], ref_dst + nal_pos[2*i], nal_pos[2*i+1] - nal_pos[2*i]);
+			if (memcmp(ref_dst + nal_pos[2*i], dst + nal_pos[2*i], len)) {
+				fprintf(stderr, "unescaped payload mismatch in NAL %u\n", i);
+				ok = GF_FALSE;
+				break;
+			}
+		}
+	}
+	print_result("remove_emulation_bytes", (u64) size * nb_iter, ref_time, time);
+
+	gf_free(buf);
+	gf_free(ref_dst);
+	gf_free(dst);
+	gf_free(nal_pos);
+	gf_sys_close();
+	return ok ? 0 : 1;
+}
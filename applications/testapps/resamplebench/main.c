@@ -0,0 +1,208 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom ParisTech 2024
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - audio resampler benchmark
+ *
+ */
+
+#include <gpac/filters.h>
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: resamplebench [OPTS]\n"
+	        "Runs 16 bit PCM audio held in memory through the resample filter and reports the resampling speed\n"
+	        "\n"
+	        "-sr N:        source sample rate (default 44100)\n"
+	        "-osr N:       output sample rate (default 48000)\n"
+	        "-ch N:        number of channels (default 2)\n"
+	        "-rq Q:        resample quality, linear, fast, std or best (default linear)\n"
+	        "-dur N:       source duration in seconds (default 600)\n"
+	        "-args ARGS:   extra options for resample, e.g. osfmt=flt\n"
+	       );
+}
+
+static u32 rand_state = 1;
+static u32 bench_rand()
+{
+	rand_state = rand_state * 1103515245 + 12345;
+	return (rand_state >> 16) & 0x7FFF;
+}
+
+#define FRAME_SAMPLES	1024
+
+static GF_FilterPid *src_pid = NULL;
+static u8 *src_frame = NULL;
+static u32 src_size = 0;
+static u32 nb_frames = 0, nb_sent = 0;
+static u64 nb_bytes_out = 0;
+static u32 out_bps = 2;
+
+static GF_Err bsrc_process(GF_Filter *filter)
+{
+	while (nb_sent < nb_frames) {
+		GF_FilterPacket *pck;
+		if (gf_filter_pid_would_block(src_pid))
+			return GF_OK;
+		pck = gf_filter_pck_new_shared(src_pid, src_frame, src_size, NULL);
+		if (!pck) return GF_OUT_OF_MEM;
+		gf_filter_pck_set_cts(pck, (u64) nb_sent * FRAME_SAMPLES);
+		gf_filter_pck_set_duration(pck, FRAME_SAMPLES);
+		gf_filter_pck_set_sap(pck, GF_FILTER_SAP_1);
+		gf_filter_pck_send(pck);
+		nb_sent++;
+	}
+	gf_filter_pid_set_eos(src_pid);
+	return GF_EOS;
+}
+
+static GF_Err bsink_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
+{
+	GF_FilterEvent evt;
+	const GF_PropertyValue *p;
+	if (is_remove) return GF_OK;
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_AUDIO_FORMAT);
+	if (p) out_bps = gf_audio_fmt_bit_depth(p->value.uint) / 8;
+	GF_FEVT_INIT(evt, GF_FEVT_PLAY, pid);
+	gf_filter_pid_send_event(pid, &evt);
+	return GF_OK;
+}
+
+static GF_Err bsink_process(GF_Filter *filter)
+{
+	GF_FilterPid *pid = gf_filter_get_ipid(filter, 0);
+	while (1) {
+		u32 size;
+		GF_FilterPacket *pck = gf_filter_pid_get_packet(pid);
+		if (!pck) break;
+		gf_filter_pck_get_data(pck, &size);
+		nb_bytes_out += size;
+		gf_filter_pid_drop_packet(pid);
+	}
+	return GF_OK;
+}
+
+int main(int argc, char **argv)
+{
+	u32 i, sr = 44100, osr = 48000, nb_ch = 2, dur = 600;
+	const char *rq = "linear";
+	const char *args = NULL;
+	char szArgs[GF_MAX_PATH];
+	GF_FilterSession *fsess;
+	GF_Filter *src, *resample, *sink;
+	GF_Err e;
+	u64 start, time, nb_out;
+	s16 *samples;
+
+	for (i=1; i<(u32)argc; i++) {
+		char *arg = argv[i];
+		if ((i+1<(u32)argc) && !strcmp(arg, "-sr")) sr = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-osr")) osr = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-ch")) nb_ch = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-rq")) rq = argv[++i];
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-dur")) dur = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-args")) args = argv[++i];
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!sr || !osr || !nb_ch || (nb_ch>8) || !dur) {
+		PrintUsage();
+		return 1;
+	}
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+
+	//triangle tone plus noise, content does not change the resampler cost
+	src_size = FRAME_SAMPLES * nb_ch * 2;
+	src_frame = gf_malloc(src_size);
+	if (!src_frame) {
+		fprintf(stderr, "Out of memory\n");
+		gf_sys_close();
+		return 1;
+	}
+	samples = (s16 *) src_frame;
+	for (i=0; i<FRAME_SAMPLES*nb_ch; i++) {
+		s32 tri = (s32) ((i / nb_ch) % 64);
+		if (tri>=32) tri = 64 - tri;
+		samples[i] = (s16) ((tri - 16) * 1000 + (s32) (bench_rand() % 2048) - 1024);
+	}
+	nb_frames = (u32) (((u64) dur * sr + FRAME_SAMPLES - 1) / FRAME_SAMPLES);
+
+	fsess = gf_fs_new(0, GF_FS_SCHEDULER_LOCK_FREE, 0, NULL);
+	if (!fsess) {
+		fprintf(stderr, "Cannot create filter session\n");
+		gf_free(src_frame);
+		gf_sys_close();
+		return 1;
+	}
+
+	src = gf_fs_new_filter(fsess, "bsrc", 0, &e);
+	if (src) e = gf_filter_push_caps(src, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_AUDIO), NULL, GF_CAPS_OUTPUT, 0);
+	if (src && !e) e = gf_filter_set_process_ckb(src, bsrc_process);
+	if (src && !e) {
+		src_pid = gf_filter_pid_new(src);
+		if (!src_pid) e = GF_OUT_OF_MEM;
+	}
+	if (!e) {
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_AUDIO));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_CODECID, &PROP_UINT(GF_CODECID_RAW));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_SAMPLE_RATE, &PROP_UINT(sr));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_TIMESCALE, &PROP_UINT(sr));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_NUM_CHANNELS, &PROP_UINT(nb_ch));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_AUDIO_FORMAT, &PROP_UINT(GF_AUDIO_FMT_S16));
+	}
+
+	resample = NULL;
+	if (!e) {
+		snprintf(szArgs, GF_MAX_PATH, "resample:osr=%u:rq=%s%s%s", osr, rq, args ? ":" : "", args ? args : "");
+		resample = gf_fs_load_filter(fsess, szArgs, &e);
+	}
+	if (resample) e = gf_filter_set_source(resample, src, NULL);
+
+	sink = NULL;
+	if (!e) sink = gf_fs_new_filter(fsess, "bsink", 0, &e);
+	if (sink) e = gf_filter_push_caps(sink, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_AUDIO), NULL, GF_CAPS_INPUT, 0);
+	if (sink && !e) e = gf_filter_set_configure_ckb(sink, bsink_configure_pid);
+	if (sink && !e) e = gf_filter_set_process_ckb(sink, bsink_process);
+	if (sink && !e) e = gf_filter_set_source(sink, resample, NULL);
+
+	if (e) {
+		fprintf(stderr, "Cannot setup session: %s\n", gf_error_to_string(e));
+		gf_fs_del(fsess);
+		gf_free(src_frame);
+		gf_sys_close();
+		return 1;
+	}
+	gf_filter_post_process_task(src);
+
+	fprintf(stderr, "Resampling %u s of %u channels audio from %u Hz to %u Hz - quality %s\n", dur, nb_ch, sr, osr, rq);
+
+	start = gf_sys_clock_high_res();
+	e = gf_fs_run(fsess);
+	time = gf_sys_clock_high_res() - start;
+	if (e>GF_OK) e = GF_OK;
+	if (!e) e = gf_fs_get_last_connect_error(fsess);
+	if (!e) e = gf_fs_get_last_process_error(fsess);
+
+	nb_out = nb_bytes_out / (out_bps * nb_ch);
+
+	if (e) {
+		fprintf(stderr, "Session error: %s\n", gf_error_to_string(e));
+	} else if (!nb_out || !time) {
+		fprintf(stderr, "No output produced\n");
+		e = GF_IO_ERR;
+	} else {
+		fprintf(stderr, "%.03f s - %.02f x realtime - %.02f ns per output sample - "LLU" samples out\n", (Double) time / 1000000,
+			(Double) nb_frames * FRAME_SAMPLES * 1000000 / sr / time, (Double) time * 1000 / nb_out, nb_out);
+	}
+
+	gf_fs_del(fsess);
+	gf_free(src_frame);
+	gf_sys_close();
+	return e ? 1 : 0;
+}
@@ -0,0 +1,295 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom ParisTech 2024
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - ISOBMFF sample table memory benchmark
+ *
+ */
+
+#include <gpac/isomedia.h>
+#include <gpac/filters.h>
+
+#if !defined(WIN32)
+#include <sys/resource.h>
+#endif
+
+void PrintUsage()
+{
+	fprintf(stderr, "USAGE: stblbench [OPTS]\n"
+	        "Appends samples to a flat ISOBMFF file as done when recording, and reports time and peak memory\n"
+	        "\n"
+	        "-n N:      number of samples (default 1000000)\n"
+	        "-size N:   maximum sample size in bytes, sizes are random in [1, N] (default 256)\n"
+	        "-vfr:      jitter sample durations, one time to sample entry per sample\n"
+	        "-bframes:  use an IBBP composition offset pattern\n"
+	        "-nopack:   disable sample table compaction (same as -no-stbl-pack)\n"
+	        "-mux:      send samples through the mp4 muxer filter (with dependency flags) instead of calling the isomedia API\n"
+	        "-o FILE:   output file (default stblbench.mp4, deleted unless -keep is set)\n"
+	        "-keep:     keep output file\n"
+	        "-seed N:   random seed (default 1)\n"
+	       );
+}
+
+static u32 rand_state = 1;
+static u32 bench_rand()
+{
+	rand_state = rand_state * 1103515245 + 12345;
+	return (rand_state >> 16) & 0x7FFF;
+}
+
+static u32 bench_size(u32 max_size)
+{
+	u32 r = bench_rand();
+	//more than 15 bits needed
+	if (max_size > 0x8000) r = (r << 15) | bench_rand();
+	return 1 + r % max_size;
+}
+
+static u64 get_peak_rss()
+{
+#if !defined(WIN32)
+	struct rusage ru;
+	if (getrusage(RUSAGE_SELF, &ru)) return 0;
+	//kilobytes on linux
+	return (u64) ru.ru_maxrss * 1024;
+#else
+	return 0;
+#endif
+}
+
+static GF_FilterPid *src_pid = NULL;
+static u8 *src_data = NULL;
+static u32 src_max_size = 0;
+static u32 nb_sent = 0, nb_to_send = 0;
+static Bool src_vfr = GF_FALSE, src_bframes = GF_FALSE;
+static u64 src_dts = 0, src_end_time = 0, src_end_rss = 0;
+
+static GF_Err bsrc_process(GF_Filter *filter)
+{
+	//packets sent before the muxer is connected would be queued in the session
+	if (!gf_filter_pid_is_playing(src_pid))
+		return GF_OK;
+	while (nb_sent < nb_to_send) {
+		GF_FilterPacket *pck;
+		u32 cts_o = 0;
+		u8 dep_flags;
+		if (gf_filter_pid_would_block(src_pid))
+			return GF_OK;
+		pck = gf_filter_pck_new_shared(src_pid, src_data, bench_size(src_max_size), NULL);
+		if (!pck) return GF_OUT_OF_MEM;
+		//I frames do not depend on others, B frames are not depended on
+		if (!(nb_sent%60)) {
+			if (src_bframes) cts_o = 3000;
+			dep_flags = 0x20;
+		} else if (!src_bframes || !(nb_sent%3)) {
+			if (src_bframes) cts_o = 3*3000;
+			dep_flags = 0x10;
+		} else {
+			dep_flags = 0x18;
+		}
+		gf_filter_pck_set_dts(pck, src_dts);
+		gf_filter_pck_set_cts(pck, src_dts + cts_o);
+		gf_filter_pck_set_sap(pck, (nb_sent%60) ? GF_FILTER_SAP_NONE : GF_FILTER_SAP_1);
+		gf_filter_pck_set_dependency_flags(pck, dep_flags);
+		gf_filter_pck_send(pck);
+		src_dts += src_vfr ? 2990 + bench_rand() % 21 : 3000;
+		nb_sent++;
+	}
+	src_end_time = gf_sys_clock_high_res();
+	src_end_rss = get_peak_rss();
+	gf_filter_pid_set_eos(src_pid);
+	return GF_EOS;
+}
+
+static GF_Err run_mux(const char *dst, u32 nb_samples, u32 max_size, Bool vfr, Bool bframes, Bool nopack)
+{
+	GF_FilterSession *fsess;
+	GF_Filter *src, *mux;
+	GF_Err e;
+	u64 start, end, rss_start, rss_end;
+
+	fsess = gf_fs_new(0, GF_FS_SCHEDULER_LOCK_FREE, 0, NULL);
+	if (!fsess) return GF_OUT_OF_MEM;
+
+	src_max_size = max_size;
+	nb_to_send = nb_samples;
+	src_vfr = vfr;
+	src_bframes = bframes;
+	src = gf_fs_new_filter(fsess, "bsrc", 0, &e);
+	if (src) e = gf_filter_push_caps(src, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_VISUAL), NULL, GF_CAPS_OUTPUT, 0);
+	if (src && !e) e = gf_filter_set_process_ckb(src, bsrc_process);
+	if (src && !e) {
+		src_pid = gf_filter_pid_new(src);
+		if (!src_pid) e = GF_OUT_OF_MEM;
+	}
+	if (!e) {
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_VISUAL));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_CODECID, &PROP_UINT(GF_4CC('s','t','b','l')));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_TIMESCALE, &PROP_UINT(90000));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_WIDTH, &PROP_UINT(320));
+		gf_filter_pid_set_property(src_pid, GF_PROP_PID_HEIGHT, &PROP_UINT(240));
+	}
+	mux = NULL;
+	if (!e) mux = gf_fs_load_destination(fsess, dst, NULL, NULL, &e);
+	if (mux) e = gf_filter_set_source(mux, src, NULL);
+	if (e) {
+		gf_fs_del(fsess);
+		return e;
+	}
+	gf_filter_post_process_task(src);
+
+	fprintf(stderr, "Muxing %u samples - sizes 1 to %u bytes%s%s - sample table compaction %s\n", nb_samples, max_size,
+		vfr ? " - VFR" : "", bframes ? " - IBBP" : "", nopack ? "off" : "on");
+
+	rss_start = get_peak_rss();
+	start = gf_sys_clock_high_res();
+	e = gf_fs_run(fsess);
+	end = gf_sys_clock_high_res();
+	if (e>GF_OK) e = GF_OK;
+	if (!e) e = gf_fs_get_last_connect_error(fsess);
+	if (!e) e = gf_fs_get_last_process_error(fsess);
+	gf_fs_del(fsess);
+	rss_end = get_peak_rss();
+
+	if (!e && (nb_sent != nb_samples)) e = GF_IO_ERR;
+	if (!e) {
+		fprintf(stderr, "Add: %.03f s (%.02f us per sample) - peak RSS %.02f MB (+%.02f MB for %u samples)\n",
+			(Double) (src_end_time - start) / 1000000, (Double) (src_end_time - start) / nb_samples, (Double) src_end_rss / 1000000, (Double) (src_end_rss - rss_start) / 1000000, nb_samples);
+		fprintf(stderr, "Close: %.03f s - peak RSS %.02f MB\n", (Double) (end - src_end_time) / 1000000, (Double) rss_end / 1000000);
+	}
+	return e;
+}
+
+int main(int argc, char **argv)
+{
+	u32 i, tk, di, max_size = 256, nb_samples = 1000000;
+	Bool vfr = GF_FALSE, bframes = GF_FALSE, nopack = GF_FALSE, keep = GF_FALSE, mux = GF_FALSE;
+	const char *dst = "stblbench.mp4";
+	u64 dts, start, add_time, close_time, rss_start, rss_add, rss_end;
+	GF_GenericSampleDescription udesc;
+	GF_ISOSample *samp;
+	GF_ISOFile *file;
+	GF_Err e;
+	u8 *data;
+
+	for (i=1; i<(u32)argc; i++) {
+		char *arg = argv[i];
+		if ((i+1<(u32)argc) && !strcmp(arg, "-n")) nb_samples = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-size")) max_size = atoi(argv[++i]);
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-o")) dst = argv[++i];
+		else if ((i+1<(u32)argc) && !strcmp(arg, "-seed")) rand_state = atoi(argv[++i]);
+		else if (!strcmp(arg, "-vfr")) vfr = GF_TRUE;
+		else if (!strcmp(arg, "-bframes")) bframes = GF_TRUE;
+		else if (!strcmp(arg, "-nopack")) nopack = GF_TRUE;
+		else if (!strcmp(arg, "-mux")) mux = GF_TRUE;
+		else if (!strcmp(arg, "-keep")) keep = GF_TRUE;
+		else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!nb_samples || !max_size) {
+		PrintUsage();
+		return 1;
+	}
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	if (nopack) gf_opts_set_key("temp", "no-stbl-pack", "yes");
+
+	data = gf_malloc(max_size);
+	if (!data) {
+		fprintf(stderr, "Out of memory\n");
+		gf_sys_close();
+		return 1;
+	}
+	memset(data, 0xAA, max_size);
+
+	if (mux) {
+		src_data = data;
+		e = run_mux(dst, nb_samples, max_size, vfr, bframes, nopack);
+		if (e) fprintf(stderr, "Error muxing samples: %s\n", gf_error_to_string(e));
+		gf_free(data);
+		if (!keep) gf_file_delete(dst);
+		gf_sys_close();
+		return e ? 1 : 0;
+	}
+
+	file = gf_isom_open(dst, GF_ISOM_OPEN_WRITE, NULL);
+	if (!file) {
+		fprintf(stderr, "Cannot open output %s: %s\n", dst, gf_error_to_string(gf_isom_last_error(NULL)));
+		gf_free(data);
+		gf_sys_close();
+		return 1;
+	}
+	tk = gf_isom_new_track(file, 0, GF_ISOM_MEDIA_VISUAL, 90000);
+	gf_isom_set_track_enabled(file, tk, GF_TRUE);
+	memset(&udesc, 0, sizeof(GF_GenericSampleDescription));
+	udesc.codec_tag = GF_4CC('s','t','b','l');
+	udesc.width = 320;
+	udesc.height = 240;
+	e = gf_isom_new_generic_sample_description(file, tk, NULL, NULL, &udesc, &di);
+	if (e) {
+		fprintf(stderr, "Cannot create sample description: %s\n", gf_error_to_string(e));
+		gf_isom_delete(file);
+		gf_free(data);
+		gf_sys_close();
+		return 1;
+	}
+
+	fprintf(stderr, "Appending %u samples - sizes 1 to %u bytes%s%s - sample table compaction %s\n", nb_samples, max_size,
+		vfr ? " - VFR" : "", bframes ? " - IBBP" : "", nopack ? "off" : "on");
+
+	samp = gf_isom_sample_new();
+	samp->data = data;
+	rss_start = get_peak_rss();
+	start = gf_sys_clock_high_res();
+	dts = 0;
+	for (i=0; i<nb_samples; i++) {
+		samp->dataLength = bench_size(max_size);
+		samp->DTS = dts;
+		samp->IsRAP = (i % 60) ? RAP_NO : RAP;
+		samp->CTS_Offset = 0;
+		if (bframes) {
+			//P B B in decode order, P frames are displayed after the two B frames
+			if (!(i%60)) samp->CTS_Offset = 3000;
+			else if (!(i%3)) samp->CTS_Offset = 3*3000;
+		}
+		e = gf_isom_add_sample(file, tk, di, samp);
+		if (e) break;
+		dts += vfr ? 2990 + bench_rand() % 21 : 3000;
+	}
+	add_time = gf_sys_clock_high_res() - start;
+	rss_add = get_peak_rss();
+	samp->data = NULL;
+	samp->dataLength = 0;
+	gf_isom_sample_del(&samp);
+
+	if (e) {
+		fprintf(stderr, "Error adding sample %u: %s\n", i+1, gf_error_to_string(e));
+		gf_isom_delete(file);
+		gf_free(data);
+		gf_sys_close();
+		return 1;
+	}
+
+	start = gf_sys_clock_high_res();
+	e = gf_isom_close(file);
+	close_time = gf_sys_clock_high_res() - start;
+	rss_end = get_peak_rss();
+	gf_free(data);
+
+	if (e) {
+		fprintf(stderr, "Error writing file: %s\n", gf_error_to_string(e));
+	} else {
+		fprintf(stderr, "Add: %.03f s (%.02f us per sample) - peak RSS %.02f MB (+%.02f MB for %u samples)\n",
+			(Double) add_time / 1000000, (Double) add_time / nb_samples, (Double) rss_add / 1000000, (Double) (rss_add - rss_start) / 1000000, nb_samples);
+		fprintf(stderr, "Close: %.03f s - peak RSS %.02f MB\n", (Double) close_time / 1000000, (Double) rss_end / 1000000);
+	}
+	if (!keep) gf_file_delete(dst);
+
+	gf_sys_close();
+	return e ? 1 : 0;
+}
@@ -782,6 +782,12 @@ Errors will be thrown if these are not met on future parts and merging will be d
 */
 void gf_dash_enable_single_range_llhls(GF_DashClient *dash, Bool enable_single_range);
 
+/*! sets maximum size of merged subsegments for on-demand representations indexed by a SIDX box. Consecutive subsegments are merged into a single byte range request as long as the merged range does not exceed the given size. This reduces the number of requests at the cost of coarser switching and seeking granularity; this must be called before the manifest is opened
+\param dash the target dash client
+\param max_size maximum merged size in bytes, 0 disables merging
+*/
+void gf_dash_set_sidx_merge(GF_DashClient *dash, u32 max_size);
+
 /*! create a new DASH client
 \param dash the target dash cleint
 \param auto_switch_count forces representation switching (quality up if positive, down if negative) every auto_switch_count segments, set to 0 to disable
@@ -955,6 +961,23 @@ void gf_dash_set_tile_adaptation_mode(GF_DashClient *dash, GF_DASHTileAdaptation
 */
 void gf_dash_disable_low_quality_tiles(GF_DashClient *dash, Bool disable_tiles);
 
+/*! sets the number of segments the client fetches ahead of the current segment in each group. The segment queue of each group is enlarged accordingly; this must be called before the manifest is opened
+\param dash the target dash client
+\param nb_segs number of segments to queue ahead of the current one, 0 disables prefetching
+*/
+void gf_dash_set_prefetch(GF_DashClient *dash, u32 nb_segs);
+
+/*! gets a segment queued for download in a group, without consuming it
+\param dash the target dash client
+\param group_idx the 0-based index of the target group
+\param seg_idx the 0-based index of the queued segment, 0 being the segment returned by the next call to \ref gf_dash_group_get_next_segment_location
+\param url set to the URL of the queued segment
+\param start_range set to the start byte offset of the segment in the resource, or 0 if not a byte range
+\param end_range set to the end byte offset of the segment in the resource, or 0 if not a byte range
+\return error if any, GF_BUFFER_TOO_SMALL if fewer segments are queued, GF_URL_REMOVED if the segment is disabled
+*/
+GF_Err gf_dash_group_get_queued_segment(GF_DashClient *dash, u32 group_idx, u32 seg_idx, const char **url, u64 *start_range, u64 *end_range);
+
 /*! gets current tile adaptation mode
 \param dash the target dash client
 \return tile adaptation mode*/
@@ -505,6 +505,22 @@ Gets the cumultated bitrate in of all active sessions.
  */
 u32 gf_dm_get_global_rate(GF_DownloadManager *dm);
 
+/*!
+\brief gets connection statistics of a remote host
+
+Gets connection statistics of a remote host contacted by the download manager. Hosts are identified by name, port and use of TLS.
+\param dm the download manager object
+\param idx 0-based index of the host
+\param server set to the host name - may be NULL
+\param port set to the host port - may be NULL
+\param nb_connections set to the number of TCP connections opened to the host - may be NULL
+\param nb_reused set to the number of requests sent on an already opened connection (keep-alive, idle connection pool or HTTP/2 stream) - may be NULL
+\param nb_handshakes set to the number of TLS handshakes performed - may be NULL
+\param nb_resumed set to the number of TLS handshakes using session resumption - may be NULL
+\return error if any, GF_EOS if no more hosts
+ */
+GF_Err gf_dm_get_host_stats(GF_DownloadManager *dm, u32 idx, const char **server, u16 *port, u32 *nb_connections, u32 *nb_reused, u32 *nb_handshakes, u32 *nb_resumed);
+
 
 /*!
 \brief Get header sizes and times stats for the session
@@ -663,6 +679,7 @@ const char *gf_dm_sess_get_header(GF_DownloadSession *sess, const char *name);
 u64 gf_dm_sess_get_utc_start(GF_DownloadSession *sess);
 u32 gf_dm_get_data_rate(GF_DownloadManager *dm);
 u32 gf_dm_get_global_rate(GF_DownloadManager *dm);
+GF_Err gf_dm_get_host_stats(GF_DownloadManager *dm, u32 idx, const char **server, u16 *port, u32 *nb_connections, u32 *nb_reused, u32 *nb_handshakes, u32 *nb_resumed);
 void gf_dm_set_data_rate(GF_DownloadManager *dm, u32 rate_in_bits_per_sec);
 GF_DownloadManager *gf_dm_new(GF_DownloadFilterSession *fsess);
 void gf_dm_del(GF_DownloadManager *dm);
@@ -290,6 +290,7 @@ Generic filter options are:
 - NCID: ID of netcap configuration to use (string)
 - DBG: debug missing input PID property (`=pid`), missing input packet property (`=pck`) or both (`=all`)
 - DL: enable defer linking of filter (no value) - the filter output pids will not be connected until a call to \ref gf_filter_reconnect_output
+- TH: pin filter to the given session thread (unsigned int value, 1-based, 0 for least loaded thread) - ignored if no extra thread is used
 
 
 \param session filter session
@@ -349,6 +350,32 @@ GF_Err gf_fs_set_max_resolution_chain_length(GF_FilterSession *session, u32 max_
 */
 GF_Err gf_fs_set_max_sleep_time(GF_FilterSession *session, u32 max_sleep);
 
+/*! Policy applied when the memory budget of a session is exceeded*/
+typedef enum
+{
+	/*! output PIDs holding packets are blocked until memory is released*/
+	GF_FS_MEM_BLOCK=0,
+	/*! packets are dropped for destinations lagging behind, until their next SAP once memory is released*/
+	GF_FS_MEM_DROP,
+} GF_FSMemPolicy;
+
+/*! Sets the memory budget of the session. The budget applies to the data of packets allocated by filters and not yet released, whatever the filter chain holding them.
+\param session filter session
+\param budget budget in bytes, 0 means no budget
+\param policy policy to apply when the budget is exceeded
+\return error if any
+*/
+GF_Err gf_fs_set_memory_budget(GF_FilterSession *session, u64 budget, GF_FSMemPolicy policy);
+
+/*! Gets memory held by packets of the session
+\param session filter session
+\param pck_mem set to the number of bytes of allocated packets not yet released - may be NULL
+\param reservoir_mem set to the number of bytes of packets kept in filter reservoirs for reuse - may be NULL
+\param nb_drops set to the number of packets dropped because of memory budget - may be NULL
+\return error if any
+*/
+GF_Err gf_fs_get_memory_usage(GF_FilterSession *session, u64 *pck_mem, u64 *reservoir_mem, u64 *nb_drops);
+
 /*! gets the maximum filter chain lengtG
 \param session filter session
 \return maximum chain length when resolving filter links.
@@ -801,6 +828,14 @@ typedef enum
  */
 void gf_fs_print_debug_info(GF_FilterSession *session, GF_SessionDebugFlag dbg_flags);
 
+/*! requests a dump of the session trace (see -trace option)
+
+The dump is performed by the main thread of the session when executing its next task. This function only sets a flag and may be called from a signal handler.
+
+\param session filter session
+ */
+void gf_fs_request_trace_dump(GF_FilterSession *session);
+
 
 /*! @} */
 
@@ -1095,6 +1130,7 @@ enum
 	GF_PROP_PID_UNFRAMED_FULL_AU = GF_4CC('P','F','R','F'),
 	GF_PROP_PID_DURATION = GF_4CC('P','D','U','R'),
 	GF_PROP_PID_NB_FRAMES = GF_4CC('N','F','R','M'),
+	GF_PROP_PID_NB_SYNC = GF_4CC('N','S','Y','N'),
 	GF_PROP_PID_FRAME_OFFSET = GF_4CC('F','R','M','O'),
 	GF_PROP_PID_FRAME_SIZE = GF_4CC('C','F','R','S'),
 	GF_PROP_PID_TIMESHIFT_DEPTH = GF_4CC('P','T','S','D'),
@@ -2621,6 +2657,22 @@ immediately or after reschedule_ms.
 */
 GF_Err gf_filter_post_task(GF_Filter *filter, Bool (*task_execute) (GF_Filter *filter, void *callback, u32 *reschedule_ms), void *udta, const char *task_name);
 
+/*! Gets the number of threads of the session running the filter, including the main thread
+\param filter target filter
+\return number of threads, 1 if the session does not use extra threads
+*/
+u32 gf_filter_get_num_threads(GF_Filter *filter);
+
+/*! Runs a job split in several parts on the session threads, typically to process bands of a frame. The calling thread runs parts as well, and idle session threads pick up the remaining parts. The function returns once all parts are done.
+Parts may run concurrently and in any order; the callback shall not use the filter API. No thread is created, if the session has no extra thread all parts are run by the calling thread.
+\param filter target filter
+\param nb_parts number of parts, usually at most \ref gf_filter_get_num_threads
+\param run_part callback function called once for each part
+\param udta user data passed back to the callback
+\return error code if failure
+*/
+GF_Err gf_filter_run_parallel(GF_Filter *filter, u32 nb_parts, void (*run_part)(void *udta, u32 part_idx), void *udta);
+
 
 /*! Sets callback function on source filter setup failure
 \param filter target filter
@@ -3279,6 +3331,16 @@ Bool gf_filter_in_parent_chain(GF_Filter *parent, GF_Filter *filter);
 */
 GF_Err gf_filter_get_stats(GF_Filter *filter, GF_FilterStats *stats);
 
+/*! Gets memory held by packets of a filter
+\param filter target filter
+\param pck_mem set to the number of bytes of packets allocated by this filter and not yet released - may be NULL
+\param reservoir_mem set to the number of bytes of packets kept in this filter reservoir for reuse - may be NULL
+\param in_mem set to the number of bytes of packets waiting on the input PIDs of this filter - may be NULL
+\param nb_drops set to the number of packets dropped on input PIDs of this filter because of session memory budget - may be NULL
+\return error code if any
+*/
+GF_Err gf_filter_get_memory_usage(GF_Filter *filter, u64 *pck_mem, u64 *reservoir_mem, u64 *in_mem, u64 *nb_drops);
+
 
 /*! Enumerates default arguments of a filter
 \param filter filter session
@@ -1216,6 +1216,21 @@ void gf_mixer_remove_input(GF_AudioMixer *am, GF_AudioInterface *src);
 void gf_mixer_lock(GF_AudioMixer *am, Bool lockIt);
 void gf_mixer_set_max_speed(GF_AudioMixer *am, Double max_speed);
 
+/*resampling quality of the mixer*/
+enum
+{
+	/*linear interpolation (default)*/
+	GF_MIXER_RESAMPLE_LINEAR = 0,
+	/*polyphase windowed-sinc, 16 taps*/
+	GF_MIXER_RESAMPLE_FAST,
+	/*polyphase windowed-sinc, 32 taps*/
+	GF_MIXER_RESAMPLE_STD,
+	/*polyphase windowed-sinc, 64 taps*/
+	GF_MIXER_RESAMPLE_BEST,
+};
+/*sets resampling quality, one of GF_MIXER_RESAMPLE_* values*/
+void gf_mixer_set_resample_quality(GF_AudioMixer *am, u32 quality);
+
 /*mix inputs in buffer, return number of bytes written to output*/
 u32 gf_mixer_get_output(GF_AudioMixer *am, void *buffer, u32 buffer_size, u32 delay_ms);
 /*reconfig all sources if needed - returns TRUE if main audio config changed
@@ -1152,6 +1152,30 @@ typedef struct
 	char *nameURN;
 } GF_DataEntryURNBox;
 
+#ifndef GPAC_DISABLE_ISOM_WRITE
+/*varint column holding sample table entries compacted while appending samples in write mode
+tables are materialized back when read, edited or written, see stbl_FlushColumn*/
+typedef struct
+{
+	u8 *data;
+	u32 size, alloc;
+	/*number of table entries stored in the column*/
+	u32 nb_entries;
+	/*last coded value for chunk offsets (delta coding), total duration for time to sample*/
+	u64 last;
+	/*number of samples described by the column, for time to sample and composition offsets*/
+	u32 nb_samples;
+	/*set once the table has been materialized, compaction is no longer done for this table*/
+	Bool disabled;
+	/*read cursor: index of next entry to decode, its position in data and value of the previous entry
+	for time to sample and composition offsets, also sample count, first sample and time of the previous entry*/
+	u32 r_idx, r_pos;
+	u64 r_val;
+	u32 r_count, r_sample;
+	u64 r_time;
+} GF_StblColumn;
+#endif
+
 typedef struct
 {
 	u32 sampleCount;
@@ -1178,6 +1202,10 @@ typedef struct
 
 	//stats for read
 	u32 max_ts_delta;
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	/*first entries of the table when compacted, entries only holds the last ones*/
+	GF_StblColumn w_col;
+#endif
 } GF_TimeToSampleBox;
 
 
@@ -1205,6 +1233,10 @@ typedef struct
 
 	s32 max_cts_delta;
 	//u32 sample_num_max_cts_delta;
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	/*first entries of the table when compacted, entries only holds the last ones*/
+	GF_StblColumn w_col;
+#endif
 } GF_CompositionOffsetBox;
 
 
@@ -1909,6 +1941,10 @@ typedef struct
 	u32 max_size;
 	u64 total_size;
 	u32 total_samples;
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	/*first sizes when compacted, sizes only holds the last (sampleCount - w_col.nb_entries) ones*/
+	GF_StblColumn w_col;
+#endif
 } GF_SampleSizeBox;
 
 typedef struct
@@ -1917,6 +1953,10 @@ typedef struct
 	u32 nb_entries;
 	u32 alloc_size;
 	u32 *offsets;
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	/*first offsets when compacted, offsets only holds the last (nb_entries - w_col.nb_entries) ones*/
+	GF_StblColumn w_col;
+#endif
 } GF_ChunkOffsetBox;
 
 typedef struct
@@ -1925,6 +1965,10 @@ typedef struct
 	u32 nb_entries;
 	u32 alloc_size;
 	u64 *offsets;
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	/*first offsets when compacted, offsets only holds the last (nb_entries - w_col.nb_entries) ones*/
+	GF_StblColumn w_col;
+#endif
 } GF_ChunkLargeOffsetBox;
 
 typedef struct
@@ -4317,6 +4361,8 @@ GF_Err stbl_GetSampleDepType(GF_SampleDependencyTypeBox *stbl, u32 SampleNumber,
 
 /*unpack sample2chunk and chunk offset so that we have 1 sample per chunk (edition mode only)*/
 GF_Err stbl_UnpackOffsets(GF_SampleTableBox *stbl);
+/*expands runs of chunks sharing a sample2chunk entry (write mode) into one entry per chunk*/
+GF_Err stbl_ExpandChunkRuns(GF_SampleTableBox *stbl);
 GF_Err stbl_unpackCTS(GF_SampleTableBox *stbl);
 GF_Err SetTrackDuration(GF_TrackBox *trak);
 GF_Err SetTrackDurationEx(GF_TrackBox *trak, Bool keep_utc);
@@ -4383,7 +4429,27 @@ GF_EdtsEntry *CreateEditEntry(u64 EditDuration, u64 MediaTime, u32 MediaRate, u8
 GF_Err stbl_SetRedundant(GF_SampleTableBox *stbl, u32 sampleNumber);
 GF_Err stbl_AddRedundant(GF_SampleTableBox *stbl, u32 sampleNumber);
 
+/*materializes a sample table box (stts, ctts, stsz, stz2, stco or co64) compacted while appending samples*/
+GF_Err stbl_FlushColumn(GF_Box *a);
+/*materializes all compacted tables of a sample table*/
+GF_Err stbl_FlushColumns(GF_SampleTableBox *stbl);
+/*writes the compacted entries of a stts, ctts or stsz box, before the entries still in the table*/
+GF_Err stbl_WriteColumn(GF_Box *a, GF_BitStream *bs);
+/*gets entry idx of a stsz or stco/co64 column without materializing the table (is_delta set for chunk offsets)
+entries are decoded forward from the last read one, returns GF_FALSE if idx is not in the column or is before the last
+read entry (except for the first entry), in which case the table must be restored*/
+Bool stbl_GetColumnEntry(GF_StblColumn *col, u32 idx, Bool is_delta, u64 *val);
+/*gets time (stts only) and value (delta or signed offset) of a sample in a stts or ctts column, same rules as above*/
+Bool stbl_GetColumnSample(GF_StblColumn *col, Bool is_ctts, u32 SampleNumber, u64 *time, s64 *val);
+/*same as gf_isom_get_track_from_file but keeps sample tables compacted, only used by functions appending samples
+or setting info of appended samples, and by functions accessing tables only through stbl_GetSample* (which handle compacted tables)*/
+GF_TrackBox *gf_isom_get_track_for_append(GF_ISOFile *the_file, u32 trackNumber);
+
 /*REMOVE functions*/
+#else
+#define stbl_FlushColumn(_a)	GF_OK
+#define stbl_FlushColumns(_a)	GF_OK
+#define gf_isom_get_track_for_append	gf_isom_get_track_from_file
 #endif
 
 #if !defined(GPAC_DISABLE_ISOM_WRITE) || !defined(GPAC_DISABLE_ISOM_FRAGMENTS)
@@ -22,6 +22,73 @@
   (say, 10 or 20)
 
   ****************************************************************/
+#ifndef _GF_RS_FEC_H_
+#define _GF_RS_FEC_H_
+
+#include <gpac/tools.h>
+
+/*
+	Systematic Reed-Solomon erasure code over GF(2^8), used for application-layer FEC of LCT objects
+
+	A source block of k symbols is extended with up to 255-k repair symbols, any k symbols among the k+r encoding
+	symbols being enough to rebuild the source block. Repair symbols use a Cauchy generator matrix.
+*/
+
+/*! maximum number of encoding symbols (source+repair) in a source block*/
+#define GF_RS_FEC_MAX_SYMBOLS	255
+
+/*! computes repair symbols of a source block
+\param src the k source symbols, each of sym_size bytes
+\param k number of source symbols
+\param repair the repair symbols to fill, each of sym_size bytes. Repair symbol i has encoding symbol ID k+i
+\param nb_repair number of repair symbols
+\param sym_size size of a symbol in bytes
+
+eturn error if any
+*/
+GF_Err gf_rs_fec_encode(const u8 **src, u32 k, u8 **repair, u32 nb_repair, u32 sym_size);
+
+/*! rebuilds missing source symbols of a source block
+\param src the k source symbols, each of sym_size bytes. Missing symbols are overwritten
+\param k number of source symbols
+\param missing indexes of missing source symbols
+\param nb_missing number of missing source symbols
+\param repair received repair symbols, at least nb_missing
+\param repair_idx index of each received repair symbol (encoding symbol ID minus k)
+\param sym_size size of a symbol in bytes
+
+eturn error if any
+*/
+GF_Err gf_rs_fec_decode(u8 **src, u32 k, const u32 *missing, u32 nb_missing, const u8 **repair, const u32 *repair_idx, u32 sym_size);
+
+/*! computes dst ^= c*src over GF(2^8), using SIMD when available
+\param dst destination buffer
+\param src source buffer
+\param c multiplication factor
+\param len size of buffers in bytes
+*/
+void gf_rs_fec_mul_add(u8 *dst, const u8 *src, u8 c, u32 len);
+
+/*! gets name of the SIMD implementation used for GF(2^8) region arithmetic
+
+eturn name of implementation*/
+const char *gf_rs_fec_get_impl(void);
+
+/*! partitions an object in source blocks (RFC 5052 block partitioning algorithm)
+\param size size of the object in bytes
+\param sym_size size of a symbol in bytes
+\param max_k maximum number of source symbols in a block
+\param nb_blocks set to the number of source blocks
+\param k_large set to the number of source symbols in the first nb_large blocks
+\param k_small set to the number of source symbols in the remaining blocks
+\param nb_large set to the number of blocks with k_large symbols
+*/
+void gf_rs_fec_partition(u64 size, u32 sym_size, u32 max_k, u32 *nb_blocks, u32 *k_large, u32 *k_small, u32 *nb_large);
+
+#endif //_GF_RS_FEC_H_
+
+#ifdef GPAC_ENABLE_MPE
+
 #ifndef _ECC_H_
 #define _ECC_H_
 #define NPAR 64
@@ -76,3 +143,5 @@ void mult_polys(int dst[], int p1[], int p2[]);
 void copy_poly(int dst[], int src[]);
 void zero_poly(int poly[]);
 #endif //_ECC_H_
+
+#endif //GPAC_ENABLE_MPE
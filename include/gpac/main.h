@@ -161,6 +161,8 @@ typedef struct
 #define GF_ARG_4CCS		6
 /*! argument is a custom arg, default value contains the syntax of the argument*/
 #define GF_ARG_CUSTOM	7
+/*! argument is a 64 bit unsigned integer, k, M and G suffixes allowed*/
+#define GF_ARG_LUINT	8
 
 /*! macros for defining a GF_GPACArg argument*/
 #define GF_DEF_ARG(_a, _b, _c, _d, _e, _f, _g) {_a, _b, _c, _d, _e, _f, _g}
@@ -928,6 +928,8 @@ typedef struct {
 	Bool llhls_rendition_reports;
 	/*! user-defined  PART-HOLD-BACK, auto computed if <=0*/
 	Double llhls_part_holdback;
+	/*! if true signal CAN-BLOCK-RELOAD in EXT-X-SERVER-CONTROL*/
+	Bool llhls_can_block;
 	//als absolute url flag
 	u32 hls_abs_url;
 	Bool m3u8_use_repid;
@@ -663,6 +663,25 @@ Fetches data on a socket without performing any select (wait), to be used with s
  */
 GF_Err gf_sk_receive_no_select(GF_Socket *sock, u8 *buffer, u32 length, u32 *read);
 
+/*!
+Fetches several datagrams on a UDP socket without performing any select (wait). Datagram i is written at buffer + i*max_size. On systems without batched reception, datagrams are read one at a time
+\param sock the socket object
+\param buffer the reception buffer where data is written, must be at least nb_pck * max_size bytes
+\param max_size the maximum size of a datagram; larger datagrams are truncated
+\param nb_pck set to the maximum number of datagrams to fetch, and set on output to the number of datagrams received
+\param sizes set to the size of each received datagram, must hold at least nb_pck entries
+\param arrival_ntp set to the arrival time of each received datagram as an NTP timestamp, using kernel timestamps when enabled through \ref gf_sk_enable_rx_timestamps - may be NULL
+\return error if any, GF_IP_NETWORK_EMPTY if nothing to read
+ */
+GF_Err gf_sk_receive_batch(GF_Socket *sock, u8 *buffer, u32 max_size, u32 *nb_pck, u32 *sizes, u64 *arrival_ntp);
+
+/*!
+Enables kernel reception timestamps on a socket, reported by \ref gf_sk_receive_batch. Software timestamps are taken by the network stack when the datagram is received, before any queuing in the socket buffer
+\param sock the socket object
+\return error if any, GF_NOT_SUPPORTED if kernel timestamps are not available on this platform
+ */
+GF_Err gf_sk_enable_rx_timestamps(GF_Socket *sock);
+
 /*!
 Checks if connection has been closed by remote peer
 \param sock the socket object
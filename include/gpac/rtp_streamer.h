@@ -308,6 +308,22 @@ u16 gf_rtp_streamer_get_next_rtp_sn(GF_RTPStreamer *streamer);
 */
 GF_Err gf_rtp_streamer_set_interleave_callbacks(GF_RTPStreamer *streamer, GF_Err (*RTP_TCPCallback)(void *cbk1, void *cbk2, Bool is_rtcp, u8 *pck, u32 pck_size), void *cbk1, void *cbk2);
 
+/*! callback function for capturing RTP packets produced by the streamer
+\param udta user data passed to \ref gf_rtp_streamer_set_packet_callback
+\param hdr the RTP header of the packet
+\param payload the RTP payload of the packet
+\param payload_size the RTP payload size in bytes
+\return error if any
+*/
+typedef GF_Err (*gf_rtp_packet_callback)(void *udta, GF_RTPHeader *hdr, u8 *payload, u32 payload_size);
+
+/*! sets packet capture callback. When set, packets are no longer sent on the RTP channel but passed to the callback, and the streamer may be used without RTP channel setup
+\param streamer the target RTP streamer
+\param on_packet the callback function, or NULL to restore channel sending
+\param udta opaque data passed to callback function
+\return error if any
+*/
+GF_Err gf_rtp_streamer_set_packet_callback(GF_RTPStreamer *streamer, gf_rtp_packet_callback on_packet, void *udta);
 
 /*! callback function for procesing RTCP  receiver reports
 \param cbk user data passed to \ref  gf_rtp_streamer_read_rtcp
@@ -1989,6 +1989,58 @@ Bool gf_fileio_read_mode(GF_FileIO *fileio);
 */
 Bool gf_fileio_write_mode(GF_FileIO *fileio);
 
+/*! Asynchronous file I/O engine
+
+The engine owns a set of fixed-size blocks used as I/O buffers. Reads and writes are queued on a block with an explicit file offset, submitted in batches and completed without changing the file position. Only one operation can be pending per block.
+The engine is only available on Linux builds with io_uring support (GPAC_HAS_IO_URING), \ref gf_aio_new returns NULL otherwise.
+*/
+typedef struct __gf_async_io GF_AsyncIO;
+
+/*! Creates a new asynchronous I/O engine
+\param nb_blocks number of I/O blocks
+\param block_size size of each I/O block. Blocks are aligned on 4096 bytes
+\return new engine, or NULL if asynchronous I/O is not available
+*/
+GF_AsyncIO *gf_aio_new(u32 nb_blocks, u32 block_size);
+
+/*! Destroys an asynchronous I/O engine, waiting for pending operations to complete
+\param aio target engine
+*/
+void gf_aio_del(GF_AsyncIO *aio);
+
+/*! Gets memory of an I/O block
+\param aio target engine
+\param idx index of the block
+\return block memory, or NULL if error
+*/
+u8 *gf_aio_block(GF_AsyncIO *aio, u32 idx);
+
+/*! Queues a read or write operation on an I/O block. The operation is not submitted until \ref gf_aio_submit or \ref gf_aio_wait is called
+\param aio target engine
+\param idx index of the block, must not have a pending operation
+\param fd file descriptor to use
+\param is_write if GF_TRUE, writes the first size bytes of the block, otherwise reads size bytes in the block
+\param offset file offset of the operation
+\param size number of bytes to read or write
+\return error if any
+*/
+GF_Err gf_aio_queue(GF_AsyncIO *aio, u32 idx, s32 fd, Bool is_write, u64 offset, u32 size);
+
+/*! Submits all queued operations in a single call
+\param aio target engine
+\return error if any
+*/
+GF_Err gf_aio_submit(GF_AsyncIO *aio);
+
+/*! Waits for completion of the operation on an I/O block. Short writes are resumed until all bytes are written, short reads are only expected at end of file
+\param aio target engine
+\param idx index of the block
+\param blocking if GF_FALSE, returns GF_NOT_READY if the operation is not completed
+\param done set to the number of bytes read or written, or 0 if no operation was pending on the block - may be NULL
+\return error if any
+*/
+GF_Err gf_aio_wait(GF_AsyncIO *aio, u32 idx, Bool blocking, u32 *done);
+
 /*!	@} */
 
 /*!
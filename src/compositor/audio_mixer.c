@@ -58,6 +58,21 @@ typedef struct
 	s32 (*get_sample)(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride);
 	Bool is_planar;
 	Bool muted;
+
+	/*polyphase resampler state, only used when resample quality is not linear*/
+	Bool fir_active;
+	//filter bank, (nb_phases+1) rows of fir_taps_a coefs (fir_taps padded to 4)
+	Float *fir_bank;
+	u32 fir_taps, fir_taps_a, fir_phases;
+	//input rate step and output rate, reduced by their gcd
+	u32 fir_step, fir_den, fir_frac;
+	//set if one phase per output position (no phase interpolation)
+	Bool fir_exact;
+	//planar float history per input channel
+	Float *fir_hist[GF_AUDIO_MIXER_MAX_CHANNELS];
+	u32 fir_hist_alloc, fir_hist_len, fir_start, fir_nb_ch;
+	//number of zero samples left to push at end of stream
+	u32 fir_flush;
 } MixerInput;
 
 struct __audiomix
@@ -84,6 +99,8 @@ struct __audiomix
 
 	s32 *output;
 	u32 output_size;
+	/*resampling quality, 0 is linear interpolation*/
+	u32 resample_quality;
 };
 
 #define swap_16(x) (( (x) << 8 & 0xff00) | ((x) >> 8 & 0x00ff))
@@ -125,6 +142,33 @@ void gf_mixer_set_max_speed(GF_AudioMixer *am, Double max_speed)
 	am->max_speed = FLT2FIX(max_speed);
 }
 
+static void gf_mixer_fir_reset(MixerInput *in)
+{
+	u32 j;
+	if (in->fir_bank) gf_free(in->fir_bank);
+	in->fir_bank = NULL;
+	for (j=0; j<GF_AUDIO_MIXER_MAX_CHANNELS; j++) {
+		if (in->fir_hist[j]) gf_free(in->fir_hist[j]);
+		in->fir_hist[j] = NULL;
+	}
+	in->fir_hist_alloc = in->fir_hist_len = in->fir_start = 0;
+	in->fir_active = GF_FALSE;
+}
+
+void gf_mixer_set_resample_quality(GF_AudioMixer *am, u32 quality)
+{
+	u32 i=0;
+	MixerInput *in;
+	if (quality>GF_MIXER_RESAMPLE_BEST) quality = GF_MIXER_RESAMPLE_BEST;
+	if (am->resample_quality == quality) return;
+	gf_mixer_lock(am, GF_TRUE);
+	am->resample_quality = quality;
+	while ((in = (MixerInput *)gf_list_enum(am->sources, &i))) {
+		in->ratio_aligned = 0;
+	}
+	gf_mixer_lock(am, GF_FALSE);
+}
+
 GF_EXPORT
 void gf_mixer_del(GF_AudioMixer *am)
 {
@@ -145,6 +189,7 @@ void gf_mixer_remove_all(GF_AudioMixer *am)
 		for (j=0; j<GF_AUDIO_MIXER_MAX_CHANNELS; j++) {
 			if (in->ch_buf[j]) gf_free(in->ch_buf[j]);
 		}
+		gf_mixer_fir_reset(in);
 		gf_free(in);
 	}
 	am->isEmpty = GF_TRUE;
@@ -242,6 +287,7 @@ void gf_mixer_remove_input(GF_AudioMixer *am, GF_AudioInterface *src)
 		for (j=0; j<GF_AUDIO_MIXER_MAX_CHANNELS; j++) {
 			if (in->ch_buf[j]) gf_free(in->ch_buf[j]);
 		}
+		gf_mixer_fir_reset(in);
 		gf_free(in);
 		break;
 	}
@@ -785,18 +831,328 @@ static GFINLINE void gf_mixer_map_channels(s32 *inChan, u32 nb_in, u64 in_ch_lay
 	}
 }
 
+/*polyphase windowed-sinc resampler
+
+The source is deinterleaved into per-channel float history buffers, each output sample is a dot product
+of the history window with one phase of a precomputed Kaiser-windowed sinc bank.
+When the reduced output rate is small enough, each output position maps to exactly one phase. Otherwise,
+coefficients are linearly interpolated between the two nearest phases of a 256-phase bank.
+*/
+
+#if defined(WIN32) && !defined(__GNUC__) && (defined(_M_X64) || defined(_M_IX86))
+# include <intrin.h>
+# define MIX_HAS_SSE2
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+# define MIX_HAS_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+# include <arm_neon.h>
+# define MIX_HAS_NEON
+#endif
+
+#define FIR_MAX_EXACT_PHASES	1024
+#define FIR_INTERP_PHASES	256
+#define FIR_MAX_HALF_TAPS	512
+#define FIR_HIST_BLOCK	4096
+
+static Double fir_bessel_i0(Double x)
+{
+	Double sum = 1, term = 1;
+	u32 k;
+	for (k=1; k<64; k++) {
+		term *= (x / (2*k)) * (x / (2*k));
+		sum += term;
+		if (term < sum * 1e-12) break;
+	}
+	return sum;
+}
+
+static u32 fir_gcd(u32 a, u32 b)
+{
+	while (b) {
+		u32 t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+static Bool gf_mixer_fir_setup(GF_AudioMixer *am, MixerInput *in)
+{
+	u32 j, k, p, half, g, nb_rows;
+	Double beta, rolloff, fc, ratio, i0_beta;
+	u32 in_rate = in->scaled_sr;
+	u32 out_rate = am->sample_rate;
+
+	gf_mixer_fir_reset(in);
+	if (!in_rate || !out_rate || (in_rate==out_rate)) return GF_FALSE;
+
+	switch (am->resample_quality) {
+	case GF_MIXER_RESAMPLE_FAST:
+		half = 8;
+		beta = 6.0;
+		rolloff = 0.90;
+		break;
+	case GF_MIXER_RESAMPLE_STD:
+		half = 16;
+		beta = 8.0;
+		rolloff = 0.94;
+		break;
+	default:
+		half = 32;
+		beta = 10.0;
+		rolloff = 0.96;
+		break;
+	}
+	ratio = ((Double) out_rate) / in_rate;
+	fc = rolloff;
+	//downsampling, lower cutoff and stretch kernel
+	if (ratio < 1) {
+		fc *= ratio;
+		half = (u32) ceil(half / ratio);
+		if (half > FIR_MAX_HALF_TAPS) half = FIR_MAX_HALF_TAPS;
+	}
+	g = fir_gcd(in_rate, out_rate);
+	in->fir_step = in_rate / g;
+	in->fir_den = out_rate / g;
+	in->fir_frac = 0;
+	in->fir_taps = 2*half;
+	in->fir_taps_a = (in->fir_taps + 3) & ~3;
+	if (in->fir_den <= FIR_MAX_EXACT_PHASES) {
+		in->fir_exact = GF_TRUE;
+		in->fir_phases = in->fir_den;
+	} else {
+		in->fir_exact = GF_FALSE;
+		in->fir_phases = FIR_INTERP_PHASES;
+	}
+	//one extra row for interpolation of last phase, one scratch row for interpolated coefs
+	nb_rows = in->fir_phases + 2;
+	in->fir_bank = (Float *) gf_malloc(sizeof(Float) * nb_rows * in->fir_taps_a);
+	if (!in->fir_bank) return GF_FALSE;
+	memset(in->fir_bank, 0, sizeof(Float) * nb_rows * in->fir_taps_a);
+
+	i0_beta = fir_bessel_i0(beta);
+	for (p=0; p<=in->fir_phases; p++) {
+		Double sum = 0;
+		Float *coefs = in->fir_bank + p * in->fir_taps_a;
+		for (k=0; k<in->fir_taps; k++) {
+			Double h, w, x = (Double) k - (half-1) - ((Double) p) / in->fir_phases;
+			Double r = x / half;
+			if ((r <= -1) || (r >= 1)) continue;
+			w = fir_bessel_i0(beta * sqrt(1 - r*r)) / i0_beta;
+			h = (x==0) ? fc : sin(GF_PI * fc * x) / (GF_PI * x);
+			coefs[k] = (Float) (h * w);
+			sum += coefs[k];
+		}
+		//normalize DC gain of each phase
+		if (sum) {
+			for (k=0; k<in->fir_taps; k++) coefs[k] = (Float) (coefs[k] / sum);
+		}
+	}
+
+	in->fir_nb_ch = in->src->chan;
+	in->fir_hist_alloc = in->fir_taps_a + FIR_HIST_BLOCK;
+	for (j=0; j<in->fir_nb_ch; j++) {
+		//pad to read full vectors past the end of the window
+		in->fir_hist[j] = (Float *) gf_malloc(sizeof(Float) * (in->fir_hist_alloc + 4));
+		if (!in->fir_hist[j]) {
+			gf_mixer_fir_reset(in);
+			return GF_FALSE;
+		}
+		memset(in->fir_hist[j], 0, sizeof(Float) * (in->fir_hist_alloc + 4));
+	}
+	//window of output 0 starts half-1 samples before first input sample
+	in->fir_hist_len = half - 1;
+	in->fir_start = 0;
+	in->fir_flush = half;
+	in->fir_active = GF_TRUE;
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_AUDIO, ("[AudioMixer] Polyphase resampler %d -> %d Hz, %d taps %d phases%s\n", in_rate, out_rate, in->fir_taps, in->fir_phases, in->fir_exact ? "" : " interpolated"));
+	return GF_TRUE;
+}
+
+static GFINLINE Float gf_mixer_fir_dot(const Float *src, const Float *coefs, u32 nb_taps)
+{
+	u32 k;
+#if defined(MIX_HAS_SSE2)
+	__m128 acc0 = _mm_setzero_ps();
+	__m128 acc1 = _mm_setzero_ps();
+	Float res[4];
+	for (k=0; k+8<=nb_taps; k+=8) {
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(src+k), _mm_loadu_ps(coefs+k)));
+		acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(src+k+4), _mm_loadu_ps(coefs+k+4)));
+	}
+	if (k<nb_taps)
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(src+k), _mm_loadu_ps(coefs+k)));
+	acc0 = _mm_add_ps(acc0, acc1);
+	_mm_storeu_ps(res, acc0);
+	return (res[0] + res[1]) + (res[2] + res[3]);
+#elif defined(MIX_HAS_NEON)
+	float32x4_t acc0 = vdupq_n_f32(0);
+	float32x4_t acc1 = vdupq_n_f32(0);
+	for (k=0; k+8<=nb_taps; k+=8) {
+		acc0 = vfmaq_f32(acc0, vld1q_f32(src+k), vld1q_f32(coefs+k));
+		acc1 = vfmaq_f32(acc1, vld1q_f32(src+k+4), vld1q_f32(coefs+k+4));
+	}
+	if (k<nb_taps)
+		acc0 = vfmaq_f32(acc0, vld1q_f32(src+k), vld1q_f32(coefs+k));
+	return vaddvq_f32(vaddq_f32(acc0, acc1));
+#else
+	Float acc[4] = {0, 0, 0, 0};
+	for (k=0; k<nb_taps; k+=4) {
+		acc[0] += src[k] * coefs[k];
+		acc[1] += src[k+1] * coefs[k+1];
+		acc[2] += src[k+2] * coefs[k+2];
+		acc[3] += src[k+3] * coefs[k+3];
+	}
+	return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+#endif
+}
+
+static void gf_mixer_write_sample(GF_AudioMixer *am, MixerInput *in, s32 *inChan)
+{
+	u32 j, in_ch = in->src->chan, out_ch = am->nb_channels;
+	//don't apply pan when forced layout is used
+	if (!in->src->forced_layout) {
+		for (j = 0; j < in_ch; j++) {
+			if (in->pan[j]!=FIX_ONE)
+				inChan[j] = (s32) ( ((s64) inChan[j]) * FIX2INT(100 * in->pan[j]) / 100);
+		}
+	}
+	if (in->speed <= am->max_speed) {
+		//map inChannel to the output channel config
+		gf_mixer_map_channels(inChan, in_ch, in->src->ch_layout, in->src->forced_layout, out_ch, am->channel_layout);
+
+		for (j=0; j<out_ch ; j++) {
+			*(in->ch_buf[j] + in->out_samples_written) = (s32) inChan[j];
+		}
+	} else {
+		for (j=0; j<out_ch ; j++) {
+			*(in->ch_buf[j] + in->out_samples_written) = 0;
+		}
+	}
+	in->out_samples_written ++;
+}
+
+static void gf_mixer_fetch_input_fir(GF_AudioMixer *am, MixerInput *in, u32 audio_delay)
+{
+	u32 j, in_ch, src_samp, src_size, consumed;
+	u32 planar_stride=0;
+	s8 *in_data;
+	s32 inChan[GF_AUDIO_MIXER_MAX_CHANNELS];
+
+	in_ch = in->fir_nb_ch;
+	in_data = (s8 *) in->src->FetchFrame(in->src->callback, &src_size, &planar_stride, audio_delay);
+	if (!in_data || !src_size) {
+		if (in->src->is_eos)
+			am->nb_eos++;
+		else if (in->src->is_buffering)
+			am->source_buffering = GF_TRUE;
+		//end of stream, flush filter tail
+		if (!in->src->is_eos || !in->fir_flush) {
+			/*done, stop fill*/
+			in->out_samples_to_write = 0;
+			return;
+		}
+		src_size = 0;
+	}
+	src_samp = (u32) (src_size / in->bytes_p_samp);
+	consumed = 0;
+
+	memset(inChan, 0, sizeof(s32)*GF_AUDIO_MIXER_MAX_CHANNELS);
+	while (in->out_samples_written < in->out_samples_to_write) {
+		const Float *coefs;
+		//fill history up to the end of the window
+		while (in->fir_hist_len < in->fir_start + in->fir_taps) {
+			if (in->fir_hist_len == in->fir_hist_alloc) {
+				//window starts after last sample when downsampling, skipped samples are still pushed
+				if (in->fir_start >= in->fir_hist_len) {
+					in->fir_start -= in->fir_hist_len;
+					in->fir_hist_len = 0;
+				} else {
+					u32 nb_keep = in->fir_hist_len - in->fir_start;
+					for (j=0; j<in_ch; j++)
+						memmove(in->fir_hist[j], in->fir_hist[j] + in->fir_start, sizeof(Float) * nb_keep);
+					in->fir_hist_len = nb_keep;
+					in->fir_start = 0;
+				}
+			}
+			if (consumed < src_samp) {
+				for (j=0; j<in_ch; j++)
+					in->fir_hist[j][in->fir_hist_len] = (Float) in->get_sample((u8 *) in_data, in_ch, consumed, j, planar_stride);
+				consumed++;
+				in->fir_flush = in->fir_taps/2;
+			} else if (!src_samp && in->fir_flush) {
+				for (j=0; j<in_ch; j++)
+					in->fir_hist[j][in->fir_hist_len] = 0;
+				in->fir_flush--;
+			} else {
+				goto exit;
+			}
+			in->fir_hist_len++;
+		}
+
+		if (in->fir_exact) {
+			coefs = in->fir_bank + in->fir_frac * in->fir_taps_a;
+		} else {
+			u32 k, p;
+			Float mu, *c0, *c1, *tmp;
+			Double pos = ((Double) in->fir_frac) * in->fir_phases / in->fir_den;
+			p = (u32) pos;
+			mu = (Float) (pos - p);
+			c0 = in->fir_bank + p * in->fir_taps_a;
+			c1 = c0 + in->fir_taps_a;
+			tmp = in->fir_bank + (in->fir_phases+1) * in->fir_taps_a;
+			for (k=0; k<in->fir_taps_a; k++)
+				tmp[k] = c0[k] + mu * (c1[k] - c0[k]);
+			coefs = tmp;
+		}
+		for (j=0; j<in_ch; j++) {
+			Float v = gf_mixer_fir_dot(in->fir_hist[j] + in->fir_start, coefs, in->fir_taps_a);
+			if (v >= 2147483647.0f) inChan[j] = GF_INT_MAX;
+			else if (v <= -2147483648.0f) inChan[j] = GF_INT_MIN;
+			else inChan[j] = (s32) v;
+		}
+		gf_mixer_write_sample(am, in, inChan);
+
+		in->fir_frac += in->fir_step;
+		in->fir_start += in->fir_frac / in->fir_den;
+		in->fir_frac %= in->fir_den;
+	}
+
+exit:
+	//flush done, don't request more output for this source
+	if (!src_samp && (in->out_samples_written < in->out_samples_to_write))
+		in->out_samples_to_write = in->out_samples_written;
+
+	/*cf gf_mixer_get_output, make sure we call release*/
+	in->in_bytes_used = consumed * in->bytes_p_samp + 1;
+}
+
 #define RESAMPLE_SCALER	1000
 
 static void gf_mixer_fetch_input(GF_AudioMixer *am, MixerInput *in, u32 audio_delay)
 {
-	u32 j, in_ch, out_ch, prev, next, src_samp, src_size;
+	u32 j, in_ch, prev, next, src_samp, src_size;
 	Bool use_prev;
 	u32 planar_stride=0;
 	s8 *in_data;
 	s32 frac, inChan[GF_AUDIO_MIXER_MAX_CHANNELS], inChanNext[GF_AUDIO_MIXER_MAX_CHANNELS];
 
+	if (!in->ratio_aligned) {
+		if (in->fir_active) gf_mixer_fir_reset(in);
+		if (am->resample_quality) {
+			in->scaled_sr = FIX2INT(in->src->samplerate * in->speed);
+			in->bytes_p_samp = in->bit_depth * in->src->chan / 8;
+			if (gf_mixer_fir_setup(am, in))
+				in->ratio_aligned = 1;
+		}
+	}
+	if (in->fir_active) {
+		gf_mixer_fetch_input_fir(am, in, audio_delay);
+		return;
+	}
+
 	in_ch = in->src->chan;
-	out_ch = am->nb_channels;
 	use_prev = in->has_prev;
 
 	in_data = (s8 *) in->src->FetchFrame(in->src->callback, &src_size, &planar_stride, audio_delay);
@@ -880,26 +1236,9 @@ static void gf_mixer_fetch_input(GF_AudioMixer *am, MixerInput *in, u32 audio_de
 				inChanNext[j] = in->get_sample(in_data, in_ch, next, j, planar_stride);
 				inChan[j] = (s32) ( ( ((s64) inChanNext[j])*frac + ((s64)inChan[j])*(RESAMPLE_SCALER-frac)) / RESAMPLE_SCALER );
 			}
-			//don't apply pan when forced layout is used
-			if (!in->src->forced_layout && (in->pan[j]!=FIX_ONE) ) {
-				inChan[j] = (s32) ( ((s64) inChan[j]) * FIX2INT(100 * in->pan[j]) / 100);
-			}
-		}
-
-		if (in->speed <= am->max_speed) {
-			//map inChannel to the output channel config
-			gf_mixer_map_channels(inChan, in_ch, in->src->ch_layout, in->src->forced_layout, out_ch, am->channel_layout);
-
-			for (j=0; j<out_ch ; j++) {
-				*(in->ch_buf[j] + in->out_samples_written) = (s32) inChan[j];
-			}
-		} else {
-			for (j=0; j<out_ch ; j++) {
-				*(in->ch_buf[j] + in->out_samples_written) = 0;
-			}
 		}
+		gf_mixer_write_sample(am, in, inChan);
 
-		in->out_samples_written ++;
 		in->out_samples_pos ++;
 		if (in->out_samples_written == in->out_samples_to_write)
 			break;
@@ -169,6 +169,12 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_lz_compress_payload) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_lz_decompress_payload) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_file_handles_count) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_aio_new) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_aio_del) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_aio_block) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_aio_queue) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_aio_submit) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_aio_wait) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_timestamp_rescale) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_timestamp_rescale_signed) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_timestamp_less) )
@@ -330,6 +336,8 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_setup_multicast) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_is_multicast_address) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_receive_no_select) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_receive_batch) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_enable_rx_timestamps) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_set_usec_wait) )
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_url_is_local) )
@@ -473,6 +481,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_set_range) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_setup_from_url) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_get_global_rate) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_dm_get_host_stats) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_wget) )
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_xml_sax_new) )
@@ -1263,6 +1272,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_send_rtcp) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_get_payload_type) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_set_interleave_callbacks) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_set_packet_callback) )
 
 #endif
 
@@ -2286,6 +2296,9 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_group_get_num_components) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_all_groups_done) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dash_set_period_xlink_query_string) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_dash_set_prefetch) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_dash_group_get_queued_segment) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_dash_set_sidx_merge) )
 
 #endif
 
@@ -2318,6 +2331,11 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_set_service_udta) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_get_service_udta) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_debug_tsi) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rs_fec_mul_add) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rs_fec_get_impl) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rs_fec_partition) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rs_fec_encode) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rs_fec_decode) )
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_add_cache_entry) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_force_headers) )
@@ -2435,6 +2453,8 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_print_all_connections ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_check_filter_register_cap ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_set_max_resolution_chain_length ) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_fs_set_memory_budget ) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_fs_get_memory_usage ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_get_max_resolution_chain_length ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_add_filter_register ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_remove_filter_register ) )
@@ -2457,12 +2477,14 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_get_rt_udta) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_set_external_gl_provider) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fs_print_debug_info) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_fs_request_trace_dump) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_send_update ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_get_arg ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_get_arg_str ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_ui_event ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_is_alias ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_get_stats ) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_filter_get_memory_usage ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_in_parent_chain ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_push_caps) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_set_process_ckb) )
@@ -2503,6 +2525,8 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_notification_failure ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_setup_failure ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_post_task ) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_filter_get_num_threads ) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_filter_run_parallel ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_remove_src ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_remove ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_connect_source ) )
@@ -499,25 +499,44 @@ GF_Filter *gf_filter_new(GF_FilterSession *fsess, const GF_FilterRegister *freg,
 	}
 
 #ifndef GPAC_DISABLE_THREADS
-	if ((freg->flags & GF_FS_REG_SINGLE_THREAD) && gf_list_count(filter->session->threads)) {
-		u32 count = gf_list_count(filter->session->threads);
-		GF_SessionThread *ft;
-		u32 idx=0;
+	if ((freg->flags & GF_FS_REG_SINGLE_THREAD) && !filter->restrict_th_idx) {
+		gf_filter_pin_thread(filter, 0);
+	}
+#endif
+	return filter;
+}
+
+#ifndef GPAC_DISABLE_THREADS
+void gf_filter_pin_thread(GF_Filter *filter, u32 th_idx)
+{
+	GF_SessionThread *ft;
+	u32 i, count = gf_list_count(filter->session->threads);
+	if (!count) return;
+
+	if (filter->restrict_th_idx) {
+		ft = gf_list_get(filter->session->threads, filter->restrict_th_idx-1);
+		safe_int_dec(&ft->nb_filters_pinned);
+		filter->restrict_th_idx = 0;
+	}
+	//pick least loaded thread
+	if (!th_idx) {
 		u32 min_th_assigned = 0;
 		for (i=0; i<count; i++) {
 			ft = gf_list_get(filter->session->threads, i);
-			if (!idx || (min_th_assigned>ft->nb_filters_pinned)) {
-				idx = i+1;
+			if (!th_idx || (min_th_assigned>ft->nb_filters_pinned)) {
+				th_idx = i+1;
 				min_th_assigned = ft->nb_filters_pinned;
 			}
 		}
-		ft = gf_list_get(filter->session->threads, idx-1);
-		safe_int_inc(&ft->nb_filters_pinned);
-		filter->restrict_th_idx = idx;
+	} else if (th_idx>count) {
+		th_idx = 1 + (th_idx-1) % count;
 	}
-#endif
-	return filter;
+	ft = gf_list_get(filter->session->threads, th_idx-1);
+	safe_int_inc(&ft->nb_filters_pinned);
+	filter->restrict_th_idx = th_idx;
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_SCHEDULER, ("Filter %s pinned to thread %d\n", filter->freg->name, th_idx));
 }
+#endif
 
 void gf_filter_check_pending_pids(GF_Filter *filter)
 {
@@ -671,8 +690,10 @@ void gf_filter_del(GF_Filter *filter)
 		gf_fq_del(filter->pcks_shared_reservoir, gf_void_del);
 	if (filter->pcks_inst_reservoir)
 		gf_fq_del(filter->pcks_inst_reservoir, gf_void_del);
-	if (filter->pcks_alloc_reservoir)
+	if (filter->pcks_alloc_reservoir) {
 		gf_fq_del(filter->pcks_alloc_reservoir, gf_filterpacket_del);
+		safe_int64_sub(&filter->session->res_mem_bytes, filter->res_mem_bytes);
+	}
 
 	gf_mx_del(filter->pcks_mx);
 	if (filter->tasks_mx)
@@ -800,6 +821,7 @@ void gf_filter_set_name(GF_Filter *filter, const char *name)
 
 	if (filter->name) gf_free(filter->name);
 	filter->name = gf_strdup(name ? name : filter->freg->name);
+	filter->trace_name_id = 0;
 }
 
 void gf_filter_set_id(GF_Filter *filter, const char *ID)
@@ -1733,6 +1755,7 @@ static void filter_parse_dyn_args(GF_Filter *filter, const char *args, GF_Filter
 						|| !strncmp(args+4, "gmem://", 7)
 						|| !strncmp(args+4, "gpac://", 7)
 						|| !strncmp(args+4, "pipe://", 7)
+						|| !strncmp(args+4, "shm://", 6)
 						|| !strncmp(args+4, "tcp://", 6)
 						|| !strncmp(args+4, "udp://", 6)
 						|| !strncmp(args+4, "tcpu://", 7)
@@ -2106,6 +2129,15 @@ skip_date:
 				found = GF_TRUE;
 				internal_arg = GF_TRUE;
 			}
+			//thread pinning
+			else if (!strcmp("TH", szArg)) {
+#ifndef GPAC_DISABLE_THREADS
+				if (value && !(filter->freg->flags & GF_FS_REG_MAIN_THREAD))
+					gf_filter_pin_thread(filter, atoi(value));
+#endif
+				found = GF_TRUE;
+				internal_arg = GF_TRUE;
+			}
 			else if (!strcmp("DL", szArg)) {
 				if (! filter->dynamic_filter) {
 					filter->deferred_link = GF_TRUE;
@@ -0,0 +1,668 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom ParisTech 2024
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / filters sub-project
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include "filter_session.h"
+#include <gpac/network.h>
+#include <stdarg.h>
+
+/*
+Session metrics: a small HTTP server thread answering Prometheus scrapes.
+
+The server thread never touches the filter graph. When a scrape arrives, it flags a capture request and wakes up
+the main scheduler thread, which copies the counters into a snapshot between two tasks (as done for continuous debug reports).
+Text rendering and sending are done by the server thread from the last snapshot, so that a slow scraper never delays
+the scheduler. The server waits at most METRICS_WAIT_MS for a new snapshot and otherwise serves the previous one.
+*/
+
+#if !defined(GPAC_DISABLE_NETWORK) && !defined(GPAC_DISABLE_THREADS)
+
+//max time the server waits for the main thread to capture a new snapshot
+#define METRICS_WAIT_MS	200
+//max number of scheduler threads reported
+#define METRICS_MAX_THREADS	256
+
+//task duration histogram upper bounds in us, last bucket is +Inf
+static const u32 metrics_hist_bounds[GF_FS_METRICS_HIST_SIZE-1] = {10, 50, 100, 500, 1000, 5000, 10000, 50000, 100000};
+
+enum
+{
+	FM_TASKS=0,
+	FM_PCK_IN,
+	FM_BYTES_IN,
+	FM_PCK_OUT,
+	FM_BYTES_OUT,
+	FM_TIME,
+	FM_ERRORS,
+	FM_QUEUE,
+	FM_BLOCKING,
+	FM_EOS,
+	FM_PCK_MEM,
+	FM_RES_MEM,
+	FM_LAST
+};
+
+static const struct {
+	const char *name, *type, *help;
+} filter_metrics[FM_LAST] = {
+	{"gpac_filter_tasks_total", "counter", "Number of tasks executed by the filter"},
+	{"gpac_filter_packets_in_total", "counter", "Number of packets consumed by the filter"},
+	{"gpac_filter_bytes_in_total", "counter", "Number of bytes consumed by the filter"},
+	{"gpac_filter_packets_out_total", "counter", "Number of packets sent by the filter"},
+	{"gpac_filter_bytes_out_total", "counter", "Number of bytes sent by the filter"},
+	{"gpac_filter_process_seconds_total", "counter", "Time spent in filter tasks"},
+	{"gpac_filter_errors_total", "counter", "Number of processing errors of the filter"},
+	{"gpac_filter_task_queue", "gauge", "Number of tasks queued for the filter"},
+	{"gpac_filter_blocking_pids", "gauge", "Number of output PIDs of the filter in blocking state"},
+	{"gpac_filter_eos", "gauge", "Set to 1 if the filter is done or has all inputs in end of stream"},
+	{"gpac_filter_packet_memory_bytes", "gauge", "Bytes of packets allocated by the filter and not yet released"},
+	{"gpac_filter_reservoir_memory_bytes", "gauge", "Bytes of packets kept in the filter reservoir for reuse"},
+};
+
+enum
+{
+	PM_BUFFER=0,
+	PM_BUFFER_UNITS,
+	PM_BUFFER_MAX,
+	PM_PCK,
+	PM_BITRATE,
+	PM_MAX_BITRATE,
+	PM_PROCESS_RATE,
+	PM_MAX_PROCESS_TIME,
+	PM_BLOCKING,
+	PM_LAST
+};
+
+static const struct {
+	const char *name, *type, *help;
+} pid_metrics[PM_LAST] = {
+	{"gpac_pid_buffer_seconds", "gauge", "Duration of media buffered in the input PID queue"},
+	{"gpac_pid_buffer_packets", "gauge", "Number of packets in the input PID queue"},
+	{"gpac_pid_buffer_max_seconds", "gauge", "Maximum buffer duration of the source PID before blocking"},
+	{"gpac_pid_packets_total", "counter", "Number of packets processed on the input PID"},
+	{"gpac_pid_bitrate_bps", "gauge", "Average bitrate of the input PID"},
+	{"gpac_pid_max_bitrate_bps", "gauge", "Maximum bitrate of the input PID"},
+	{"gpac_pid_process_rate_bps", "gauge", "Average processing rate of the input PID"},
+	{"gpac_pid_max_process_seconds", "gauge", "Maximum packet processing time on the input PID"},
+	{"gpac_pid_blocking", "gauge", "Set to 1 if the source PID is in blocking state"},
+};
+
+typedef struct
+{
+	char name[200], reg[100], id[100];
+	//time values in us
+	u64 val[FM_LAST];
+	u32 nb_res_pck;
+	u32 hist[GF_FS_METRICS_HIST_SIZE];
+} MetricsFilter;
+
+typedef struct
+{
+	//index of consuming filter in snapshot
+	u32 filter_idx;
+	char name[200], source[200];
+	//time values in us
+	u64 val[PM_LAST];
+} MetricsPid;
+
+typedef struct
+{
+	u64 capture_time;
+	u32 tasks_pending;
+	u32 nb_threads;
+	u64 th_tasks[METRICS_MAX_THREADS], th_active[METRICS_MAX_THREADS];
+	u32 res_items[4];
+	u64 pck_mem, res_mem, mem_budget, nb_mem_drops;
+	MetricsFilter *filters;
+	u32 nb_filters, alloc_filters;
+	MetricsPid *pids;
+	u32 nb_pids, alloc_pids;
+} MetricsSnapshot;
+
+struct __gf_fs_metrics
+{
+	GF_FilterSession *fsess;
+	GF_Thread *th;
+	GF_Socket *server;
+	GF_SockGroup *sg;
+	volatile Bool run;
+
+	//triple buffering: capture is filled by main thread, ready is the last complete snapshot (protected by mx)
+	//and render is owned by the server thread
+	GF_Mutex *mx;
+	MetricsSnapshot snaps[3];
+	MetricsSnapshot *capture, *ready, *render;
+	Bool ready_fresh;
+
+	//text buffer, only used by server thread
+	char *buf;
+	u32 buf_size, buf_alloc;
+
+	volatile u32 capture_requested;
+	volatile u32 capture_seq;
+
+	u64 start_time;
+	u32 nb_scrapes;
+	GF_SystemRTInfo rti;
+};
+
+void gf_fs_metrics_hist_add(u32 *hist, u64 dur_us)
+{
+	u32 i;
+	for (i=0; i<GF_FS_METRICS_HIST_SIZE-1; i++) {
+		if (dur_us <= metrics_hist_bounds[i]) break;
+	}
+	hist[i]++;
+}
+
+static void metrics_printf(GF_FSMetrics *m, const char *fmt, ...)
+{
+	s32 len;
+	va_list vl;
+	while (1) {
+		u32 avail = m->buf_alloc - m->buf_size;
+		va_start(vl, fmt);
+		len = vsnprintf(m->buf + m->buf_size, avail, fmt, vl);
+		va_end(vl);
+		if (len<0) return;
+		if ((u32) len < avail) {
+			m->buf_size += len;
+			return;
+		}
+		m->buf_alloc = MAX(2*m->buf_alloc, m->buf_size + len + 1);
+		m->buf = gf_realloc(m->buf, m->buf_alloc);
+		if (!m->buf) {
+			m->buf_alloc = m->buf_size = 0;
+			return;
+		}
+	}
+}
+
+//label values escaping as per Prometheus text format
+static const char *metrics_label(char *dst, u32 size, const char *str)
+{
+	u32 i=0;
+	if (!str) str = "";
+	while (*str && (i+3<size)) {
+		char c = *str++;
+		if ((c=='"') || (c=='\\')) dst[i++] = '\\';
+		if (c=='\n') {
+			dst[i++] = '\\';
+			c = 'n';
+		}
+		dst[i++] = c;
+	}
+	dst[i] = 0;
+	return dst;
+}
+
+static void metrics_header(GF_FSMetrics *m, const char *name, const char *type, const char *help)
+{
+	metrics_printf(m, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+static void metrics_copy_str(char *dst, u32 size, const char *str)
+{
+	if (!str) str = "";
+	strncpy(dst, str, size-1);
+	dst[size-1] = 0;
+}
+
+//called by main thread only, copies counters without formatting
+static void gf_fs_metrics_capture(GF_FilterSession *fsess)
+{
+	u32 i, j, count;
+	GF_FSMetrics *m = fsess->metrics;
+	MetricsSnapshot *snap = m->capture;
+
+	m->capture_requested = 0;
+	snap->capture_time = gf_sys_clock_high_res();
+	snap->tasks_pending = fsess->tasks_pending;
+
+	snap->nb_threads = 1;
+#ifndef GPAC_DISABLE_THREADS
+	snap->nb_threads += gf_list_count(fsess->threads);
+#endif
+	if (snap->nb_threads > METRICS_MAX_THREADS) snap->nb_threads = METRICS_MAX_THREADS;
+	for (i=0; i<snap->nb_threads; i++) {
+		GF_SessionThread *sth = i ? gf_list_get(fsess->threads, i-1) : &fsess->main_th;
+		snap->th_tasks[i] = sth->nb_tasks;
+		snap->th_active[i] = sth->active_time;
+	}
+	snap->res_items[0] = gf_fq_count(fsess->tasks_reservoir);
+	snap->res_items[1] = gf_fq_count(fsess->prop_maps_reservoir);
+	snap->res_items[2] = gf_fq_count(fsess->prop_maps_entry_reservoir);
+	snap->res_items[3] = gf_fq_count(fsess->prop_maps_entry_data_alloc_reservoir);
+	snap->pck_mem = fsess->pck_mem_bytes;
+	snap->res_mem = fsess->res_mem_bytes;
+	snap->mem_budget = fsess->mem_budget;
+	snap->nb_mem_drops = fsess->nb_mem_drops;
+
+	snap->nb_filters = snap->nb_pids = 0;
+	if (fsess->filters_mx) gf_mx_p(fsess->filters_mx);
+	count = gf_list_count(fsess->filters);
+	for (i=0; i<count; i++) {
+		MetricsFilter *mf;
+		GF_Filter *f = gf_list_get(fsess->filters, i);
+		if (f->multi_sink_target) continue;
+
+		if (snap->nb_filters == snap->alloc_filters) {
+			snap->alloc_filters = snap->alloc_filters ? 2*snap->alloc_filters : 16;
+			snap->filters = gf_realloc(snap->filters, sizeof(MetricsFilter) * snap->alloc_filters);
+			if (!snap->filters) {
+				snap->alloc_filters = snap->nb_filters = 0;
+				break;
+			}
+		}
+		mf = &snap->filters[snap->nb_filters];
+		metrics_copy_str(mf->name, 200, f->name);
+		metrics_copy_str(mf->reg, 100, f->freg->name);
+		metrics_copy_str(mf->id, 100, f->id);
+		mf->val[FM_TASKS] = f->nb_tasks_done;
+		mf->val[FM_PCK_IN] = f->nb_pck_processed;
+		mf->val[FM_BYTES_IN] = f->nb_bytes_processed;
+		mf->val[FM_PCK_OUT] = f->nb_pck_sent;
+		mf->val[FM_BYTES_OUT] = f->nb_bytes_sent;
+		mf->val[FM_TIME] = f->time_process;
+		mf->val[FM_ERRORS] = f->nb_errors;
+		mf->val[FM_BLOCKING] = f->would_block;
+		mf->val[FM_PCK_MEM] = f->pck_mem_bytes;
+		mf->val[FM_RES_MEM] = f->res_mem_bytes;
+		mf->nb_res_pck = gf_fq_count(f->pcks_alloc_reservoir) + gf_fq_count(f->pcks_shared_reservoir) + gf_fq_count(f->pcks_inst_reservoir);
+		memcpy(mf->hist, f->task_hist, sizeof(u32)*GF_FS_METRICS_HIST_SIZE);
+
+		//input PID list is modified under filter task mutex
+		gf_mx_p(f->tasks_mx);
+		mf->val[FM_QUEUE] = gf_fq_count(f->tasks);
+		mf->val[FM_EOS] = (f->removed || f->finalized) ? 1 : 0;
+		if (!mf->val[FM_EOS] && f->num_input_pids) {
+			mf->val[FM_EOS] = 1;
+			for (j=0; j<f->num_input_pids; j++) {
+				GF_FilterPidInst *pidi = gf_list_get(f->input_pids, j);
+				if (pidi && !pidi->is_end_of_stream) mf->val[FM_EOS] = 0;
+			}
+		}
+		for (j=0; j<f->num_input_pids; j++) {
+			MetricsPid *mp;
+			GF_FilterPidInst *pidi = gf_list_get(f->input_pids, j);
+			if (!pidi || !pidi->pid) continue;
+
+			if (snap->nb_pids == snap->alloc_pids) {
+				snap->alloc_pids = snap->alloc_pids ? 2*snap->alloc_pids : 16;
+				snap->pids = gf_realloc(snap->pids, sizeof(MetricsPid) * snap->alloc_pids);
+				if (!snap->pids) {
+					snap->alloc_pids = snap->nb_pids = 0;
+					break;
+				}
+			}
+			mp = &snap->pids[snap->nb_pids];
+			mp->filter_idx = snap->nb_filters;
+			metrics_copy_str(mp->name, 200, pidi->pid->name);
+			metrics_copy_str(mp->source, 200, pidi->pid->filter ? pidi->pid->filter->name : NULL);
+			mp->val[PM_BUFFER] = (pidi->buffer_duration>0) ? (u64) pidi->buffer_duration : 0;
+			mp->val[PM_BUFFER_UNITS] = gf_fq_count(pidi->packets);
+			mp->val[PM_BUFFER_MAX] = pidi->pid->max_buffer_time;
+			mp->val[PM_PCK] = pidi->nb_processed;
+			mp->val[PM_BITRATE] = pidi->avg_bit_rate;
+			mp->val[PM_MAX_BITRATE] = pidi->max_bit_rate;
+			mp->val[PM_PROCESS_RATE] = pidi->avg_process_rate;
+			mp->val[PM_MAX_PROCESS_TIME] = pidi->max_process_time;
+			mp->val[PM_BLOCKING] = pidi->pid->would_block ? 1 : 0;
+			snap->nb_pids++;
+		}
+		gf_mx_v(f->tasks_mx);
+		snap->nb_filters++;
+	}
+	if (fsess->filters_mx) gf_mx_v(fsess->filters_mx);
+
+	//publish
+	gf_mx_p(m->mx);
+	m->capture = m->ready;
+	m->ready = snap;
+	m->ready_fresh = GF_TRUE;
+	m->capture_seq++;
+	gf_mx_v(m->mx);
+
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_FILTER, ("[Metrics] Snapshot captured in "LLU" us (%u filters %u PIDs)\n", gf_sys_clock_high_res() - snap->capture_time, snap->nb_filters, snap->nb_pids));
+}
+
+void gf_fs_metrics_check(GF_FilterSession *fsess)
+{
+	if (fsess->metrics->capture_requested)
+		gf_fs_metrics_capture(fsess);
+}
+
+static void metrics_filter_labels(MetricsFilter *mf, char *labels, u32 size)
+{
+	char szName[400], szReg[200], szID[200];
+	snprintf(labels, size, "filter=\"%s\",register=\"%s\",id=\"%s\"",
+		metrics_label(szName, 400, mf->name), metrics_label(szReg, 200, mf->reg), metrics_label(szID, 200, mf->id));
+}
+
+//called by server thread only
+static void gf_fs_metrics_render(GF_FSMetrics *m, MetricsSnapshot *snap)
+{
+	u32 i, j, k;
+	char labels[1000], pid_labels[2000], szPid[400], szSrc[400];
+
+	m->buf_size = 0;
+
+	metrics_header(m, "gpac_session_uptime_seconds", "counter", "Time since the metrics server started");
+	metrics_printf(m, "gpac_session_uptime_seconds %g\n", ((Double) (snap->capture_time - m->start_time)) / 1000000);
+	metrics_header(m, "gpac_session_tasks_pending", "gauge", "Number of tasks pending in the scheduler");
+	metrics_printf(m, "gpac_session_tasks_pending %u\n", snap->tasks_pending);
+	metrics_header(m, "gpac_session_scrapes_total", "counter", "Number of metrics snapshots rendered");
+	metrics_printf(m, "gpac_session_scrapes_total %u\n", ++m->nb_scrapes);
+
+	//per-thread stats
+	metrics_header(m, "gpac_thread_tasks_total", "counter", "Number of tasks executed by the scheduler thread");
+	for (i=0; i<snap->nb_threads; i++) {
+		metrics_printf(m, "gpac_thread_tasks_total{thread=\"%u\"} "LLU"\n", i, snap->th_tasks[i]);
+	}
+	metrics_header(m, "gpac_thread_active_seconds_total", "counter", "Time spent executing tasks by the scheduler thread");
+	for (i=0; i<snap->nb_threads; i++) {
+		metrics_printf(m, "gpac_thread_active_seconds_total{thread=\"%u\"} %g\n", i, ((Double) snap->th_active[i]) / 1000000);
+	}
+
+	//memory and reservoirs
+	gf_sys_get_rti(1000, &m->rti, GF_RTI_PROCESS_MEMORY);
+	metrics_header(m, "gpac_process_memory_bytes", "gauge", "Process allocated memory");
+	metrics_printf(m, "gpac_process_memory_bytes "LLU"\n", m->rti.process_memory);
+	metrics_header(m, "gpac_process_cpu_percent", "gauge", "Process CPU usage");
+	metrics_printf(m, "gpac_process_cpu_percent %u\n", m->rti.process_cpu_usage);
+#ifdef GPAC_MEMORY_TRACKING
+	metrics_header(m, "gpac_memory_allocated_bytes", "gauge", "Memory currently allocated by GPAC (memory tracking enabled)");
+	metrics_printf(m, "gpac_memory_allocated_bytes "LLU"\n", gf_memory_size());
+#endif
+	metrics_header(m, "gpac_reservoir_items", "gauge", "Number of recycled objects kept in session reservoirs");
+	metrics_printf(m, "gpac_reservoir_items{type=\"task\"} %u\n", snap->res_items[0]);
+	metrics_printf(m, "gpac_reservoir_items{type=\"prop_map\"} %u\n", snap->res_items[1]);
+	metrics_printf(m, "gpac_reservoir_items{type=\"prop_entry\"} %u\n", snap->res_items[2]);
+	metrics_printf(m, "gpac_reservoir_items{type=\"prop_data\"} %u\n", snap->res_items[3]);
+	metrics_header(m, "gpac_session_packet_memory_bytes", "gauge", "Bytes of packets allocated by all filters and not yet released");
+	metrics_printf(m, "gpac_session_packet_memory_bytes "LLU"\n", snap->pck_mem);
+	metrics_header(m, "gpac_session_reservoir_memory_bytes", "gauge", "Bytes of packets kept in filter reservoirs for reuse");
+	metrics_printf(m, "gpac_session_reservoir_memory_bytes "LLU"\n", snap->res_mem);
+	metrics_header(m, "gpac_session_memory_budget_bytes", "gauge", "Session packet memory budget, 0 if none");
+	metrics_printf(m, "gpac_session_memory_budget_bytes "LLU"\n", snap->mem_budget);
+	metrics_header(m, "gpac_session_memory_drops_total", "counter", "Number of packets dropped because of the session memory budget");
+	metrics_printf(m, "gpac_session_memory_drops_total "LLU"\n", snap->nb_mem_drops);
+
+	for (k=0; k<FM_LAST; k++) {
+		metrics_header(m, filter_metrics[k].name, filter_metrics[k].type, filter_metrics[k].help);
+		for (i=0; i<snap->nb_filters; i++) {
+			MetricsFilter *mf = &snap->filters[i];
+			metrics_filter_labels(mf, labels, 1000);
+			if (k==FM_TIME)
+				metrics_printf(m, "%s{%s} %g\n", filter_metrics[k].name, labels, ((Double) mf->val[k]) / 1000000);
+			else
+				metrics_printf(m, "%s{%s} "LLU"\n", filter_metrics[k].name, labels, mf->val[k]);
+		}
+	}
+
+	metrics_header(m, "gpac_filter_packet_reservoir_items", "gauge", "Number of recycled packets kept in filter reservoirs");
+	for (i=0; i<snap->nb_filters; i++) {
+		MetricsFilter *mf = &snap->filters[i];
+		metrics_filter_labels(mf, labels, 1000);
+		metrics_printf(m, "gpac_filter_packet_reservoir_items{%s} %u\n", labels, mf->nb_res_pck);
+	}
+
+	metrics_header(m, "gpac_filter_task_duration_seconds", "histogram", "Duration of filter tasks");
+	for (i=0; i<snap->nb_filters; i++) {
+		u64 cumul = 0;
+		MetricsFilter *mf = &snap->filters[i];
+		metrics_filter_labels(mf, labels, 1000);
+		for (j=0; j<GF_FS_METRICS_HIST_SIZE; j++) {
+			cumul += mf->hist[j];
+			if (j+1<GF_FS_METRICS_HIST_SIZE)
+				metrics_printf(m, "gpac_filter_task_duration_seconds_bucket{%s,le=\"%g\"} "LLU"\n", labels, ((Double) metrics_hist_bounds[j]) / 1000000, cumul);
+			else
+				metrics_printf(m, "gpac_filter_task_duration_seconds_bucket{%s,le=\"+Inf\"} "LLU"\n", labels, cumul);
+		}
+		metrics_printf(m, "gpac_filter_task_duration_seconds_sum{%s} %g\n", labels, ((Double) mf->val[FM_TIME]) / 1000000);
+		metrics_printf(m, "gpac_filter_task_duration_seconds_count{%s} "LLU"\n", labels, cumul);
+	}
+
+	//input PIDs of each filter, labeled with consumer filter, PID name and source filter
+	for (k=0; k<PM_LAST; k++) {
+		metrics_header(m, pid_metrics[k].name, pid_metrics[k].type, pid_metrics[k].help);
+		for (i=0; i<snap->nb_pids; i++) {
+			MetricsPid *mp = &snap->pids[i];
+			metrics_filter_labels(&snap->filters[mp->filter_idx], labels, 1000);
+			snprintf(pid_labels, 2000, "%s,pid=\"%s\",source=\"%s\"", labels, metrics_label(szPid, 400, mp->name), metrics_label(szSrc, 400, mp->source));
+			switch (k) {
+			case PM_BUFFER:
+			case PM_BUFFER_MAX:
+			case PM_MAX_PROCESS_TIME:
+				metrics_printf(m, "%s{%s} %g\n", pid_metrics[k].name, pid_labels, ((Double) mp->val[k]) / 1000000);
+				break;
+			default:
+				metrics_printf(m, "%s{%s} "LLU"\n", pid_metrics[k].name, pid_labels, mp->val[k]);
+				break;
+			}
+		}
+	}
+}
+
+static void metrics_reply(GF_Socket *sk, const char *status, const char *body, u32 body_size)
+{
+	char szHdr[300];
+	snprintf(szHdr, 300, "HTTP/1.1 %s\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\nContent-Length: %u\r\nConnection: close\r\nServer: GPAC %s\r\n\r\n", status, body_size, gf_gpac_version());
+	gf_sk_send(sk, szHdr, (u32) strlen(szHdr));
+	if (body_size)
+		gf_sk_send(sk, body, body_size);
+}
+
+static void metrics_serve(GF_FSMetrics *m, GF_Socket *sk)
+{
+	char req[2048];
+	u32 size=0, i, seq;
+	Bool is_head = GF_FALSE;
+
+	//read request header, a scraper sends it in one go
+	for (i=0; i<50; i++) {
+		u32 read=0;
+		GF_Err e = gf_sk_receive(sk, req+size, 2047-size, &read);
+		if (e==GF_IP_NETWORK_EMPTY) {
+			gf_sleep(2);
+			continue;
+		}
+		if (e) return;
+		size += read;
+		req[size] = 0;
+		if (strstr(req, "\r\n\r\n") || (size==2047)) break;
+	}
+	req[size] = 0;
+	if (!strncmp(req, "HEAD ", 5)) is_head = GF_TRUE;
+	else if (strncmp(req, "GET ", 4)) {
+		metrics_reply(sk, "405 Method Not Allowed", NULL, 0);
+		return;
+	}
+	if (strncmp(req + (is_head ? 5 : 4), "/metrics", 8) && strncmp(req + (is_head ? 5 : 4), "/ ", 2)) {
+		metrics_reply(sk, "404 Not Found", NULL, 0);
+		return;
+	}
+
+	//ask main thread for a new snapshot and wake it up
+	seq = m->capture_seq;
+	m->capture_requested = 1;
+	if (m->fsess->semaphore_main)
+		gf_sema_notify(m->fsess->semaphore_main, 1);
+	for (i=0; i<METRICS_WAIT_MS; i++) {
+		if (m->capture_seq != seq) break;
+		gf_sleep(1);
+	}
+	if (m->capture_seq == seq) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_FILTER, ("[Metrics] Main thread busy, serving previous snapshot\n"));
+	}
+
+	//grab the last snapshot, the previous one is kept if no new capture
+	gf_mx_p(m->mx);
+	if (m->ready_fresh) {
+		MetricsSnapshot *tmp = m->render;
+		m->render = m->ready;
+		m->ready = tmp;
+		m->ready_fresh = GF_FALSE;
+	}
+	gf_mx_v(m->mx);
+
+	if (!m->render->capture_time) {
+		metrics_reply(sk, "503 Service Unavailable", NULL, 0);
+		return;
+	}
+	gf_fs_metrics_render(m, m->render);
+	if (!m->buf_size) {
+		metrics_reply(sk, "503 Service Unavailable", NULL, 0);
+	} else if (is_head) {
+		//for HEAD, send headers only with the expected length
+		char szHdr[300];
+		snprintf(szHdr, 300, "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\nContent-Length: %u\r\nConnection: close\r\n\r\n", m->buf_size);
+		gf_sk_send(sk, szHdr, (u32) strlen(szHdr));
+	} else {
+		metrics_reply(sk, "200 OK", m->buf, m->buf_size);
+	}
+}
+
+static u32 metrics_th_run(void *par)
+{
+	GF_FSMetrics *m = par;
+	while (m->run) {
+		GF_Socket *conn = NULL;
+		GF_Err e = gf_sk_group_select(m->sg, 100000, GF_SK_SELECT_READ);
+		if (e) continue;
+		if (!gf_sk_group_sock_is_set(m->sg, m->server, GF_SK_SELECT_READ)) continue;
+		e = gf_sk_accept(m->server, &conn);
+		if (e || !conn) continue;
+		gf_sk_set_block_mode(conn, GF_TRUE);
+		metrics_serve(m, conn);
+		gf_sk_del(conn);
+	}
+	return 0;
+}
+
+GF_FSMetrics *gf_fs_metrics_new(GF_FilterSession *fsess, const char *addr)
+{
+	GF_Err e;
+	char szIP[GF_MAX_IP_NAME_LEN];
+	u16 port;
+	const char *ip = NULL;
+	char *sep = strrchr(addr, ':');
+	GF_FSMetrics *m;
+
+	if (sep) {
+		u32 len = (u32) (sep - addr);
+		if (len>=GF_MAX_IP_NAME_LEN) len = GF_MAX_IP_NAME_LEN-1;
+		strncpy(szIP, addr, len);
+		szIP[len] = 0;
+		ip = szIP;
+		port = atoi(sep+1);
+	} else {
+		port = atoi(addr);
+	}
+	if (!port) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("[Metrics] Invalid metrics address %s, expecting [IP:]PORT\n", addr));
+		return NULL;
+	}
+
+	GF_SAFEALLOC(m, GF_FSMetrics);
+	if (!m) return NULL;
+	m->fsess = fsess;
+	m->start_time = gf_sys_clock_high_res();
+	m->capture = &m->snaps[0];
+	m->ready = &m->snaps[1];
+	m->render = &m->snaps[2];
+	m->mx = gf_mx_new("FSMetrics");
+	m->server = gf_sk_new(GF_SOCK_TYPE_TCP);
+	m->sg = gf_sk_group_new();
+	m->th = gf_th_new("FSMetrics");
+	if (!m->mx || !m->server || !m->sg || !m->th) {
+		gf_fs_metrics_del(m);
+		return NULL;
+	}
+	//no port reuse, a second instance must not share the port and answer scrapes in place of this one
+	e = gf_sk_bind(m->server, ip, port, NULL, 0, 0);
+	if (e) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("[Metrics] Cannot bind metrics server on %s:%u, port is likely already in use: %s\n", ip ? ip : "*", port, gf_error_to_string(e)));
+		gf_fs_metrics_del(m);
+		return NULL;
+	}
+	e = gf_sk_listen(m->server, 4);
+	if (e) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("[Metrics] Failed to start server on %s:%u: %s\n", ip ? ip : "*", port, gf_error_to_string(e)));
+		gf_fs_metrics_del(m);
+		return NULL;
+	}
+	gf_sk_server_mode(m->server, GF_TRUE);
+	gf_sk_group_register(m->sg, m->server);
+	m->run = GF_TRUE;
+	if (gf_th_run(m->th, metrics_th_run, m) != GF_OK) {
+		m->run = GF_FALSE;
+		gf_fs_metrics_del(m);
+		return NULL;
+	}
+	GF_LOG(GF_LOG_INFO, GF_LOG_FILTER, ("[Metrics] Serving session metrics on http://%s:%u/metrics\n", ip ? ip : "localhost", port));
+	return m;
+}
+
+void gf_fs_metrics_del(GF_FSMetrics *m)
+{
+	u32 i;
+	if (!m) return;
+	if (m->th) {
+		m->run = GF_FALSE;
+		gf_th_stop(m->th);
+		gf_th_del(m->th);
+	}
+	if (m->sg) {
+		if (m->server) gf_sk_group_unregister(m->sg, m->server);
+		gf_sk_group_del(m->sg);
+	}
+	if (m->server) gf_sk_del(m->server);
+	if (m->mx) gf_mx_del(m->mx);
+	for (i=0; i<3; i++) {
+		if (m->snaps[i].filters) gf_free(m->snaps[i].filters);
+		if (m->snaps[i].pids) gf_free(m->snaps[i].pids);
+	}
+	if (m->buf) gf_free(m->buf);
+	gf_free(m);
+}
+
+#else
+
+GF_FSMetrics *gf_fs_metrics_new(GF_FilterSession *fsess, const char *addr)
+{
+	GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("[Metrics] Metrics server not available in this build\n"));
+	return NULL;
+}
+void gf_fs_metrics_del(GF_FSMetrics *m)
+{
+}
+void gf_fs_metrics_check(GF_FilterSession *fsess)
+{
+}
+void gf_fs_metrics_hist_add(u32 *hist, u64 dur_us)
+{
+}
+
+#endif
@@ -99,6 +99,17 @@ static void pck_queue_enum(void *udta, void *item)
 	else if (enum_state->closest->alloc_size < cur->alloc_size) enum_state->closest = cur;
 }
 
+//update memory accounting of an allocated packet after a realloc
+static void gf_filter_pck_mem_resize(GF_FilterPacket *pck)
+{
+	s64 diff;
+	if (!pck->mem_size || (pck->mem_size == pck->alloc_size)) return;
+	diff = (s64) pck->alloc_size - (s64) pck->mem_size;
+	safe_int64_add(&pck->pid->filter->pck_mem_bytes, diff);
+	safe_int64_add(&pck->session->pck_mem_bytes, diff);
+	pck->mem_size = pck->alloc_size;
+}
+
 static GF_FilterPacket *gf_filter_pck_new_alloc_internal(GF_FilterPid *pid, u32 data_size, u8 **data)
 {
 	GF_FilterPacket *pck=NULL;
@@ -116,6 +127,8 @@ static GF_FilterPacket *gf_filter_pck_new_alloc_internal(GF_FilterPid *pid, u32
 		//don't let reservoir grow too large (may happen if burst of packets are stored/consumed in the upper chain)
 		while (count>30) {
 			GF_FilterPacket *head_pck = gf_fq_pop(pid->filter->pcks_alloc_reservoir);
+			safe_int64_sub(&pid->filter->res_mem_bytes, head_pck->alloc_size);
+			safe_int64_sub(&pid->filter->session->res_mem_bytes, head_pck->alloc_size);
 			gf_free(head_pck->data);
 			gf_free(head_pck);
 			count--;
@@ -137,6 +150,8 @@ static GF_FilterPacket *gf_filter_pck_new_alloc_internal(GF_FilterPid *pid, u32
 
 	if (!pck && (count>=max_reservoir_size)) {
 		if (!closest) return NULL;
+		safe_int64_sub(&pid->filter->res_mem_bytes, closest->alloc_size);
+		safe_int64_sub(&pid->filter->session->res_mem_bytes, closest->alloc_size);
 		closest->alloc_size = data_size;
 		closest->data = gf_realloc(closest->data, closest->alloc_size);
 		if (!closest->data) {
@@ -144,6 +159,8 @@ static GF_FilterPacket *gf_filter_pck_new_alloc_internal(GF_FilterPid *pid, u32
 			GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Failed to allocate new packet on PID %s of filter %s\n", pid->name, pid->filter->name));
 			return NULL;
 		}
+		safe_int64_add(&pid->filter->res_mem_bytes, closest->alloc_size);
+		safe_int64_add(&pid->filter->session->res_mem_bytes, closest->alloc_size);
 		pck = closest;
 #ifdef GPAC_MEMORY_TRACKING
 		pid->filter->session->nb_realloc_pck++;
@@ -180,12 +197,17 @@ static GF_FilterPacket *gf_filter_pck_new_alloc_internal(GF_FilterPid *pid, u32
 		head_pck->data = pck_data;
 		head_pck->alloc_size = alloc_size;
 		pck = head_pck;
+		safe_int64_sub(&pid->filter->res_mem_bytes, pck->alloc_size);
+		safe_int64_sub(&pid->filter->session->res_mem_bytes, pck->alloc_size);
 	}
 
 	pck->pck = pck;
 	pck->data_length = data_size;
 	if (data) *data = pck->data;
 	pck->filter_owns_mem = 0;
+	pck->mem_size = pck->alloc_size;
+	safe_int64_add(&pid->filter->pck_mem_bytes, pck->mem_size);
+	safe_int64_add(&pid->filter->session->pck_mem_bytes, pck->mem_size);
 
 	gf_filter_pck_reset_props(pck, pid);
 	return pck;
@@ -669,6 +691,12 @@ void gf_filter_packet_destroy(GF_FilterPacket *pck)
 		if (pck->is_dangling)
 			pck->data = NULL;
 	}
+	if (pck->mem_size) {
+		safe_int64_sub(&pck->session->pck_mem_bytes, pck->mem_size);
+		if (!is_filter_destroyed && pid && pid->filter)
+			safe_int64_sub(&pid->filter->pck_mem_bytes, pck->mem_size);
+		pck->mem_size = 0;
+	}
 	/*this is a property reference packet, its destruction may happen at ANY time*/
 	if (is_ref_props_packet) {
 		if (gf_fq_res_add(pck->session->pcks_refprops_reservoir, pck)) {
@@ -686,7 +714,19 @@ void gf_filter_packet_destroy(GF_FilterPacket *pck)
 			gf_free(pck);
 		}
 	} else {
-		if (!pid->filter || gf_fq_res_add(pid->filter->pcks_alloc_reservoir, pck)) {
+		GF_FilterSession *fsess = pck->session;
+		//don't keep packet for reuse if this would exceed the memory budget
+		if (!pid->filter || (fsess->mem_budget && (fsess->pck_mem_bytes + fsess->res_mem_bytes + pck->alloc_size > fsess->mem_budget))) {
+			if (pck->data) gf_free(pck->data);
+			gf_free(pck);
+			return;
+		}
+		//account before pushing, packet may be popped right away by the filter
+		safe_int64_add(&pid->filter->res_mem_bytes, pck->alloc_size);
+		safe_int64_add(&fsess->res_mem_bytes, pck->alloc_size);
+		if (gf_fq_res_add(pid->filter->pcks_alloc_reservoir, pck)) {
+			safe_int64_sub(&pid->filter->res_mem_bytes, pck->alloc_size);
+			safe_int64_sub(&fsess->res_mem_bytes, pck->alloc_size);
 			if (pck->data) gf_free(pck->data);
 			gf_free(pck);
 		}
@@ -837,6 +877,42 @@ void gf_filter_pck_discard(GF_FilterPacket *pck)
 	}
 }
 
+//checks if packet shall be dropped for a destination because of session memory budget
+//only destinations lagging behind (buffer above PID max buffer) are dropped, and delivery resumes at the next SAP once memory is back under budget
+static Bool gf_filter_pck_mem_drop(GF_FilterPidInst *dst, GF_FilterPacket *pck)
+{
+	GF_FilterPid *pid = dst->pid;
+	Bool over_budget = GF_FS_MEM_OVER_BUDGET(pid->filter->session);
+
+	//never drop packets signaling property changes or partial blocks for destinations requiring full blocks
+	if (pck->info.flags & (GF_PCKF_PROPS_CHANGED|GF_PCKF_INFO_CHANGED))
+		return GF_FALSE;
+	if (dst->requires_full_data_block) {
+		if ((pck->info.flags & (GF_PCKF_BLOCK_START|GF_PCKF_BLOCK_END)) != (GF_PCKF_BLOCK_START|GF_PCKF_BLOCK_END)) return GF_FALSE;
+		if (gf_list_count(dst->pck_reassembly)) return GF_FALSE;
+	}
+
+	if (dst->mem_dropping) {
+		if (!over_budget && (gf_filter_pck_get_sap(pck) != GF_FILTER_SAP_NONE)) {
+			dst->mem_dropping = GF_FALSE;
+			GF_LOG(GF_LOG_INFO, GF_LOG_FILTER, ("Filter %s PID %s resuming dispatch to %s after "LLU" packets dropped for memory budget\n", pid->filter->name, pid->name, dst->filter->name, dst->nb_mem_drops));
+			return GF_FALSE;
+		}
+	} else {
+		if (!over_budget) return GF_FALSE;
+		if (pid->max_buffer_unit) {
+			if (gf_fq_count(dst->packets) < pid->max_buffer_unit) return GF_FALSE;
+		} else if (dst->buffer_duration <= (s64) pid->max_buffer_time) {
+			return GF_FALSE;
+		}
+		dst->mem_dropping = GF_TRUE;
+		GF_LOG(GF_LOG_WARNING, GF_LOG_FILTER, ("Filter %s PID %s memory budget exceeded ("LLU" bytes in use), dropping packets for %s\n", pid->filter->name, pid->name, pid->filter->session->pck_mem_bytes, dst->filter->name));
+	}
+	dst->nb_mem_drops++;
+	safe_int64_add(&pid->filter->session->nb_mem_drops, 1);
+	return GF_TRUE;
+}
+
 GF_Err gf_filter_pck_send_internal(GF_FilterPacket *pck, Bool from_filter)
 {
 	u32 i, count, nb_dispatch=0;
@@ -845,6 +921,7 @@ GF_Err gf_filter_pck_send_internal(GF_FilterPacket *pck, Bool from_filter)
 	u32 timescale=0;
 	GF_FilterClockType cktype;
 	Bool is_cmd_pck;
+	Bool mem_drop=GF_FALSE;
 #ifdef GPAC_MEMORY_TRACKING
 	u32 nb_allocs=0, nb_reallocs=0, prev_nb_allocs=0, prev_nb_reallocs=0;
 #endif
@@ -962,6 +1039,9 @@ GF_Err gf_filter_pck_send_internal(GF_FilterPacket *pck, Bool from_filter)
 		gf_rmt_end();
 		return GF_PENDING_PACKET;
 	}
+	if (pid->filter->session->tracer)
+		gf_fs_trace_packet(pid->filter->session, pid->filter, pck, GF_TRUE);
+
 	//now dispatched
 	pck->src_filter = NULL;
 
@@ -1105,6 +1185,9 @@ GF_Err gf_filter_pck_send_internal(GF_FilterPacket *pck, Bool from_filter)
 
 
 
+	if ((pid->filter->session->mem_policy==GF_FS_MEM_DROP) && pid->filter->session->mem_budget)
+		mem_drop = GF_TRUE;
+
 	//protect packet from destruction - this could happen
 	//1) during aggregation of packets
 	//2) after dispatching to the packet queue of the next filter, that packet may be consumed
@@ -1153,6 +1236,9 @@ GF_Err gf_filter_pck_send_internal(GF_FilterPacket *pck, Bool from_filter)
 			}
 		}
 
+		if (mem_drop && !cktype && !is_cmd_pck && gf_filter_pck_mem_drop(dst, pck))
+			continue;
+
 		inst = gf_fq_pop(pck->pid->filter->pcks_inst_reservoir);
 		if (!inst) {
 			GF_SAFEALLOC(inst, GF_FilterPacketInstance);
@@ -1248,7 +1334,7 @@ GF_Err gf_filter_pck_send_internal(GF_FilterPacket *pck, Bool from_filter)
 					inst->pck->pck = inst->pck;
 					inst->pck->data = data;
 					memcpy(inst->pck->data, pck->data, pck->data_length);
-					inst->pck->alloc_size = alloc_size;
+					inst->pck->alloc_size = inst->pck->mem_size = alloc_size;
 					inst->pck->filter_owns_mem = 0;
 					inst->pck->reference_count = 0;
 					inst->pck->reference = NULL;
@@ -1881,6 +1967,7 @@ GF_Err gf_filter_pck_expand(GF_FilterPacket *pck, u32 nb_bytes_to_add, u8 **data
 	if (pck->data_length + nb_bytes_to_add > pck->alloc_size) {
 		pck->alloc_size = pck->data_length + nb_bytes_to_add;
 		pck->data = gf_realloc(pck->data, pck->alloc_size);
+		gf_filter_pck_mem_resize(pck);
 #ifdef GPAC_MEMORY_TRACKING
 		pck->pid->filter->session->nb_realloc_pck++;
 #endif
@@ -1938,6 +2025,7 @@ void gf_filter_pck_check_realloc(GF_FilterPacket *pck, u8 *data, u32 size)
 	) {
 		pck->alloc_size = pck->data_length = size;
 		pck->data = data;
+		gf_filter_pck_mem_resize(pck);
 	} else {
 		pck->data_length = size;
 	}
@@ -110,6 +110,23 @@ static GF_FilterPidInst *gf_filter_pid_inst_new(GF_Filter *filter, GF_FilterPid
 	return pidinst;
 }
 
+//checks if PID must stay blocked because session memory budget is exceeded and some destinations still hold packets
+//in fan-out non-blocking mode the PID buffer level is the one of the fastest destination, so we check all destinations
+static Bool gf_filter_pid_mem_blocked(GF_FilterPid *pid)
+{
+	u32 i;
+	GF_FilterSession *fsess = pid->filter->session;
+	if ((fsess->mem_policy!=GF_FS_MEM_BLOCK) || !GF_FS_MEM_OVER_BUDGET(fsess))
+		return GF_FALSE;
+	if (pid->nb_buffer_unit) return GF_TRUE;
+	if (fsess->blocking_mode!=GF_FS_NOBLOCK_FANOUT) return GF_FALSE;
+	for (i=0; i<pid->num_destinations; i++) {
+		GF_FilterPidInst *pidi = gf_list_get(pid->destinations, i);
+		if (gf_fq_count(pidi->packets)) return GF_TRUE;
+	}
+	return GF_FALSE;
+}
+
 static void gf_filter_pid_check_unblock(GF_FilterPid *pid)
 {
 	Bool unblock;
@@ -144,6 +161,10 @@ static void gf_filter_pid_check_unblock(GF_FilterPid *pid)
 	if (!unblock) {
 		return;
 	}
+	//session memory budget exceeded, stay blocked until all packets of the PID are consumed
+	if (gf_filter_pid_mem_blocked(pid)) {
+		return;
+	}
 	gf_mx_p(pid->filter->tasks_mx);
 	unblock = GF_FALSE;
 
@@ -1447,6 +1468,7 @@ void gf_filter_pid_set_name(GF_FilterPid *pid, const char *name)
 		if (pid->name && !strcmp(pid->name, name)) return;
 		if (pid->name) gf_free(pid->name);
 		pid->name = gf_strdup(name);
+		pid->trace_name_id = 0;
 	}
 }
 
@@ -6683,6 +6705,8 @@ void gf_filter_pid_drop_packet(GF_FilterPid *pid)
 
 	gf_rmt_begin(pck_drop, GF_RMT_AGGREGATE);
 	pck = pcki->pck;
+	if (pidinst->pid->filter->session->tracer)
+		gf_fs_trace_packet(pidinst->pid->filter->session, pidinst->filter, pck, GF_FALSE);
 	//move to source pid
 	pid = pid->pid;
 	if (pck->pid_props)
@@ -6966,6 +6990,12 @@ Bool gf_filter_pid_would_block(GF_FilterPid *pid)
 	}
 #endif
 
+	//session memory budget exceeded, block PIDs still holding packets
+	if (!would_block && gf_filter_pid_mem_blocked(pid)) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_FILTER, ("Filter %s PID %s blocked by session memory budget ("LLU" bytes in use)\n", pid->filter->name, pid->name, pid->filter->session->pck_mem_bytes));
+		would_block = GF_TRUE;
+	}
+
 	result = would_block;
 	//if PID is sparse and filter has more than one active output:
 	//- force the pid to move to blocking state
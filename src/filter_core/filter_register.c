@@ -130,6 +130,8 @@ REG_DEC(tilesplit)
 #if !defined(GPAC_CONFIG_ANDROID)
 REG_DEC(pin)
 REG_DEC(pout)
+REG_DEC(shmin)
+REG_DEC(shmout)
 #endif
 REG_DEC(gsfmx)
 REG_DEC(gsfdmx)
@@ -294,6 +296,8 @@ BuiltinReg BuiltinFilters [] = {
 #if !defined(GPAC_CONFIG_ANDROID)
 	REG_IT(pin),
 	REG_IT(pout),
+	REG_IT(shmin),
+	REG_IT(shmout),
 #endif
 	REG_IT(gsfmx),
 	REG_IT(gsfdmx),
@@ -204,6 +204,12 @@ static Bool fs_check_locales(void *__self, const char *locales_parent_path, cons
 #include <emscripten/threading.h>
 #endif
 
+//default task execution, see gf_fs_trace_task_exec when tracing
+static void gf_fs_task_exec(GF_FilterSession *fsess, GF_FSTask *task, u32 thid)
+{
+	task->run_task(task);
+}
+
 GF_EXPORT
 GF_FilterSession *gf_fs_new(s32 nb_threads, GF_FilterSchedulerType sched_type, GF_FilterSessionFlags flags, const char *blacklist)
 {
@@ -229,6 +235,7 @@ GF_FilterSession *gf_fs_new(s32 nb_threads, GF_FilterSchedulerType sched_type, G
 		flags |= GF_FS_FLAG_IMPLICIT_MODE;
 
 	fsess->flags = flags;
+	fsess->task_exec = gf_fs_task_exec;
 
 	if (gf_opts_get_bool("core", "no-mx"))
 		nb_threads=0;
@@ -608,6 +615,30 @@ GF_FilterSession *gf_fs_new_defaults(GF_FilterSessionFlags inflags)
 	if (opt)
 		gf_fs_set_separators(fsess, opt);
 
+	opt = gf_opts_get_key("core", "trace");
+	if (opt) {
+		fsess->tracer = gf_fs_trace_new(opt, gf_opts_get_int("core", "trace-size"), gf_opts_get_int("core", "trace-period"), gf_list_count(fsess->threads));
+		if (fsess->tracer) fsess->task_exec = gf_fs_trace_task_exec;
+	}
+
+	opt = gf_opts_get_key("core", "metrics");
+	if (opt) {
+		fsess->metrics = gf_fs_metrics_new(fsess, opt);
+		//metrics explicitly requested, do not run unmonitored
+		if (!fsess->metrics) {
+			gf_fs_del(fsess);
+			return NULL;
+		}
+	}
+
+	opt = gf_opts_get_key("core", "mem-budget");
+	if (opt) {
+		//budget may exceed 4 GBytes, parse as u64 with k/M/G suffixes
+		GF_PropertyValue p = gf_props_parse_value(GF_PROP_LUINT, "mem-budget", opt, NULL, 0);
+		opt = gf_opts_get_key("core", "mem-policy");
+		gf_fs_set_memory_budget(fsess, p.value.longuint, (opt && !strcmp(opt, "drop")) ? GF_FS_MEM_DROP : GF_FS_MEM_BLOCK);
+	}
+
 	return fsess;
 }
 
@@ -650,6 +681,25 @@ GF_Err gf_fs_set_max_sleep_time(GF_FilterSession *session, u32 max_sleep)
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_fs_set_memory_budget(GF_FilterSession *session, u64 budget, GF_FSMemPolicy policy)
+{
+	if (!session) return GF_BAD_PARAM;
+	session->mem_budget = budget;
+	session->mem_policy = policy;
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_fs_get_memory_usage(GF_FilterSession *session, u64 *pck_mem, u64 *reservoir_mem, u64 *nb_drops)
+{
+	if (!session) return GF_BAD_PARAM;
+	if (pck_mem) *pck_mem = session->pck_mem_bytes;
+	if (reservoir_mem) *reservoir_mem = session->res_mem_bytes;
+	if (nb_drops) *nb_drops = session->nb_mem_drops;
+	return GF_OK;
+}
+
 GF_EXPORT
 u32 gf_fs_get_max_resolution_chain_length(GF_FilterSession *session)
 {
@@ -724,6 +774,20 @@ void gf_fs_del(GF_FilterSession *fsess)
 	gf_fs_stop(fsess);
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_FILTER, ("Session destroy begin\n"));
 
+	if (fsess->metrics) {
+		gf_fs_metrics_del(fsess->metrics);
+		fsess->metrics = NULL;
+	}
+
+	if (fsess->tracer) {
+		GF_FSTracer *tracer = fsess->tracer;
+		gf_fs_trace_dump(fsess);
+		//no tracing during filter destruction
+		fsess->task_exec = gf_fs_task_exec;
+		fsess->tracer = NULL;
+		gf_fs_trace_del(tracer);
+	}
+
 	if (fsess->parsed_args) {
 		while (gf_list_count(fsess->parsed_args)) {
 			GF_FSArgItem *ai = gf_list_pop_back(fsess->parsed_args);
@@ -1571,6 +1635,8 @@ void gf_fs_print_debug_info(GF_FilterSession *fsess, GF_SessionDebugFlag dbg_fla
 				fprintf(stderr, " %d packets to process on %d input PIDs "LLU" KBytes\n", pcki.nb_packets, f->num_input_pids, pcki.all_size/1000);
 			if (f->ref_bytes)
 				fprintf(stderr, " "LLU" KBytes of detached packets in destinations\n", f->ref_bytes/1000);
+			if (f->pck_mem_bytes || f->res_mem_bytes)
+				fprintf(stderr, " "LLU" KBytes allocated in packets "LLU" KBytes in reservoir\n", f->pck_mem_bytes/1000, f->res_mem_bytes/1000);
 		}
 		gf_mx_v(fsess->filters_mx);
 	}
@@ -1686,6 +1752,9 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 		if ((fsess->dbg_flags & GF_FS_DEBUG_CONTINUOUS) && !thid) {
 			gf_fs_print_debug_info(fsess, fsess->dbg_flags ? fsess->dbg_flags : GF_FS_DEBUG_ALL);
 		}
+		if (fsess->metrics && !thid) {
+			gf_fs_metrics_check(fsess);
+		}
 
 #ifndef GPAC_DISABLE_REMOTERY
 		sess_thread->rmt_tasks--;
@@ -2141,7 +2210,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 		task->can_swap = 0;
 		task->requeue_request = GF_FALSE;
 		task->thid = 1+thid;
-		task->run_task(task);
+		fsess->task_exec(fsess, task, thid);
 		task->thid = 0;
 		requeue = task->requeue_request;
 
@@ -2160,6 +2229,8 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 			Bool last_task = GF_FALSE;
 			current_filter->nb_tasks_done++;
 			current_filter->time_process += task_time;
+			if (fsess->metrics)
+				gf_fs_metrics_hist_add(current_filter->task_hist, task_time);
 			consecutive_filter_tasks++;
 
 #if defined(GPAC_CONFIG_EMSCRIPTEN)
@@ -4208,6 +4279,90 @@ GF_Err gf_filter_post_task(GF_Filter *filter, Bool (*task_execute) (GF_Filter *f
 	return GF_OK;
 }
 
+typedef struct
+{
+	void (*run_part)(void *udta, u32 part_idx);
+	void *udta;
+	u32 nb_parts;
+	volatile u32 next_part, nb_done, ref_count;
+	//notified once by the thread completing the last part
+	GF_Semaphore *sem_done;
+} GF_ParallelJob;
+
+static void gf_fs_parallel_job_run(GF_ParallelJob *job)
+{
+	while (1) {
+		u32 part = (u32) safe_int_inc(&job->next_part) - 1;
+		if (part >= job->nb_parts) break;
+		job->run_part(job->udta, part);
+		if ((u32) safe_int_inc(&job->nb_done) == job->nb_parts)
+			gf_sema_notify(job->sem_done, 1);
+	}
+}
+
+static void gf_fs_parallel_job_release(GF_ParallelJob *job)
+{
+	if (safe_int_dec(&job->ref_count)) return;
+	gf_sema_del(job->sem_done);
+	gf_free(job);
+}
+
+static Bool gf_fs_parallel_job_task(GF_FilterSession *fsess, void *callback, u32 *reschedule_ms)
+{
+	GF_ParallelJob *job = (GF_ParallelJob *)callback;
+	//the task may run once all parts are done, in which case it only releases the job
+	gf_fs_parallel_job_run(job);
+	gf_fs_parallel_job_release(job);
+	return GF_FALSE;
+}
+
+GF_EXPORT
+u32 gf_filter_get_num_threads(GF_Filter *filter)
+{
+	if (!filter || !filter->session->threads || filter->session->force_main_thread_tasks) return 1;
+	return 1 + gf_list_count(filter->session->threads);
+}
+
+GF_EXPORT
+GF_Err gf_filter_run_parallel(GF_Filter *filter, u32 nb_parts, void (*run_part)(void *udta, u32 part_idx), void *udta)
+{
+	u32 i, nb_helpers;
+	GF_ParallelJob *job;
+	if (!filter || !run_part) return GF_BAD_PARAM;
+	if (!nb_parts) return GF_OK;
+
+	nb_helpers = gf_filter_get_num_threads(filter) - 1;
+	if (nb_helpers > nb_parts - 1) nb_helpers = nb_parts - 1;
+	if (!nb_helpers) {
+		for (i=0; i<nb_parts; i++)
+			run_part(udta, i);
+		return GF_OK;
+	}
+
+	GF_SAFEALLOC(job, GF_ParallelJob);
+	if (!job) return GF_OUT_OF_MEM;
+	job->sem_done = gf_sema_new(1, 0);
+	if (!job->sem_done) {
+		gf_free(job);
+		return GF_OUT_OF_MEM;
+	}
+	job->run_part = run_part;
+	job->udta = udta;
+	job->nb_parts = nb_parts;
+	//one reference per helper task and one for the caller
+	job->ref_count = nb_helpers + 1;
+	for (i=0; i<nb_helpers; i++) {
+		if (gf_fs_post_user_task(filter->session, gf_fs_parallel_job_task, job, filter->name) != GF_OK)
+			safe_int_dec(&job->ref_count);
+	}
+	//the calling thread runs parts as well, so that all parts are done even if no other thread is available
+	gf_fs_parallel_job_run(job);
+	//parts picked by other threads may still be running
+	gf_sema_wait(job->sem_done);
+	gf_fs_parallel_job_release(job);
+	return GF_OK;
+}
+
 
 GF_EXPORT
 Bool gf_fs_is_last_task(GF_FilterSession *fsess)
@@ -4372,6 +4527,30 @@ GF_Err gf_filter_get_stats(GF_Filter *f, GF_FilterStats *stats)
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_filter_get_memory_usage(GF_Filter *f, u64 *pck_mem, u64 *reservoir_mem, u64 *in_mem, u64 *nb_drops)
+{
+	u32 i;
+	struct __pck_size_info pcki;
+	if (!f) return GF_BAD_PARAM;
+	if (pck_mem) *pck_mem = f->pck_mem_bytes;
+	if (reservoir_mem) *reservoir_mem = f->res_mem_bytes;
+	if (!in_mem && !nb_drops) return GF_OK;
+
+	memset(&pcki, 0, sizeof(struct __pck_size_info));
+	if (nb_drops) *nb_drops = 0;
+	gf_mx_p(f->tasks_mx);
+	for (i=0; i<f->num_input_pids; i++) {
+		GF_FilterPidInst *pidi = gf_list_get(f->input_pids, i);
+		if (nb_drops) *nb_drops += pidi->nb_mem_drops;
+		if (in_mem && pidi->packets)
+			gf_fq_enum(pidi->packets, gather_pck_size, &pcki);
+	}
+	gf_mx_v(f->tasks_mx);
+	if (in_mem) *in_mem = pcki.all_alloc_size;
+	return GF_OK;
+}
+
 GF_EXPORT
 GF_Err gf_fs_get_filter_stats(GF_FilterSession *session, u32 idx, GF_FilterStats *stats)
 {
@@ -37,6 +37,9 @@
 
 #define GF_FILTER_SPEED_SCALER	1000
 
+//number of buckets in filter task duration histograms
+#define GF_FS_METRICS_HIST_SIZE	10
+
 #define PID_IS_INPUT(__pid) ((__pid->pid==__pid) ? GF_FALSE : GF_TRUE)
 #define PID_IS_OUTPUT(__pid) ((__pid->pid==__pid) ? GF_TRUE : GF_FALSE)
 #define PCK_IS_INPUT(__pck) ((__pck->pck==__pck) ? GF_FALSE : GF_TRUE)
@@ -268,7 +271,11 @@ struct __gf_filter_pck
 	//note that packets with frame_ifce are always considered as read-only memory
 	u8 filter_owns_mem;
 	u8 is_dangling;
+	//size accounted in session memory usage, only set for allocated packets
+	u32 mem_size;
 
+	//flow ID assigned at dispatch when session tracing is enabled
+	u32 trace_id;
 };
 
 /*!
@@ -372,8 +379,15 @@ enum
 	GF_FS_NOBLOCK
 };
 
+//packets in use exceed the session memory budget
+#define GF_FS_MEM_OVER_BUDGET(_fs)	((_fs)->mem_budget && ((_fs)->pck_mem_bytes > (_fs)->mem_budget))
+
 //#define GF_FS_ENABLE_LOCALES
 
+typedef struct __gf_fs_tracer GF_FSTracer;
+typedef struct __gf_fs_trace_ring GF_FSTraceRing;
+typedef struct __gf_fs_metrics GF_FSMetrics;
+
 
 struct __gf_filter_session
 {
@@ -529,8 +543,36 @@ struct __gf_filter_session
 
 
 	u32 dbg_flags;
+
+	//session tracer, NULL if disabled
+	GF_FSTracer *tracer;
+	//task execution, set to the tracer one when tracing is enabled so that the scheduler does not check for tracing
+	void (*task_exec)(GF_FilterSession *fsess, GF_FSTask *task, u32 thid);
+	//metrics server, NULL if disabled
+	GF_FSMetrics *metrics;
+
+	//memory budget in bytes for allocated packets, 0 if none
+	u64 mem_budget;
+	GF_FSMemPolicy mem_policy;
+	//bytes of allocated packets in use and in filter reservoirs
+	volatile u64 pck_mem_bytes;
+	volatile u64 res_mem_bytes;
+	volatile u64 nb_mem_drops;
 };
 
+//session tracing, see filter_trace.c
+GF_FSTracer *gf_fs_trace_new(const char *file, u32 nb_events, u32 period_ms, u32 nb_threads);
+void gf_fs_trace_del(GF_FSTracer *tr);
+void gf_fs_trace_task_exec(GF_FilterSession *fsess, GF_FSTask *task, u32 thid);
+void gf_fs_trace_packet(GF_FilterSession *fsess, GF_Filter *filter, GF_FilterPacket *pck, Bool is_send);
+GF_Err gf_fs_trace_dump(GF_FilterSession *fsess);
+
+//session metrics server, see filter_metrics.c
+GF_FSMetrics *gf_fs_metrics_new(GF_FilterSession *fsess, const char *addr);
+void gf_fs_metrics_del(GF_FSMetrics *m);
+void gf_fs_metrics_check(GF_FilterSession *fsess);
+void gf_fs_metrics_hist_add(u32 *hist, u64 dur_us);
+
 #ifdef GPAC_HAS_QJS
 void jsfs_on_filter_created(GF_Filter *new_filter);
 void jsfs_on_filter_destroyed(GF_Filter *del_filter);
@@ -686,6 +728,9 @@ struct __gf_filter
 	volatile u32 pending_packets;
 	volatile u32 nb_ref_packets;
 	volatile u64 ref_bytes;
+	//bytes of allocated packets in use and in the alloc reservoir of this filter
+	volatile u64 pck_mem_bytes;
+	volatile u64 res_mem_bytes;
 
 	volatile u32 stream_reset_pending;
 	volatile u32 num_events_queued;
@@ -730,6 +775,8 @@ struct __gf_filter
 	u64 nb_bytes_sent;
 	//number of microseconds this filter was active
 	u64 time_process;
+	//task duration histogram, only updated when session metrics are enabled
+	u32 task_hist[GF_FS_METRICS_HIST_SIZE];
 
 #ifdef GPAC_MEMORY_TRACKING
 	//various stats in mem tracking mode, mostly used to detect heavy alloc/free usage by the filter
@@ -888,6 +935,12 @@ struct __gf_filter
 #endif
 	//for external bindings
 	void *rt_udta;
+
+	//interned name and start time in ns of current task, only used when session tracing is enabled
+	u32 trace_name_id;
+	u64 trace_ts;
+	//trace ring of the thread running the current task of the filter, NULL outside tasks
+	GF_FSTraceRing *trace_ring;
 };
 
 GF_Filter *gf_filter_new(GF_FilterSession *fsess, const GF_FilterRegister *freg, const char *args, const char *dst_args, GF_FilterArgType arg_type, GF_Err *err, GF_Filter *multi_sink_target, Bool dynamic_filter);
@@ -955,6 +1008,10 @@ struct __gf_filter_pid_inst
 
 	//amount of media data in us in the packet queue - concurrent inc/dec
 	volatile s64 buffer_duration;
+	//packets dropped for this instance because of session memory budget
+	u64 nb_mem_drops;
+	//set when dropping because of memory budget, cleared at next SAP
+	Bool mem_dropping;
 
 	volatile s32 detach_pending;
 	Bool force_flush;
@@ -1105,6 +1162,8 @@ struct __gf_filter_pid
 
 	u32 link_flags;
 
+	//interned name, only used when session tracing is enabled
+	u32 trace_name_id;
 };
 
 
@@ -1135,6 +1194,11 @@ void gf_filter_post_remove(GF_Filter *filter);
 
 void gf_filter_check_pending_pids(GF_Filter *filter);
 
+#ifndef GPAC_DISABLE_THREADS
+/*pins filter tasks to the given session thread (1-based, wrapped on thread count), 0 picks the least loaded thread*/
+void gf_filter_pin_thread(GF_Filter *filter, u32 th_idx);
+#endif
+
 typedef struct
 {
 	u32 code;
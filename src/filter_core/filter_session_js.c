@@ -2113,7 +2113,7 @@ static GF_Err gf_fs_load_script_ex(GF_FilterSession *fs, const char *jsfile, JSC
 	JS_SetPropertyStr(ctx, global, "parent_filter", for_filter ? jsfs_new_filter_obj(ctx, for_filter) : JS_NULL);
 	JS_FreeValue(ctx, global);
 
-	ret = JS_Eval(ctx, (char *)buf, buf_len, jsfile, flags);
+	ret = qjs_eval_cached(ctx, (char *)buf, buf_len, jsfile, flags);
 	gf_free(buf);
 
 	if (JS_IsException(ret)) {
@@ -0,0 +1,456 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: agent
+ *			Copyright (c) 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / filters sub-project
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include "filter_session.h"
+
+#if !defined(WIN32)
+#include <time.h>
+#endif
+
+/*
+Session tracer: each session thread records events in its own ring, without atomic operations.
+
+The ring of a thread is only written by that thread: a slot is reserved by incrementing the write index,
+filled and published by setting the slot sequence number to index+1 with a release store. The ring used by the
+current task is cached in the filter, so that packet events find it without a lookup. Events from threads
+outside the scheduler (or for filters not running a task) go to a shared ring, where slots are reserved
+with an atomic increment.
+
+The dump code copies a slot and checks the sequence number before and after the copy, so that slots being
+overwritten while dumping are skipped rather than written corrupted. Dumps are always done by the main thread
+(or at session destruction), writers never block.
+
+Events are one cache line. Filter and PID names are interned once and referenced by ID, the ID being cached
+in the filter or PID. Packet events use the start time of the current task of the filter and the event index
+as flow ID, so that they cost neither a clock read nor another synchronization.
+*/
+
+//writers only need store ordering, full barriers are only used by the dump code
+#if defined(WIN32) && !defined(__GNUC__)
+#define trace_barrier()	MemoryBarrier()
+#define trace_store_fence()	MemoryBarrier()
+#define trace_store_release(_ptr, _v)	{ MemoryBarrier(); *(_ptr) = (_v); }
+#else
+#define trace_barrier()	__sync_synchronize()
+#define trace_store_fence()	__atomic_thread_fence(__ATOMIC_RELEASE)
+#define trace_store_release(_ptr, _v)	__atomic_store_n(_ptr, _v, __ATOMIC_RELEASE)
+#endif
+
+enum
+{
+	GF_FS_TRACE_TASK=0,
+	GF_FS_TRACE_PCK_SEND,
+	GF_FS_TRACE_PCK_DROP,
+};
+
+#define TRACE_TASK_LEN	20
+#define TRACE_LINE_SIZE	64
+
+typedef struct
+{
+	volatile u32 seq;
+	u32 type;
+	//start time in ns since tracer creation
+	u64 ts;
+	//duration in ns
+	u32 dur;
+	u32 th_id;
+	//interned filter name
+	u32 name_id;
+	//packets consumed / sent during task, packet size for packet events
+	u32 pck_in, pck_out;
+	//filter task queue size and session pending tasks, flow ID and interned PID name for packet events
+	u32 queue, pending;
+	//task name, copied as it may be freed before dump
+	char task[TRACE_TASK_LEN];
+} GF_FSTraceEvent;
+
+struct __gf_fs_trace_ring
+{
+	GF_FSTraceEvent *events;
+	//only written by the owning thread, except for the shared ring
+	volatile u32 write_idx;
+	//system ID of owning thread, 0 if not yet used or for the shared ring
+	u32 th_id;
+};
+
+struct __gf_fs_tracer
+{
+	void *events_alloc;
+	u32 mask;
+	//one ring per session thread (index is the scheduler thread index), last one is shared
+	GF_FSTraceRing *rings;
+	u32 nb_rings;
+	u64 start_ns;
+
+	//interned names, ID is index+1
+	GF_List *names;
+	GF_Mutex *names_mx;
+
+	char *file;
+	u32 period_ms;
+	u64 next_dump;
+	volatile Bool dump_requested;
+	u32 nb_dumps;
+};
+
+static u64 trace_clock(void)
+{
+#if defined(WIN32)
+	return gf_sys_clock_high_res() * 1000;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((u64) ts.tv_sec) * 1000000000 + (u64) ts.tv_nsec;
+#endif
+}
+
+GF_FSTracer *gf_fs_trace_new(const char *file, u32 nb_events, u32 period_ms, u32 nb_threads)
+{
+	u32 i, size = 1;
+	GF_FSTracer *tr;
+	if (!file || !file[0]) return NULL;
+
+	GF_SAFEALLOC(tr, GF_FSTracer);
+	if (!tr) return NULL;
+	//round to power of 2 so that slot index is a simple mask
+	if (nb_events<1024) nb_events = 1024;
+	while (size < nb_events) size <<= 1;
+	//main thread, session threads and shared ring
+	tr->nb_rings = nb_threads + 2;
+	//align on cache lines so that each event is a single line
+	tr->events_alloc = gf_malloc(sizeof(GF_FSTraceEvent) * size * tr->nb_rings + TRACE_LINE_SIZE);
+	tr->rings = gf_malloc(sizeof(GF_FSTraceRing) * tr->nb_rings);
+	tr->names = gf_list_new();
+	tr->names_mx = gf_mx_new("SessionTracer");
+	if (!tr->events_alloc || !tr->rings || !tr->names || !tr->names_mx) {
+		gf_fs_trace_del(tr);
+		return NULL;
+	}
+	//no memset of events, slots are only read once written and pages are only touched when used
+	for (i=0; i<tr->nb_rings; i++) {
+		tr->rings[i].events = (GF_FSTraceEvent *) ((u8 *) tr->events_alloc + ((TRACE_LINE_SIZE - (PTR_TO_U_CAST tr->events_alloc) % TRACE_LINE_SIZE) % TRACE_LINE_SIZE)) + i*size;
+		tr->rings[i].write_idx = 0;
+		tr->rings[i].th_id = 0;
+	}
+	tr->mask = size - 1;
+	tr->file = gf_strdup(file);
+	tr->period_ms = period_ms;
+	tr->start_ns = trace_clock();
+	if (period_ms)
+		tr->next_dump = gf_sys_clock_high_res() + ((u64) period_ms) * 1000;
+	GF_LOG(GF_LOG_INFO, GF_LOG_FILTER, ("Session tracing enabled, %u rings of %u events (%u kB each), output %s\n", tr->nb_rings, size, (u32) (sizeof(GF_FSTraceEvent)*size/1024), file));
+	return tr;
+}
+
+void gf_fs_trace_del(GF_FSTracer *tr)
+{
+	if (!tr) return;
+	if (tr->events_alloc) gf_free(tr->events_alloc);
+	if (tr->rings) gf_free(tr->rings);
+	if (tr->names) {
+		while (gf_list_count(tr->names))
+			gf_free(gf_list_pop_back(tr->names));
+		gf_list_del(tr->names);
+	}
+	if (tr->names_mx) gf_mx_del(tr->names_mx);
+	if (tr->file) gf_free(tr->file);
+	gf_free(tr);
+}
+
+//escapes name for JSON output, dst must be at least twice the size of str
+static const char *trace_escape(char *dst, const char *str)
+{
+	u32 i=0;
+	while (*str) {
+		char c = *str;
+		if ((c=='"') || (c=='\\')) dst[i++] = '\\';
+		dst[i++] = ((u8) c < 0x20) ? ' ' : c;
+		str++;
+	}
+	dst[i] = 0;
+	return dst;
+}
+
+//interns name escaped for JSON output, only called once per filter or PID name
+static u32 trace_intern(GF_FSTracer *tr, const char *name)
+{
+	u32 id;
+	char *esc;
+	if (!name) name = "";
+	esc = gf_malloc(2*strlen(name) + 1);
+	if (!esc) return 0;
+	trace_escape(esc, name);
+	gf_mx_p(tr->names_mx);
+	gf_list_add(tr->names, esc);
+	id = gf_list_count(tr->names);
+	gf_mx_v(tr->names_mx);
+	return id;
+}
+
+//gets the ring of the calling thread, or the shared ring if the thread is not the owner
+static GF_FSTraceRing *trace_get_ring(GF_FSTracer *tr, GF_FSTraceRing *ring)
+{
+	if (ring) {
+		u32 th_id = gf_th_id();
+		if (!ring->th_id) ring->th_id = th_id;
+		if (ring->th_id == th_id) return ring;
+	}
+	return &tr->rings[tr->nb_rings-1];
+}
+
+static GF_FSTraceEvent *trace_reserve(GF_FSTracer *tr, GF_FSTraceRing *ring, u32 *idx)
+{
+	GF_FSTraceEvent *evt;
+	if (ring == &tr->rings[tr->nb_rings-1]) {
+		*idx = (u32) safe_int_inc(&ring->write_idx) - 1;
+	} else {
+		//owner is the only writer, no atomic operation needed
+		*idx = ring->write_idx;
+		ring->write_idx = *idx + 1;
+	}
+	evt = &ring->events[*idx & tr->mask];
+	evt->seq = 0;
+	trace_store_fence();
+	return evt;
+}
+
+static void trace_publish(GF_FSTraceEvent *evt, u32 idx)
+{
+	//0 is reserved for "being written"
+	trace_store_release(&evt->seq, idx+1 ? idx+1 : 1);
+}
+
+static void trace_copy_name(char *dst, const char *src, u32 len)
+{
+	u32 i=0;
+	if (src) {
+		while (src[i] && (i+1<len)) {
+			dst[i] = src[i];
+			i++;
+		}
+	}
+	dst[i] = 0;
+}
+
+static void gf_fs_trace_check_dump(GF_FilterSession *fsess);
+
+void gf_fs_trace_task_exec(GF_FilterSession *fsess, GF_FSTask *task, u32 thid)
+{
+	u32 idx, nb_in=0, nb_out=0;
+	GF_FSTracer *tr = fsess->tracer;
+	GF_Filter *filter = task->filter;
+	GF_FSTraceRing *ring;
+	GF_FSTraceEvent *evt;
+	u64 end_ns, start_ns = trace_clock() - tr->start_ns;
+
+	ring = trace_get_ring(tr, (thid < tr->nb_rings-1) ? &tr->rings[thid] : NULL);
+	if (filter) {
+		nb_in = (u32) filter->nb_pck_processed;
+		nb_out = (u32) filter->nb_pck_sent;
+		filter->trace_ts = start_ns;
+		filter->trace_ring = ring;
+	}
+	task->run_task(task);
+	end_ns = trace_clock() - tr->start_ns;
+
+	evt = trace_reserve(tr, ring, &idx);
+	evt->type = GF_FS_TRACE_TASK;
+	evt->ts = start_ns;
+	evt->dur = (u32) (end_ns - start_ns);
+	evt->th_id = ring->th_id ? ring->th_id : gf_th_id();
+	//filter may have been destroyed by the task
+	filter = task->filter;
+	if (filter) {
+		filter->trace_ring = NULL;
+		if (!filter->trace_name_id) filter->trace_name_id = trace_intern(tr, filter->name);
+		evt->name_id = filter->trace_name_id;
+		evt->pck_in = (u32) filter->nb_pck_processed - nb_in;
+		evt->pck_out = (u32) filter->nb_pck_sent - nb_out;
+		evt->queue = gf_fq_count(filter->tasks);
+	} else {
+		evt->name_id = 0;
+		evt->pck_in = evt->pck_out = evt->queue = 0;
+	}
+	evt->pending = fsess->tasks_pending;
+	trace_copy_name(evt->task, task->log_name, TRACE_TASK_LEN);
+	trace_publish(evt, idx);
+
+	if (!thid) gf_fs_trace_check_dump(fsess);
+}
+
+void gf_fs_trace_packet(GF_FilterSession *fsess, GF_Filter *filter, GF_FilterPacket *pck, Bool is_send)
+{
+	u32 idx;
+	GF_FSTracer *tr = fsess->tracer;
+	GF_FSTraceRing *ring = trace_get_ring(tr, filter ? filter->trace_ring : NULL);
+	GF_FSTraceEvent *evt = trace_reserve(tr, ring, &idx);
+
+	//event index and ring are unique, use them as flow ID
+	if (is_send)
+		pck->trace_id = idx * tr->nb_rings + (u32) (ring - tr->rings) + 1;
+
+	evt->type = is_send ? GF_FS_TRACE_PCK_SEND : GF_FS_TRACE_PCK_DROP;
+	//packets are sent or dropped while the filter runs, stamp them with the start of the enclosing task slice
+	evt->ts = (filter && filter->trace_ts) ? filter->trace_ts : trace_clock() - tr->start_ns;
+	evt->dur = 0;
+	evt->th_id = ring->th_id ? ring->th_id : gf_th_id();
+	if (filter) {
+		if (!filter->trace_name_id) filter->trace_name_id = trace_intern(tr, filter->name);
+		evt->name_id = filter->trace_name_id;
+	} else {
+		evt->name_id = 0;
+	}
+	evt->pck_in = 0;
+	evt->pck_out = pck->data_length;
+	evt->queue = pck->trace_id;
+	if (pck->pid) {
+		if (!pck->pid->trace_name_id) pck->pid->trace_name_id = trace_intern(tr, pck->pid->name);
+		evt->pending = pck->pid->trace_name_id;
+	} else {
+		evt->pending = 0;
+	}
+	trace_publish(evt, idx);
+}
+
+//maps system thread IDs to session thread index, as used by the scheduler logs
+static u32 trace_thread_idx(GF_FilterSession *fsess, u32 th_id)
+{
+#ifndef GPAC_DISABLE_THREADS
+	u32 i, count = gf_list_count(fsess->threads);
+	for (i=0; i<count; i++) {
+		GF_SessionThread *sess_th = gf_list_get(fsess->threads, i);
+		if (sess_th->th_id == th_id) return i+1;
+	}
+#endif
+	if (fsess->main_th.th_id == th_id) return 0;
+	//other threads (user threads calling into the session, e.g. download threads), keep raw ID
+	return th_id;
+}
+
+GF_Err gf_fs_trace_dump(GF_FilterSession *fsess)
+{
+	u32 i, r, start, end, nb_written=0, nb_recorded=0, nb_threads=1;
+	char szTmp[GF_MAX_PATH];
+	char szTask[2*TRACE_TASK_LEN];
+	FILE *f;
+	Bool first = GF_TRUE;
+	GF_FSTracer *tr = fsess->tracer;
+	u64 dump_start = gf_sys_clock_high_res();
+	if (!tr) return GF_BAD_PARAM;
+
+	tr->dump_requested = GF_FALSE;
+	tr->nb_dumps++;
+
+	//write to a temp file and move, so that periodic dumps never leave a truncated trace
+	snprintf(szTmp, GF_MAX_PATH, "%s.tmp", tr->file);
+	f = gf_fopen(szTmp, "wt");
+	if (!f) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Failed to open trace file %s\n", szTmp));
+		return GF_IO_ERR;
+	}
+	gf_fprintf(f, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"version\":\"%s\"},\"traceEvents\":[\n", gf_gpac_version());
+
+#ifndef GPAC_DISABLE_THREADS
+	nb_threads += gf_list_count(fsess->threads);
+#endif
+	for (i=0; i<nb_threads; i++) {
+		gf_fprintf(f, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s%u\"}}", first ? "" : ",\n", i, i ? "FSThread" : "Main", i);
+		first = GF_FALSE;
+	}
+
+	//names may be interned while dumping
+	gf_mx_p(tr->names_mx);
+	for (r=0; r<tr->nb_rings; r++) {
+		GF_FSTraceRing *ring = &tr->rings[r];
+		end = ring->write_idx;
+		nb_recorded += end;
+		start = (end > tr->mask+1) ? end - tr->mask - 1 : 0;
+		for (i=start; i!=end; i++) {
+			GF_FSTraceEvent evt;
+			GF_FSTraceEvent *src = &ring->events[i & tr->mask];
+			u32 seq = src->seq;
+			u32 expected = i+1 ? i+1 : 1;
+			u32 tid;
+			const char *name;
+			if (seq != expected) continue;
+			trace_barrier();
+			memcpy(&evt, src, sizeof(GF_FSTraceEvent));
+			trace_barrier();
+			//slot reused while copying
+			if (src->seq != seq) continue;
+	
+			tid = trace_thread_idx(fsess, evt.th_id);
+			name = evt.name_id ? gf_list_get(tr->names, evt.name_id-1) : NULL;
+			if (evt.type==GF_FS_TRACE_TASK) {
+				evt.task[TRACE_TASK_LEN-1] = 0;
+				trace_escape(szTask, evt.task);
+				gf_fprintf(f, ",\n{\"ph\":\"X\",\"cat\":\"task\",\"name\":\"%s\",\"pid\":1,\"tid\":%u,\"ts\":"LLU".%03u,\"dur\":%u.%03u,\"args\":{\"task\":\"%s\",\"pck_in\":%u,\"pck_out\":%u,\"queue\":%u,\"pending\":%u}}",
+					name ? name : szTask, tid, evt.ts/1000, (u32) (evt.ts%1000), evt.dur/1000, evt.dur%1000,
+					szTask, evt.pck_in, evt.pck_out, evt.queue, evt.pending);
+			} else {
+				Bool is_send = (evt.type==GF_FS_TRACE_PCK_SEND) ? GF_TRUE : GF_FALSE;
+				const char *pid_name = evt.pending ? gf_list_get(tr->names, evt.pending-1) : NULL;
+				//flow start binds to the enclosing task slice of the sender, flow end to the enclosing slice of the consumer
+				gf_fprintf(f, ",\n{\"ph\":\"%s\",\"cat\":\"pck\",\"name\":\"%s\",\"id\":%u,\"pid\":1,\"tid\":%u,\"ts\":"LLU".%03u,\"args\":{\"filter\":\"%s\",\"size\":%u}}",
+					is_send ? "s" : "f\",\"bp\":\"e", pid_name ? pid_name : "", evt.queue, tid, evt.ts/1000, (u32) (evt.ts%1000),
+					name ? name : "", evt.pck_out);
+			}
+			nb_written++;
+		}
+	}
+	gf_mx_v(tr->names_mx);
+	gf_fprintf(f, "\n]}\n");
+	gf_fclose(f);
+
+	if (gf_file_move(szTmp, tr->file) != GF_OK) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Failed to move trace file to %s\n", tr->file));
+		gf_file_delete(szTmp);
+		return GF_IO_ERR;
+	}
+	GF_LOG(GF_LOG_INFO, GF_LOG_FILTER, ("Session trace dumped to %s: %u events (%u recorded) in "LLU" us\n", tr->file, nb_written, nb_recorded, gf_sys_clock_high_res() - dump_start));
+	return GF_OK;
+}
+
+static void gf_fs_trace_check_dump(GF_FilterSession *fsess)
+{
+	GF_FSTracer *tr = fsess->tracer;
+	if (tr->dump_requested) {
+		gf_fs_trace_dump(fsess);
+	} else if (tr->period_ms) {
+		u64 now = gf_sys_clock_high_res();
+		if (now < tr->next_dump) return;
+		gf_fs_trace_dump(fsess);
+		tr->next_dump = now + ((u64) tr->period_ms) * 1000;
+	}
+}
+
+GF_EXPORT
+void gf_fs_request_trace_dump(GF_FilterSession *session)
+{
+	//only sets a flag, may be called from a signal handler
+	if (session && session->tracer)
+		session->tracer->dump_requested = GF_TRUE;
+}
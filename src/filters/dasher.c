@@ -211,11 +211,12 @@ typedef struct
 	u32 llhls;
 	//inherited from mp4mx
 	GF_Fraction cdur;
-	Bool ll_preload_hint, ll_rend_rep;
+	Bool ll_preload_hint, ll_rend_rep, ll_can_block;
 	Bool gencues, force_init, gxns;
 	Double ll_part_hb;
 	u32 hls_absu, seg_sync;
 	Bool hls_ap;
+	Bool pinth;
 
 	//internal
 	Bool in_error;
@@ -307,6 +308,8 @@ typedef struct
 
 	Bool move_to_static;
 	Bool explicit_mode;
+	//last session thread used when pinning representation chains
+	u32 last_pin_th;
 } GF_DasherCtx;
 
 typedef enum
@@ -515,6 +518,10 @@ typedef struct _dash_stream
 
 	u64 frag_start_offset, frag_first_ftdt;
 	u32 tpl_use_time;
+
+	//segment production latency (wall clock, us) from segment start to flush
+	u64 seg_clock_start, seg_lat_total, seg_lat_max;
+	u32 seg_lat_nb;
 } GF_DashStream;
 
 static void dasher_flush_segment(GF_DasherCtx *ctx, GF_DashStream *ds, Bool is_last_in_period);
@@ -3302,6 +3309,13 @@ static void dasher_open_destination(GF_Filter *filter, GF_DasherCtx *ctx, GF_MPD
 		gf_dynstrcat(&szDST, szSRC, NULL);
 	}
 
+	//pin muxer and output of this representation to their own session thread
+	if (ctx->pinth) {
+		ctx->last_pin_th++;
+		sprintf(szSRC, "%cTH%c%d", sep_args, sep_name, ctx->last_pin_th);
+		gf_dynstrcat(&szDST, szSRC, NULL);
+	}
+
 	if (trailer_args)
 		gf_dynstrcat(&szDST, trailer_args, NULL);
 
@@ -5312,6 +5326,7 @@ static GF_Err dasher_write_and_send_manifest(GF_DasherCtx *ctx, u64 last_period_
 		ctx->mpd->llhls_preload = ctx->ll_preload_hint;
 		ctx->mpd->llhls_rendition_reports = ctx->ll_rend_rep;
 		ctx->mpd->llhls_part_holdback = ctx->ll_part_hb;
+		ctx->mpd->llhls_can_block = ctx->ll_can_block;
 		ctx->mpd->hls_abs_url = ctx->hls_absu;
 		ctx->mpd->hls_audio_primary = ctx->hls_ap;
 
@@ -7663,6 +7678,15 @@ static void dasher_flush_segment(GF_DasherCtx *ctx, GF_DashStream *ds, Bool is_l
 			if (base_ds->segment_started) {
 				base_ds->segment_started = GF_FALSE;
 
+				if (base_ds->seg_clock_start) {
+					u64 lat = gf_sys_clock_high_res() - base_ds->seg_clock_start;
+					base_ds->seg_lat_total += lat;
+					base_ds->seg_lat_nb++;
+					if (base_ds->seg_lat_max < lat) base_ds->seg_lat_max = lat;
+					base_ds->seg_clock_start = 0;
+					GF_LOG(GF_LOG_DEBUG, GF_LOG_DASH, ("[Dasher] Rep#%s segment %d produced in "LLU" us\n", base_ds->rep->id, base_ds->seg_number, lat));
+				}
+
 				base_ds->next_seg_start += (u64) (base_ds->dash_dur.num) * base_ds->timescale / base_ds->dash_dur.den;
 				while (base_ds->next_seg_start <= base_ds->adjusted_next_seg_start) {
 					base_ds->next_seg_start += (u64) (base_ds->dash_dur.num) * base_ds->timescale / base_ds->dash_dur.den;
@@ -7773,6 +7797,9 @@ static void dasher_mark_segment_start(GF_DasherCtx *ctx, GF_DashStream *ds, GF_F
 	char szSegmentName[GF_MAX_PATH], szSegmentFullPath[GF_MAX_PATH], szIndexName[GF_MAX_PATH];
 	GF_DashStream *base_ds = ds->muxed_base ? ds->muxed_base : ds;
 
+	if (!base_ds->seg_clock_start)
+		base_ds->seg_clock_start = gf_sys_clock_high_res();
+
 	if (ctx->forward_mode) {
 		const GF_PropertyValue *p_fname, *p_manifest;
 
@@ -10440,6 +10467,9 @@ static void dasher_finalize(GF_Filter *filter)
 
 	while (gf_list_count(ctx->pids)) {
 		GF_DashStream *ds = gf_list_pop_back(ctx->pids);
+		if (ds->seg_lat_nb) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("[Dasher] Rep#%s %d segments produced in "LLU" us average, "LLU" us max\n", ds->rep_id ? ds->rep_id : "unknown", ds->seg_lat_nb, ds->seg_lat_total / ds->seg_lat_nb, ds->seg_lat_max));
+		}
 		dasher_reset_stream(filter, ds, GF_TRUE);
 		gf_free(ds);
 	}
@@ -10645,6 +10675,7 @@ static const GF_FilterArgs DasherArgs[] =
 	{ OFFS(ll_preload_hint), "inject preload hint for LL-HLS", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(ll_rend_rep), "inject rendition reports for LL-HLS", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(ll_part_hb), "user-defined part hold-back for LLHLS, negative value means 3 times max part duration in session", GF_PROP_DOUBLE, "-1", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(ll_can_block), "signal blocking playlist reload support (CAN-BLOCK-RELOAD) for LL-HLS, the HTTP server must support `_HLS_msn` and `_HLS_part` requests", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(ckurl), "set the ClearKey URL common to all encrypted streams (overriden by `CKUrl` pid property)", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 
 	{ OFFS(hls_absu), "use absolute url in HLS generation using first URL in [base]()\n"
@@ -10653,6 +10684,7 @@ static const GF_FilterArgs DasherArgs[] =
 	"- mas: use absolute URL only in master playlist\n"
 	"- both: use absolute URL everywhere"
 		, GF_PROP_UINT, "no", "no|var|mas|both", GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(pinth), "pin the multiplexer and output chain of each representation to a dedicated session thread, see filter option `TH` - only used when session runs with extra threads", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(hls_ap), "use audio as primary media instead of video when generating playlists", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(seg_sync), "control how waiting on last packet P of fragment/segment to be written impacts segment injection in manifest\n"
 	"- no: do not wait for P\n"
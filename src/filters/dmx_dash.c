@@ -80,6 +80,7 @@ typedef struct
 	char *query;
 	Bool noxlink, split_as, noseek, groupsel, bsmerge;
 	u32 lowlat;
+	u32 prefetch, sidx_merge;
 
 	GF_FilterPid *mpd_pid;
 	GF_Filter *filter;
@@ -135,8 +136,25 @@ typedef struct
 	Bool load_file;
 	GF_FileIO *fio;
 	GF_FilterPacket *mpd_pck_ref;
+
+	//last time prefetch concurrency was sampled
+	u64 pf_last_us;
 } GF_DASHDmxCtx;
 
+#ifdef GPAC_USE_DOWNLOADER
+typedef struct
+{
+	GF_DownloadSession *sess;
+	char *url;
+	u64 start_range, end_range;
+	u64 us_start, us_end, size;
+	//number of concurrent downloads integrated over download time
+	u64 conc_sum, conc_time;
+	GF_Err status;
+	Bool done;
+} DASHPrefetch;
+#endif
+
 typedef struct
 {
 	GF_DASHDmxCtx *ctx;
@@ -155,7 +173,12 @@ typedef struct
 
 #ifdef GPAC_USE_DOWNLOADER
 	GF_DownloadSession *sess;
+	//segments being fetched ahead, and prefetched segment currently loaded by seg_filter_src
+	GF_List *prefetch;
+	DASHPrefetch *pf_current;
 #endif
+	//concurrency seen while seg_filter_src downloads the current segment
+	u64 conc_sum, conc_time;
 	Bool is_timestamp_based, pto_setup;
 	Bool prev_is_init_segment, init_from_media;
 	//media timescale for which the pto, max_cts_in_period and timedisc_ts_offset were computed
@@ -187,6 +210,29 @@ typedef struct
 	Bool url_changed;
 } GF_DASHGroup;
 
+#ifdef GPAC_USE_DOWNLOADER
+static void dashdmx_prefetch_del(DASHPrefetch *pf)
+{
+	if (pf->sess) gf_dm_sess_del(pf->sess);
+	gf_free(pf->url);
+	gf_free(pf);
+}
+
+static void dashdmx_prefetch_reset(GF_DASHGroup *group)
+{
+	if (group->pf_current) {
+		dashdmx_prefetch_del(group->pf_current);
+		group->pf_current = NULL;
+	}
+	if (!group->prefetch) return;
+	while (gf_list_count(group->prefetch)) {
+		dashdmx_prefetch_del(gf_list_pop_back(group->prefetch));
+	}
+	gf_list_del(group->prefetch);
+	group->prefetch = NULL;
+}
+#endif
+
 static void dashdmx_notify_group_quality(GF_DASHDmxCtx *ctx, GF_DASHGroup *group);
 
 static void dashdmx_set_string_list_prop(GF_FilterPacket *ref, u32 prop_name, GF_List **str_list)
@@ -1206,6 +1252,9 @@ GF_Err dashdmx_io_on_dash_event(GF_DASHFileIO *dashio, GF_DASHEventType dash_evt
 			}
 			if (group->template) gf_free(group->template);
 			if (group->current_url) gf_free(group->current_url);
+#ifdef GPAC_USE_DOWNLOADER
+			dashdmx_prefetch_reset(group);
+#endif
 			gf_free(group);
 			gf_dash_set_group_udta(ctx->dash, i, NULL);
 		}
@@ -2228,7 +2277,7 @@ static GF_Err dashdmx_initialize_js(GF_DASHDmxCtx *dashctx, char *jsfile)
 		flags = JS_EVAL_TYPE_MODULE;
 	}
 
-	ret = JS_Eval(dashctx->js_ctx, (char *)buf, buf_len, jsfile, flags);
+	ret = qjs_eval_cached(dashctx->js_ctx, (char *)buf, buf_len, jsfile, flags);
 	gf_free(buf);
 
 	if (JS_IsException(ret)) {
@@ -2403,6 +2452,7 @@ static GF_Err dashdmx_initialize(GF_Filter *filter)
 	gf_dash_set_switching_probe_count(ctx->dash, ctx->switch_count);
 	gf_dash_set_agressive_adaptation(ctx->dash, ctx->aggressive);
 	gf_dash_enable_single_range_llhls(ctx->dash, ctx->llhls_merge);
+	gf_dash_set_sidx_merge(ctx->dash, ctx->sidx_merge);
 	gf_dash_debug_groups(ctx->dash, ctx->debug_as.vals, ctx->debug_as.nb_items);
 	gf_dash_disable_speed_adaptation(ctx->dash, !ctx->speedadapt);
 	gf_dash_ignore_xlink(ctx->dash, ctx->noxlink);
@@ -2412,6 +2462,7 @@ static GF_Err dashdmx_initialize(GF_Filter *filter)
 		gf_dash_split_adaptation_sets(ctx->dash);
 	gf_dash_disable_low_quality_tiles(ctx->dash, ctx->skip_lqt);
 	gf_dash_set_chaining_mode(ctx->dash, ctx->chain_mode);
+	gf_dash_set_prefetch(ctx->dash, ctx->prefetch);
 	gf_dash_set_auto_switch(ctx->dash, ctx->auto_switch, ctx->asloop);
 
 	//in test mode, we disable seeking inside the segment: this initial seek range is dependent from tune-in time and would lead to different start range
@@ -2712,6 +2763,9 @@ static Bool dashdmx_process_event(GF_Filter *filter, const GF_FilterEvent *fevt)
 		group->is_playing = GF_FALSE;
 		group->prev_is_init_segment = GF_FALSE;
 		group->init_from_media = GF_FALSE;
+#ifdef GPAC_USE_DOWNLOADER
+		dashdmx_prefetch_reset(group);
+#endif
 		if (ctx->nb_playing) {
 			ctx->initial_play = GF_FALSE;
 			group->force_seg_switch = GF_TRUE;
@@ -2842,6 +2896,166 @@ static void dashdmx_notify_group_quality(GF_DASHDmxCtx *ctx, GF_DASHGroup *group
 
 GF_Err gf_dash_group_push_tfrf(GF_DashClient *dash, u32 idx, void *tfrf, u32 timescale);
 
+#ifdef GPAC_USE_DOWNLOADER
+static Bool dashdmx_prefetch_is_queued(GF_DASHDmxCtx *ctx, GF_DASHGroup *group, DASHPrefetch *pf, u32 nb_win)
+{
+	u32 i;
+	for (i=0; i<=nb_win; i++) {
+		const char *url;
+		u64 start_range, end_range;
+		GF_Err e = gf_dash_group_get_queued_segment(ctx->dash, group->idx, i, &url, &start_range, &end_range);
+		if (e==GF_BUFFER_TOO_SMALL) break;
+		if (e) continue;
+		if (strcmp(url, pf->url)) continue;
+		if ((start_range != pf->start_range) || (end_range != pf->end_range)) continue;
+		return GF_TRUE;
+	}
+	return GF_FALSE;
+}
+
+static DASHPrefetch *dashdmx_prefetch_find(GF_DASHGroup *group, const char *url, u64 start_range, u64 end_range)
+{
+	u32 i, count = gf_list_count(group->prefetch);
+	for (i=0; i<count; i++) {
+		DASHPrefetch *pf = gf_list_get(group->prefetch, i);
+		if (strcmp(url, pf->url)) continue;
+		if ((start_range != pf->start_range) || (end_range != pf->end_range)) continue;
+		return pf;
+	}
+	return NULL;
+}
+
+//fetch the next queued segments of each group in parallel with the one loaded by the group source filter
+//downloads are made in the download manager cache, and the source filter reuses the cache entry when switching to the segment
+static void dashdmx_prefetch_process(GF_DASHDmxCtx *ctx)
+{
+	u32 i, j, count, nb_active = 0;
+	Bool has_pending = GF_FALSE;
+	u64 now, elapsed;
+
+	if (!ctx->prefetch) return;
+
+	count = gf_dash_get_group_count(ctx->dash);
+	for (i=0; i<count; i++) {
+		u32 nb_win;
+		GF_DASHGroup *group = gf_dash_get_group_udta(ctx->dash, i);
+		if (!group || !group->is_playing || !group->seg_filter_src) continue;
+
+		if (!group->prefetch) {
+			group->prefetch = gf_list_new();
+			if (!group->prefetch) continue;
+		}
+		nb_win = ctx->prefetch * (1 + group->nb_group_deps);
+
+		//discard downloads no longer needed (seek, quality switch)
+		for (j=0; j<gf_list_count(group->prefetch); j++) {
+			DASHPrefetch *pf = gf_list_get(group->prefetch, j);
+			if (dashdmx_prefetch_is_queued(ctx, group, pf, nb_win)) continue;
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_DASH, ("[DASHDmx] group %d discarding prefetch of %s\n", group->idx, pf->url));
+			gf_list_rem(group->prefetch, j);
+			j--;
+			dashdmx_prefetch_del(pf);
+		}
+
+		//check download status
+		for (j=0; j<gf_list_count(group->prefetch); j++) {
+			u64 bytes_done = 0;
+			GF_NetIOStatus status;
+			GF_Err e;
+			DASHPrefetch *pf = gf_list_get(group->prefetch, j);
+			if (pf->done) continue;
+			nb_active++;
+
+			e = gf_dm_sess_get_stats(pf->sess, NULL, NULL, NULL, &bytes_done, NULL, &status);
+			//HTTP errors are reported on transfered sessions
+			if (status==GF_NETIO_DATA_TRANSFERED)
+				e = gf_dm_sess_last_error(pf->sess);
+
+			if (((status==GF_NETIO_DATA_TRANSFERED) || (status==GF_NETIO_DISCONNECTED)) && (e>=GF_OK)) {
+				pf->done = GF_TRUE;
+				pf->us_end = gf_sys_clock_high_res();
+				pf->size = bytes_done;
+				GF_LOG(GF_LOG_DEBUG, GF_LOG_DASH, ("[DASHDmx] group %d prefetch of %s done\n", group->idx, pf->url));
+			} else if ((status==GF_NETIO_STATE_ERROR) || (status==GF_NETIO_DATA_TRANSFERED) || (status==GF_NETIO_DISCONNECTED)) {
+				pf->done = GF_TRUE;
+				pf->status = e ? e : GF_SERVICE_ERROR;
+				GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[DASHDmx] group %d prefetch of %s failed: %s\n", group->idx, pf->url, gf_error_to_string(pf->status) ));
+			} else {
+				has_pending = GF_TRUE;
+			}
+		}
+		//segment being downloaded by the source filter
+		if (group->segment_sent && !group->stats_uploaded && !group->pf_current)
+			nb_active++;
+
+		//no prefetch for encrypted files (not cached by source) nor for low latency (segments are still being produced)
+		if (group->in_is_cryptfile || gf_dash_is_low_latency(ctx->dash, group->idx))
+			continue;
+
+		//index 0 is the segment currently loaded by the source filter
+		for (j=1; j<=nb_win; j++) {
+			GF_Err e;
+			u32 flags;
+			const char *url;
+			u64 start_range, end_range;
+			DASHPrefetch *pf;
+
+			e = gf_dash_group_get_queued_segment(ctx->dash, group->idx, j, &url, &start_range, &end_range);
+			if (e==GF_BUFFER_TOO_SMALL) break;
+			if (e || !url) continue;
+			if (strnicmp(url, "http://", 7) && strnicmp(url, "https://", 8)) continue;
+			if (dashdmx_prefetch_find(group, url, start_range, end_range)) continue;
+
+			GF_SAFEALLOC(pf, DASHPrefetch);
+			if (!pf) break;
+			flags = GF_NETIO_SESSION_NO_BLOCK | GF_NETIO_SESSION_PERSISTENT;
+			if (!ctx->segstore) flags |= GF_NETIO_SESSION_MEMORY_CACHE;
+			pf->sess = gf_dm_sess_new(ctx->dm, url, flags, NULL, NULL, &e);
+			if (pf->sess && (start_range || end_range))
+				e = gf_dm_sess_set_range(pf->sess, start_range, end_range, GF_TRUE);
+			if (!pf->sess || e) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[DASHDmx] group %d failed to setup prefetch of %s: %s\n", group->idx, url, gf_error_to_string(e) ));
+				if (pf->sess) gf_dm_sess_del(pf->sess);
+				gf_free(pf);
+				break;
+			}
+			pf->url = gf_strdup(url);
+			pf->start_range = start_range;
+			pf->end_range = end_range;
+			pf->us_start = gf_sys_clock_high_res();
+			gf_list_add(group->prefetch, pf);
+			GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("[DASHDmx] group %d prefetching segment %s\n", group->idx, url));
+			gf_dm_sess_process(pf->sess);
+			has_pending = GF_TRUE;
+		}
+	}
+
+	//integrate number of concurrent downloads over time, used to derive link rate from per-download rate
+	now = gf_sys_clock_high_res();
+	elapsed = ctx->pf_last_us ? (now - ctx->pf_last_us) : 0;
+	ctx->pf_last_us = has_pending ? now : 0;
+	if (has_pending)
+		gf_filter_ask_rt_reschedule(ctx->filter, 2000);
+	if (!elapsed || !nb_active) return;
+
+	for (i=0; i<count; i++) {
+		GF_DASHGroup *group = gf_dash_get_group_udta(ctx->dash, i);
+		if (!group || !group->prefetch) continue;
+		for (j=0; j<gf_list_count(group->prefetch); j++) {
+			DASHPrefetch *pf = gf_list_get(group->prefetch, j);
+			if (pf->us_start >= now - elapsed) continue;
+			if (pf->done && (pf->us_end < now - elapsed)) continue;
+			pf->conc_sum += nb_active * elapsed;
+			pf->conc_time += elapsed;
+		}
+		if (group->segment_sent && !group->stats_uploaded && !group->pf_current) {
+			group->conc_sum += nb_active * elapsed;
+			group->conc_time += elapsed;
+		}
+	}
+}
+#endif
+
 static void dashdmx_update_group_stats(GF_DASHDmxCtx *ctx, GF_DASHGroup *group)
 {
 	u32 bytes_per_sec = 0;
@@ -2850,13 +3064,45 @@ static void dashdmx_update_group_stats(GF_DASHDmxCtx *ctx, GF_DASHGroup *group)
 	const GF_PropertyValue *p;
 	GF_PropertyEntry *pe=NULL;
 	Bool broadcast_flag = GF_FALSE;
+	u64 us_since_start;
 	if (group->stats_uploaded) return;
 	if (group->prev_is_init_segment) return;
 	if (!group->seg_filter_src) return;
 
+	if (group->nb_group_deps)
+		dep_rep_idx = group->current_group_dep ? (group->current_group_dep-1) : group->nb_group_deps;
+	else
+		dep_rep_idx = group->current_dependent_rep_idx;
+
+#ifdef GPAC_USE_DOWNLOADER
+	//segment was prefetched, the source filter only read it from cache: use prefetch download stats
+	if (group->pf_current) {
+		DASHPrefetch *pf = group->pf_current;
+		Double rate=0, conc=1;
+		us_since_start = pf->us_end - pf->us_start;
+		if (pf->conc_time) {
+			conc = (Double) pf->conc_sum;
+			conc /= pf->conc_time;
+			if (conc<1) conc = 1;
+		}
+		//the link is shared among concurrent downloads: scale up download rate and scale down download time
+		if (us_since_start) {
+			rate = (Double) pf->size * 1000000;
+			rate /= us_since_start;
+			rate *= conc;
+			us_since_start = (u64) (us_since_start / conc);
+		}
+		if (rate > 0xFFFFFFFF) rate = 0xFFFFFFFF;
+		bytes_per_sec = (u32) rate;
+		group->stats_uploaded = GF_TRUE;
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_DASH, ("[DASHDmx] group %d prefetched segment "LLU" bytes, %g concurrent downloads, estimated rate %d kbps\n", group->idx, pf->size, conc, (u32) (rate*8/1000) ));
+		gf_dash_group_store_stats(ctx->dash, group->idx, dep_rep_idx, bytes_per_sec, pf->size, GF_FALSE, us_since_start);
+		return;
+	}
+#endif
+
 	p = gf_filter_get_info(group->seg_filter_src, GF_PROP_PID_FILE_CACHED, &pe);
 	if (!p || !p->value.boolean) {
-		u64 us_since_start = 0;
 		u64 down_bytes = 0;
 		u32 bits_per_sec = 0;
 		u32 now = gf_sys_clock();
@@ -2895,12 +3141,18 @@ static void dashdmx_update_group_stats(GF_DASHDmxCtx *ctx, GF_DASHGroup *group)
 	if (p && p->value.string && !strcmp(p->value.string, "yes")) {
 		broadcast_flag = GF_TRUE;
 	}
-	if (group->nb_group_deps)
-		dep_rep_idx = group->current_group_dep ? (group->current_group_dep-1) : group->nb_group_deps;
-	else
-		dep_rep_idx = group->current_dependent_rep_idx;
+	us_since_start = gf_sys_clock_high_res() - group->us_at_seg_start;
 
-	gf_dash_group_store_stats(ctx->dash, group->idx, dep_rep_idx, bytes_per_sec, file_size, broadcast_flag, gf_sys_clock_high_res() - group->us_at_seg_start);
+	//prefetch downloads were running concurrently, scale up download rate
+	if (!broadcast_flag && (group->conc_time > 0) && (group->conc_sum > group->conc_time)) {
+		Double conc = (Double) group->conc_sum;
+		conc /= group->conc_time;
+		if (bytes_per_sec * conc < 0xFFFFFFFF)
+			bytes_per_sec = (u32) (bytes_per_sec * conc);
+		us_since_start = (u64) (us_since_start / conc);
+	}
+
+	gf_dash_group_store_stats(ctx->dash, group->idx, dep_rep_idx, bytes_per_sec, file_size, broadcast_flag, us_since_start);
 
 	p = gf_filter_get_info(group->seg_filter_src, GF_PROP_PID_FILE_CACHED, &pe);
 	if (p && p->value.boolean)
@@ -2920,6 +3172,9 @@ static void dashdmx_switch_segment(GF_DASHDmxCtx *ctx, GF_DASHGroup *group)
 	u64 start_range, end_range, switch_start_range, switch_end_range;
 	bin128 key_IV;
 	u32 group_idx;
+#ifdef GPAC_USE_DOWNLOADER
+	DASHPrefetch *pf;
+#endif
 
 	//for smooth if prev is init segment itis not connected to the real httpin yet...
 	if (group->prev_is_init_segment && gf_dash_is_smooth_streaming(ctx->dash)) {
@@ -3027,6 +3282,21 @@ fetch_next:
 		return;
 	}
 
+#ifdef GPAC_USE_DOWNLOADER
+	//segment is being prefetched, wait for completion rather than downloading it twice
+	pf = NULL;
+	if (group->prefetch && next_url && !seg_disabled && (!next_url_init_or_switch_segment || group->init_switch_seg_sent)) {
+		pf = dashdmx_prefetch_find(group, next_url, start_range, end_range);
+		if (pf && !pf->done) {
+			group->seg_was_not_ready = GF_TRUE;
+			group->stats_uploaded = GF_TRUE;
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_DASH, ("[DASHDmx] group %d next segment %s still being prefetched\n", group->idx, next_url));
+			gf_filter_ask_rt_reschedule(ctx->filter, 2000);
+			return;
+		}
+	}
+#endif
+
 	if (!has_scalable_next) {
 		group->next_dependent_rep_idx = 0;
 	} else {
@@ -3118,6 +3388,26 @@ fetch_next:
 	evt.seek.start_offset = start_range;
 	evt.seek.end_offset = end_range;
 	evt.seek.is_init_segment = GF_FALSE;
+
+	group->conc_sum = group->conc_time = 0;
+#ifdef GPAC_USE_DOWNLOADER
+	//previous prefetched segment no longer used by source filter
+	if (group->pf_current) {
+		dashdmx_prefetch_del(group->pf_current);
+		group->pf_current = NULL;
+	}
+	if (pf) {
+		gf_list_del_item(group->prefetch, pf);
+		if (pf->status) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("[DASHDmx] group %d prefetch of %s failed, fetching again\n", group->idx, next_url));
+			dashdmx_prefetch_del(pf);
+		} else {
+			//keep prefetch session alive until source filter has attached to the cache entry
+			group->pf_current = pf;
+			evt.seek.skip_cache_expiration = GF_TRUE;
+		}
+	}
+#endif
 	gf_filter_send_event(group->seg_filter_src, &evt, GF_FALSE);
 }
 
@@ -3217,6 +3507,10 @@ GF_Err dashdmx_process(GF_Filter *filter)
 	if (e)
 		return e;
 
+#ifdef GPAC_USE_DOWNLOADER
+	dashdmx_prefetch_process(ctx);
+#endif
+
 	next_time_ms = gf_dash_get_min_wait_ms(ctx->dash);
 	if (next_time_ms>1000)
 		next_time_ms=1000;
@@ -3577,6 +3871,7 @@ static const GF_FilterArgs DASHDmxArgs[] =
 
 	{ OFFS(skip_lqt), "disable decoding of tiles with highest degradation hints (not visible, not gazed at) for debug purposes", GF_PROP_BOOL, "no", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(llhls_merge), "merge LL-HLS byte range parts into a single open byte range request", GF_PROP_BOOL, "yes", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(sidx_merge), "merge consecutive subsegments of on-demand representations into byte range requests of at most the given size in bytes (0 disables merging)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(groupsel), "select groups based on language (by default all playable groups are exposed)", GF_PROP_BOOL, "no", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(chain_mode), "MPD chaining mode\n"
 	"- off: do not use MPD chaining\n"
@@ -3584,6 +3879,7 @@ static const GF_FilterArgs DASHDmxArgs[] =
 	"- error: use MPD chaining once over or if error (MPD or segment download)", GF_PROP_UINT, "on", "off|on|error", GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(asloop), "when auto switch is enabled, iterates back and forth from highest to lowest qualities", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(bsmerge), "allow merging of video bitstreams (only HEVC for now)", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(prefetch), "number of segments to download ahead of the current one in each group (see filter help)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{0}
 };
 
@@ -3618,6 +3914,12 @@ GF_FilterRegister DASHDmxRegister = {
 	"- run with no adaptation, fetching all qualities.\n"
 	"EX gpac -i MANIFEST_URL:split_as -o dst=$File$.mp4\n"
 	"\n"
+	"# Segment prefetch\n"
+	"When [-prefetch]() is set, the client downloads the next segments of each group while the current one is being processed, using concurrent HTTP requests (multiplexed on a single connection for HTTP/2 servers, on parallel connections otherwise).\n"
+	"Prefetched segments are stored in the download cache and loaded from there when played. A segment still being prefetched is waited for rather than requested again.\n"
+	"Download rates are scaled by the average number of concurrent downloads before being passed to the adaptation algorithm, so that the estimated bandwidth reflects the link rate rather than the per-request rate.\n"
+	"Prefetch is not used for low latency sessions, encrypted HLS segments and local files.\n"
+	"\n"
 	"# File mode\n"
 	"When [-forward]() is set to `file`, the client forwards media files without demultiplexing them.\n"
 	"This is mostly used to expose the DASH session to a file server such as ROUTE or HTTP.\n"
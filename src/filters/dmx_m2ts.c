@@ -60,7 +60,7 @@ typedef struct
 {
 	//opts
 	const char *temi_url;
-	Bool dsmcc, seeksrc, sigfrag, dvbtxt;
+	Bool dsmcc, seeksrc, sigfrag, dvbtxt, pcrdur;
 	Double index;
 
 	GF_Filter *filter;
@@ -165,6 +165,145 @@ static void m2tsdmx_on_event_duration_probe(GF_M2TS_Demuxer *ts, u32 evt_type, v
 	}
 }
 
+//size of the windows read at the beginning and at the end of the file when probing PCRs
+#define M2TSDMX_PCR_PROBE_SIZE	(512*1024)
+
+//PCR wrap period in 27MHz units
+#define M2TSDMX_PCR_WRAP	(((u64) 1 << 33) * 300)
+
+typedef struct
+{
+	//PID carrying the PCR, 0 to use the first PCR PID found
+	u32 pid;
+	//first and last PCR found, in 27MHz units, and their byte offsets in the window
+	u64 first, last;
+	u32 first_pos, last_pos;
+	//PCR span between first and last PCR, accounting for wraps
+	u64 span;
+	u32 nb_pcr;
+	//discontinuity_indicator set on one of the PCR packets
+	Bool discontinuity;
+} M2TSDmxPCRScan;
+
+//locates TS packets in buffer and gathers PCRs found on scan->pid, or on the first PCR PID found if scan->pid is 0
+static Bool m2tsdmx_scan_pcr(u8 *data, u32 size, M2TSDmxPCRScan *scan)
+{
+	u32 i, pck_size=0;
+
+	scan->nb_pcr = 0;
+	scan->span = 0;
+	scan->discontinuity = GF_FALSE;
+	for (i=0; i+3*192<size; i++) {
+		if (data[i]!=0x47) continue;
+		if ((data[i+188]==0x47) && (data[i+2*188]==0x47)) pck_size = 188;
+		else if ((data[i+192]==0x47) && (data[i+2*192]==0x47)) pck_size = 192;
+		else continue;
+		break;
+	}
+	if (!pck_size) return GF_FALSE;
+
+	for (; i+188<=size; i+=pck_size) {
+		u32 pid;
+		u64 pcr;
+		u8 *pck = data+i;
+		//sync lost, move forward byte by byte
+		if (pck[0]!=0x47) {
+			i = i + 1 - pck_size;
+			continue;
+		}
+		//transport error
+		if (pck[1] & 0x80) continue;
+		//no adaptation field
+		if (! (pck[3] & 0x20)) continue;
+		//adaptation field too short or no PCR
+		if ((pck[4]<7) || !(pck[5] & 0x10)) continue;
+		pid = ((pck[1] & 0x1F) << 8) | pck[2];
+		if (scan->pid && (pid != scan->pid)) continue;
+
+		scan->pid = pid;
+		pcr = ((u64) pck[6] << 25) | ((u64) pck[7] << 17) | ((u64) pck[8] << 9) | ((u64) pck[9] << 1) | (pck[10] >> 7);
+		pcr = pcr * 300 + (((pck[10] & 1) << 8) | pck[11]);
+		//time base changes, PCRs before and after cannot be compared
+		if (pck[5] & 0x80) scan->discontinuity = GF_TRUE;
+
+		if (!scan->nb_pcr) {
+			scan->first = pcr;
+			scan->first_pos = i;
+		} else {
+			//consecutive PCRs are at most 100 ms apart, a lower value is a wrap
+			if (pcr < scan->last) scan->span += pcr + M2TSDMX_PCR_WRAP - scan->last;
+			else scan->span += pcr - scan->last;
+		}
+		scan->last = pcr;
+		scan->last_pos = i;
+		scan->nb_pcr++;
+	}
+	return scan->nb_pcr ? GF_TRUE : GF_FALSE;
+}
+
+//computes duration from first PCR in the file and last PCR on the same PID at the end of the file
+//this only reads two small windows of the file, regardless of its size
+static Bool m2tsdmx_probe_pcr_duration(GF_M2TSDmxCtx *ctx, FILE *stream)
+{
+	u32 nb_read;
+	u64 fsize, dur, est=0;
+	u8 *buf;
+	M2TSDmxPCRScan head, tail;
+
+	fsize = gf_fsize(stream);
+	if (!fsize) return GF_FALSE;
+	buf = gf_malloc(M2TSDMX_PCR_PROBE_SIZE);
+	if (!buf) return GF_FALSE;
+
+	memset(&head, 0, sizeof(M2TSDmxPCRScan));
+	nb_read = (u32) gf_fread(buf, M2TSDMX_PCR_PROBE_SIZE, stream);
+	if (!m2tsdmx_scan_pcr(buf, nb_read, &head) || head.discontinuity) {
+		gf_free(buf);
+		gf_fseek(stream, 0, SEEK_SET);
+		return GF_FALSE;
+	}
+	//whole file in the first window
+	if (fsize <= M2TSDMX_PCR_PROBE_SIZE) {
+		gf_free(buf);
+		gf_fseek(stream, 0, SEEK_SET);
+		dur = head.span;
+	} else {
+		u64 tail_start = fsize - M2TSDMX_PCR_PROBE_SIZE;
+		memset(&tail, 0, sizeof(M2TSDmxPCRScan));
+		tail.pid = head.pid;
+		gf_fseek(stream, tail_start, SEEK_SET);
+		nb_read = (u32) gf_fread(buf, M2TSDMX_PCR_PROBE_SIZE, stream);
+		gf_fseek(stream, 0, SEEK_SET);
+		if (!m2tsdmx_scan_pcr(buf, nb_read, &tail) || tail.discontinuity) {
+			gf_free(buf);
+			return GF_FALSE;
+		}
+		gf_free(buf);
+
+		dur = (tail.last >= head.first) ? (tail.last - head.first) : (tail.last + M2TSDMX_PCR_WRAP - head.first);
+		//extrapolate the PCR span from the rate of the first window, and use it to get the number of wraps in between
+		if (head.span && (head.last_pos > head.first_pos)) {
+			u64 nb_bytes = tail_start + tail.last_pos - head.first_pos;
+			est = (u64) ( ((Double) nb_bytes) * head.span / (head.last_pos - head.first_pos) );
+			if (est > dur)
+				dur += ((est - dur + M2TSDMX_PCR_WRAP/2) / M2TSDMX_PCR_WRAP) * M2TSDMX_PCR_WRAP;
+			//unsignaled time base change between the two windows, or rate too variable to trust the PCRs
+			if ((dur > 2*est) || (2*dur < est)) {
+				GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[M2TSDmx] PCR duration %g sec too far from rate estimate %g sec, ignoring\n", ((Double) dur)/27000000, ((Double) est)/27000000));
+				return GF_FALSE;
+			}
+		}
+	}
+	dur /= 27000;
+	if (!dur) return GF_FALSE;
+
+	ctx->file_size = fsize;
+	ctx->duration.num = (s32) dur;
+	ctx->duration.den = 1000;
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[M2TSDmx] Duration from PCR %d sampling: %g sec\n", head.pid, ((Double) dur)/1000));
+	return GF_TRUE;
+}
+
 static void m2tsdmx_update_sdt(GF_M2TS_Demuxer *ts, void *for_pid)
 {
 	u32 i, count = gf_list_count(ts->programs);
@@ -1164,6 +1303,11 @@ static GF_Err m2tsdmx_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 
 		ctx->ipid = pid;
 		ctx->is_file = GF_TRUE;
+		//try first and last PCR, otherwise estimate duration from instant bitrate
+		if (stream && (ctx->pcrdur || gf_opts_get_bool("temp", "inspect_summary")) && m2tsdmx_probe_pcr_duration(ctx, stream)) {
+			gf_fclose(stream);
+			stream = NULL;
+		}
 		if (stream) {
 			ctx->ts->seek_mode = GF_TRUE;
 			ctx->ts->on_event = m2tsdmx_on_event_duration_probe;
@@ -1511,6 +1655,7 @@ static const GF_FilterArgs M2TSDmxArgs[] =
 	{ OFFS(sigfrag), "signal segment boundaries on output packets for DASH or HLS sources", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(dvbtxt), "export DVB teletext streams", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(index), "indexing window length", GF_PROP_DOUBLE, "1.0", NULL, GF_FS_ARG_HINT_HIDE},
+	{ OFFS(pcrdur), "compute duration of local files from the first and last PCR, only reading the start and end of the file (always done when inspecting PID changes only)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -27,6 +27,7 @@
 
 #ifndef GPAC_DISABLE_EVG
 #include <gpac/evg.h>
+#include <gpac/maths.h>
 
 enum
 {
@@ -35,7 +36,52 @@ enum
 	EVGS_KEEPAR_NOSRC,
 };
 
+enum
+{
+	EVGS_KERNEL_EVG=0,
+	EVGS_KERNEL_BICUBIC,
+	EVGS_KERNEL_LANCZOS,
+};
+
+typedef struct
+{
+	//first source sample for each destination sample
+	u32 *offsets;
+	//nb_taps coefficients for each destination sample
+	s16 *coefs;
+	u32 nb_taps, src_size, dst_size, type;
+} EVGSKernel;
+
+typedef struct
+{
+	const EVGSKernel *kh, *kv;
+	const u8 *src;
+	u32 src_stride;
+	u8 *dst;
+	u32 dst_stride;
+} EVGSPlaneJob;
+
 typedef struct
+{
+	//horizontally filtered rows
+	s16 *tmp;
+	u32 tmp_alloc;
+} EVGSBand;
+
+typedef struct
+{
+	GF_FilterPid *opid;
+	u32 w, h, size, stride, stride_uv, uv_h;
+	//index of level used as source, -1 for input frame
+	s32 src_level;
+	//luma and chroma kernels
+	EVGSKernel kh[2], kv[2];
+	//output being built
+	GF_FilterPacket *pck;
+	u8 *planes[3];
+} EVGSLevel;
+
+typedef struct _evgs_ctx
 {
 	//options
 	GF_PropVec2i osize;
@@ -44,6 +90,9 @@ typedef struct
 	char *padclr;
 	u32 keepar;
 	GF_Fraction osar;
+	u32 kernel;
+	GF_PropVec2iList olist;
+	Bool pyramid;
 
 	//internal data
 	GF_FilterPid *ipid;
@@ -60,11 +109,403 @@ typedef struct
 	GF_EVGSurface *surf;
 	GF_EVGStencil *tx;
 	GF_Path *path;
+
+	//polyphase scaler: level 0 is the main output, other levels are from olist
+	EVGSLevel *levels;
+	u32 nb_levels, nb_active;
+	u32 *order;
+	Bool use_pp;
+	u32 pp_w, pp_h, pp_fmt, pp_size, pp_stride, pp_stride_uv, pp_uv_h;
+	u32 uv_shift_w, uv_shift_h;
+
+	GF_Filter *filter;
+	//bands are run on the session threads
+	EVGSBand *bands;
+	u32 max_bands, nb_bands;
+	EVGSPlaneJob job;
+	GF_Err job_error;
 } EVGScaleCtx;
 
 u32 gf_evg_stencil_get_pixel_fast(GF_EVGStencil *st, s32 x, s32 y);
 u64 gf_evg_stencil_get_pixel_wide_fast(GF_EVGStencil *st, s32 x, s32 y);
 
+/*polyphase separable scaler for planar 8-bit formats*/
+
+#if defined(WIN32) && !defined(__GNUC__) && (defined(_M_X64) || defined(_M_IX86))
+# include <intrin.h>
+# define EVGS_HAS_SSE2
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+# define EVGS_HAS_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+# include <arm_neon.h>
+# define EVGS_HAS_NEON
+#endif
+
+//coefficients are 14-bit fixed point, intermediate samples have 6 fractional bits
+#define EVGS_COEF_BITS	14
+#define EVGS_TMP_BITS	6
+
+static GF_Err evgs_kernel_setup(EVGSKernel *k, u32 type, u32 src_size, u32 dst_size)
+{
+	u32 i;
+	Double *w;
+	Double scale = (Double) src_size / dst_size;
+	Double fscale = MAX(scale, 1.0);
+	Double support = ((type==EVGS_KERNEL_BICUBIC) ? 2.0 : 3.0) * fscale;
+	u32 nb_taps = (u32) ceil(2*support) + 2;
+	if (nb_taps > src_size) nb_taps = src_size;
+
+	if ((k->src_size==src_size) && (k->dst_size==dst_size) && (k->type==type)) return GF_OK;
+	k->offsets = gf_realloc(k->offsets, sizeof(u32) * dst_size);
+	k->coefs = gf_realloc(k->coefs, sizeof(s16) * dst_size * nb_taps);
+	w = gf_malloc(sizeof(Double) * nb_taps);
+	if (!k->offsets || !k->coefs || !w) {
+		if (w) gf_free(w);
+		k->src_size = 0;
+		return GF_OUT_OF_MEM;
+	}
+	k->src_size = src_size;
+	k->dst_size = dst_size;
+	k->nb_taps = nb_taps;
+	k->type = type;
+
+	for (i=0; i<dst_size; i++) {
+		s32 j, start, first, last;
+		u32 t, max_t=0;
+		s32 isum=0;
+		Double sum=0;
+		Double center = (i + 0.5) * scale - 0.5;
+		first = (s32) floor(center - support);
+		last = (s32) ceil(center + support);
+		start = first;
+		if (start + (s32) nb_taps > (s32) src_size) start = src_size - nb_taps;
+		if (start<0) start = 0;
+
+		memset(w, 0, sizeof(Double)*nb_taps);
+		for (j=first; j<=last; j++) {
+			Double x = fabs((j - center) / fscale);
+			Double v;
+			s32 idx = (j<0) ? 0 : ((j >= (s32) src_size) ? (s32) src_size-1 : j);
+			if (type==EVGS_KERNEL_BICUBIC) {
+				//Catmull-Rom
+				if (x<1) v = (1.5*x - 2.5)*x*x + 1;
+				else if (x<2) v = ((-0.5*x + 2.5)*x - 4)*x + 2;
+				else v = 0;
+			} else {
+				//Lanczos, 3 lobes
+				if (x<1e-8) v = 1;
+				else if (x<3) v = 3 * sin(GF_PI*x) * sin(GF_PI*x/3) / (GF_PI*GF_PI*x*x);
+				else v = 0;
+			}
+			idx -= start;
+			//outside window weights are null
+			if ((idx<0) || (idx >= (s32) nb_taps)) continue;
+			w[idx] += v;
+			sum += v;
+		}
+		if (sum==0) sum = 1;
+		k->offsets[i] = start;
+		for (t=0; t<nb_taps; t++) {
+			s16 c = (s16) floor(w[t] * (1<<EVGS_COEF_BITS) / sum + 0.5);
+			k->coefs[i*nb_taps + t] = c;
+			isum += c;
+			if (abs(c) > abs(k->coefs[i*nb_taps + max_t])) max_t = t;
+		}
+		//make sure coefficients sum to unity
+		k->coefs[i*nb_taps + max_t] += (1<<EVGS_COEF_BITS) - isum;
+	}
+	gf_free(w);
+	return GF_OK;
+}
+
+static void evgs_kernel_reset(EVGSKernel *k)
+{
+	if (k->offsets) gf_free(k->offsets);
+	if (k->coefs) gf_free(k->coefs);
+	memset(k, 0, sizeof(EVGSKernel));
+}
+
+static void evgs_scale_rows_h(const EVGSKernel *kh, const u8 *src, u32 src_stride, s16 *tmp, u32 nb_rows)
+{
+	u32 x, y, t;
+	for (y=0; y<nb_rows; y++) {
+		const s16 *coefs = kh->coefs;
+		for (x=0; x<kh->dst_size; x++) {
+			const u8 *s = src + kh->offsets[x];
+			s32 sum = 0;
+			for (t=0; t<kh->nb_taps; t++)
+				sum += coefs[t] * s[t];
+			coefs += kh->nb_taps;
+			sum = (sum + (1<<(EVGS_COEF_BITS-EVGS_TMP_BITS-1))) >> (EVGS_COEF_BITS-EVGS_TMP_BITS);
+			//intermediate overshoot is kept, only clamp to a safe range for the vertical pass
+			if (sum < -(1<<(8+EVGS_TMP_BITS-1))) sum = -(1<<(8+EVGS_TMP_BITS-1));
+			else if (sum > (3<<(8+EVGS_TMP_BITS-1))) sum = (3<<(8+EVGS_TMP_BITS-1));
+			tmp[x] = (s16) sum;
+		}
+		src += src_stride;
+		tmp += kh->dst_size;
+	}
+}
+
+#define EVGS_V_SHIFT	(EVGS_COEF_BITS+EVGS_TMP_BITS)
+
+static void evgs_scale_row_v(const s16 *coefs, u32 nb_taps, const s16 *tmp, u32 width, u8 *dst)
+{
+	u32 x=0, t;
+#if defined(EVGS_HAS_SSE2)
+	const __m128i round = _mm_set1_epi32(1<<(EVGS_V_SHIFT-1));
+	for (; x+8<=width; x+=8) {
+		__m128i acc_lo = round, acc_hi = round;
+		for (t=0; t<nb_taps; t+=2) {
+			__m128i r0 = _mm_loadu_si128((const __m128i *) (tmp + t*width + x));
+			__m128i r1 = (t+1<nb_taps) ? _mm_loadu_si128((const __m128i *) (tmp + (t+1)*width + x)) : _mm_setzero_si128();
+			u16 c1 = (t+1<nb_taps) ? (u16) coefs[t+1] : 0;
+			__m128i c = _mm_set1_epi32( (s32) ( ((u32) c1 << 16) | (u16) coefs[t]) );
+			acc_lo = _mm_add_epi32(acc_lo, _mm_madd_epi16(_mm_unpacklo_epi16(r0, r1), c));
+			acc_hi = _mm_add_epi32(acc_hi, _mm_madd_epi16(_mm_unpackhi_epi16(r0, r1), c));
+		}
+		acc_lo = _mm_srai_epi32(acc_lo, EVGS_V_SHIFT);
+		acc_hi = _mm_srai_epi32(acc_hi, EVGS_V_SHIFT);
+		_mm_storel_epi64((__m128i *) (dst+x), _mm_packus_epi16(_mm_packs_epi32(acc_lo, acc_hi), _mm_setzero_si128()));
+	}
+#elif defined(EVGS_HAS_NEON)
+	for (; x+8<=width; x+=8) {
+		int32x4_t acc_lo = vdupq_n_s32(1<<(EVGS_V_SHIFT-1));
+		int32x4_t acc_hi = acc_lo;
+		for (t=0; t<nb_taps; t++) {
+			int16x8_t r = vld1q_s16(tmp + t*width + x);
+			acc_lo = vmlal_n_s16(acc_lo, vget_low_s16(r), coefs[t]);
+			acc_hi = vmlal_n_s16(acc_hi, vget_high_s16(r), coefs[t]);
+		}
+		int16x8_t res = vcombine_s16(vshrn_n_s32(acc_lo, EVGS_V_SHIFT), vshrn_n_s32(acc_hi, EVGS_V_SHIFT));
+		vst1_u8(dst+x, vqmovun_s16(res));
+	}
+#endif
+	for (; x<width; x++) {
+		s32 sum = 1<<(EVGS_V_SHIFT-1);
+		for (t=0; t<nb_taps; t++)
+			sum += coefs[t] * tmp[t*width + x];
+		sum >>= EVGS_V_SHIFT;
+		dst[x] = (sum<0) ? 0 : ((sum>255) ? 255 : (u8) sum);
+	}
+}
+
+//rescale rows [y_start, y_end[ of a plane, using the band temporary buffer
+static GF_Err evgs_scale_band(EVGSBand *wk, const EVGSPlaneJob *job, u32 y_start, u32 y_end)
+{
+	u32 y, sy_start, sy_end, size;
+	const EVGSKernel *kh = job->kh;
+	const EVGSKernel *kv = job->kv;
+	if (y_start>=y_end) return GF_OK;
+
+	sy_start = kv->offsets[y_start];
+	sy_end = kv->offsets[y_end-1] + kv->nb_taps;
+	size = sizeof(s16) * kh->dst_size * (sy_end - sy_start);
+	if (wk->tmp_alloc < size) {
+		wk->tmp = gf_realloc(wk->tmp, size);
+		if (!wk->tmp) {
+			wk->tmp_alloc = 0;
+			return GF_OUT_OF_MEM;
+		}
+		wk->tmp_alloc = size;
+	}
+	evgs_scale_rows_h(kh, job->src + sy_start * job->src_stride, job->src_stride, wk->tmp, sy_end - sy_start);
+
+	for (y=y_start; y<y_end; y++) {
+		evgs_scale_row_v(kv->coefs + y*kv->nb_taps, kv->nb_taps, wk->tmp + (kv->offsets[y] - sy_start) * kh->dst_size, kh->dst_size, job->dst + y*job->dst_stride);
+	}
+	return GF_OK;
+}
+
+static void evgs_run_band(void *udta, u32 band)
+{
+	EVGScaleCtx *ctx = (EVGScaleCtx *) udta;
+	u32 y_start = band * ctx->job.kv->dst_size / ctx->nb_bands;
+	u32 y_end = (band+1) * ctx->job.kv->dst_size / ctx->nb_bands;
+	if (evgs_scale_band(&ctx->bands[band], &ctx->job, y_start, y_end))
+		ctx->job_error = GF_OUT_OF_MEM;
+}
+
+static void evgs_setup_bands(EVGScaleCtx *ctx)
+{
+	u32 nb_threads;
+	s32 nbth = (s32) ctx->nbth;
+	if (ctx->bands) return;
+	//one band per session thread, at most nbth
+	nb_threads = gf_filter_get_num_threads(ctx->filter);
+	if ((nbth>=0) && ((u32) nbth < nb_threads)) nb_threads = MAX(nbth, 1);
+	ctx->bands = gf_malloc(sizeof(EVGSBand) * nb_threads);
+	if (!ctx->bands) return;
+	memset(ctx->bands, 0, sizeof(EVGSBand) * nb_threads);
+	ctx->max_bands = nb_threads;
+}
+
+static GF_Err evgs_scale_plane(EVGScaleCtx *ctx, const EVGSKernel *kh, const EVGSKernel *kv, const u8 *src, u32 src_stride, u8 *dst, u32 dst_stride)
+{
+	GF_Err e;
+	ctx->job.kh = kh;
+	ctx->job.kv = kv;
+	ctx->job.src = src;
+	ctx->job.src_stride = src_stride;
+	ctx->job.dst = dst;
+	ctx->job.dst_stride = dst_stride;
+	ctx->job_error = GF_OK;
+	//bands of at least 16 rows
+	ctx->nb_bands = MIN(ctx->max_bands, MAX(kv->dst_size / 16, 1));
+
+	e = gf_filter_run_parallel(ctx->filter, ctx->nb_bands, evgs_run_band, ctx);
+	if (e) return e;
+	return ctx->job_error;
+}
+
+static void evgs_del_bands(EVGScaleCtx *ctx)
+{
+	u32 i;
+	if (!ctx->bands) return;
+	for (i=0; i<ctx->max_bands; i++) {
+		if (ctx->bands[i].tmp) gf_free(ctx->bands[i].tmp);
+	}
+	gf_free(ctx->bands);
+	ctx->bands = NULL;
+	ctx->max_bands = 0;
+}
+
+static Bool evgs_pp_format_ok(u32 pfmt, u32 *uv_shift_w, u32 *uv_shift_h)
+{
+	*uv_shift_w = *uv_shift_h = 0;
+	switch (pfmt) {
+	case GF_PIXEL_GREYSCALE:
+	case GF_PIXEL_YUV444:
+		return GF_TRUE;
+	case GF_PIXEL_YUV:
+	case GF_PIXEL_YVU:
+		*uv_shift_h = 1;
+		//fallthrough
+	case GF_PIXEL_YUV422:
+		*uv_shift_w = 1;
+		return GF_TRUE;
+	default:
+		break;
+	}
+	return GF_FALSE;
+}
+
+static GF_Err evgs_setup_level(EVGScaleCtx *ctx, EVGSLevel *lev)
+{
+	GF_Err e;
+	u32 sw, sh, uv_w, uv_h, src_uv_w, src_uv_h;
+	u32 kernel = ctx->kernel ? ctx->kernel : EVGS_KERNEL_BICUBIC;
+	lev->stride = lev->stride_uv = 0;
+	if (!gf_pixel_get_size_info(ctx->pp_fmt, lev->w, lev->h, &lev->size, &lev->stride, &lev->stride_uv, NULL, &lev->uv_h))
+		return GF_NOT_SUPPORTED;
+
+	//pick the smallest level already computed and larger than this one, or the input frame
+	lev->src_level = -1;
+	sw = ctx->pp_w;
+	sh = ctx->pp_h;
+	if (ctx->pyramid) {
+		u32 i;
+		for (i=0; i<ctx->nb_active; i++) {
+			EVGSLevel *prev = &ctx->levels[ctx->order[i]];
+			if (prev == lev) break;
+			if ((prev->w >= lev->w) && (prev->h >= lev->h) && (prev->w * prev->h <= sw * sh)) {
+				lev->src_level = ctx->order[i];
+				sw = prev->w;
+				sh = prev->h;
+			}
+		}
+	}
+	uv_w = (lev->w + ctx->uv_shift_w) >> ctx->uv_shift_w;
+	uv_h = (lev->h + ctx->uv_shift_h) >> ctx->uv_shift_h;
+	src_uv_w = (sw + ctx->uv_shift_w) >> ctx->uv_shift_w;
+	src_uv_h = (sh + ctx->uv_shift_h) >> ctx->uv_shift_h;
+	e = evgs_kernel_setup(&lev->kh[0], kernel, sw, lev->w);
+	if (!e) e = evgs_kernel_setup(&lev->kv[0], kernel, sh, lev->h);
+	if (!e) e = evgs_kernel_setup(&lev->kh[1], kernel, src_uv_w, uv_w);
+	if (!e) e = evgs_kernel_setup(&lev->kv[1], kernel, src_uv_h, uv_h);
+	return e;
+}
+
+static GF_Err evgs_process_level(EVGScaleCtx *ctx, EVGSLevel *lev, const u8 *planes[3], u32 strides[3])
+{
+	GF_Err e;
+	u32 i, nb_planes = (ctx->pp_fmt==GF_PIXEL_GREYSCALE) ? 1 : 3;
+	const u8 *src[3];
+	u32 src_stride[3];
+	u8 *output;
+
+	lev->pck = gf_filter_pck_new_alloc(lev->opid, lev->size, &output);
+	if (!lev->pck) return GF_OUT_OF_MEM;
+	lev->planes[0] = output;
+	lev->planes[1] = output + lev->stride * lev->h;
+	lev->planes[2] = lev->planes[1] + lev->stride_uv * lev->uv_h;
+
+	for (i=0; i<nb_planes; i++) {
+		if (lev->src_level>=0) {
+			EVGSLevel *prev = &ctx->levels[lev->src_level];
+			src[i] = prev->planes[i];
+			src_stride[i] = i ? prev->stride_uv : prev->stride;
+		} else {
+			src[i] = planes[i];
+			src_stride[i] = strides[i];
+		}
+		e = evgs_scale_plane(ctx, &lev->kh[i ? 1 : 0], &lev->kv[i ? 1 : 0], src[i], src_stride[i], lev->planes[i], i ? lev->stride_uv : lev->stride);
+		if (e) return e;
+	}
+	return GF_OK;
+}
+
+static GF_Err evgs_process_levels(EVGScaleCtx *ctx, GF_FilterPacket *pck)
+{
+	GF_Err e = GF_OK;
+	u32 i, isize;
+	const u8 *planes[3];
+	u32 strides[3];
+	const u8 *data = gf_filter_pck_get_data(pck, &isize);
+
+	if (data) {
+		if (isize < ctx->pp_size) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[EVGS] Mismatch in source size, expected %d got %d - stride issue ?\n", ctx->pp_size, isize));
+			return GF_NOT_SUPPORTED;
+		}
+		planes[0] = data;
+		planes[1] = data + ctx->pp_stride * ctx->pp_h;
+		planes[2] = planes[1] + ctx->pp_stride_uv * ctx->pp_uv_h;
+		strides[0] = ctx->pp_stride;
+		strides[1] = strides[2] = ctx->pp_stride_uv;
+	} else {
+		GF_FilterFrameInterface *frame_ifce = gf_filter_pck_get_frame_interface(pck);
+		if (!frame_ifce || !frame_ifce->get_plane) return GF_NOT_SUPPORTED;
+		for (i=0; i<((ctx->pp_fmt==GF_PIXEL_GREYSCALE) ? 1 : 3); i++) {
+			e = frame_ifce->get_plane(frame_ifce, i, &planes[i], &strides[i]);
+			if (e) return e;
+		}
+	}
+	evgs_setup_bands(ctx);
+	if (!ctx->bands) return GF_OUT_OF_MEM;
+
+	for (i=0; i<ctx->nb_active; i++) {
+		e = evgs_process_level(ctx, &ctx->levels[ctx->order[i]], planes, strides);
+		if (e) break;
+	}
+	for (i=0; i<ctx->nb_active; i++) {
+		EVGSLevel *lev = &ctx->levels[ctx->order[i]];
+		if (!lev->pck) continue;
+		if (e) {
+			gf_filter_pck_discard(lev->pck);
+		} else {
+			gf_filter_pck_merge_properties(pck, lev->pck);
+			gf_filter_pck_send(lev->pck);
+		}
+		lev->pck = NULL;
+	}
+	if (e) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[EVGS] Failed to rescale frame: %s\n", gf_error_to_string(e) ));
+	}
+	return e;
+}
+
 static GF_Err evgs_process(GF_Filter *filter)
 {
 	const char *data;
@@ -79,12 +520,24 @@ static GF_Err evgs_process(GF_Filter *filter)
 
 	if (!pck) {
 		if (gf_filter_pid_is_eos(ctx->ipid)) {
+			u32 i;
 			gf_filter_pid_set_eos(ctx->opid);
+			for (i=1; i<ctx->nb_levels; i++) {
+				if (ctx->levels[i].opid) gf_filter_pid_set_eos(ctx->levels[i].opid);
+			}
 			return GF_EOS;
 		}
 		return GF_OK;
 	}
 
+	if (ctx->nb_active) {
+		GF_Err e = evgs_process_levels(ctx, pck);
+		if (e || ctx->use_pp) {
+			gf_filter_pid_drop_packet(ctx->ipid);
+			return e;
+		}
+	}
+
 	if (ctx->passthrough) {
 		gf_filter_pck_forward(pck, ctx->opid);
 		gf_filter_pid_drop_packet(ctx->ipid);
@@ -173,6 +626,100 @@ static GF_Err evgs_process(GF_Filter *filter)
 	return e;
 }
 
+static GF_Err evgs_setup_levels(GF_Filter *filter, EVGScaleCtx *ctx, u32 w, u32 h, u32 pfmt, u32 stride, u32 stride_uv, GF_Fraction sar)
+{
+	GF_Err e;
+	u32 i, j;
+	ctx->use_pp = GF_FALSE;
+	ctx->nb_active = 0;
+	if (!ctx->kernel && !ctx->olist.nb_items) return GF_OK;
+
+	if (!evgs_pp_format_ok(pfmt, &ctx->uv_shift_w, &ctx->uv_shift_h)) {
+		if (ctx->olist.nb_items) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[EVGS] Multiple outputs not supported for pixel format %s\n", gf_pixel_fmt_name(pfmt) ));
+			return GF_NOT_SUPPORTED;
+		}
+		GF_LOG(GF_LOG_INFO, GF_LOG_MEDIA, ("[EVGS] Kernel not supported for pixel format %s, using EVG rasterizer\n", gf_pixel_fmt_name(pfmt) ));
+		return GF_OK;
+	}
+	ctx->pp_w = w;
+	ctx->pp_h = h;
+	ctx->pp_fmt = pfmt;
+	ctx->pp_stride = stride;
+	ctx->pp_stride_uv = stride_uv;
+	if (!gf_pixel_get_size_info(pfmt, w, h, &ctx->pp_size, &ctx->pp_stride, &ctx->pp_stride_uv, NULL, &ctx->pp_uv_h))
+		return GF_NOT_SUPPORTED;
+
+	if (!ctx->levels) {
+		ctx->nb_levels = ctx->olist.nb_items + 1;
+		ctx->levels = gf_malloc(sizeof(EVGSLevel) * ctx->nb_levels);
+		ctx->order = gf_malloc(sizeof(u32) * ctx->nb_levels);
+		if (!ctx->levels || !ctx->order) return GF_OUT_OF_MEM;
+		memset(ctx->levels, 0, sizeof(EVGSLevel) * ctx->nb_levels);
+	}
+	//main output uses the polyphase scaler if same pixel format and no padding
+	if (ctx->kernel && !ctx->passthrough && (ctx->ofmt==pfmt) && !ctx->offset_w && !ctx->offset_h) {
+		ctx->use_pp = GF_TRUE;
+		ctx->levels[0].opid = ctx->opid;
+		ctx->levels[0].w = ctx->o_w;
+		ctx->levels[0].h = ctx->o_h;
+		ctx->order[ctx->nb_active++] = 0;
+	}
+	for (i=1; i<ctx->nb_levels; i++) {
+		EVGSLevel *lev = &ctx->levels[i];
+		GF_PropVec2i *size = &ctx->olist.vals[i-1];
+		lev->w = size->x ? size->x : (size->y * w / h);
+		lev->h = size->y ? size->y : (size->x * h / w);
+		if (!lev->w || !lev->h) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[EVGS] Invalid output size %dx%d\n", size->x, size->y));
+			return GF_BAD_PARAM;
+		}
+		if (!lev->opid) {
+			lev->opid = gf_filter_pid_new(filter);
+			if (!lev->opid) return GF_OUT_OF_MEM;
+		}
+		ctx->order[ctx->nb_active++] = i;
+	}
+	//process largest outputs first so that they can be used as source for smaller ones
+	for (i=1; i<ctx->nb_active; i++) {
+		u32 idx = ctx->order[i];
+		u32 area = ctx->levels[idx].w * ctx->levels[idx].h;
+		j = i;
+		while (j && (ctx->levels[ctx->order[j-1]].w * ctx->levels[ctx->order[j-1]].h < area)) {
+			ctx->order[j] = ctx->order[j-1];
+			j--;
+		}
+		ctx->order[j] = idx;
+	}
+
+	for (i=0; i<ctx->nb_active; i++) {
+		EVGSLevel *lev = &ctx->levels[ctx->order[i]];
+		e = evgs_setup_level(ctx, lev);
+		if (e) return e;
+
+		GF_LOG(GF_LOG_INFO, GF_LOG_MEDIA, ("[EVGS] Setup %s rescaler from %dx%d to %dx%d fmt %s\n", (ctx->kernel==EVGS_KERNEL_LANCZOS) ? "lanczos" : "bicubic",
+			(lev->src_level>=0) ? ctx->levels[lev->src_level].w : w, (lev->src_level>=0) ? ctx->levels[lev->src_level].h : h,
+			lev->w, lev->h, gf_pixel_fmt_name(pfmt)));
+
+		//main output properties are set by caller
+		if (!ctx->order[i]) continue;
+
+		gf_filter_pid_copy_properties(lev->opid, ctx->ipid);
+		gf_filter_pid_set_property(lev->opid, GF_PROP_PID_WIDTH, &PROP_UINT(lev->w));
+		gf_filter_pid_set_property(lev->opid, GF_PROP_PID_HEIGHT, &PROP_UINT(lev->h));
+		gf_filter_pid_set_property(lev->opid, GF_PROP_PID_STRIDE, &PROP_UINT(lev->stride));
+		gf_filter_pid_set_property(lev->opid, GF_PROP_PID_STRIDE_UV, lev->stride_uv ? &PROP_UINT(lev->stride_uv) : NULL);
+		gf_filter_pid_set_property(lev->opid, GF_PROP_PID_CODECID, &PROP_UINT(GF_CODECID_RAW));
+		gf_filter_pid_set_property(lev->opid, GF_PROP_PID_PIXFMT, &PROP_UINT(pfmt));
+		gf_filter_pid_set_property(lev->opid, GF_PROP_PID_SAR, sar.num ? &PROP_FRAC(sar) : NULL);
+		gf_filter_pid_set_property(lev->opid, GF_PROP_PID_CLAP_X, NULL);
+		gf_filter_pid_set_property(lev->opid, GF_PROP_PID_CLAP_Y, NULL);
+		gf_filter_pid_set_property(lev->opid, GF_PROP_PID_CLAP_W, NULL);
+		gf_filter_pid_set_property(lev->opid, GF_PROP_PID_CLAP_H, NULL);
+	}
+	return GF_OK;
+}
+
 static GF_Err evgs_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
 {
 	const GF_PropertyValue *p;
@@ -182,10 +729,16 @@ static GF_Err evgs_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_r
 	EVGScaleCtx *ctx = gf_filter_get_udta(filter);
 
 	if (is_remove) {
+		u32 i;
 		if (ctx->opid) {
 			gf_filter_pid_remove(ctx->opid);
 			ctx->opid = NULL;
 		}
+		for (i=1; i<ctx->nb_levels; i++) {
+			if (ctx->levels[i].opid) gf_filter_pid_remove(ctx->levels[i].opid);
+			ctx->levels[i].opid = NULL;
+		}
+		ctx->nb_active = 0;
 		return GF_OK;
 	}
 	if (! gf_filter_pid_check_caps(pid))
@@ -385,6 +938,9 @@ static GF_Err evgs_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_r
 		GF_LOG(GF_LOG_INFO, GF_LOG_MEDIA, ("[EVGS] Setup rescaler from %dx%d fmt %s to %dx%d fmt %s\n", w, h, gf_pixel_fmt_name(ofmt), ctx->o_w, ctx->o_h, gf_pixel_fmt_name(ctx->ofmt)));
 	}
 
+	GF_Err e = evgs_setup_levels(filter, ctx, w, h, ofmt, stride, stride_uv, sar);
+	if (e) return e;
+
 	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_WIDTH, &PROP_UINT(ctx->o_w));
 	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_HEIGHT, &PROP_UINT(ctx->o_h));
 	gf_filter_pid_set_property(ctx->opid, GF_PROP_PID_STRIDE, &PROP_UINT(ctx->o_stride));
@@ -412,6 +968,7 @@ static GF_Err evgs_initialize(GF_Filter *filter)
 {
 	EVGScaleCtx *ctx = gf_filter_get_udta(filter);
 
+	ctx->filter = filter;
 	ctx->surf = gf_evg_surface_new(GF_TRUE);
 	if (!ctx->surf) return GF_OUT_OF_MEM;
 
@@ -437,6 +994,19 @@ static void evgs_finalize(GF_Filter *filter)
 	gf_evg_surface_delete(ctx->surf);
 	gf_evg_stencil_delete(ctx->tx);
 	gf_path_del(ctx->path);
+
+	evgs_del_bands(ctx);
+	if (ctx->levels) {
+		u32 i;
+		for (i=0; i<ctx->nb_levels; i++) {
+			evgs_kernel_reset(&ctx->levels[i].kh[0]);
+			evgs_kernel_reset(&ctx->levels[i].kh[1]);
+			evgs_kernel_reset(&ctx->levels[i].kv[0]);
+			evgs_kernel_reset(&ctx->levels[i].kv[1]);
+		}
+		gf_free(ctx->levels);
+	}
+	if (ctx->order) gf_free(ctx->order);
 	return;
 }
 
@@ -474,6 +1044,12 @@ static GF_FilterArgs EVGSArgs[] =
 	{ OFFS(osar), "force output pixel aspect ratio", GF_PROP_FRACTION, "0/1", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(nbth), "number of threads to use, -1 means all cores", GF_PROP_SINT, "-1", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(hq), "use bilinear interpolation instead of closest pixel", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(kernel), "scaling kernel for planar 8-bit YUV and grey formats\n"
+	"- evg: use EVG rasterizer, see [-hq]()\n"
+	"- bicubic: separable bicubic filter\n"
+	"- lanczos: separable Lanczos filter (3 lobes)", GF_PROP_UINT, "evg", "evg|bicubic|lanczos", GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(olist), "additional output sizes, each creating a new output PID", GF_PROP_VEC2I_LIST, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(pyramid), "compute smaller outputs from larger ones rather than from source", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_EXPERT},
 
 	{0}
 };
@@ -511,6 +1087,18 @@ GF_FilterRegister EVGSRegister = {
 	"When sample aspect ratio is kept, the filter will:\n"
 	"- center the rescaled input frame on the output frame\n"
 	"- fill extra pixels with [-padclr]()\n"
+	"\n"
+	"## Polyphase scaling\n"
+	"For planar 8-bit YUV (420, 422, 444) and grey sources, [-kernel]() selects a separable bicubic or Lanczos scaler. Output rows are processed in bands by the session threads (see [-threads](CORE)), limited to [-nbth]() unless -1.\n"
+	"This scaler is only used for the main output if no pixel format conversion and no padding is required.\n"
+	"\n"
+	"## Multiple outputs\n"
+	"The filter can produce additional output PIDs at different sizes using [-olist](), for example to feed an encoding ladder from a single filter.\n"
+	"Each size is given as `WxH`, a value of 0 for width (resp. height) means the width (resp. height) is computed from source aspect ratio.\n"
+	"Additional outputs use the source pixel format, and are produced with the polyphase scaler (bicubic if [-kernel=evg]()).\n"
+	"When [-pyramid]() is set, smaller outputs are computed from the smallest already computed output larger than them.\n"
+	"EX gpac -i src.mp4 evgs:osize=1920x1080:kernel=lanczos:olist=1280x720,640x360 -o dump_$Width$.yuv\n"
+	"This will produce 3 outputs at 1080p, 720p and 360p, the 360p output being computed from the 720p one.\n"
 	)
 	.private_size = sizeof(EVGScaleCtx),
 	.args = EVGSArgs,
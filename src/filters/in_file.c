@@ -52,6 +52,7 @@ typedef struct
 	u32 block_size;
 	GF_PropData pck;
 	GF_Fraction64 range;
+	u32 aio;
 
 	//only one output pid declared
 	GF_FilterPid *pid;
@@ -59,6 +60,13 @@ typedef struct
 	FILE *file;
 #ifdef GPAC_HAS_FD
 	int fd;
+	//read-ahead blocks, aio_count blocks queued from aio_head at consecutive offsets
+	GF_AsyncIO *aio_eng;
+	u64 *aio_offsets;
+	u32 aio_head, aio_count, aio_bsize;
+	u64 aio_next;
+	//reads ahead do not move the descriptor position, set before synchronous reads
+	Bool fd_resync;
 #endif
 	u64 file_size;
 	u64 file_pos, end_pos;
@@ -73,6 +81,71 @@ typedef struct
 } GF_FileInCtx;
 
 
+#ifdef GPAC_HAS_FD
+static void filein_aio_reset(GF_FileInCtx *ctx)
+{
+	u32 i;
+	if (!ctx->aio_eng) return;
+	//wait for reads in flight, their data is discarded
+	for (i=0; i<ctx->aio; i++)
+		gf_aio_wait(ctx->aio_eng, i, GF_TRUE, NULL);
+	ctx->aio_count = 0;
+}
+
+static GF_Err filein_aio_read(GF_FileInCtx *ctx, u64 end, char **data, u32 *nb_read)
+{
+	GF_Err e;
+	u32 done;
+
+	//first use or block size changed (seek hint)
+	if (!ctx->aio_eng || (ctx->aio_bsize < ctx->block_size)) {
+		gf_aio_del(ctx->aio_eng);
+		ctx->aio_count = 0;
+		ctx->aio_eng = gf_aio_new(ctx->aio, ctx->block_size+1);
+		if (!ctx->aio_eng) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[FileIn] Asynchronous I/O not available, using synchronous reads\n"));
+			ctx->aio = 0;
+			return GF_NOT_SUPPORTED;
+		}
+		ctx->aio_bsize = ctx->block_size;
+		if (!ctx->aio_offsets) ctx->aio_offsets = gf_malloc(sizeof(u64) * ctx->aio);
+		if (!ctx->aio_offsets) return GF_OUT_OF_MEM;
+	}
+	//read-ahead does not start at current position (seek, short read), restart it
+	if (ctx->aio_count && (ctx->aio_offsets[ctx->aio_head] != ctx->file_pos))
+		filein_aio_reset(ctx);
+	if (!ctx->aio_count)
+		ctx->aio_next = ctx->file_pos;
+
+	//queue reads on all free blocks and submit them at once
+	while ((ctx->aio_count < ctx->aio) && (ctx->aio_next < end)) {
+		u32 idx = (ctx->aio_head + ctx->aio_count) % ctx->aio;
+		u32 size = ctx->block_size;
+		if (end - ctx->aio_next < size) size = (u32) (end - ctx->aio_next);
+		e = gf_aio_queue(ctx->aio_eng, idx, ctx->fd, GF_FALSE, ctx->aio_next, size);
+		if (e) return e;
+		ctx->aio_offsets[idx] = ctx->aio_next;
+		ctx->aio_next += size;
+		ctx->aio_count++;
+	}
+	e = gf_aio_submit(ctx->aio_eng);
+	if (e) return e;
+
+	e = gf_aio_wait(ctx->aio_eng, ctx->aio_head, GF_FALSE, &done);
+	if (e==GF_NOT_READY) return e;
+	if (e) {
+		filein_aio_reset(ctx);
+		return e;
+	}
+	*data = (char *) gf_aio_block(ctx->aio_eng, ctx->aio_head);
+	*nb_read = done;
+	ctx->aio_head = (ctx->aio_head + 1) % ctx->aio;
+	ctx->aio_count--;
+	ctx->fd_resync = GF_TRUE;
+	return GF_OK;
+}
+#endif
+
 static GF_Err filein_initialize_ex(GF_Filter *filter)
 {
 	GF_FileInCtx *ctx = (GF_FileInCtx *) gf_filter_get_udta(filter);
@@ -156,6 +229,7 @@ static GF_Err filein_initialize_ex(GF_Filter *filter)
 
 #ifdef GPAC_HAS_FD
 		if (ctx->fd>=0) {
+			filein_aio_reset(ctx);
 			close(ctx->fd);
 			ctx->fd = -1;
 		}
@@ -231,6 +305,7 @@ static GF_Err filein_initialize_ex(GF_Filter *filter)
 #ifdef GPAC_HAS_FD
 	if (ctx->fd>=0) {
 		lseek(ctx->fd, ctx->file_pos, SEEK_SET);
+		ctx->fd_resync = GF_FALSE;
 	} else
 #endif
 		gf_fseek(ctx->file, ctx->file_pos, SEEK_SET);
@@ -265,6 +340,8 @@ static void filein_finalize(GF_Filter *filter)
 
 	if (ctx->file) gf_fclose(ctx->file);
 #ifdef GPAC_HAS_FD
+	if (ctx->aio_eng) gf_aio_del(ctx->aio_eng);
+	if (ctx->aio_offsets) gf_free(ctx->aio_offsets);
 	if (ctx->fd>=0) close(ctx->fd);
 #endif
 	if (ctx->block) gf_free(ctx->block);
@@ -350,6 +427,7 @@ static Bool filein_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 		if (ctx->fd>=0) {
 			res = lseek(ctx->fd, evt->seek.start_offset, SEEK_SET);
 			if (res>=0) res = 0;
+			ctx->fd_resync = GF_FALSE;
 		} else
 #endif
 			res = gf_fseek(ctx->file, evt->seek.start_offset, SEEK_SET);
@@ -392,6 +470,7 @@ static Bool filein_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 		if (ctx->is_end && !strcmp(evt->file_del.url, "__gpac_self__")) {
 #ifdef GPAC_HAS_FD
 			if (ctx->fd>=0) {
+				filein_aio_reset(ctx);
 				close(ctx->fd);
 				ctx->fd = -1;
 			}
@@ -424,6 +503,7 @@ static GF_Err filein_process(GF_Filter *filter)
 	GF_Err e;
 	u32 nb_read, to_read;
 	u64 lto_read;
+	char *data;
 	GF_FilterPacket *pck;
 	GF_FileInCtx *ctx = (GF_FileInCtx *) gf_filter_get_udta(filter);
 
@@ -533,10 +613,15 @@ static GF_Err filein_process(GF_Filter *filter)
 	else
 		to_read = (u32) lto_read;
 
+	data = ctx->block;
 	//force eof flush
 	if (!to_read) {
 #ifdef GPAC_HAS_FD
 		if (ctx->fd>=0) {
+			if (ctx->fd_resync) {
+				lseek(ctx->fd, ctx->file_pos, SEEK_SET);
+				ctx->fd_resync = GF_FALSE;
+			}
 			nb_read = (u32) read(ctx->fd, ctx->block, 1);
 			if (nb_read==0xFFFFFFFF) nb_read=0;
 		} else
@@ -545,7 +630,24 @@ static GF_Err filein_process(GF_Filter *filter)
 		if (nb_read) to_read=1;
 	} else {
 #ifdef GPAC_HAS_FD
-		if (ctx->fd>=0) {
+		e = GF_NOT_SUPPORTED;
+		//read-ahead once the pid is setup
+		if (ctx->aio && (ctx->fd>=0) && ctx->pid && !ctx->do_reconfigure) {
+			e = filein_aio_read(ctx, ctx->file_pos + lto_read, &data, &nb_read);
+			if (e==GF_NOT_READY) {
+				gf_filter_ask_rt_reschedule(filter, 1000);
+				return GF_OK;
+			}
+			if (e && (e!=GF_NOT_SUPPORTED)) return e;
+		}
+		if (e==GF_OK) {
+			//block was read ahead
+		} else if (ctx->fd>=0) {
+			//synchronous read after read-ahead, restore descriptor position
+			if (ctx->fd_resync) {
+				lseek(ctx->fd, ctx->file_pos, SEEK_SET);
+				ctx->fd_resync = GF_FALSE;
+			}
 			nb_read = (u32) read(ctx->fd, ctx->block, to_read);
 			if (nb_read==0xFFFFFFFF) return GF_IO_ERR;
 		} else
@@ -553,7 +655,7 @@ static GF_Err filein_process(GF_Filter *filter)
 			nb_read = (u32) gf_fread(ctx->block, to_read, ctx->file);
 	}
 
-	ctx->block[nb_read] = 0;
+	data[nb_read] = 0;
 	if (!ctx->pid || ctx->do_reconfigure) {
 		GF_FileIOCacheState cstate;
 		u64 fsize;
@@ -681,7 +783,7 @@ static GF_Err filein_process(GF_Filter *filter)
 	}
 
 	if (nb_read) {
-		pck = gf_filter_pck_new_shared(ctx->pid, ctx->block, nb_read, filein_pck_destructor);
+		pck = gf_filter_pck_new_shared(ctx->pid, data, nb_read, filein_pck_destructor);
 		if (!pck) return GF_OUT_OF_MEM;
 
 		gf_filter_pck_set_byte_offset(pck, ctx->file_pos);
@@ -720,6 +822,7 @@ static const GF_FilterArgs FileInArgs[] =
 	{ OFFS(ext), "override file extension", GF_PROP_NAME, NULL, NULL, 0},
 	{ OFFS(mime), "set file mime type", GF_PROP_NAME, NULL, NULL, 0},
 	{ OFFS(pck), "data to use instead of file", GF_PROP_DATA, NULL, NULL, 0},
+	{ OFFS(aio), "read ahead asynchronously using the given number of blocks, 0 disables read-ahead (Linux io_uring only)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -733,6 +836,7 @@ GF_FilterRegister FileInRegister = {
 	GF_FS_SET_DESCRIPTION("File input")
 	GF_FS_SET_HELP("This filter dispatch raw blocks from input file into a filter chain.\n"
 	"Block size can be adjusted using [-block_size]().\n"
+	"On Linux, blocks can be read ahead asynchronously using io_uring with [-aio](), in which case a larger [-block_size]() should be used.\n"
 	"Content format can be forced through [-mime]() and file extension can be changed through [-ext]().\n"
 	"Note: Unless disabled at session level (see [-no-probe](CORE) ), file extensions are usually ignored and format probing is done on the first data block.\n"
 	"The special file name `null` is used for creating a file with no data, needed by some filters such as [dasher](dasher).\n"
@@ -59,6 +59,7 @@ typedef struct
 	char *ext;
 	char *mime;
 	Bool blockio;
+	u32 rgap, rcache;
 
 
 	//internal
@@ -82,6 +83,14 @@ typedef struct
 	GF_Err last_state;
 	Bool is_source_switch;
 	Bool prev_was_init_segment;
+
+	//position of the network transfer, may differ from nb_read when replaying or skipping data after a seek
+	u64 net_pos;
+	u32 skip_bytes;
+	Bool net_done;
+	//ring buffer of last rcache bytes received, ending at net_pos
+	u8 *rc_buf;
+	u32 rc_start, rc_len;
 } GF_HTTPInCtx;
 
 static void httpin_notify_error(GF_Filter *filter, GF_HTTPInCtx *ctx, GF_Err e)
@@ -97,6 +106,47 @@ static void httpin_notify_error(GF_Filter *filter, GF_HTTPInCtx *ctx, GF_Err e)
 	}
 }
 
+static void httpin_reset_net_pos(GF_HTTPInCtx *ctx, u64 pos)
+{
+	ctx->net_pos = pos;
+	ctx->skip_bytes = 0;
+	ctx->net_done = GF_FALSE;
+	ctx->rc_start = ctx->rc_len = 0;
+}
+
+static void httpin_rc_push(GF_HTTPInCtx *ctx, const u8 *data, u32 size)
+{
+	u32 pos, len;
+	if (size >= ctx->rcache) {
+		memcpy(ctx->rc_buf, data + size - ctx->rcache, ctx->rcache);
+		ctx->rc_start = 0;
+		ctx->rc_len = ctx->rcache;
+		return;
+	}
+	pos = (ctx->rc_start + ctx->rc_len) % ctx->rcache;
+	len = MIN(size, ctx->rcache - pos);
+	memcpy(ctx->rc_buf + pos, data, len);
+	if (len < size)
+		memcpy(ctx->rc_buf, data + len, size - len);
+
+	ctx->rc_len += size;
+	if (ctx->rc_len > ctx->rcache) {
+		ctx->rc_start = (ctx->rc_start + ctx->rc_len - ctx->rcache) % ctx->rcache;
+		ctx->rc_len = ctx->rcache;
+	}
+}
+
+static void httpin_rc_read(GF_HTTPInCtx *ctx, u64 offset, u8 *data, u32 size)
+{
+	u32 pos, len;
+	pos = ctx->rc_len - (u32) (ctx->net_pos - offset);
+	pos = (ctx->rc_start + pos) % ctx->rcache;
+	len = MIN(size, ctx->rcache - pos);
+	memcpy(data, ctx->rc_buf + pos, len);
+	if (len < size)
+		memcpy(data + len, ctx->rc_buf, size - len);
+}
+
 static GF_Err httpin_initialize(GF_Filter *filter)
 {
 	GF_HTTPInCtx *ctx = (GF_HTTPInCtx *) gf_filter_get_udta(filter);
@@ -110,6 +160,10 @@ static GF_Err httpin_initialize(GF_Filter *filter)
 	if (!ctx->dm) return GF_SERVICE_ERROR;
 #endif
 	ctx->block = gf_malloc(ctx->block_size +1);
+	if (ctx->rcache) {
+		ctx->rc_buf = gf_malloc(ctx->rcache);
+		if (!ctx->rc_buf) return GF_OUT_OF_MEM;
+	}
 
 	flags = GF_NETIO_SESSION_NOT_THREADED | GF_NETIO_SESSION_PERSISTENT;
 	if (ctx->cache==GF_HTTPIN_STORE_MEM)
@@ -178,6 +232,7 @@ void httpin_finalize(GF_Filter *filter)
 	if (ctx->sess) gf_dm_sess_del(ctx->sess);
 
 	if (ctx->block) gf_free(ctx->block);
+	if (ctx->rc_buf) gf_free(ctx->rc_buf);
 	if (ctx->cached) gf_fclose(ctx->cached);
 }
 
@@ -236,16 +291,29 @@ static Bool httpin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 				if (cached) ctx->cached = gf_fopen(cached, "rb");
 			}
 			ctx->nb_read = evt->seek.start_offset;
+			ctx->last_state = GF_OK;
 
 			if (ctx->cached) {
 				gf_fseek(ctx->cached, ctx->nb_read, SEEK_SET);
-			} else if (ctx->sess) {
+			} else if (ctx->sess && !ctx->blob_size) {
+				//backward seek in recently received data, replay from memory
+				if (ctx->rc_len && (ctx->nb_read < ctx->net_pos) && (ctx->nb_read + ctx->rc_len >= ctx->net_pos)) {
+					GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPIn] Seek to "LLU" replayed from memory\n", ctx->nb_read));
+					ctx->skip_bytes = 0;
+					return GF_TRUE;
+				}
+				//forward seek close to current position, skip data rather than issuing a new request
+				if (!ctx->net_done && !ctx->range.den && (ctx->nb_read >= ctx->net_pos) && (ctx->nb_read - ctx->net_pos <= ctx->rgap)) {
+					GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPIn] Seek to "LLU" done by skipping "LLU" bytes\n", ctx->nb_read, ctx->nb_read - ctx->net_pos));
+					ctx->skip_bytes = (u32) (ctx->nb_read - ctx->net_pos);
+					return GF_TRUE;
+				}
 				gf_dm_sess_abort(ctx->sess);
 				gf_dm_sess_set_range(ctx->sess, ctx->nb_read, 0, GF_TRUE);
+				httpin_reset_net_pos(ctx, ctx->nb_read);
 			}
 			ctx->range.den = 0;
 			ctx->range.num = ctx->nb_read;
-			ctx->last_state = GF_OK;
 		} else {
 			GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[HTTPIn] Requested seek outside file range !\n") );
 			ctx->is_end = GF_TRUE;
@@ -310,6 +378,7 @@ static Bool httpin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 				httpin_set_eos(ctx);
 			}
 			ctx->nb_read = 0;
+			httpin_reset_net_pos(ctx, 0);
 			ctx->last_state = GF_OK;
 			return GF_TRUE;
 		}
@@ -347,6 +416,7 @@ static Bool httpin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 			return GF_TRUE;
 		}
 		ctx->nb_read = ctx->file_size = 0;
+		httpin_reset_net_pos(ctx, 0);
 		ctx->do_reconfigure = GF_TRUE;
 		ctx->is_end = GF_FALSE;
 		ctx->last_state = GF_OK;
@@ -462,6 +532,19 @@ static GF_Err httpin_process(GF_Filter *filter)
 		}
         gf_blob_release(cached);
 	}
+	//we replay data from memory after a backward seek
+	else if (ctx->nb_read < ctx->net_pos) {
+		nb_read = ctx->block_size;
+		if (ctx->net_pos - ctx->nb_read < nb_read)
+			nb_read = (u32) (ctx->net_pos - ctx->nb_read);
+
+		httpin_rc_read(ctx, ctx->nb_read, ctx->block, nb_read);
+		if (ctx->net_done && (ctx->nb_read + nb_read == ctx->net_pos)) {
+			e = GF_EOS;
+			net_status = GF_NETIO_DATA_TRANSFERED;
+		}
+		gf_dm_sess_get_stats(ctx->sess, NULL, NULL, &total_size, &bytes_done, &bytes_per_sec, NULL);
+	}
 	//we read from network
 	else {
 
@@ -479,6 +562,9 @@ static GF_Err httpin_process(GF_Filter *filter)
 				httpin_notify_error(filter, ctx, e);
 
 			ctx->is_end = GF_TRUE;
+			//transfer is aborted, further seeks must issue a new request
+			ctx->net_done = GF_TRUE;
+			ctx->rc_len = 0;
 
 			//do not return an error if first fetch after source switch fails with removed or 404, this happens in DASH dynamic
 			//and the error might be absorbed by the dash demux later
@@ -555,6 +641,27 @@ static GF_Err httpin_process(GF_Filter *filter)
 				}
 			}
 		}
+		if (nb_read) {
+			if (ctx->rcache && !ctx->blob_size && !ctx->cached)
+				httpin_rc_push(ctx, ctx->block, nb_read);
+			ctx->net_pos += nb_read;
+			//discard data until forward seek position
+			if (ctx->skip_bytes) {
+				if (nb_read <= ctx->skip_bytes) {
+					ctx->skip_bytes -= nb_read;
+					nb_read = 0;
+				} else {
+					memmove(ctx->block, ctx->block + ctx->skip_bytes, nb_read - ctx->skip_bytes);
+					nb_read -= ctx->skip_bytes;
+					ctx->skip_bytes = 0;
+				}
+			}
+		}
+		if (e==GF_EOS) ctx->net_done = GF_TRUE;
+		else if (!nb_read) {
+			gf_filter_ask_rt_reschedule(filter, 1);
+			return GF_OK;
+		}
 		//update file size at each call to get_stats, since we may use a dynamic blob in case of route
 		ctx->file_size = total_size;
 
@@ -632,6 +739,8 @@ static const GF_FilterArgs HTTPInArgs[] =
 	{ OFFS(ext), "override file extension", GF_PROP_NAME, NULL, NULL, 0},
 	{ OFFS(mime), "set file mime type", GF_PROP_NAME, NULL, NULL, 0},
 	{ OFFS(blockio), "use blocking IO", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(rgap), "maximum number of bytes to skip on the current request when seeking forward instead of issuing a new byte range request", GF_PROP_UINT, "65536", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(rcache), "size in bytes of the memory window of last received data used to serve backward seeks without issuing a new byte range request", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -649,6 +758,8 @@ GF_FilterRegister HTTPInRegister = {
 	"\n"
 	"The filter supports both http and https schemes, and will attempt reconnecting as TLS if TCP connection fails.\n"
 	"\n"
+	"When the consuming filter seeks in the resource, the current request is kept if the seek position is less than [-rgap]() bytes ahead, or within the last [-rcache]() bytes received.\n"
+	"\n"
 	"Note: Unless disabled at session level (see [-no-probe](CORE) ), file extensions are usually ignored and format probing is done on the first data block.")
 	.private_size = sizeof(GF_HTTPInCtx),
 	.flags = GF_FS_REG_USE_SYNC_READ,
@@ -0,0 +1,655 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: agent
+ *			Copyright (c) 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / shared memory input filter
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include "shm_ring.h"
+#include <gpac/constants.h>
+#include <gpac/thread.h>
+
+#ifdef GPAC_HAS_SHM_RING
+
+//record read from the ring and not yet released
+typedef struct
+{
+	u64 pos;
+	u32 size;
+	//offset in data area of the packet payload, 0 if no packet points to this record
+	u32 data_offset;
+	Bool released;
+} ShmInRecord;
+
+//output stream in packet mode
+typedef struct
+{
+	u32 id;
+	GF_FilterPid *opid;
+	Bool stopped;
+} ShmInStream;
+
+enum
+{
+	SHMIN_MODE_UNKNOWN=0,
+	SHMIN_MODE_FILE,
+	SHMIN_MODE_PCK,
+};
+
+typedef struct
+{
+	//options
+	char *src, *ext, *mime;
+	u32 size, wait, poll;
+
+	//file mode: only one output pid declared
+	GF_FilterPid *pid;
+	//packet mode: one output pid per writer input pid
+	GF_List *streams;
+	GF_BitStream *bs;
+	//packet split over several records, copied
+	GF_FilterPacket *frag_pck;
+	u8 *frag_data;
+	u32 frag_size, frag_offset;
+	Bool frag_skip;
+	u32 mode;
+
+	GF_ShmRing ring;
+	//position of next record to read
+	u64 read_pos;
+
+	//pending records, in ring order, protected by mx as packets may be released from other threads
+	ShmInRecord *recs;
+	u32 nb_recs, first_rec, alloc_recs;
+	GF_Mutex *mx;
+
+	Bool is_first, is_end;
+	u64 nb_bytes, nb_pck;
+} GF_ShmInCtx;
+
+static GF_Err shmin_initialize(GF_Filter *filter)
+{
+	GF_Err e;
+	GF_ShmInCtx *ctx = (GF_ShmInCtx *) gf_filter_get_udta(filter);
+
+	if (!ctx || !ctx->src) return GF_BAD_PARAM;
+	ctx->ring.fd = -1;
+	if (strnicmp(ctx->src, "shm://", 6))  {
+		gf_filter_setup_failure(filter, GF_NOT_SUPPORTED);
+		return GF_NOT_SUPPORTED;
+	}
+	e = gf_shm_ring_open(&ctx->ring, ctx->src, ctx->size);
+	if (e) return e;
+
+	ctx->read_pos = __atomic_load_n(&ctx->ring.hdr->read_pos, __ATOMIC_ACQUIRE);
+	__atomic_or_fetch(&ctx->ring.hdr->state, GF_SHM_STATE_READER, __ATOMIC_SEQ_CST);
+	ctx->mx = gf_mx_new("SHMIn");
+	ctx->streams = gf_list_new();
+	ctx->bs = gf_bs_new((u8 *) ctx, 1, GF_BITSTREAM_READ);
+	if (!ctx->mx || !ctx->streams || !ctx->bs) return GF_OUT_OF_MEM;
+	ctx->is_first = GF_TRUE;
+	return GF_OK;
+}
+
+static void shmin_finalize(GF_Filter *filter)
+{
+	GF_ShmInCtx *ctx = (GF_ShmInCtx *) gf_filter_get_udta(filter);
+
+	if (ctx->ring.hdr) {
+		__atomic_and_fetch(&ctx->ring.hdr->state, ~GF_SHM_STATE_READER, __ATOMIC_SEQ_CST);
+		GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[SHMIn] Read "LLU" packets "LLU" bytes\n", ctx->nb_pck, ctx->nb_bytes));
+	}
+	//reader is the last user of the ring, remove it
+	gf_shm_ring_close(&ctx->ring, GF_TRUE);
+	if (ctx->recs) gf_free(ctx->recs);
+	if (ctx->mx) gf_mx_del(ctx->mx);
+	if (ctx->streams) {
+		while (gf_list_count(ctx->streams)) {
+			ShmInStream *st = gf_list_pop_back(ctx->streams);
+			gf_free(st);
+		}
+		gf_list_del(ctx->streams);
+	}
+	if (ctx->bs) gf_bs_del(ctx->bs);
+}
+
+static ShmInStream *shmin_get_stream(GF_ShmInCtx *ctx, u32 id)
+{
+	u32 i, count = gf_list_count(ctx->streams);
+	for (i=0; i<count; i++) {
+		ShmInStream *st = gf_list_get(ctx->streams, i);
+		if (st->id == id) return st;
+	}
+	return NULL;
+}
+
+static GF_FilterProbeScore shmin_probe_url(const char *url, const char *mime_type)
+{
+	if (!strnicmp(url, "shm://", 6)) return GF_FPROBE_SUPPORTED;
+	return GF_FPROBE_NOT_SUPPORTED;
+}
+
+static Bool shmin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
+{
+	GF_ShmInCtx *ctx = (GF_ShmInCtx *) gf_filter_get_udta(filter);
+
+	if (ctx->mode==SHMIN_MODE_PCK) {
+		u32 i, nb_stopped=0, count = gf_list_count(ctx->streams);
+		for (i=0; i<count; i++) {
+			ShmInStream *st = gf_list_get(ctx->streams, i);
+			if (st->opid == evt->base.on_pid) {
+				if (evt->base.type==GF_FEVT_PLAY) st->stopped = GF_FALSE;
+				else if (evt->base.type==GF_FEVT_STOP) st->stopped = GF_TRUE;
+			}
+			if (st->stopped) nb_stopped++;
+		}
+		if (evt->base.type==GF_FEVT_SOURCE_SEEK) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[SHMIn] Seek request not possible on shared memory, ignoring\n"));
+		}
+		//all outputs stopped, stop reading
+		if (count && (nb_stopped==count)) ctx->is_end = GF_TRUE;
+		return GF_TRUE;
+	}
+	if (evt->base.on_pid && (evt->base.on_pid != ctx->pid))
+		return GF_TRUE;
+
+	switch (evt->base.type) {
+	case GF_FEVT_PLAY:
+		return GF_TRUE;
+	case GF_FEVT_STOP:
+		//stop sending data
+		ctx->is_end = GF_TRUE;
+		if (ctx->pid) gf_filter_pid_set_eos(ctx->pid);
+		return GF_TRUE;
+	case GF_FEVT_SOURCE_SEEK:
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[SHMIn] Seek request not possible on shared memory, ignoring\n"));
+		return GF_TRUE;
+	default:
+		break;
+	}
+	return GF_TRUE;
+}
+
+//moves shared read position past all released records at the head of the queue - must be called with mutex held
+static void shmin_release_records(GF_ShmInCtx *ctx)
+{
+	u64 read_pos = 0;
+	Bool changed = GF_FALSE;
+	while (ctx->nb_recs) {
+		ShmInRecord *rec = &ctx->recs[ctx->first_rec];
+		if (!rec->released) break;
+		read_pos = rec->pos + rec->size;
+		changed = GF_TRUE;
+		ctx->first_rec = (ctx->first_rec + 1) % ctx->alloc_recs;
+		ctx->nb_recs--;
+	}
+	if (!changed) return;
+	__atomic_store_n(&ctx->ring.hdr->read_pos, read_pos, __ATOMIC_RELEASE);
+	gf_shm_ring_signal(&ctx->ring.hdr->read_seq, &ctx->ring.hdr->writer_waiting);
+}
+
+//must be called with mutex held
+static Bool shmin_push_record(GF_ShmInCtx *ctx, u64 pos, u32 size, u32 data_offset)
+{
+	ShmInRecord *rec;
+	if (ctx->nb_recs == ctx->alloc_recs) {
+		u32 i, new_alloc = ctx->alloc_recs ? 2*ctx->alloc_recs : 64;
+		ShmInRecord *recs = gf_malloc(sizeof(ShmInRecord) * new_alloc);
+		if (!recs) return GF_FALSE;
+		for (i=0; i<ctx->nb_recs; i++)
+			recs[i] = ctx->recs[(ctx->first_rec + i) % ctx->alloc_recs];
+		if (ctx->recs) gf_free(ctx->recs);
+		ctx->recs = recs;
+		ctx->alloc_recs = new_alloc;
+		ctx->first_rec = 0;
+	}
+	rec = &ctx->recs[(ctx->first_rec + ctx->nb_recs) % ctx->alloc_recs];
+	rec->pos = pos;
+	rec->size = size;
+	rec->data_offset = data_offset;
+	rec->released = data_offset ? GF_FALSE : GF_TRUE;
+	ctx->nb_recs++;
+	return GF_TRUE;
+}
+
+static void shmin_pck_destructor(GF_Filter *filter, GF_FilterPid *pid, GF_FilterPacket *pck)
+{
+	u32 i, size, offset;
+	const u8 *data;
+	GF_ShmInCtx *ctx = (GF_ShmInCtx *) gf_filter_get_udta(filter);
+
+	data = gf_filter_pck_get_data(pck, &size);
+	if (!data || !ctx->ring.data) return;
+	offset = (u32) (data - ctx->ring.data);
+
+	gf_mx_p(ctx->mx);
+	//packets are usually released in order, so the first pending record usually matches
+	for (i=0; i<ctx->nb_recs; i++) {
+		ShmInRecord *rec = &ctx->recs[(ctx->first_rec + i) % ctx->alloc_recs];
+		if (rec->released) continue;
+		if (rec->data_offset != offset) continue;
+		rec->released = GF_TRUE;
+		break;
+	}
+	shmin_release_records(ctx);
+	gf_mx_v(ctx->mx);
+	gf_filter_post_process_task(filter);
+}
+
+//end of stream on all outputs
+static void shmin_set_eos(GF_ShmInCtx *ctx)
+{
+	u32 i, count = gf_list_count(ctx->streams);
+	if (ctx->pid) gf_filter_pid_set_eos(ctx->pid);
+	for (i=0; i<count; i++) {
+		ShmInStream *st = gf_list_get(ctx->streams, i);
+		gf_filter_pid_set_eos(st->opid);
+	}
+	if (ctx->frag_pck) {
+		gf_filter_pck_discard(ctx->frag_pck);
+		ctx->frag_pck = NULL;
+	}
+	ctx->is_end = GF_TRUE;
+}
+
+//checks if we should stop reading the ring
+static Bool shmin_would_block(GF_ShmInCtx *ctx)
+{
+	u32 i, count;
+	if (ctx->mode != SHMIN_MODE_PCK)
+		return (ctx->pid && gf_filter_pid_would_block(ctx->pid)) ? GF_TRUE : GF_FALSE;
+
+	//records are read in order, only stop once no output can take more packets
+	count = gf_list_count(ctx->streams);
+	if (!count) return GF_FALSE;
+	for (i=0; i<count; i++) {
+		ShmInStream *st = gf_list_get(ctx->streams, i);
+		if (!st->stopped && !gf_filter_pid_would_block(st->opid)) return GF_FALSE;
+	}
+	return GF_TRUE;
+}
+
+//parses a packet mode message, returns in shared_pck the packet pointing in the ring if any, to send once the record is pushed
+static GF_Err shmin_read_message(GF_Filter *filter, GF_ShmInCtx *ctx, GF_ShmRecord *rec, GF_FilterPacket **shared_pck)
+{
+	GF_Err e;
+	u8 msg, flags;
+	u32 id, data_size;
+	ShmInStream *st;
+	GF_FilterPacket *pck;
+	u8 *payload = (u8 *) rec + sizeof(GF_ShmRecord);
+
+	//continuation of a split packet
+	if (!(rec->flags & GF_SHM_REC_START)) {
+		if (ctx->frag_skip) {
+			if (rec->flags & GF_SHM_REC_END) ctx->frag_skip = GF_FALSE;
+			return GF_OK;
+		}
+		if (!ctx->frag_pck || (ctx->frag_offset + rec->size > ctx->frag_size)) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHMIn] Unexpected packet continuation in ring\n"));
+			return GF_NON_COMPLIANT_BITSTREAM;
+		}
+		memcpy(ctx->frag_data + ctx->frag_offset, payload, rec->size);
+		ctx->frag_offset += rec->size;
+		if (rec->flags & GF_SHM_REC_END) {
+			if (ctx->frag_offset != ctx->frag_size) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[SHMIn] Split packet size mismatch, got %u bytes expecting %u\n", ctx->frag_offset, ctx->frag_size));
+				gf_filter_pck_set_corrupted(ctx->frag_pck, GF_TRUE);
+			}
+			gf_filter_pck_send(ctx->frag_pck);
+			ctx->frag_pck = NULL;
+		}
+		return GF_OK;
+	}
+	if (ctx->frag_pck) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[SHMIn] Split packet interrupted, discarding\n"));
+		gf_filter_pck_discard(ctx->frag_pck);
+		ctx->frag_pck = NULL;
+	}
+	ctx->frag_skip = GF_FALSE;
+
+	gf_bs_reassign_buffer(ctx->bs, payload, rec->size);
+	msg = gf_bs_read_u8(ctx->bs);
+	id = gf_bs_read_u32(ctx->bs);
+	st = shmin_get_stream(ctx, id);
+
+	switch (msg) {
+	case GF_SHM_MSG_PID_CONFIG:
+		if (!st) {
+			GF_SAFEALLOC(st, ShmInStream);
+			if (!st) return GF_OUT_OF_MEM;
+			st->id = id;
+			st->opid = gf_filter_pid_new(filter);
+			if (!st->opid) {
+				gf_free(st);
+				return GF_OUT_OF_MEM;
+			}
+			gf_list_add(ctx->streams, st);
+		} else {
+			gf_filter_pid_reset_properties(st->opid);
+		}
+		e = gf_shm_read_props(ctx->bs, st->opid, NULL);
+		if (e) return e;
+		gf_filter_pid_set_property(st->opid, GF_PROP_PID_PLAYBACK_MODE, &PROP_UINT(GF_PLAYBACK_MODE_NONE) );
+		return GF_OK;
+
+	case GF_SHM_MSG_PID_EOS:
+		if (!st) return GF_OK;
+		if (gf_bs_read_u8(ctx->bs)) gf_filter_pid_send_flush(st->opid);
+		else gf_filter_pid_set_eos(st->opid);
+		return GF_OK;
+
+	case GF_SHM_MSG_PID_REMOVE:
+		if (!st) return GF_OK;
+		gf_filter_pid_remove(st->opid);
+		gf_list_del_item(ctx->streams, st);
+		gf_free(st);
+		return GF_OK;
+
+	case GF_SHM_MSG_PCK:
+	{
+		u64 dts, cts, byte_offset;
+		u32 dur, seq_num;
+		u8 sap, interlaced, dep_flags, crypt_flags, carousel, clock_type;
+		s16 roll;
+
+		dts = gf_bs_read_u64(ctx->bs);
+		cts = gf_bs_read_u64(ctx->bs);
+		dur = gf_bs_read_u32(ctx->bs);
+		sap = gf_bs_read_u8(ctx->bs);
+		flags = gf_bs_read_u8(ctx->bs);
+		interlaced = gf_bs_read_u8(ctx->bs);
+		dep_flags = gf_bs_read_u8(ctx->bs);
+		crypt_flags = gf_bs_read_u8(ctx->bs);
+		carousel = gf_bs_read_u8(ctx->bs);
+		clock_type = gf_bs_read_u8(ctx->bs);
+		roll = (s16) gf_bs_read_u16(ctx->bs);
+		seq_num = gf_bs_read_u32(ctx->bs);
+		byte_offset = gf_bs_read_u64(ctx->bs);
+		data_size = gf_bs_read_u32(ctx->bs);
+
+		if (!st || st->stopped) {
+			if (!(rec->flags & GF_SHM_REC_END)) ctx->frag_skip = GF_TRUE;
+			return GF_OK;
+		}
+		if (rec->flags & GF_SHM_REC_END) {
+			if (data_size > rec->size) return GF_NON_COMPLIANT_BITSTREAM;
+			if (data_size) {
+				//payload stays in the ring until the packet is released
+				pck = gf_filter_pck_new_shared(st->opid, payload + rec->size - data_size, data_size, shmin_pck_destructor);
+			} else {
+				pck = gf_filter_pck_new_alloc(st->opid, 0, NULL);
+			}
+		} else {
+			//packet larger than a record, copy
+			pck = gf_filter_pck_new_alloc(st->opid, data_size, &ctx->frag_data);
+		}
+		if (!pck) return GF_OUT_OF_MEM;
+
+		gf_filter_pck_set_dts(pck, dts);
+		gf_filter_pck_set_cts(pck, cts);
+		gf_filter_pck_set_duration(pck, dur);
+		gf_filter_pck_set_sap(pck, sap);
+		gf_filter_pck_set_framing(pck, (flags & GF_SHM_PCK_START) ? GF_TRUE : GF_FALSE, (flags & GF_SHM_PCK_END) ? GF_TRUE : GF_FALSE);
+		if (flags & GF_SHM_PCK_SEEK) gf_filter_pck_set_seek_flag(pck, GF_TRUE);
+		if (flags & GF_SHM_PCK_CORRUPTED) gf_filter_pck_set_corrupted(pck, GF_TRUE);
+		if (interlaced) gf_filter_pck_set_interlaced(pck, interlaced);
+		if (dep_flags) gf_filter_pck_set_dependency_flags(pck, dep_flags);
+		if (crypt_flags) gf_filter_pck_set_crypt_flags(pck, crypt_flags);
+		if (carousel) gf_filter_pck_set_carousel_version(pck, carousel);
+		if (clock_type) gf_filter_pck_set_clock_type(pck, clock_type);
+		if (roll) gf_filter_pck_set_roll_info(pck, roll);
+		if (seq_num) gf_filter_pck_set_seq_num(pck, seq_num);
+		if (byte_offset != GF_FILTER_NO_BO) gf_filter_pck_set_byte_offset(pck, byte_offset);
+
+		e = gf_shm_read_props(ctx->bs, NULL, pck);
+		if (e) {
+			gf_filter_pck_discard(pck);
+			return e;
+		}
+		ctx->nb_bytes += data_size;
+		ctx->nb_pck++;
+
+		if (rec->flags & GF_SHM_REC_END) {
+			if (data_size) *shared_pck = pck;
+			else gf_filter_pck_send(pck);
+			return GF_OK;
+		}
+		//data starts at the next 8-byte boundary
+		id = (u32) ((gf_bs_get_position(ctx->bs) + 7) & ~7);
+		if ((id > rec->size) || (rec->size - id > data_size)) {
+			gf_filter_pck_discard(pck);
+			return GF_NON_COMPLIANT_BITSTREAM;
+		}
+		ctx->frag_pck = pck;
+		ctx->frag_size = data_size;
+		ctx->frag_offset = rec->size - id;
+		memcpy(ctx->frag_data, payload + id, ctx->frag_offset);
+		return GF_OK;
+	}
+	default:
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[SHMIn] Unknown message type %u in ring, ignoring\n", msg));
+		return GF_OK;
+	}
+	return GF_OK;
+}
+
+static GF_Err shmin_process(GF_Filter *filter)
+{
+	u32 nb_out = 0;
+	Bool waited = GF_FALSE;
+	GF_ShmInCtx *ctx = (GF_ShmInCtx *) gf_filter_get_udta(filter);
+	GF_ShmRingHeader *hdr = ctx->ring.hdr;
+
+	if (ctx->is_end || !hdr)
+		return GF_EOS;
+
+	while (1) {
+		GF_Err e;
+		GF_ShmRecord *rec;
+		GF_FilterPacket *pck;
+		u8 *payload;
+		u32 rec_size, data_offset;
+		u64 write_pos;
+
+		if (shmin_would_block(ctx))
+			return GF_OK;
+
+		write_pos = __atomic_load_n(&hdr->write_pos, __ATOMIC_ACQUIRE);
+		if (write_pos == ctx->read_pos) {
+			u32 seq;
+			if (__atomic_load_n(&hdr->state, __ATOMIC_ACQUIRE) & GF_SHM_STATE_EOS) {
+				//writer may have published just before setting eos
+				if (__atomic_load_n(&hdr->write_pos, __ATOMIC_ACQUIRE) != ctx->read_pos) continue;
+				GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[SHMIn] end of stream detected\n"));
+				shmin_set_eos(ctx);
+				return GF_EOS;
+			}
+			//by default never block the scheduler, check again after poll period
+			if (nb_out || waited || !ctx->wait) break;
+
+			//wait for writer
+			waited = GF_TRUE;
+			__atomic_store_n(&hdr->reader_waiting, 1, __ATOMIC_SEQ_CST);
+			seq = __atomic_load_n(&hdr->write_seq, __ATOMIC_SEQ_CST);
+			if (__atomic_load_n(&hdr->write_pos, __ATOMIC_ACQUIRE) == ctx->read_pos)
+				gf_shm_ring_wait(&hdr->write_seq, seq, ctx->wait);
+			__atomic_store_n(&hdr->reader_waiting, 0, __ATOMIC_SEQ_CST);
+			continue;
+		}
+
+		rec = (GF_ShmRecord *) (ctx->ring.data + (ctx->read_pos % ctx->ring.size));
+		rec_size = (u32) GF_SHM_REC_SIZE(rec->size);
+		if ((rec_size > ctx->ring.size) || (write_pos - ctx->read_pos < rec_size)) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHMIn] Corrupted record in ring (size %u), aborting\n", rec->size));
+			shmin_set_eos(ctx);
+			return GF_NON_COMPLIANT_BITSTREAM;
+		}
+		payload = (u8 *) rec + sizeof(GF_ShmRecord);
+
+		if (!(rec->flags & GF_SHM_REC_PAD) && rec->size && (ctx->mode==SHMIN_MODE_UNKNOWN)) {
+			ctx->mode = (rec->flags & GF_SHM_REC_PCK) ? SHMIN_MODE_PCK : SHMIN_MODE_FILE;
+			GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[SHMIn] Ring carries %s\n", (ctx->mode==SHMIN_MODE_PCK) ? "packets" : "file data"));
+		}
+
+		if (rec->flags & GF_SHM_REC_PCK) {
+			pck = NULL;
+			if (ctx->mode != SHMIN_MODE_PCK) e = GF_NON_COMPLIANT_BITSTREAM;
+			else e = shmin_read_message(filter, ctx, rec, &pck);
+			if (e) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHMIn] Failed to parse message in ring: %s, aborting\n", gf_error_to_string(e) ));
+				shmin_set_eos(ctx);
+				return e;
+			}
+			//record is released right away unless a packet points to it
+			data_offset = 0;
+			if (pck) {
+				u32 data_size;
+				data_offset = (u32) (gf_filter_pck_get_data(pck, &data_size) - ctx->ring.data);
+			}
+			gf_mx_p(ctx->mx);
+			if (!shmin_push_record(ctx, ctx->read_pos, rec_size, data_offset)) {
+				gf_mx_v(ctx->mx);
+				return GF_OUT_OF_MEM;
+			}
+			shmin_release_records(ctx);
+			gf_mx_v(ctx->mx);
+			ctx->read_pos += rec_size;
+			if (pck) {
+				gf_filter_pck_send(pck);
+				nb_out++;
+			}
+			continue;
+		}
+
+		if ((rec->flags & (GF_SHM_REC_PAD|GF_SHM_REC_FLUSH)) || !rec->size) {
+			if ((rec->flags & GF_SHM_REC_FLUSH) && ctx->pid)
+				gf_filter_pid_send_flush(ctx->pid);
+
+			gf_mx_p(ctx->mx);
+			shmin_push_record(ctx, ctx->read_pos, rec_size, 0);
+			shmin_release_records(ctx);
+			gf_mx_v(ctx->mx);
+			ctx->read_pos += rec_size;
+			continue;
+		}
+
+		if (!ctx->pid) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[SHMIn] configuring stream %d probe bytes\n", rec->size));
+			e = gf_filter_pid_raw_new(filter, ctx->src, NULL, ctx->mime, ctx->ext, payload, rec->size, GF_TRUE, &ctx->pid);
+			if (e) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[SHMIn] failed to configure stream: %s\n", gf_error_to_string(e) ));
+				return e;
+			}
+			gf_filter_pid_set_property(ctx->pid, GF_PROP_PID_FILE_CACHED, &PROP_BOOL(GF_FALSE) );
+			gf_filter_pid_set_property(ctx->pid, GF_PROP_PID_PLAYBACK_MODE, &PROP_UINT(GF_PLAYBACK_MODE_NONE) );
+		}
+
+		gf_mx_p(ctx->mx);
+		if (!shmin_push_record(ctx, ctx->read_pos, rec_size, (u32) (payload - ctx->ring.data))) {
+			gf_mx_v(ctx->mx);
+			return GF_OUT_OF_MEM;
+		}
+		gf_mx_v(ctx->mx);
+
+		//payload stays in the ring until the packet is released
+		pck = gf_filter_pck_new_shared(ctx->pid, payload, rec->size, shmin_pck_destructor);
+		if (!pck) return GF_OUT_OF_MEM;
+		gf_filter_pck_set_framing(pck, ctx->is_first, GF_FALSE);
+		gf_filter_pck_set_sap(pck, GF_FILTER_SAP_1);
+		ctx->is_first = GF_FALSE;
+		ctx->nb_bytes += rec->size;
+		ctx->nb_pck++;
+		ctx->read_pos += rec_size;
+		gf_filter_pck_send(pck);
+		nb_out++;
+	}
+	//nothing yet, check again later without blocking the scheduler
+	if (!nb_out)
+		gf_filter_ask_rt_reschedule(filter, ctx->poll);
+	return GF_OK;
+}
+
+#define OFFS(_n)	#_n, offsetof(GF_ShmInCtx, _n)
+
+static const GF_FilterArgs ShmInArgs[] =
+{
+	{ OFFS(src), "name of source shared memory ring", GF_PROP_NAME, NULL, NULL, 0},
+	{ OFFS(ext), "indicate file extension of data", GF_PROP_STRING, NULL, NULL, 0},
+	{ OFFS(mime), "indicate mime type of data", GF_PROP_STRING, NULL, NULL, 0},
+	{ OFFS(size), "size of ring data area if the ring is created", GF_PROP_UINT, "16777216", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(poll), "delay in microseconds before checking again for data when the ring is empty", GF_PROP_UINT, "1000", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(wait), "maximum time in microseconds to block the filter waiting for data when the ring is empty, 0 never blocks", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
+	{0}
+};
+
+static const GF_FilterCapability ShmInCaps[] =
+{
+	//in packet mode we deliver more than these but this make the filter chain loading stop until we declare a pid
+	CAP_UINT(GF_CAPS_OUTPUT, GF_PROP_PID_STREAM_TYPE, GF_STREAM_FILE),
+	CAP_UINT(GF_CAPS_OUTPUT, GF_PROP_PID_STREAM_TYPE, GF_STREAM_AUDIO),
+	CAP_UINT(GF_CAPS_OUTPUT, GF_PROP_PID_STREAM_TYPE, GF_STREAM_VISUAL),
+	CAP_UINT(GF_CAPS_OUTPUT, GF_PROP_PID_STREAM_TYPE, GF_STREAM_TEXT),
+};
+
+GF_FilterRegister ShmInRegister = {
+	.name = "shmin",
+	GF_FS_SET_DESCRIPTION("Shared memory input")
+	GF_FS_SET_HELP("This filter receives data from another GPAC process through a shared memory ring written by [shmout](shmout).\n"
+		"The associated protocol scheme is `shm://` when loaded as a generic input (e.g. -i `shm://NAME` where NAME is the ring name).\n"
+		"\n"
+		"When the writer runs in packet mode (no format given to [shmout](shmout)), the filter declares the writer PIDs with their properties and dispatches their packets. "
+		"Packet payloads are dispatched without copy, pointing directly in the shared memory, except packets split over several records which are copied.\n"
+		"When the writer runs in file mode, the data is dispatched as a file PID without copy and parsed by a demultiplexer, which usually copies the data again, "
+		"for example when GSF streams are reassembled by [gsfdmx](gsfdmx).\n"
+		"Data format may then be specified using extension (either in name or through [-ext]()) or MIME type through [-mime]().\n"
+		"\n"
+		"The writer can only reuse ring space once dispatched packets are released, so slow consumers will throttle the writing process.\n"
+		"When the ring is empty, the filter checks again after [-poll]() microseconds and does not block the scheduler. "
+		"On Linux, [-wait]() can be set to sleep on a futex shared with the writer, woken up as soon as data is published, at the cost of blocking one scheduler thread.\n"
+		"\n"
+		"The shared memory object is removed when the filter is destroyed.\n"
+		"Warning: Only one reader per ring is supported, and input cannot seek.\n"
+	"")
+	.private_size = sizeof(GF_ShmInCtx),
+	.args = ShmInArgs,
+	SETCAPS(ShmInCaps),
+	.initialize = shmin_initialize,
+	.finalize = shmin_finalize,
+	.process = shmin_process,
+	.process_event = shmin_process_event,
+	.probe_url = shmin_probe_url
+};
+
+
+const GF_FilterRegister *shmin_register(GF_FilterSession *session)
+{
+	if (gf_opts_get_bool("temp", "get_proto_schemes")) {
+		gf_opts_set_key("temp_in_proto", ShmInRegister.name, "shm");
+	}
+	return &ShmInRegister;
+}
+#else
+const GF_FilterRegister *shmin_register(GF_FilterSession *session)
+{
+	return NULL;
+}
+#endif // GPAC_HAS_SHM_RING
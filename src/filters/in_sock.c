@@ -35,6 +35,20 @@
 #include <gpac/internal/ietf_dev.h>
 #endif
 
+//max size of a UDP datagram in batched reception
+#define SOCKIN_DGRAM_SIZE	9216
+
+//datagram queued in jitter buffer
+typedef struct
+{
+	u8 *data;
+	u32 size, alloc_size;
+	u16 seq;
+	u64 arrival_ntp;
+	//playout time in system clock us
+	u64 release_time;
+} SockInDatagram;
+
 typedef struct
 {
 	GF_FilterPid *pid;
@@ -42,11 +56,23 @@ typedef struct
 	Bool pck_out;
 #ifndef GPAC_DISABLE_STREAMING
 	GF_RTPReorder *rtp_reorder;
-#else
-	Bool is_rtp;
 #endif
+	Bool is_rtp;
 	char address[GF_MAX_IP_NAME_LEN];
 
+	//jitter buffer, ordered by RTP sequence number or by arrival for raw UDP
+	GF_List *jb;
+	Bool jb_has_last;
+	u16 jb_last_seq;
+	u32 rtp_base_ts;
+	u64 rtp_base_clock;
+	u32 nb_lost, nb_late, nb_dup, nb_resync;
+
+	//UDP output packet being filled
+	GF_FilterPacket *out_pck;
+	u8 *out_data;
+	u32 out_size;
+
 	u32 init_time;
 	Bool done, first_pck;
 	//stats
@@ -70,6 +96,8 @@ typedef struct
 	u32 reorder_delay;
 #endif
 	GF_PropStringList ssm, ssmx;
+	u32 batch, jitter;
+	Bool rxts;
 
 	GF_SockInClient sock_c;
 	GF_List *clients;
@@ -78,6 +106,11 @@ typedef struct
 	Bool is_stop;
 
 	char *buffer;
+	//UDP batched reception
+	u8 *rx_buf;
+	u32 *rx_sizes;
+	u64 *rx_ntp;
+	GF_List *jb_reservoir;
 
 	GF_SockGroup *active_sockets;
 	u32 last_rcv_time;
@@ -186,6 +219,21 @@ static GF_Err sockin_initialize(GF_Filter *filter)
 		ctx->block_size = (ctx->block_size / 188) * 188;
 
 		gf_filter_prevent_blocking(filter, GF_TRUE);
+
+		if (!ctx->batch) ctx->batch = 1;
+		ctx->rx_buf = gf_malloc(ctx->batch * SOCKIN_DGRAM_SIZE);
+		ctx->rx_sizes = gf_malloc(ctx->batch * sizeof(u32));
+		ctx->rx_ntp = gf_malloc(ctx->batch * sizeof(u64));
+		if (!ctx->rx_buf || !ctx->rx_sizes || !ctx->rx_ntp) return GF_OUT_OF_MEM;
+
+		if (ctx->jitter) {
+			ctx->sock_c.jb = gf_list_new();
+			ctx->jb_reservoir = gf_list_new();
+			if (!ctx->sock_c.jb || !ctx->jb_reservoir) return GF_OUT_OF_MEM;
+		}
+		if (ctx->rxts && (gf_sk_enable_rx_timestamps(ctx->sock_c.socket) != GF_OK)) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[SockIn] Kernel timestamps not available, using reception time as arrival time\n"));
+		}
 	}
 	gf_sk_set_buffer_size(ctx->sock_c.socket, 0, ctx->block_size);
 	gf_sk_set_block_mode(ctx->sock_c.socket, (!ctx->is_udp && ctx->block) ? GF_FALSE : GF_TRUE);
@@ -209,6 +257,16 @@ static GF_Err sockin_initialize(GF_Filter *filter)
 	return GF_OK;
 }
 
+static void sockin_jb_del(GF_List *jb)
+{
+	while (gf_list_count(jb)) {
+		SockInDatagram *dg = gf_list_pop_back(jb);
+		if (dg->data) gf_free(dg->data);
+		gf_free(dg);
+	}
+	gf_list_del(jb);
+}
+
 static void sockin_client_reset(GF_SockInClient *sc)
 {
 	if (sc->socket) gf_sk_del(sc->socket);
@@ -217,6 +275,10 @@ static void sockin_client_reset(GF_SockInClient *sc)
 	if (sc->rtp_reorder) gf_rtp_reorderer_del(sc->rtp_reorder);
 	sc->rtp_reorder = NULL;
 #endif
+	if (sc->jb) sockin_jb_del(sc->jb);
+	sc->jb = NULL;
+	if (sc->out_pck) gf_filter_pck_discard(sc->out_pck);
+	sc->out_pck = NULL;
 }
 
 static void sockin_finalize(GF_Filter *filter)
@@ -231,8 +293,15 @@ static void sockin_finalize(GF_Filter *filter)
 		}
 		gf_list_del(ctx->clients);
 	}
+	if (ctx->jitter && ctx->sock_c.jb) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[SockIn] Jitter buffer stats: %u lost %u late %u duplicated packets - %u resyncs\n", ctx->sock_c.nb_lost, ctx->sock_c.nb_late, ctx->sock_c.nb_dup, ctx->sock_c.nb_resync));
+	}
 	sockin_client_reset(&ctx->sock_c);
+	if (ctx->jb_reservoir) sockin_jb_del(ctx->jb_reservoir);
 	if (ctx->buffer) gf_free(ctx->buffer);
+	if (ctx->rx_buf) gf_free(ctx->rx_buf);
+	if (ctx->rx_sizes) gf_free(ctx->rx_sizes);
+	if (ctx->rx_ntp) gf_free(ctx->rx_ntp);
 	if (ctx->active_sockets) gf_sk_group_del(ctx->active_sockets);
 }
 
@@ -280,10 +349,68 @@ static Bool sockin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 	return GF_FALSE;
 }
 
+//probe data in ctx->buffer and declare output PID
+static GF_Err sockin_declare_pid(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockInClient *sock_c, u32 nb_read)
+{
+	GF_Err e;
+	const char *mime = ctx->mime;
+	const char *ext = ctx->ext;
+	//probe MPEG-2
+	if (ctx->tsprobe) {
+		/*TS over RTP signaled as udp */
+		if ((ctx->buffer[0] != 0x47) && ((ctx->buffer[1] & 0x7F) == 33) ) {
+#ifndef GPAC_DISABLE_STREAMING
+			//the jitter buffer performs reordering
+			if (!ctx->is_udp || !ctx->jitter)
+				sock_c->rtp_reorder = gf_rtp_reorderer_new(ctx->reorder_pck, ctx->reorder_delay, 90000);
+#endif
+			sock_c->is_rtp = GF_TRUE;
+			mime = "video/mp2t";
+			ext = "ts";
+		} else if (ctx->buffer[0] == 0x47) {
+			mime = "video/mp2t";
+			ext = "ts";
+		}
+	}
+
+	e = gf_filter_pid_raw_new(filter, ctx->src, NULL, mime, ext, ctx->buffer, nb_read, GF_TRUE, &sock_c->pid);
+	if (e) return e;
+
+//	if (ctx->is_udp) gf_filter_pid_set_property(sock_c->pid, GF_PROP_PID_UDP, &PROP_BOOL(GF_TRUE) );
+
+	gf_filter_pid_set_udta(sock_c->pid, sock_c);
+
+#ifdef GPAC_ENABLE_COVERAGE
+	if (gf_sys_is_cov_mode()) {
+		GF_FilterEvent evt;
+		memset(&evt, 0, sizeof(GF_FilterEvent));
+		evt.base.type = GF_FEVT_PLAY;
+		evt.base.on_pid = sock_c->pid;
+		sockin_process_event(filter, &evt);
+	}
+#endif
+	return GF_OK;
+}
+
+static void sockin_update_stats(GF_SockInClient *sock_c)
+{
+	//send bitrate ever half sec
+	u64 now = gf_sys_clock_high_res();
+	if (now > sock_c->last_stats_time + 500000) {
+		sock_c->last_stats_time = now;
+		u64 bitrate = (now - sock_c->start_time );
+		if (bitrate) {
+			bitrate = (sock_c->nb_bytes * 8 * 500000) / bitrate;
+			gf_filter_pid_set_info(sock_c->pid, GF_PROP_PID_DOWN_RATE, &PROP_UINT((u32) bitrate) );
+			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[SockIn] Receiving from %s at %d kbps\r", sock_c->address, (u32) (bitrate/1000)));
+		}
+		sock_c->nb_bytes = 0;
+	}
+}
+
 static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockInClient *sock_c)
 {
 	u32 nb_read, pos;
-	u64 now;
 	GF_Err e;
 	GF_FilterPacket *dst_pck;
 	u8 *out_data, *in_data;
@@ -325,13 +452,7 @@ static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockIn
 			}
 		}
 		nb_read+=read;
-		if (!ctx->is_udp
-#ifndef GPAC_DISABLE_STREAMING
-		 || sock_c->rtp_reorder
-#else
-		 || sock_c->is_rtp
-#endif
-		 )
+		if (!ctx->is_udp || sock_c->is_rtp)
 			break;
 		pos += read;
 	}
@@ -349,42 +470,8 @@ static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockIn
 
 	//first run, probe data
 	if (!sock_c->pid) {
-		const char *mime = ctx->mime;
-		const char *ext = ctx->ext;
-		//probe MPEG-2
-		if (ctx->tsprobe) {
-			/*TS over RTP signaled as udp */
-			if ((ctx->buffer[0] != 0x47) && ((ctx->buffer[1] & 0x7F) == 33) ) {
-#ifndef GPAC_DISABLE_STREAMING
-				sock_c->rtp_reorder = gf_rtp_reorderer_new(ctx->reorder_pck, ctx->reorder_delay, 90000);
-#else
-				sock_c->is_rtp = GF_TRUE;
-#endif
-				mime = "video/mp2t";
-				ext = "ts";
-			} else if (ctx->buffer[0] == 0x47) {
-				mime = "video/mp2t";
-				ext = "ts";
-			}
-		}
-
-		e = gf_filter_pid_raw_new(filter, ctx->src, NULL, mime, ext, ctx->buffer, nb_read, GF_TRUE, &sock_c->pid);
+		e = sockin_declare_pid(filter, ctx, sock_c, nb_read);
 		if (e) return e;
-
-//		if (ctx->is_udp) gf_filter_pid_set_property(sock_c->pid, GF_PROP_PID_UDP, &PROP_BOOL(GF_TRUE) );
-
-		gf_filter_pid_set_udta(sock_c->pid, sock_c);
-
-#ifdef GPAC_ENABLE_COVERAGE
-		if (gf_sys_is_cov_mode()) {
-			GF_FilterEvent evt;
-			memset(&evt, 0, sizeof(GF_FilterEvent));
-			evt.base.type = GF_FEVT_PLAY;
-			evt.base.on_pid = sock_c->pid;
-			sockin_process_event(filter, &evt);
-		}
-#endif
-
 	}
 
 	in_data = ctx->buffer;
@@ -423,19 +510,277 @@ static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockIn
 	sock_c->first_pck = GF_FALSE;
 
 do_stats:
-	//send bitrate ever half sec
+	sockin_update_stats(sock_c);
+	return GF_OK;
+}
+
+static void sockin_out_flush(GF_SockInClient *sc)
+{
+	if (!sc->out_pck) return;
+	gf_filter_pck_truncate(sc->out_pck, sc->out_size);
+	gf_filter_pck_set_framing(sc->out_pck, sc->first_pck, GF_FALSE);
+	gf_filter_pck_send(sc->out_pck);
+	sc->out_pck = NULL;
+	sc->first_pck = GF_FALSE;
+}
+
+//aggregate UDP payloads in output packets of at most block_size bytes
+static GF_Err sockin_out_push(GF_SockInCtx *ctx, GF_SockInClient *sc, const u8 *data, u32 size, u64 arrival_ntp)
+{
+	if (!size) return GF_OK;
+	if (sc->out_pck && (sc->out_size + size > ctx->block_size))
+		sockin_out_flush(sc);
+
+	if (!sc->out_pck) {
+		sc->out_pck = gf_filter_pck_new_alloc(sc->pid, MAX(ctx->block_size, size), &sc->out_data);
+		if (!sc->out_pck) return GF_OUT_OF_MEM;
+		sc->out_size = 0;
+		//arrival time of the first datagram in the packet
+		if (ctx->rxts)
+			gf_filter_pck_set_property(sc->out_pck, GF_PROP_PCK_RECEIVER_NTP, &PROP_LONGUINT(arrival_ntp) );
+	}
+	memcpy(sc->out_data + sc->out_size, data, size);
+	sc->out_size += size;
+	return GF_OK;
+}
+
+//get RTP payload, skipping CSRC, header extension and padding
+static Bool sockin_rtp_payload(const u8 *data, u32 size, u32 *offset, u32 *psize)
+{
+	u32 hdr_size = 12;
+	if (size < 12) return GF_FALSE;
+	hdr_size += 4 * (data[0] & 0x0F);
+	if (data[0] & 0x10) {
+		if (size < hdr_size + 4) return GF_FALSE;
+		hdr_size += 4 + 4 * ( ((u32) data[hdr_size+2] << 8) | data[hdr_size+3]);
+	}
+	if (size < hdr_size) return GF_FALSE;
+	size -= hdr_size;
+	if (data[0] & 0x20) {
+		u32 pad = data[hdr_size + size - 1];
+		if (!size || (pad > size)) return GF_FALSE;
+		size -= pad;
+	}
+	*offset = hdr_size;
+	*psize = size;
+	return GF_TRUE;
+}
+
+static GF_Err sockin_jb_add(GF_SockInCtx *ctx, GF_SockInClient *sc, const u8 *data, u32 size, u64 arrival_ntp)
+{
+	u32 pos;
+	u16 seq = 0;
+	SockInDatagram *dg;
+	u64 now = gf_sys_clock_high_res();
+	u64 delay = (u64) ctx->jitter * 1000;
+	u64 release_time = now + delay;
+
+	if (sc->is_rtp) {
+		u32 ts;
+		s32 diff;
+		s64 playout;
+		if (size < 12) return GF_OK;
+		seq = ((u16) data[2] << 8) | data[3];
+		ts = ((u32) data[4] << 24) | ((u32) data[5] << 16) | ((u32) data[6] << 8) | data[7];
+
+		//already played out, drop
+		if (sc->jb_has_last && ((s16) (seq - sc->jb_last_seq) <= 0)) {
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_NETWORK, ("[SockIn] RTP packet %u received after playout, dropping\n", seq));
+			sc->nb_late++;
+			return GF_OK;
+		}
+		//playout time is derived from the RTP timestamp, removing network jitter
+		if (!sc->rtp_base_clock) {
+			sc->rtp_base_clock = now;
+			sc->rtp_base_ts = ts;
+		}
+		diff = (s32) (ts - sc->rtp_base_ts);
+		playout = (s64) sc->rtp_base_clock + (s64) diff * 100 / 9;
+		//packet arrived after its playout time or more than one delay early: clock drift or timestamp discontinuity, resync
+		if ((playout + (s64) delay < (s64) now) || (playout > (s64) (now + delay))) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[SockIn] RTP jitter buffer resync at packet %u (drift "LLD" us)\n", seq, (s64) now - playout));
+			sc->rtp_base_clock = now;
+			sc->rtp_base_ts = ts;
+			sc->nb_resync++;
+		} else {
+			release_time = (u64) playout + delay;
+			//rebase to keep timestamp difference in range
+			if (diff > 0x3FFFFFFF) {
+				sc->rtp_base_clock = (u64) playout;
+				sc->rtp_base_ts = ts;
+			}
+		}
+	}
+
+	dg = gf_list_pop_back(ctx->jb_reservoir);
+	if (!dg) {
+		GF_SAFEALLOC(dg, SockInDatagram);
+		if (!dg) return GF_OUT_OF_MEM;
+	}
+	if (dg->alloc_size < size) {
+		dg->data = gf_realloc(dg->data, size);
+		if (!dg->data) {
+			gf_free(dg);
+			return GF_OUT_OF_MEM;
+		}
+		dg->alloc_size = size;
+	}
+	memcpy(dg->data, data, size);
+	dg->size = size;
+	dg->seq = seq;
+	dg->arrival_ntp = arrival_ntp;
+	dg->release_time = release_time;
+
+	pos = gf_list_count(sc->jb);
+	if (sc->is_rtp) {
+		while (pos) {
+			SockInDatagram *prev = gf_list_get(sc->jb, pos-1);
+			s16 d = (s16) (seq - prev->seq);
+			if (d>0) break;
+			if (!d) {
+				sc->nb_dup++;
+				return gf_list_add(ctx->jb_reservoir, dg);
+			}
+			pos--;
+		}
+	}
+	return gf_list_insert(sc->jb, dg, pos);
+}
+
+static GF_Err sockin_jb_release(GF_SockInCtx *ctx, GF_SockInClient *sc, Bool flush)
+{
+	GF_Err e = GF_OK;
+	u64 now = gf_sys_clock_high_res();
+
+	while (!e) {
+		SockInDatagram *dg = gf_list_get(sc->jb, 0);
+		if (!dg) break;
+		if (!flush && (dg->release_time > now)) break;
+		gf_list_rem(sc->jb, 0);
+
+		if (sc->is_rtp) {
+			u32 offset, psize;
+			if (sc->jb_has_last && (dg->seq != (u16) (sc->jb_last_seq + 1))) {
+				u16 nb_lost = dg->seq - sc->jb_last_seq - 1;
+				GF_LOG(GF_LOG_DEBUG, GF_LOG_NETWORK, ("[SockIn] RTP packet loss: %u packets missing before %u\n", nb_lost, dg->seq));
+				sc->nb_lost += nb_lost;
+			}
+			sc->jb_last_seq = dg->seq;
+			sc->jb_has_last = GF_TRUE;
+			if (sockin_rtp_payload(dg->data, dg->size, &offset, &psize))
+				e = sockin_out_push(ctx, sc, dg->data + offset, psize, dg->arrival_ntp);
+		} else {
+			e = sockin_out_push(ctx, sc, dg->data, dg->size, dg->arrival_ntp);
+		}
+		gf_list_add(ctx->jb_reservoir, dg);
+	}
+	sockin_out_flush(sc);
+	return e;
+}
+
+//delay in us until next jitter buffer release
+static u32 sockin_jb_next_release(GF_SockInClient *sc)
+{
+	u64 now;
+	SockInDatagram *dg = gf_list_get(sc->jb, 0);
+	if (!dg) return 0;
 	now = gf_sys_clock_high_res();
-	if (now > sock_c->last_stats_time + 500000) {
-		sock_c->last_stats_time = now;
-		u64 bitrate = (now - sock_c->start_time );
-		if (bitrate) {
-			bitrate = (sock_c->nb_bytes * 8 * 500000) / bitrate;
-			gf_filter_pid_set_info(sock_c->pid, GF_PROP_PID_DOWN_RATE, &PROP_UINT((u32) bitrate) );
-			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[SockIn] Receiving from %s at %d kbps\r", sock_c->address, (u32) (bitrate/1000)));
+	if (dg->release_time <= now) return 1;
+	if (dg->release_time - now > 1000) return 1000;
+	return (u32) (dg->release_time - now);
+}
+
+static GF_Err sockin_udp_datagram(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockInClient *sc, const u8 *data, u32 size, u64 arrival_ntp)
+{
+	GF_Err e;
+	//first run, probe data
+	if (!sc->pid) {
+		u32 probe_size = MIN(size, ctx->block_size);
+		GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[SockIn] Reception started after %u ms\n", gf_sys_clock() - sc->init_time));
+		memcpy(ctx->buffer, data, probe_size);
+		//we allocated one more byte for that
+		ctx->buffer[probe_size] = 0;
+		e = sockin_declare_pid(filter, ctx, sc, probe_size);
+		if (e) return e;
+	}
+	if (sc->jb)
+		return sockin_jb_add(ctx, sc, data, size, arrival_ntp);
+
+	if (sc->is_rtp) {
+		u32 offset, psize;
+#ifndef GPAC_DISABLE_STREAMING
+		if (sc->rtp_reorder) {
+			u8 *pck;
+			u16 seq_num;
+			if (size < 12) return GF_OK;
+			seq_num = ((u16) data[2] << 8) | data[3];
+			gf_rtp_reorderer_add(sc->rtp_reorder, (void *) data, size, seq_num);
+			e = GF_OK;
+			while (!e && (pck = (u8 *) gf_rtp_reorderer_get(sc->rtp_reorder, &size, GF_FALSE, NULL))) {
+				if (sockin_rtp_payload(pck, size, &offset, &psize))
+					e = sockin_out_push(ctx, sc, pck + offset, psize, arrival_ntp);
+				gf_free(pck);
+			}
+			return e;
 		}
-		sock_c->nb_bytes = 0;
+#endif
+		if (!sockin_rtp_payload(data, size, &offset, &psize)) return GF_OK;
+		return sockin_out_push(ctx, sc, data + offset, psize, arrival_ntp);
+	}
+	return sockin_out_push(ctx, sc, data, size, arrival_ntp);
+}
+
+static GF_Err sockin_read_udp(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockInClient *sc)
+{
+	u32 i, nb_pck, nb_read = 0;
+	GF_Err e;
+
+	if (!sc->socket)
+		return GF_EOS;
+
+	if (!sc->start_time) sc->start_time = gf_sys_clock_high_res();
+
+	//fetch datagrams by batches until we have a full block
+	while (nb_read < ctx->block_size) {
+		nb_pck = ctx->batch;
+		e = gf_sk_receive_batch(sc->socket, ctx->rx_buf, SOCKIN_DGRAM_SIZE, &nb_pck, ctx->rx_sizes, ctx->rxts ? ctx->rx_ntp : NULL);
+		if (e) {
+			if (nb_read || (e==GF_IP_NETWORK_EMPTY)) break;
+			if (e==GF_IP_CONNECTION_CLOSED) {
+				if (!sc->done) {
+					sc->done = GF_TRUE;
+					if (sc->pid) {
+						if (sc->jb) sockin_jb_release(ctx, sc, GF_TRUE);
+						gf_filter_pid_set_eos(sc->pid);
+					}
+				}
+				return GF_EOS;
+			}
+			return e;
+		}
+		for (i=0; i<nb_pck; i++) {
+			u32 size = ctx->rx_sizes[i];
+			if (!size) continue;
+			nb_read += size;
+			e = sockin_udp_datagram(filter, ctx, sc, ctx->rx_buf + i*SOCKIN_DGRAM_SIZE, size, ctx->rxts ? ctx->rx_ntp[i] : 0);
+			if (e) return e;
+		}
+		if (nb_pck < ctx->batch) break;
+	}
+	if (nb_read) {
+		sc->nb_bytes += nb_read;
+		sc->done = GF_FALSE;
+	}
+
+	if (sc->jb) {
+		e = sockin_jb_release(ctx, sc, GF_FALSE);
+		if (e) return e;
+	} else {
+		sockin_out_flush(sc);
 	}
 
+	if (nb_read)
+		sockin_update_stats(sc);
 	return GF_OK;
 }
 
@@ -458,8 +803,10 @@ static GF_Err sockin_check_eos(GF_Filter *filter, GF_SockInCtx *ctx)
 		return GF_OK;
 	}
 	if (!ctx->sock_c.done) {
-		if (ctx->sock_c.pid)
+		if (ctx->sock_c.pid) {
+			if (ctx->sock_c.jb) sockin_jb_release(ctx, &ctx->sock_c, GF_TRUE);
 			gf_filter_pid_set_eos(ctx->sock_c.pid);
+		}
 		ctx->sock_c.done = GF_TRUE;
 		if (!ctx->sock_c.first_pck) {
 			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[SockIn] No data received for %d ms, assuming end of stream\n", ctx->timeout));
@@ -484,6 +831,15 @@ static GF_Err sockin_process(GF_Filter *filter)
 	e = gf_sk_group_select(ctx->active_sockets, 1, GF_SK_SELECT_READ);
 	if (e==GF_IP_NETWORK_EMPTY) {
 		if (ctx->is_udp) {
+			//nothing received, play out jitter buffer
+			if (gf_list_count(ctx->sock_c.jb)) {
+				e = sockin_jb_release(ctx, &ctx->sock_c, GF_FALSE);
+				if (e) return e;
+				if (gf_list_count(ctx->sock_c.jb)) {
+					gf_filter_ask_rt_reschedule(filter, sockin_jb_next_release(&ctx->sock_c));
+					return GF_OK;
+				}
+			}
 			e = sockin_check_eos(filter, ctx);
 			if (e) return e;
 			if (ctx->sock_c.first_pck) {
@@ -511,7 +867,10 @@ static GF_Err sockin_process(GF_Filter *filter)
 	ctx->last_rcv_time = 0;
 	if (gf_sk_group_sock_is_set(ctx->active_sockets, ctx->sock_c.socket, GF_SK_SELECT_READ)) {
 		if (!ctx->listen) {
-			e = sockin_read_client(filter, ctx, &ctx->sock_c);
+			if (ctx->is_udp)
+				e = sockin_read_udp(filter, ctx, &ctx->sock_c);
+			else
+				e = sockin_read_client(filter, ctx, &ctx->sock_c);
 			gf_filter_ask_rt_reschedule(filter, 1);
 			return e;
 		}
@@ -618,6 +977,9 @@ static const GF_FilterArgs SockInArgs[] =
 	{ OFFS(reorder_delay), "number of ms delay for RTP reordering (M2TS over RTP)", GF_PROP_UINT, "10", NULL, GF_FS_ARG_HINT_ADVANCED},
 #endif
 
+	{ OFFS(batch), "number of datagrams to fetch per system call for UDP sockets", GF_PROP_UINT, "32", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(jitter), "delay in ms of the jitter buffer for UDP sockets, 0 to disable (see filter help)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(rxts), "set arrival time of UDP data as `ReceiverNTP` packet property, using kernel timestamps when available", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(ssm), "list of IP to include for source-specific multicast", GF_PROP_STRING_LIST, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(ssmx), "list of IP to exclude for source-specific multicast", GF_PROP_STRING_LIST, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
@@ -648,6 +1010,16 @@ GF_FilterRegister SockInRegister = {
 		"- have a trailing '/', e.g. `udp://localhost:1234/[:opts]`\n"
 		"- use `gpac` separator, e.g. `udp://localhost:1234[:gpac:opts]`\n"
 		"\n"
+		"UDP datagrams are fetched by batches of [-batch]() datagrams per system call when supported by the platform.\n"
+		"\n"
+		"When [-jitter]() is set, received UDP datagrams are held in a fixed-delay jitter buffer before being dispatched:\n"
+		"- for MPEG-2 TS over RTP, packets are reordered by sequence number, duplicates and packets received after their playout are dropped, and the playout time is derived from the RTP timestamp, removing network jitter\n"
+		"- for raw UDP, datagrams are dispatched in arrival order with a constant delay\n"
+		"If a packet arrives after its playout time or more than [-jitter]() ms ahead of it (clock drift or discontinuity), the jitter buffer is resynchronized on this packet.\n"
+		"In this mode, [-reorder_pck]() and [-reorder_delay]() are ignored.\n"
+		"\n"
+		"When [-rxts]() is set, each output packet carries the arrival time of its first datagram as `ReceiverNTP` property. On Linux, kernel timestamps (`SO_TIMESTAMPING`) are used, so the arrival time does not include scheduling delays of the receiving thread.\n"
+		"\n"
 		"When the socket is listening in keep-alive [-ka]() mode:\n"
 		"- a single connection is allowed and a single output PID will be produced\n"
 		"- each connection close event will triger a pipeline flush\n"
@@ -3609,7 +3609,13 @@ static void inspect_dump_pid_as_info(GF_InspectCtx *ctx, FILE *dump, GF_FilterPi
 		else inspect_printf(dump, " %d kbps", p->value.uint/1000 );
 	}
 	p = gf_filter_pid_get_property(pid, GF_PROP_PID_NB_FRAMES);
-	if (p && (p->value.uint>1)) inspect_printf(dump, " %d frames", p->value.uint);
+	if (p && (p->value.uint>1)) {
+		u32 nb_frames = p->value.uint;
+		inspect_printf(dump, " %d frames", nb_frames);
+		p = gf_filter_pid_get_property(pid, GF_PROP_PID_NB_SYNC);
+		if (p && p->value.uint)
+			inspect_printf(dump, " %d sync (avg GOP %.02f)", p->value.uint, ((Double) nb_frames) / p->value.uint);
+	}
 
 
 	if (is_protected) {
@@ -4830,6 +4836,10 @@ GF_Err inspect_initialize(GF_Filter *filter)
 	if (gf_filter_is_temporary(filter))
 		return GF_OK;
 
+	//only PID changes are inspected, let demuxers probe durations from the container index (e.g. TS PCRs)
+	if (!ctx->allp && !ctx->deep && !ctx->fmt)
+		gf_opts_set_key("temp", "inspect_summary", "yes");
+
 	if (!strcmp(ctx->log, "stderr")) ctx->dump = stderr;
 	else if (!strcmp(ctx->log, "stdout")) ctx->dump = stdout;
 	else if (!strcmp(ctx->log, "null")) ctx->dump = NULL;
@@ -4941,6 +4951,9 @@ const GF_FilterRegister InspectRegister = {
 	"Otherwise, all properties are dumped.\n"
 	"Note: specifying [-xml](), [-analyze](), [-fmt]() or using `-for-test` will force [-full]() to true.\n"
 	"\n"
+	"When only PID changes are inspected, the session stops as soon as all PIDs are configured and packets are not walked unless [-allp]() is set. "
+	"Durations, bitrates and sync frame counts are then taken from the container index when available (sample tables, segment index, first and last PCR for MPEG-2 TS, see [-pcrdur](m2tsdmx)).\n"
+	"\n"
 	"# Custom property dumping\n"
 	"The packet inspector can be configured to dump specific properties of packets using [-fmt]().\n"
 	"When the option is not present, all properties are dumped. Otherwise, only properties identified by `$TOKEN$` "
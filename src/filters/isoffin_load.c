@@ -771,6 +771,9 @@ static void isor_declare_track(ISOMReader *read, ISOMChannel *ch, u32 track, u32
 				gf_filter_pid_set_property(pid, GF_PROP_PID_DURATION, &PROP_FRAC64_INT(ch->duration, read->timescale));
 			}
 			gf_filter_pid_set_property(pid, GF_PROP_PID_NB_FRAMES, &PROP_UINT(sample_count));
+			//sync sample table is already loaded, expose number of sync samples for GOP probing
+			if (sample_count && (gf_isom_has_sync_points(read->mov, ch->track)==1))
+				gf_filter_pid_set_property(pid, GF_PROP_PID_NB_SYNC, &PROP_UINT(gf_isom_get_sync_point_count(read->mov, ch->track)));
 		}
 
 		if (sample_count && (streamtype==GF_STREAM_VISUAL)) {
@@ -210,6 +210,10 @@ typedef struct _js_pck_ctx
 	//array buffer
 	JSValue data_ab;
 	u32 flags;
+	//transferred array buffer memory, owned by the packet until destruction
+	u8 *owned_data;
+	JSFreeArrayBufferDataFunc *owned_free;
+	void *owned_opaque;
 } GF_JSPckCtx;
 
 typedef enum
@@ -328,7 +332,7 @@ static void jsf_pck_finalizer(JSRuntime *rt, JSValue val)
 		JS_FreeValueRT(rt, pckctx->jsobj);
 
 
-    if (JS_IsUndefined(pckctx->ref_val) && pckctx->jspid && pckctx->jspid->jsf) {
+    if (JS_IsUndefined(pckctx->ref_val) && !pckctx->owned_data && pckctx->jspid && pckctx->jspid->jsf) {
 		gf_list_add(pckctx->jspid->jsf->pck_res, pckctx);
 		memset(pckctx, 0, sizeof(GF_JSPckCtx));
 	}
@@ -2492,6 +2496,8 @@ void jsf_pck_shared_del(GF_Filter *filter, GF_FilterPid *PID, GF_FilterPacket *p
 			JS_FreeValue(pctx->jsf->ctx, pckc->ref_val);
 			pckc->ref_val = JS_UNDEFINED;
 			jsf_pck_detach_ab(pctx->jsf->ctx, pckc);
+			if (pckc->owned_data)
+				pckc->owned_free(JS_GetRuntime(pctx->jsf->ctx), pckc->owned_opaque, pckc->owned_data);
 			memset(pckc, 0, sizeof(GF_JSPckCtx));
 			gf_list_add(pctx->jsf->pck_res, pckc);
 			gf_list_rem(pctx->shared_pck, i);
@@ -2579,22 +2585,10 @@ static GF_Err jsf_pck_gl_get_texture(GF_FilterFrameInterface *frame, u32 plane_i
 JSValue webgl_get_frame_interface(JSContext *ctx, int argc, JSValueConst *argv, GF_FilterPid *for_pid, gf_fsess_packet_destructor *pck_del, GF_FilterFrameInterface **f_ifce);
 #endif
 
-static JSValue jsf_pid_new_packet(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv)
+static JSValue jsf_pid_new_pck_obj(JSContext *ctx, GF_JSPidCtx *pctx, GF_JSPckCtx **out_pckc)
 {
-	size_t ab_size;
-	u8 *data, *ab_data;
 	JSValue obj;
-	Bool use_shared=GF_FALSE;
-	Bool use_gl_ifce=GF_FALSE;
-	GF_JSPckCtx *pckc;
-	GF_JSPidCtx *pctx = JS_GetOpaque(this_val, jsf_pid_class_id);
-
-    if (!pctx) return GF_JS_EXCEPTION(ctx);
-	if (!pctx->jsf->filter->in_process)
-		return js_throw_err_msg(ctx, GF_BAD_PARAM, "Filter %s attempt to create a new packet outside process callback not allowed!\n", pctx->jsf->filter->name);
-
-
-	pckc = gf_list_pop_back(pctx->jsf->pck_res);
+	GF_JSPckCtx *pckc = gf_list_pop_back(pctx->jsf->pck_res);
 	if (!pckc) {
 		GF_SAFEALLOC(pckc, GF_JSPckCtx);
 		if (!pckc)
@@ -2611,6 +2605,26 @@ static JSValue jsf_pid_new_packet(JSContext *ctx, JSValueConst this_val, int arg
 	pckc->cbck_val = JS_UNDEFINED;
 	pckc->ref_val = JS_UNDEFINED;
 	pckc->data_ab = JS_UNDEFINED;
+	*out_pckc = pckc;
+	return obj;
+}
+
+static JSValue jsf_pid_new_packet(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv)
+{
+	size_t ab_size;
+	u8 *data, *ab_data;
+	JSValue obj;
+	Bool use_shared=GF_FALSE;
+	Bool use_gl_ifce=GF_FALSE;
+	GF_JSPckCtx *pckc;
+	GF_JSPidCtx *pctx = JS_GetOpaque(this_val, jsf_pid_class_id);
+
+    if (!pctx) return GF_JS_EXCEPTION(ctx);
+	if (!pctx->jsf->filter->in_process)
+		return js_throw_err_msg(ctx, GF_BAD_PARAM, "Filter %s attempt to create a new packet outside process callback not allowed!\n", pctx->jsf->filter->name);
+
+	obj = jsf_pid_new_pck_obj(ctx, pctx, &pckc);
+	if (JS_IsException(obj)) return obj;
 
 	if (argc>1) {
 		if (JS_IsFunction(ctx, argv[0])) {
@@ -2765,6 +2779,49 @@ pck_done:
 	return obj;
 }
 
+static JSValue jsf_pid_new_packet_transfer(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv)
+{
+	size_t ab_size;
+	u8 *ab_data;
+	JSValue obj;
+	JSFreeArrayBufferDataFunc *free_func=NULL;
+	void *opaque=NULL;
+	GF_JSPckCtx *pckc;
+	GF_JSPidCtx *pctx = JS_GetOpaque(this_val, jsf_pid_class_id);
+
+    if (!pctx || !argc) return GF_JS_EXCEPTION(ctx);
+	if (!pctx->jsf->filter->in_process)
+		return js_throw_err_msg(ctx, GF_BAD_PARAM, "Filter %s attempt to create a new packet outside process callback not allowed!\n", pctx->jsf->filter->name);
+	if (!JS_IsArrayBuffer(ctx, argv[0]))
+		return js_throw_err_msg(ctx, GF_BAD_PARAM, "new_packet_transfer expects an ArrayBuffer\n");
+
+	ab_data = JS_TransferArrayBuffer(ctx, argv[0], &ab_size, &free_func, &opaque);
+	//shared, detached or wrapping memory not owned by the JS engine (eg packet data), copy it
+	if (!ab_data) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_SCRIPT, ("[%s] ArrayBuffer cannot be transferred, copying it\n", pctx->jsf->log_name));
+		return jsf_pid_new_packet(ctx, this_val, 1, argv);
+	}
+
+	obj = jsf_pid_new_pck_obj(ctx, pctx, &pckc);
+	if (JS_IsException(obj)) {
+		free_func(JS_GetRuntime(ctx), opaque, ab_data);
+		return obj;
+	}
+	pckc->pck = gf_filter_pck_new_shared(pctx->pid, ab_data, (u32) ab_size, jsf_pck_shared_del);
+	if (!pckc->pck) {
+		free_func(JS_GetRuntime(ctx), opaque, ab_data);
+		JS_FreeValue(ctx, obj);
+		return js_throw_err(ctx, GF_OUT_OF_MEM);
+	}
+	pckc->owned_data = ab_data;
+	pckc->owned_free = free_func;
+	pckc->owned_opaque = opaque;
+	if (!pctx->shared_pck) pctx->shared_pck = gf_list_new();
+	gf_list_add(pctx->shared_pck, pckc);
+	pckc->flags = GF_JS_PCK_IS_SHARED | GF_JS_PCK_IS_OUTPUT;
+	return obj;
+}
+
 static JSValue jsf_pid_get_clock_info(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv)
 {
 	u32 timescale;
@@ -2891,16 +2948,95 @@ static JSValue jsf_pid_copy_props(JSContext *ctx, JSValueConst this_val, int arg
     return JS_UNDEFINED;
 }
 
+static GF_Err jsf_pck_set_fields(JSContext *ctx, GF_Filter *filter, GF_FilterPacket *pck, JSValueConst fields)
+{
+	GF_Err e = GF_OK;
+	u32 i, len;
+	JSPropertyEnum *tab;
+
+	if (JS_GetOwnPropertyNames(ctx, &tab, &len, fields, JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY))
+		return GF_BAD_PARAM;
+
+	for (i=0; i<len; i++) {
+		u32 ival;
+		u64 lival;
+		JSValue val = JS_GetProperty(ctx, fields, tab[i].atom);
+		const char *key = JS_AtomToCString(ctx, tab[i].atom);
+		if (!key) {
+			JS_FreeValue(ctx, val);
+			e = GF_OUT_OF_MEM;
+			break;
+		}
+		//timing fields, same semantics as the packet setters
+		if (!strcmp(key, "cts") || !strcmp(key, "dts")) {
+			if (JS_IsNull(val)) lival = GF_FILTER_NO_TS;
+			else if (JS_ToInt64(ctx, &lival, val)) e = GF_BAD_PARAM;
+			if (!e) {
+				if (key[0]=='c') gf_filter_pck_set_cts(pck, lival);
+				else gf_filter_pck_set_dts(pck, lival);
+			}
+		} else if (!strcmp(key, "dur")) {
+			if (JS_ToInt32(ctx, &ival, val)) e = GF_BAD_PARAM;
+			else gf_filter_pck_set_duration(pck, ival);
+		} else if (!strcmp(key, "sap")) {
+			if (JS_ToInt32(ctx, &ival, val)) e = GF_BAD_PARAM;
+			else gf_filter_pck_set_sap(pck, ival);
+		} else if (!strcmp(key, "seqnum")) {
+			if (JS_ToInt32(ctx, &ival, val)) e = GF_BAD_PARAM;
+			else gf_filter_pck_set_seq_num(pck, ival);
+		} else {
+			//builtin property if known, user property otherwise
+			u32 p4cc = gf_props_get_id(key);
+			if (JS_IsNull(val)) {
+				if (p4cc) e = gf_filter_pck_set_property(pck, p4cc, NULL);
+				else e = gf_filter_pck_set_property_dyn(pck, (char *) key, NULL);
+			} else {
+				GF_PropertyValue prop;
+				e = jsf_ToProp(filter, ctx, val, p4cc, &prop);
+				if (!e) {
+					if (p4cc) e = gf_filter_pck_set_property(pck, p4cc, &prop);
+					else e = gf_filter_pck_set_property_dyn(pck, (char *) key, &prop);
+					gf_props_reset_single(&prop);
+				}
+			}
+		}
+		JS_FreeCString(ctx, key);
+		JS_FreeValue(ctx, val);
+		if (e) break;
+	}
+	for (i=0; i<len; i++)
+		JS_FreeAtom(ctx, tab[i].atom);
+	js_free(ctx, tab);
+	return e;
+}
+
 static JSValue jsf_pid_forward(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv)
 {
 	GF_Err e;
 	GF_JSPckCtx *pckc;
+	GF_FilterPacket *dst;
 	GF_JSPidCtx *pctx = JS_GetOpaque(this_val, jsf_pid_class_id);
     if (!pctx || !argc) return GF_JS_EXCEPTION(ctx);
     if (!JS_IsObject(argv[0])) return GF_JS_EXCEPTION(ctx);
 	pckc = JS_GetOpaque(argv[0], jsf_pck_class_id);
     if (!pckc || !pckc->pck) return GF_JS_EXCEPTION(ctx);
-    e = gf_filter_pck_forward(pckc->pck, pctx->pid);
+    if ((argc<2) || JS_IsUndefined(argv[1]) || JS_IsNull(argv[1])) {
+		e = gf_filter_pck_forward(pckc->pck, pctx->pid);
+		if (e) return js_throw_err(ctx, e);
+		return JS_UNDEFINED;
+	}
+	if (!JS_IsObject(argv[1])) return GF_JS_EXCEPTION(ctx);
+
+	//reference source data, no copy and no JS packet object for the output
+	dst = gf_filter_pck_new_ref(pctx->pid, 0, 0, pckc->pck);
+	if (!dst) return js_throw_err(ctx, GF_OUT_OF_MEM);
+	gf_filter_pck_merge_properties(pckc->pck, dst);
+	e = jsf_pck_set_fields(ctx, pctx->jsf->filter, dst, argv[1]);
+	if (e) {
+		gf_filter_pck_discard(dst);
+		return js_throw_err(ctx, e);
+	}
+	e = gf_filter_pck_send(dst);
 	if (e) return js_throw_err(ctx, e);
     return JS_UNDEFINED;
 }
@@ -2956,6 +3092,7 @@ static const JSCFunctionListEntry jsf_pid_funcs[] = {
     JS_CFUNC_DEF("set_prop", 0, jsf_pid_set_property),
     JS_CFUNC_DEF("set_info", 0, jsf_pid_set_info),
     JS_CFUNC_DEF("new_packet", 0, jsf_pid_new_packet),
+    JS_CFUNC_DEF("new_packet_transfer", 0, jsf_pid_new_packet_transfer),
     JS_CFUNC_DEF("remove", 0, jsf_pid_remove),
     JS_CFUNC_DEF("reset_props", 0, jsf_pid_reset_props),
     JS_CFUNC_DEF("copy_props", 0, jsf_pid_copy_props),
@@ -4281,6 +4418,53 @@ static JSValue jsf_pck_clone(JSContext *ctx, JSValueConst this_val, int argc, JS
     return res;
 }
 
+static JSValue jsf_pck_make_writable(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv)
+{
+	u32 size, max_ref=0;
+	u8 *data;
+	GF_FilterPacket *pck, *ref;
+	GF_JSPckCtx *pckctx = JS_GetOpaque(this_val, jsf_pck_class_id);
+    if (!pckctx || !pckctx->pck) return GF_JS_EXCEPTION(ctx);
+	if (!(pckctx->flags & GF_JS_PCK_IS_OUTPUT))
+		return js_throw_err_msg(ctx, GF_BAD_PARAM, "Attempt to modify data of an input packet\n");
+	pck = pckctx->pck;
+	if (pck->frame_ifce)
+		return js_throw_err_msg(ctx, GF_BAD_PARAM, "Cannot modify data of a frame interface packet\n");
+	//shared string, JS owns the memory and strings are immutable
+	if (JS_IsString(pckctx->ref_val))
+		return js_throw_err_msg(ctx, GF_BAD_PARAM, "Cannot modify data of a packet shared with a string\n");
+
+	//same rules as gf_filter_pck_new_clone: data is modified in place unless read-only or referenced by other packets
+	if (pck->filter_owns_mem==2) max_ref = 2;
+	ref = pck->reference;
+	while (ref && (max_ref<2)) {
+		if (ref->filter_owns_mem==2) max_ref = 2;
+		else if (ref->reference_count > max_ref) max_ref = ref->reference_count;
+		ref = ref->reference;
+	}
+
+	if (max_ref>1) {
+		GF_FilterPacket *dst;
+		const u8 *src;
+		//the shared destructor recycles this packet context, cannot swap the packet
+		if (pckctx->flags & GF_JS_PCK_IS_SHARED)
+			return js_throw_err_msg(ctx, GF_BAD_PARAM, "Cannot modify data of a read-only shared packet\n");
+
+		src = gf_filter_pck_get_data(pck, &size);
+		dst = gf_filter_pck_new_alloc(pckctx->jspid->pid, size, &data);
+		if (!dst) return js_throw_err(ctx, GF_OUT_OF_MEM);
+		if (size) memcpy(data, src, size);
+		gf_filter_pck_merge_properties(pck, dst);
+		gf_filter_pck_discard(pck);
+		pckctx->pck = dst;
+	} else {
+		data = (u8 *) gf_filter_pck_get_data(pck, &size);
+	}
+	jsf_pck_detach_ab(ctx, pckctx);
+	if (!data) return JS_NULL;
+	pckctx->data_ab = JS_NewArrayBuffer(ctx, data, size, NULL, NULL, 0/*1*/);
+	return JS_DupValue(ctx, pckctx->data_ab);
+}
 
 static const JSCFunctionListEntry jsf_pck_funcs[] =
 {
@@ -4323,6 +4507,7 @@ static const JSCFunctionListEntry jsf_pck_funcs[] =
     JS_CFUNC_DEF("truncate", 0, jsf_pck_truncate),
     JS_CFUNC_DEF("copy_props", 0, jsf_pck_copy_props),
     JS_CFUNC_DEF("clone", 0, jsf_pck_clone),
+    JS_CFUNC_DEF("make_writable", 0, jsf_pck_make_writable),
 };
 
 
@@ -4954,7 +5139,7 @@ static GF_Err jsfilter_initialize_ex(GF_Filter *filter, JSContext *custom_ctx)
 		jsf->filter->session->js_ctx = jsf->ctx;
 		temp_assign = GF_TRUE;
 	}
-	ret = JS_Eval(jsf->ctx, (char *)buf, buf_len, jsf->js, flags);
+	ret = qjs_eval_cached(jsf->ctx, (char *)buf, buf_len, jsf->js, flags);
 	gf_free(buf);
 	if (temp_assign)
 		jsf->filter->session->js_ctx = NULL;
@@ -4995,6 +5180,10 @@ static void jsfilter_finalize(GF_Filter *filter)
 				JS_FreeValue(jsf->ctx, pckc->ref_val);
 				pckc->ref_val = JS_UNDEFINED;
 				jsf_pck_detach_ab(jsf->ctx, pckc);
+				if (pckc->owned_data) {
+					pckc->owned_free(JS_GetRuntime(jsf->ctx), pckc->owned_opaque, pckc->owned_data);
+					pckc->owned_data = NULL;
+				}
 
 				//do not free here since pck->jsobj may already have been GCed/destroyed
 			}
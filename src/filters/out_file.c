@@ -23,6 +23,7 @@
  *
  */
 
+#define _GNU_SOURCE
 
 #include <gpac/filters.h>
 #include <gpac/constants.h>
@@ -54,6 +55,8 @@ typedef struct
 	u32 cat, ow;
 	u32 mvbk;
 	s32 max_cache_segs;
+	u32 wblock, falloc, aio;
+	Bool odirect, atomic;
 
 	//only one input pid
 	GF_FilterPid *pid;
@@ -84,9 +87,22 @@ typedef struct
 	u64 last_file_size;
 	Bool use_rel;
 
+	char szPartName[GF_MAX_PATH];
+	//write stats
+	u64 nb_sys_write, nb_sys_bytes, clock_first_write;
+
 #ifdef GPAC_HAS_FD
 	Bool no_fd;
 	s32 fd;
+	//write aggregation block, aligned for O_DIRECT
+	u8 *wbuf, *wbuf_alloc;
+	u32 wbuf_size, wbuf_pos;
+	Bool is_direct;
+	u64 prealloc_size, size_hint;
+	//asynchronous write-behind, wbuf is the current block of the engine
+	GF_AsyncIO *aio_eng;
+	u32 aio_cur, aio_nb_queued, aio_batch;
+	u64 nb_aio_submit;
 #endif
 } GF_FileOutCtx;
 
@@ -104,6 +120,195 @@ typedef struct
 
 #endif
 
+#ifdef GPAC_HAS_FD
+
+//O_DIRECT requires buffer address, file offset and write size aligned on the logical block size
+#define FOUT_DIO_ALIGN	4096
+
+static u32 fileout_sys_write(GF_FileOutCtx *ctx, const u8 *data, u32 size)
+{
+	s64 res;
+	if (!ctx->clock_first_write) ctx->clock_first_write = gf_sys_clock_high_res();
+	res = (s64) write(ctx->fd, data, size);
+	ctx->nb_sys_write++;
+	if (res<0) return 0;
+	ctx->nb_sys_bytes += res;
+	return (u32) res;
+}
+
+static void fileout_leave_direct(GF_FileOutCtx *ctx)
+{
+#ifdef O_DIRECT
+	if (ctx->is_direct) {
+		fcntl(ctx->fd, F_SETFL, fcntl(ctx->fd, F_GETFL) & ~O_DIRECT);
+		ctx->is_direct = GF_FALSE;
+	}
+#endif
+}
+
+static GF_Err fileout_aio_submit(GF_FileOutCtx *ctx)
+{
+	if (!ctx->aio_nb_queued) return GF_OK;
+	ctx->aio_nb_queued = 0;
+	ctx->nb_aio_submit++;
+	return gf_aio_submit(ctx->aio_eng);
+}
+
+//waits for all blocks in flight, oldest first
+static GF_Err fileout_aio_drain(GF_FileOutCtx *ctx)
+{
+	u32 i;
+	GF_Err e = fileout_aio_submit(ctx);
+	for (i=1; i<=ctx->aio; i++) {
+		GF_Err we = gf_aio_wait(ctx->aio_eng, (ctx->aio_cur + i) % ctx->aio, GF_TRUE, NULL);
+		if (we) e = we;
+	}
+	return e;
+}
+
+//queues current block for writing at the current file position and moves to the next block
+static GF_Err fileout_aio_push(GF_FileOutCtx *ctx)
+{
+	GF_Err e;
+	s64 end;
+	u32 to_write = ctx->wbuf_pos;
+	if (!to_write) return GF_OK;
+	//unaligned tail, cannot be written in direct mode
+	if (ctx->is_direct && (to_write % FOUT_DIO_ALIGN)) {
+		e = fileout_aio_drain(ctx);
+		if (e) return e;
+		fileout_leave_direct(ctx);
+	}
+	if (!ctx->clock_first_write) ctx->clock_first_write = gf_sys_clock_high_res();
+	//writes use explicit offsets, move file position past the queued block so that tell and sync writes remain valid
+	end = (s64) lseek(ctx->fd, to_write, SEEK_CUR);
+	if (end<0) return GF_IO_ERR;
+	e = gf_aio_queue(ctx->aio_eng, ctx->aio_cur, ctx->fd, GF_TRUE, end - to_write, to_write);
+	if (e) return e;
+	ctx->nb_sys_write++;
+	ctx->nb_sys_bytes += to_write;
+	ctx->aio_nb_queued++;
+	if (ctx->aio_nb_queued >= ctx->aio_batch) {
+		e = fileout_aio_submit(ctx);
+		if (e) return e;
+	}
+	ctx->aio_cur = (ctx->aio_cur + 1) % ctx->aio;
+	ctx->wbuf = gf_aio_block(ctx->aio_eng, ctx->aio_cur);
+	ctx->wbuf_pos = 0;
+	//only blocking point: all blocks are in flight
+	e = gf_aio_wait(ctx->aio_eng, ctx->aio_cur, GF_TRUE, NULL);
+	if (e) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] Asynchronous write error on %s: %s\n", ctx->szFileName, gf_error_to_string(e)));
+	}
+	return e;
+}
+
+static GF_Err fileout_fd_flush(GF_FileOutCtx *ctx)
+{
+	u32 nb_write, to_write = ctx->wbuf_pos;
+	if (ctx->aio_eng) {
+		GF_Err e = fileout_aio_push(ctx);
+		GF_Err de = fileout_aio_drain(ctx);
+		return e ? e : de;
+	}
+	if (!to_write) return GF_OK;
+	//unaligned tail, cannot be written in direct mode
+	if (to_write % FOUT_DIO_ALIGN)
+		fileout_leave_direct(ctx);
+
+	nb_write = fileout_sys_write(ctx, ctx->wbuf, to_write);
+	ctx->wbuf_pos = 0;
+	if (nb_write != to_write) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] Write error, wrote %d bytes but had %d to write\n", nb_write, to_write));
+		return GF_IO_ERR;
+	}
+	return GF_OK;
+}
+
+static u32 fileout_fd_write(GF_FileOutCtx *ctx, const u8 *data, u32 size)
+{
+	u32 done = 0;
+	if (!ctx->wbuf)
+		return fileout_sys_write(ctx, data, size);
+
+	while (done < size) {
+		u32 copy;
+		//buffer empty and more than one block to write, write directly unless in direct mode (source not aligned)
+		if (!ctx->wbuf_pos && !ctx->is_direct && !ctx->aio_eng && (size - done >= ctx->wbuf_size)) {
+			copy = size - done;
+			if (fileout_sys_write(ctx, data+done, copy) != copy)
+				return 0;
+			return size;
+		}
+		copy = ctx->wbuf_size - ctx->wbuf_pos;
+		if (copy > size - done) copy = size - done;
+		memcpy(ctx->wbuf + ctx->wbuf_pos, data + done, copy);
+		ctx->wbuf_pos += copy;
+		done += copy;
+		if (ctx->wbuf_pos == ctx->wbuf_size) {
+			GF_Err e = ctx->aio_eng ? fileout_aio_push(ctx) : fileout_fd_flush(ctx);
+			if (e) return 0;
+		}
+	}
+	return size;
+}
+
+static u64 fileout_fd_tell(GF_FileOutCtx *ctx)
+{
+	return lseek(ctx->fd, 0, SEEK_CUR) + ctx->wbuf_pos;
+}
+
+static void fileout_fd_close(GF_FileOutCtx *ctx)
+{
+	fileout_fd_flush(ctx);
+	if (ctx->falloc) {
+		u64 fsize = lseek(ctx->fd, 0, SEEK_END);
+		//release blocks preallocated beyond end of file
+		if (ctx->prealloc_size > fsize) {
+			if (ftruncate(ctx->fd, fsize) != 0) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[FileOut] Failed to truncate %s to "LLU" bytes\n", ctx->szFileName, fsize));
+			}
+		}
+		ctx->size_hint = fsize;
+	}
+	ctx->prealloc_size = 0;
+	ctx->is_direct = GF_FALSE;
+	close(ctx->fd);
+}
+
+static void fileout_fd_prepare(GF_FileOutCtx *ctx, const char *szName)
+{
+	u32 flags = O_RDWR | O_CREAT | O_TRUNC;
+
+#ifdef O_DIRECT
+	if (ctx->odirect && ctx->wbuf) {
+		ctx->fd = open(szName, flags | O_DIRECT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH );
+		if (ctx->fd>=0) {
+			ctx->is_direct = GF_TRUE;
+		} else {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[FileOut] Failed to open %s in direct mode, using regular I/O\n", szName));
+			ctx->odirect = GF_FALSE;
+		}
+	}
+#endif
+	if (ctx->fd<0)
+		ctx->fd = open(szName, flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH );
+
+#if defined(GPAC_CONFIG_LINUX) && defined(FALLOC_FL_KEEP_SIZE)
+	if ((ctx->fd>=0) && ctx->falloc) {
+		//expected size is the size of the previous file, or the configured size if larger
+		u64 size = MAX(ctx->size_hint, ctx->falloc);
+		if (fallocate(ctx->fd, FALLOC_FL_KEEP_SIZE, 0, (off_t) size) == 0) {
+			ctx->prealloc_size = size;
+		} else {
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_MMIO, ("[FileOut] fallocate failed for %s, disabling preallocation\n", szName));
+			ctx->falloc = 0;
+		}
+	}
+#endif
+}
+#endif
+
 static void fileout_close_hls_chunk(GF_FileOutCtx *ctx, Bool final_flush)
 {
 	if (!ctx->hls_chunk) return;
@@ -117,7 +322,7 @@ static GF_Err fileout_open_close(GF_FileOutCtx *ctx, const char *filename, const
 #ifdef GPAC_HAS_FD
 		if (ctx->fd>=0) {
 			GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[FileOut] closing output file %s\n", ctx->szFileName));
-			close(ctx->fd);
+			fileout_fd_close(ctx);
 			fileout_close_hls_chunk(ctx, GF_FALSE);
 		} else
 #endif
@@ -126,6 +331,13 @@ static GF_Err fileout_open_close(GF_FileOutCtx *ctx, const char *filename, const
 			gf_fclose(ctx->file);
 			fileout_close_hls_chunk(ctx, GF_FALSE);
 		}
+		//file written under temporary name, publish it
+		if (ctx->szPartName[0]) {
+			if (gf_file_move(ctx->szPartName, ctx->szFileName) != GF_OK) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] Failed to rename %s to %s\n", ctx->szPartName, ctx->szFileName));
+			}
+			ctx->szPartName[0] = 0;
+		}
 	}
 	ctx->file = NULL;
 #ifdef GPAC_HAS_FD
@@ -208,16 +420,20 @@ static GF_Err fileout_open_close(GF_FileOutCtx *ctx, const char *filename, const
 		}
 
 		GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[FileOut] opening output file %s\n", szFinalName));
+		if (ctx->atomic && !is_gfio && !append && (!ctx->original_url || strncmp(ctx->original_url, "gfio://", 7))) {
+			snprintf(ctx->szPartName, GF_MAX_PATH, "%s.part", szFinalName);
+			ctx->szPartName[GF_MAX_PATH-1] = 0;
+		}
 #ifdef GPAC_HAS_FD
 		if (!ctx->no_fd && !is_gfio && !append && !gf_opts_get_bool("core", "no-fd")
 			&& (!ctx->original_url || strncmp(ctx->original_url, "gfio://", 7))
 		) {
 			//make sure output dir exists
 			gf_fopen(szFinalName, "mkdir");
-			ctx->fd = open(szFinalName, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH );
+			fileout_fd_prepare(ctx, ctx->szPartName[0] ? ctx->szPartName : szFinalName);
 		} else
 #endif
-			ctx->file = gf_fopen_ex(szFinalName, ctx->original_url, append ? "a+b" : "w+b", GF_FALSE);
+			ctx->file = gf_fopen_ex(ctx->szPartName[0] ? ctx->szPartName : szFinalName, ctx->original_url, append ? "a+b" : "w+b", GF_FALSE);
 
 		if (!strcmp(szFinalName, ctx->szFileName) && !append && ctx->nb_write && !explicit_overwrite) {
 			GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[FileOut] re-opening in write mode output file %s, content overwrite (use `cat` option to enable append)\n", szFinalName));
@@ -344,6 +560,32 @@ static GF_Err fileout_initialize(GF_Filter *filter)
 
 #ifdef GPAC_HAS_FD
 	ctx->fd = -1;
+#ifndef O_DIRECT
+	ctx->odirect = GF_FALSE;
+#endif
+	if ((ctx->odirect || ctx->aio) && !ctx->wblock)
+		ctx->wblock = 1048576;
+	if (ctx->wblock) {
+		//round block size to direct I/O alignment so that full blocks can always be written in direct mode
+		ctx->wbuf_size = ctx->wblock + FOUT_DIO_ALIGN - 1;
+		ctx->wbuf_size -= ctx->wbuf_size % FOUT_DIO_ALIGN;
+		if (ctx->aio) {
+			ctx->aio_eng = gf_aio_new(ctx->aio, ctx->wbuf_size);
+			if (ctx->aio_eng) {
+				ctx->wbuf = gf_aio_block(ctx->aio_eng, 0);
+				//submit writes by groups of half the blocks in flight
+				ctx->aio_batch = MAX(ctx->aio/2, 1);
+			} else {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[FileOut] Asynchronous I/O not available, using synchronous writes\n"));
+				ctx->aio = 0;
+			}
+		}
+		if (!ctx->aio_eng) {
+			ctx->wbuf_alloc = gf_malloc(ctx->wbuf_size + FOUT_DIO_ALIGN);
+			if (!ctx->wbuf_alloc) return GF_OUT_OF_MEM;
+			ctx->wbuf = ctx->wbuf_alloc + (FOUT_DIO_ALIGN - ((size_t) ctx->wbuf_alloc) % FOUT_DIO_ALIGN) % FOUT_DIO_ALIGN;
+		}
+	}
 #endif
 
 	if (strnicmp(ctx->dst, "file:/", 6) && strnicmp(ctx->dst, "gfio:/", 6) && strstr(ctx->dst, "://"))  {
@@ -425,6 +667,19 @@ static void fileout_finalize(GF_Filter *filter)
 	fileout_close_hls_chunk(ctx, GF_TRUE);
 
 	fileout_open_close(ctx, NULL, NULL, 0, GF_FALSE, NULL);
+
+	if (ctx->nb_sys_write) {
+		u64 dur = gf_sys_clock_high_res() - ctx->clock_first_write;
+		GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[FileOut] "LLU" write syscalls for "LLU" bytes - %d bytes per syscall - %.02f IOPS\n",
+			ctx->nb_sys_write, ctx->nb_sys_bytes, (u32) (ctx->nb_sys_bytes / ctx->nb_sys_write), dur ? ((Double) ctx->nb_sys_write * 1000000) / dur : 0.0));
+	}
+#ifdef GPAC_HAS_FD
+	if (ctx->nb_aio_submit) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[FileOut] "LLU" asynchronous writes in "LLU" submissions\n", ctx->nb_sys_write, ctx->nb_aio_submit));
+	}
+	if (ctx->aio_eng) gf_aio_del(ctx->aio_eng);
+	if (ctx->wbuf_alloc) gf_free(ctx->wbuf_alloc);
+#endif
 	if (ctx->gfio_ref)
 		gf_fileio_open_url((GF_FileIO *)ctx->gfio_ref, NULL, "unref", &e);
 
@@ -458,7 +713,10 @@ restart:
 		if (gf_filter_pid_is_eos(ctx->pid) && !gf_filter_pid_is_flush_eos(ctx->pid)) {
 			if (gf_filter_reporting_enabled(filter)) {
 				char szStatus[1024];
-				snprintf(szStatus, 1024, "%s: done - wrote "LLU" bytes", gf_file_basename(ctx->szFileName), ctx->nb_write);
+				if (ctx->nb_sys_write)
+					snprintf(szStatus, 1024, "%s: done - wrote "LLU" bytes - "LLU" syscalls (%d bytes/syscall)", gf_file_basename(ctx->szFileName), ctx->nb_write, ctx->nb_sys_write, (u32) (ctx->nb_sys_bytes / ctx->nb_sys_write));
+				else
+					snprintf(szStatus, 1024, "%s: done - wrote "LLU" bytes", gf_file_basename(ctx->szFileName), ctx->nb_write);
 				gf_filter_update_status(filter, 10000, szStatus);
 			}
 
@@ -482,7 +740,7 @@ restart:
 					evt.seg_size.media_range_start = ctx->offset_at_seg_start;
 #ifdef GPAC_HAS_FD
 					if (ctx->fd>=0) {
-						evt.seg_size.media_range_end = lseek(ctx->fd, 0, SEEK_CUR);
+						evt.seg_size.media_range_end = fileout_fd_tell(ctx);
 					} else
 #endif
 					if (ctx->file) {
@@ -568,7 +826,7 @@ restart:
 				evt.seg_size.media_range_start = ctx->offset_at_seg_start;
 #ifdef GPAC_HAS_FD
 				if (ctx->fd>=0) {
-					evt.seg_size.media_range_end = lseek(ctx->fd, 0, SEEK_CUR);
+					evt.seg_size.media_range_end = fileout_fd_tell(ctx);
 				} else
 #endif
 				if (ctx->file) {
@@ -705,6 +963,13 @@ check_gfio:
 				} else {
 					u32 ilaced = gf_filter_pck_get_interlaced(pck);
 					u64 pos = ctx->nb_write;
+#ifdef GPAC_HAS_FD
+					//patching reads back and seeks in file, flush pending block and leave direct mode
+					if (ctx->fd>=0) {
+						e = fileout_fd_flush(ctx);
+						fileout_leave_direct(ctx);
+					}
+#endif
 
 					//we are inserting a block: write dummy bytes at end and move bytes
 					if (ilaced) {
@@ -712,7 +977,7 @@ check_gfio:
 						u64 cur_r, cur_w;
 #ifdef GPAC_HAS_FD
 						if (ctx->fd>=0) {
-							nb_write = (u32) write(ctx->fd, pck_data, pck_size);
+							nb_write = fileout_sys_write(ctx, pck_data, pck_size);
 							cur_w = lseek(ctx->fd, 0, SEEK_CUR);
 							lseek(ctx->fd, pos, SEEK_SET);
 						} else
@@ -759,7 +1024,7 @@ check_gfio:
 #ifdef GPAC_HAS_FD
 								if (ctx->fd>=0) {
 									lseek(ctx->fd, cur_w - move_bytes, SEEK_SET);
-									nb_write = (u32) write(ctx->fd, block, (size_t) move_bytes);
+									nb_write = fileout_sys_write(ctx, block, move_bytes);
 								} else
 #endif
 								{
@@ -781,7 +1046,7 @@ check_gfio:
 #ifdef GPAC_HAS_FD
 					if (ctx->fd>=0) {
 						lseek(ctx->fd, bo, SEEK_SET);
-						nb_write = (u32) write(ctx->fd, pck_data, pck_size);
+						nb_write = fileout_sys_write(ctx, pck_data, pck_size);
 						lseek(ctx->fd, pos, SEEK_SET);
 					} else
 #endif
@@ -799,7 +1064,7 @@ check_gfio:
 			} else {
 #ifdef GPAC_HAS_FD
 				if (ctx->fd>=0) {
-					nb_write = (u32) write(ctx->fd, pck_data, pck_size);
+					nb_write = fileout_fd_write(ctx, pck_data, pck_size);
 				} else
 #endif
 					nb_write = (u32) gf_fwrite(pck_data, pck_size, ctx->file);
@@ -851,7 +1116,7 @@ check_gfio:
 					for (j=0; j<write_h; j++) {
 #ifdef GPAC_HAS_FD
 						if (ctx->fd>=0) {
-							nb_write = (u32) write(ctx->fd, out_ptr, lsize);
+							nb_write = fileout_fd_write(ctx, out_ptr, lsize);
 						} else
 #endif
 							nb_write = (u32) gf_fwrite(out_ptr, lsize, ctx->file);
@@ -871,11 +1136,18 @@ check_gfio:
 		GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] output file handle is not opened, discarding %d bytes\n", pck_size));
 	}
 	gf_filter_pid_drop_packet(ctx->pid);
+#ifdef GPAC_HAS_FD
+	//end of file or segment and file kept open, flush aggregated block so that readers get complete segments
+	if (end && ctx->cat && (ctx->fd>=0) && ctx->wbuf_pos) {
+		GF_Err fe = fileout_fd_flush(ctx);
+		if (!e) e = fe;
+	}
+#endif
 	if (end && !ctx->cat) {
 		if (ctx->dash_mode) {
 #ifdef GPAC_HAS_FD
 			if (ctx->fd>=0) {
-				ctx->last_file_size = lseek(ctx->fd, 0, SEEK_CUR);
+				ctx->last_file_size = fileout_fd_tell(ctx);
 			} else
 #endif
 				ctx->last_file_size = gf_ftell(ctx->file);
@@ -888,7 +1160,13 @@ check_gfio:
 
 	if (gf_filter_reporting_enabled(filter)) {
 		char szStatus[1024];
-		snprintf(szStatus, 1024, "%s: wrote % 16"LLD_SUF" bytes", gf_file_basename(ctx->szFileName), (s64) ctx->nb_write);
+		if (ctx->nb_sys_write) {
+			u64 dur = gf_sys_clock_high_res() - ctx->clock_first_write;
+			snprintf(szStatus, 1024, "%s: wrote % 16"LLD_SUF" bytes - %d bytes/syscall - %d IOPS", gf_file_basename(ctx->szFileName), (s64) ctx->nb_write,
+				(u32) (ctx->nb_sys_bytes / ctx->nb_sys_write), dur ? (u32) ((ctx->nb_sys_write * 1000000) / dur) : 0);
+		} else {
+			snprintf(szStatus, 1024, "%s: wrote % 16"LLD_SUF" bytes", gf_file_basename(ctx->szFileName), (s64) ctx->nb_write);
+		}
 		gf_filter_update_status(filter, -1, szStatus);
 	}
 	return e;
@@ -956,6 +1234,11 @@ static const GF_FilterArgs FileOutArgs[] =
 	{ OFFS(max_cache_segs), "maximum number of segments cached per HAS quality when recording live sessions (0 means no limit)", GF_PROP_SINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(force_null), "force no output regardless of file name", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(use_rel), "packet filename use relative names (only set by dasher)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_HIDE},
+	{ OFFS(wblock), "aggregate writes in blocks of given size (rounded up to 4 KiB) before issuing write calls, 0 disables aggregation", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(falloc), "preallocate output files with the given size or the size of the previous file if larger, 0 disables preallocation (Linux only)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(odirect), "write using direct I/O bypassing page cache, using [-wblock]() aligned blocks (1 MiB if not set)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(atomic), "write files under a `.part` temporary name and rename them once closed", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(aio), "write asynchronously using the given number of [-wblock]() blocks (1 MiB if not set) in flight, 0 disables asynchronous writes (Linux io_uring only)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -987,6 +1270,18 @@ GF_FilterRegister FileOutRegister = {
 		"\n"
 		"EX gpac -i LIVE_MPD dashin:forward=file -o rec/$File$:max_cache_segs=3\n"
 		"This will force keeping a maximum of 3 media segments while recording the DASH session.\n"
+		"\n"
+		"# Write batching\n"
+		"When writing many small files or small packets, the number of write system calls can be reduced using [-wblock]().\n"
+		"Aggregated data is flushed when a file is closed or when a packet ends a file or segment, but not at the end of low latency DASH/HLS chunks: [-wblock]() should not be used when chunks are read while being written.\n"
+		"Files can be preallocated using [-falloc]() to reduce file system metadata updates, and written using direct I/O using [-odirect]().\n"
+		"The number of write system calls and bytes per call are reported in the filter status and logged when closing the filter.\n"
+		"EX gpac -i src.mp4 -o live/dash.mpd:segdur=2:wblock=262144:falloc=2000000\n"
+		"\n"
+		"On Linux, blocks can be written asynchronously using io_uring with [-aio](), the filter only waiting when all blocks are in flight. Pending writes are completed before patching, seeking or closing a file.\n"
+		"EX gpac -i src.mp4 -o dst.mp4:aio=4:wblock=1048576\n"
+		"\n"
+		"Note: Write batching is only used when the filter writes through file descriptors (not for `std`, `gfio://` or append mode).\n"
 		""
 	)
 	.private_size = sizeof(GF_FileOutCtx),
@@ -63,6 +63,8 @@ Bool gf_dm_sess_is_h2(GF_DownloadSession *sess);
 void gf_dm_sess_flush_h2(GF_DownloadSession *sess);
 
 void gf_dm_sess_set_sock_group(GF_DownloadSession *sess, GF_SockGroup *sg);
+GF_Err gf_dm_sess_send_file(GF_DownloadSession *sess, FILE *file, u64 offset, u32 size, u32 *written);
+void gf_dm_sess_get_tls_stats(GF_DownloadSession *sess, u64 *ktls_bytes, u64 *tls_bytes);
 
 #ifdef GPAC_HAS_SSL
 
@@ -97,6 +99,14 @@ typedef struct
 	Bool is_subpath;
 } HTTP_DIRInfo;
 
+//HLS playlist state, parsed once per playlist update for blocking playlist reloads
+typedef struct
+{
+	char *path;
+	s64 seq, nb_seg, nb_parts;
+	u32 td;
+} HTTPOutHLSPlaylist;
+
 typedef struct __httpout_session GF_HTTPOutSession;
 
 typedef struct
@@ -146,6 +156,10 @@ typedef struct
 
 	GF_List *directories;
 	Bool has_read_dir, has_write_dir;
+	//HTTPOutHLSPlaylist of HLS playlists produced, created at first playlist
+	GF_List *hls_playlists;
+	//incremented whenever a manifest or LL-HLS part is produced, used to wake up held requests
+	u32 hold_version;
 
 
 #ifdef GPAC_HAS_QJS
@@ -189,10 +203,17 @@ typedef struct __httpout_input
 
 	FILE *hls_chunk;
 	char *hls_chunk_path, *hls_chunk_local_path;
+	//set once LL-HLS parts have been produced on this input
+	Bool is_llhls;
 
 	u8 *tunein_data;
 	u32 tunein_data_size;
 
+	//shared append-only buffer for sessions reading without file IO, relay[0] is at byte offset relay_base of the stream
+	u8 *relay;
+	u32 relay_size, relay_alloc;
+	u64 relay_base;
+
     Bool force_dst_name;
     Bool in_error;
     u32 clock_first_error;
@@ -233,6 +254,8 @@ struct __httpout_session {
 	Double start_range;
 
 	FILE *resource;
+	//set when resource was sent through sendfile and file position must be restored before reading
+	Bool resource_seek;
 	char *path, *mime;
 	u64 file_size, file_pos, nb_bytes, bytes_in_req;
 	u8 *buffer;
@@ -254,6 +277,12 @@ struct __httpout_session {
 	GF_HTTPOutInput *in_source;
 	Bool send_init_data;
 	Bool in_source_is_ll_hls_chunk;
+	//read position in in_source shared relay buffer
+	u64 relay_pos;
+
+	//request held until LL-HLS playlist or part is available
+	u64 hold_until, hold_check;
+	u32 hold_version;
 
 	u32 nb_ranges, alloc_ranges, range_idx;
 	HTTByteRange *ranges;
@@ -295,8 +324,8 @@ typedef struct __gf_http_io
 	struct __gf_http_io *parent;
 	u64 pos;
 
-	//only for write
-	u64 size;
+	//only for write - data is shared by all readers of the file, allocated size is alloc
+	u64 size, alloc;
 	u8 *data;
 	//source PID
 	GF_HTTPOutInput *in;
@@ -341,8 +370,15 @@ static u32 httpio_write(GF_FileIO *fileio, u8 *buffer, u32 bytes)
 	GF_HTTPFileIO *ioctx = gf_fileio_get_udta(fileio);
 	if (!ioctx || ioctx->parent) return 0;
 
-	ioctx->data = gf_realloc(ioctx->data, sizeof(u8)*((size_t)ioctx->size+bytes));
-	if (!ioctx->data) return 0;
+	//grow geometrically, segments are written packet by packet
+	if (ioctx->size + bytes > ioctx->alloc) {
+		ioctx->alloc = (ioctx->size + bytes) * 3 / 2;
+		ioctx->data = gf_realloc(ioctx->data, sizeof(u8)*((size_t)ioctx->alloc));
+		if (!ioctx->data) {
+			ioctx->size = ioctx->alloc = 0;
+			return 0;
+		}
+	}
 	memcpy(ioctx->data + ioctx->size, buffer, bytes);
 	ioctx->size += bytes;
 	ioctx->pos += bytes;
@@ -1288,6 +1324,128 @@ static void httpout_push_headers(GF_HTTPOutSession *sess)
 	gf_list_del(sess->headers);
 	sess->headers=NULL;
 }
+
+//gets media sequence, segment and part counts of an HLS playlist just written
+//all playlists usually go through the same manifest input, so state is kept per playlist path
+static void httpout_parse_hls_playlist(GF_HTTPOutCtx *ctx, const char *path, const u8 *data, u32 size)
+{
+	u32 i, count;
+	HTTPOutHLSPlaylist *pl = NULL;
+	const char *line = (const char *) data;
+	const char *end = (const char *) data + size;
+
+	if (!ctx->hls_playlists) {
+		ctx->hls_playlists = gf_list_new();
+		if (!ctx->hls_playlists) return;
+	}
+	count = gf_list_count(ctx->hls_playlists);
+	for (i=0; i<count; i++) {
+		pl = gf_list_get(ctx->hls_playlists, i);
+		if (!strcmp(pl->path, path)) break;
+		pl = NULL;
+	}
+	if (!pl) {
+		GF_SAFEALLOC(pl, HTTPOutHLSPlaylist);
+		if (!pl) return;
+		pl->path = gf_strdup(path);
+		gf_list_add(ctx->hls_playlists, pl);
+	}
+
+	pl->seq = pl->nb_seg = pl->nb_parts = 0;
+	pl->td = 0;
+	while (line && (line < end)) {
+		const char *next = memchr(line, '\n', end - line);
+		u32 len = (u32) ((next ? next : end) - line);
+		if ((len>22) && !strncmp(line, "#EXT-X-MEDIA-SEQUENCE:", 22)) pl->seq = atoll(line+22);
+		else if ((len>22) && !strncmp(line, "#EXT-X-TARGETDURATION:", 22)) pl->td = atoi(line+22);
+		else if ((len>8) && !strncmp(line, "#EXTINF:", 8)) {
+			pl->nb_seg++;
+			pl->nb_parts = 0;
+		}
+		else if ((len>12) && !strncmp(line, "#EXT-X-PART:", 12)) pl->nb_parts++;
+		line = next ? next+1 : NULL;
+	}
+}
+
+//check blocking playlist reload and preload hint requests for LL-HLS
+//returns 0 if request can be processed, 1 if request must be put on hold or an HTTP error code
+static u32 httpout_check_hold(GF_HTTPOutSession *sess, const char *url, const char *query, const char *full_path, GF_HTTPOutInput *source_pid)
+{
+	u32 i, count;
+	u64 now = gf_sys_clock_high_res();
+	GF_HTTPOutCtx *ctx = sess->ctx;
+	const char *msn_str = query ? strstr(query, "_HLS_msn=") : NULL;
+
+	if (msn_str && !strcmp(gf_file_ext_start(url) ? gf_file_ext_start(url) : "", ".m3u8")) {
+		s64 msn, part=-1, seq, nb_seg, nb_parts;
+		u32 td;
+		HTTPOutHLSPlaylist *pl = NULL;
+		const char *part_str = strstr(query, "_HLS_part=");
+		msn = atoll(msn_str+9);
+		if (part_str) part = atoll(part_str+10);
+		if ((msn<0) || (part_str && (part<0)))
+			return 400;
+
+		//playlist is being written, wait for it
+		if (source_pid) {
+			if (sess->hold_until && (now >= sess->hold_until)) return 0;
+			goto hold;
+		}
+		//use playlist state of the last update, valid for both file and memory outputs
+		count = gf_list_count(ctx->hls_playlists);
+		for (i=0; i<count; i++) {
+			pl = gf_list_get(ctx->hls_playlists, i);
+			if (!strcmp(pl->path, url)) break;
+			pl = NULL;
+		}
+		//not produced by this server, no update to wait for
+		if (!pl) return 0;
+		seq = pl->seq;
+		nb_seg = pl->nb_seg;
+		nb_parts = pl->nb_parts;
+		td = pl->td;
+
+		//last complete segment is seq+nb_seg-1, segment in progress is seq+nb_seg
+		if (msn > seq + nb_seg + 1) return 400;
+		if (msn < seq + nb_seg) return 0;
+		if ((part>=0) && (msn == seq + nb_seg) && (nb_parts > part)) return 0;
+
+		if (!sess->hold_until) {
+			if (!td) td = 2;
+			sess->hold_until = now + 3 * (u64) td * 1000000;
+		} else if (now >= sess->hold_until) {
+			return 503;
+		}
+		goto hold;
+	}
+	if (full_path || source_pid) return 0;
+
+	//preload hint on LL-HLS part not yet produced: wait if an LL-HLS input is live
+	const char *sep = strrchr(url, '.');
+	if (!sep || !sep[1]) return 0;
+	for (i=1; sep[i]; i++) {
+		if ((sep[i]<'0') || (sep[i]>'9')) return 0;
+	}
+	count = gf_list_count(ctx->inputs);
+	for (i=0; i<count; i++) {
+		GF_HTTPOutInput *in = gf_list_get(ctx->inputs, i);
+		if (in->is_llhls && in->ipid && !gf_filter_pid_is_eos(in->ipid)) break;
+	}
+	if (i==count) return 0;
+	if (!sess->hold_until) {
+		sess->hold_until = now + (u64) (ctx->timeout ? ctx->timeout : 10) * 1000000;
+	} else if (now >= sess->hold_until) {
+		return 0;
+	}
+
+hold:
+	if (!sess->hold_until)
+		sess->hold_until = now + 6000000;
+	sess->hold_check = now;
+	sess->hold_version = ctx->hold_version;
+	return 1;
+}
+
 static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 {
 	const char *durl="";
@@ -1569,6 +1727,17 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		return;
 	}
 
+	//strip query string, resolve resource on path only
+	const char *query = strchr(durl, '?');
+	if (query) {
+		char *path = gf_strdup(durl);
+		path[query - durl] = 0;
+		gf_free(url);
+		url = gf_url_percent_decode(path);
+		gf_free(path);
+		query++;
+	}
+
 	/*first check active inputs*/
 	count = gf_list_count(sess->ctx->inputs);
 	//delete only accepts local files
@@ -1691,6 +1860,22 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		}
 	}
 
+	if (!is_options && ((parameter->reply == GF_HTTP_GET) || (parameter->reply == GF_HTTP_HEAD))) {
+		u32 hold = httpout_check_hold(sess, url, query, full_path, source_pid);
+		if (hold==1) {
+			sess->method_type = parameter->reply;
+			if (full_path) gf_free(full_path);
+			if (url) gf_free(url);
+			return;
+		}
+		sess->hold_until = 0;
+		if (hold) {
+			sess->reply_code = hold;
+			if (full_path) gf_free(full_path);
+			goto exit;
+		}
+	}
+
 	if (!full_path && !source_pid) {
 		if (!sess->ctx->dlist || strcmp(url, "/")) {
 			sess->reply_code = 404;
@@ -1800,6 +1985,8 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 
 		sess->file_pos = sess->file_size = 0;
 		sess->use_chunk_transfer = GF_TRUE;
+		//start at the end of the shared buffer
+		sess->relay_pos = source_pid->relay_base + source_pid->relay_size;
 	}
 	/*we have matching etag*/
 	else if (etag && !strcmp(etag, szETag) && !sess->ctx->no_etag) {
@@ -2952,7 +3139,7 @@ static GF_Err httpout_initialize(GF_Filter *filter)
 			flags = JS_EVAL_TYPE_MODULE;
 		}
 
-		ret = buf ? JS_Eval(ctx->jsc, (char *)buf, buf_len, ctx->js, flags) : JS_TRUE;
+		ret = buf ? qjs_eval_cached(ctx->jsc, (char *)buf, buf_len, ctx->js, flags) : JS_TRUE;
 		if (buf) gf_free(buf);
 
 		if (JS_IsException(ret)) {
@@ -3029,8 +3216,9 @@ static void httpout_close_hls_chunk(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, Boo
 		for (i=0; i<count; i++) {
 			GF_HTTPOutSession *sess = gf_list_get(ctx->sessions, i);
 			if (sess->in_source != in) continue;
+			//only one LL-HLS chunk is in progress per input, sessions on previous chunks are already detached
+			//note: sess->path is the chunk path, or its gfio:// url in mem mode, never the segment path
 			if (!sess->in_source_is_ll_hls_chunk) continue;
-			if (strcmp(sess->path, in->local_path)) continue;
 
 			gf_assert(sess->file_in_progress);
 			if (sess->in_source) {
@@ -3081,6 +3269,7 @@ static void httpout_finalize(GF_Filter *filter)
 		httpout_close_hls_chunk(ctx, in, GF_TRUE);
 
 		if (in->resource) gf_fclose(in->resource);
+		if (in->relay) gf_free(in->relay);
 		if (in->llhls_upload) gf_dm_sess_del(in->llhls_upload);
 		if (in->llhls_url) gf_free(in->llhls_url);
 		if (in->upload) {
@@ -3136,6 +3325,13 @@ static void httpout_finalize(GF_Filter *filter)
 	}
 	gf_list_del(ctx->directories);
 
+	while (gf_list_count(ctx->hls_playlists)) {
+		HTTPOutHLSPlaylist *pl = gf_list_pop_back(ctx->hls_playlists);
+		gf_free(pl->path);
+		gf_free(pl);
+	}
+	gf_list_del(ctx->hls_playlists);
+
 #ifdef GPAC_HAS_QJS
 	if (ctx->jsc) {
 		httpout_cleanup_js(ctx);
@@ -3242,7 +3438,13 @@ static void log_request_done(GF_HTTPOutSession *sess)
 			unit = "kbps";
 			bps/=1000;
 		}
-		GF_LOG(GF_LOG_INFO, GF_LOG_ALL, ("[HTTPOut] %sREQ#"LLU" %s done: reply %d - "LLU" bytes in %d ms at %g %s\n", sprefix, sess->req_id, get_method_name(sess->method_type), sess->reply_code, sess->nb_bytes, (u32) (diff_us/1000), bps, unit));
+		u64 ktls_bytes, tls_bytes;
+		gf_dm_sess_get_tls_stats(sess->http_sess, &ktls_bytes, &tls_bytes);
+		if (ktls_bytes || tls_bytes) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_ALL, ("[HTTPOut] %sREQ#"LLU" %s done: reply %d - "LLU" bytes in %d ms at %g %s - TLS "LLU" bytes kTLS "LLU" bytes userspace\n", sprefix, sess->req_id, get_method_name(sess->method_type), sess->reply_code, sess->nb_bytes, (u32) (diff_us/1000), bps, unit, ktls_bytes, tls_bytes));
+		} else {
+			GF_LOG(GF_LOG_INFO, GF_LOG_ALL, ("[HTTPOut] %sREQ#"LLU" %s done: reply %d - "LLU" bytes in %d ms at %g %s\n", sprefix, sess->req_id, get_method_name(sess->method_type), sess->reply_code, sess->nb_bytes, (u32) (diff_us/1000), bps, unit));
+		}
 	}
 }
 
@@ -3447,7 +3649,8 @@ static void httpout_process_session(GF_Filter *filter, GF_HTTPOutCtx *ctx, GF_HT
 		}
 		e = gf_dm_sess_process(sess->http_sess);
 
-		if ((e==GF_IP_NETWORK_EMPTY) || (sess->async_pending==1)) {
+		//reply pending (async JS or request on hold)
+		if ((e==GF_IP_NETWORK_EMPTY) || (sess->async_pending==1) || sess->hold_until) {
 			return;
 		}
 
@@ -3583,32 +3786,75 @@ resend:
 		if (to_read > (u64) sess->ctx->block_size)
 			to_read = (u64) sess->ctx->block_size;
 
-		if (sess->comp_data) {
-			memcpy(sess->buffer, sess->comp_data+sess->file_pos, to_read);
-			read = (u32) to_read;
-		}
-		else if (sess->resource) {
-			read = (u32) gf_fread(sess->buffer, (u32) to_read, sess->resource);
-			//may happen when file writing is in progress
-			if (!read) {
-				sess->last_active_time = gf_sys_clock_high_res();
-				return;
+		e = GF_NOT_SUPPORTED;
+		read = 0;
+		//kTLS offload active, send directly from file without userspace copy and encryption
+		if (sess->resource && !sess->comp_data && !sess->is_h2 && !sess->use_chunk_transfer) {
+			e = gf_dm_sess_send_file(sess->http_sess, sess->resource, sess->file_pos, (u32) to_read, &read);
+			if (e != GF_NOT_SUPPORTED) {
+				//file position is no longer in sync with file_pos
+				sess->resource_seek = GF_TRUE;
+				if (e==GF_IP_NETWORK_EMPTY) {
+					sess->last_active_time = gf_sys_clock_high_res();
+					return;
+				}
 			}
-		} else {
-			read = (u32) to_read;
 		}
-		//transfer of file being uploaded, use chunk transfer
-		if (!sess->is_h2 && sess->use_chunk_transfer) {
-			char szHdr[100];
-			u32 len;
-			sprintf(szHdr, "%X\r\n", read);
-			len = (u32) strlen(szHdr);
+		if (e == GF_NOT_SUPPORTED) {
+			u8 *send_data = sess->buffer;
+			GF_HTTPFileIO *rio = NULL;
+			if (sess->resource && ctx->mem_url && gf_fileio_check(sess->resource)) {
+				rio = gf_fileio_get_udta((GF_FileIO *) sess->resource);
+				if (rio && !rio->parent) rio = NULL;
+			}
 
-			e = gf_dm_sess_send(sess->http_sess, szHdr, len);
-			e |= gf_dm_sess_send(sess->http_sess, sess->buffer, read);
-			e |= gf_dm_sess_send(sess->http_sess, "\r\n", 2);
-		} else {
-			e = gf_dm_sess_send(sess->http_sess, sess->buffer, read);
+			if (sess->comp_data) {
+				memcpy(sess->buffer, sess->comp_data+sess->file_pos, to_read);
+				read = (u32) to_read;
+			}
+			//memory file, send directly from the data shared by all readers
+			else if (rio) {
+				read = 0;
+				if (rio->parent->size > sess->file_pos) {
+					read = (u32) to_read;
+					if (read > rio->parent->size - sess->file_pos)
+						read = (u32) (rio->parent->size - sess->file_pos);
+				}
+				if (!read) {
+					sess->last_active_time = gf_sys_clock_high_res();
+					return;
+				}
+				send_data = rio->parent->data + sess->file_pos;
+				rio->pos = sess->file_pos + read;
+				sess->resource_seek = GF_FALSE;
+			}
+			else if (sess->resource) {
+				if (sess->resource_seek) {
+					gf_fseek(sess->resource, sess->file_pos, SEEK_SET);
+					sess->resource_seek = GF_FALSE;
+				}
+				read = (u32) gf_fread(sess->buffer, (u32) to_read, sess->resource);
+				//may happen when file writing is in progress
+				if (!read) {
+					sess->last_active_time = gf_sys_clock_high_res();
+					return;
+				}
+			} else {
+				read = (u32) to_read;
+			}
+			//transfer of file being uploaded, use chunk transfer
+			if (!sess->is_h2 && sess->use_chunk_transfer) {
+				char szHdr[100];
+				u32 len;
+				sprintf(szHdr, "%X\r\n", read);
+				len = (u32) strlen(szHdr);
+
+				e = gf_dm_sess_send(sess->http_sess, szHdr, len);
+				e |= gf_dm_sess_send(sess->http_sess, send_data, read);
+				e |= gf_dm_sess_send(sess->http_sess, "\r\n", 2);
+			} else {
+				e = gf_dm_sess_send(sess->http_sess, send_data, read);
+			}
 		}
 		sess->last_active_time = gf_sys_clock_high_res();
 
@@ -3972,6 +4218,8 @@ static void httpout_close_input_llhls(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in)
 	httpout_close_upload(ctx, in, GF_TRUE);
 }
 
+static GF_Err httpout_relay_send(GF_HTTPOutSession *sess, Bool flush_all);
+
 static void httpout_close_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in)
 {
 	httpout_close_input_llhls(ctx, in);
@@ -4007,10 +4255,22 @@ static void httpout_close_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in)
 		}
 
 		if (in->resource) {
+			Bool is_hls_pl = GF_FALSE;
 			gf_assert(in->local_path);
 			//close all LL-HLS chunks before closing session
 			httpout_close_hls_chunk(ctx, in, GF_FALSE);
 
+			if (in->is_manifest) {
+				const char *ext = gf_file_ext_start(in->path);
+				if (ext && !strcmp(ext, ".m3u8")) is_hls_pl = GF_TRUE;
+			}
+			//in mem mode, parse the playlist from the shared file data
+			if (is_hls_pl && ctx->mem_url) {
+				GF_HTTPFileIO *hio = gf_fileio_get_udta((GF_FileIO *) in->resource);
+				if (hio) httpout_parse_hls_playlist(ctx, in->path, hio->data, (u32) hio->size);
+				is_hls_pl = GF_FALSE;
+			}
+
 			//detach all clients from this input and reassign to a regular output
 			count = gf_list_count(ctx->sessions);
 			for (i=0; i<count; i++) {
@@ -4033,12 +4293,24 @@ static void httpout_close_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in)
 			}
 			gf_fclose(in->resource);
 			in->resource = NULL;
+
+			if (is_hls_pl) {
+				u8 *data;
+				u32 size;
+				if (gf_file_load_data(in->local_path, &data, &size) == GF_OK) {
+					httpout_parse_hls_playlist(ctx, in->path, data, size);
+					gf_free(data);
+				}
+			}
 		} else {
 			count = gf_list_count(ctx->active_sessions);
 			for (i=0; i<count; i++) {
 				GF_HTTPOutSession *sess = gf_list_get(ctx->active_sessions, i);
 				if (!sess->http_sess || sess->done) continue;
 				if (sess->in_source != in) continue;
+				//push remaining data of shared buffer, queued in session async buffer if needed
+				httpout_relay_send(sess, GF_TRUE);
+				if (sess->done) continue;
 				//if we sent bytes, flush - otherwise session has just started
 				if (sess->nb_bytes) {
 					if (!sess->is_h2)
@@ -4051,8 +4323,11 @@ static void httpout_close_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in)
 					httpout_sess_flush_close(sess, GF_FALSE);
 				}
 			}
+			in->relay_base += in->relay_size;
+			in->relay_size = 0;
 		}
 	}
+	ctx->hold_version++;
 	in->nb_write = 0;
 	in->offset_at_seg_start = 0;
 }
@@ -4085,6 +4360,90 @@ static Bool httpout_open_input_llhls(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, ch
 	return GF_TRUE;
 }
 
+static GF_Err httpout_relay_append(GF_HTTPOutInput *in, const u8 *data, u32 size)
+{
+	if (in->relay_size + size > in->relay_alloc) {
+		in->relay_alloc = (in->relay_size + size) * 3 / 2;
+		in->relay = gf_realloc(in->relay, in->relay_alloc);
+		if (!in->relay) {
+			in->relay_alloc = in->relay_size = 0;
+			return GF_OUT_OF_MEM;
+		}
+	}
+	memcpy(in->relay + in->relay_size, data, size);
+	in->relay_size += size;
+	return GF_OK;
+}
+
+//send data from input shared buffer at the session position - if flush_all is not set, stop as soon as the socket would block
+static GF_Err httpout_relay_send(GF_HTTPOutSession *sess, Bool flush_all)
+{
+	GF_Err e = GF_OK;
+	GF_HTTPOutInput *in = sess->in_source;
+	if (!in || !sess->http_sess || sess->done) return GF_OK;
+
+	while (1) {
+		u8 *data;
+		u32 size;
+		u64 end = in->relay_base + in->relay_size;
+		if (sess->relay_pos >= end) break;
+		//last block not fully sent, remaining bytes are in the session async buffer
+		if (!flush_all && gf_dm_sess_async_pending(sess->http_sess)) break;
+
+		size = (u32) (end - sess->relay_pos);
+		if (!flush_all && (size > sess->ctx->block_size))
+			size = sess->ctx->block_size;
+		data = in->relay + (sess->relay_pos - in->relay_base);
+
+		if (!sess->is_h2) {
+			char szChunkHdr[20];
+			sprintf(szChunkHdr, "%X\r\n", size);
+			e = gf_dm_sess_send(sess->http_sess, szChunkHdr, (u32) strlen(szChunkHdr));
+			e |= gf_dm_sess_send(sess->http_sess, data, size);
+			e |= gf_dm_sess_send(sess->http_sess, "\r\n", 2);
+		} else {
+			e = gf_dm_sess_send(sess->http_sess, data, size);
+		}
+		if ((e==GF_IP_CONNECTION_CLOSED) || (e==GF_URL_REMOVED)) {
+			httpout_close_session(sess, e);
+			return e;
+		}
+		if (e) break;
+		sess->relay_pos += size;
+		sess->nb_bytes += size;
+		sess->last_active_time = gf_sys_clock_high_res();
+	}
+	return e;
+}
+
+//discard data of shared buffer already sent to all sessions
+static void httpout_relay_trim(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in)
+{
+	u32 i, count, drop;
+	u64 min_pos = in->relay_base + in->relay_size;
+	if (!in->relay_size) return;
+
+	count = gf_list_count(ctx->active_sessions);
+	for (i=0; i<count; i++) {
+		GF_HTTPOutSession *sess = gf_list_get(ctx->active_sessions, i);
+		if ((sess->in_source != in) || sess->file_in_progress || sess->done || !sess->http_sess) continue;
+		if (sess->relay_pos < min_pos) min_pos = sess->relay_pos;
+	}
+	drop = (u32) (min_pos - in->relay_base);
+	if (!drop) return;
+	if (drop == in->relay_size) {
+		in->relay_size = 0;
+	}
+	//only move data once half of the buffer is consumed
+	else if (drop >= in->relay_size/2) {
+		memmove(in->relay, in->relay + drop, in->relay_size - drop);
+		in->relay_size -= drop;
+	} else {
+		return;
+	}
+	in->relay_base += drop;
+}
+
 u32 httpout_write_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, const u8 *pck_data, u32 pck_size, Bool file_start)
 {
 	u32 out=0;
@@ -4171,8 +4530,6 @@ retry:
 		}
 
 	} else {
-		char szChunkHdr[100];
-		u32 chunk_hdr_len=0;
 		u32 i, count = gf_list_count(ctx->active_sessions);
 
 		if (in->resource) {
@@ -4189,6 +4546,9 @@ retry:
 			}
 		} else {
 			out = pck_size;
+			//no file IO, store packet once in the shared buffer read by all sessions
+			if (in->nb_dest && (httpout_relay_append(in, pck_data, pck_size) != GF_OK))
+				out = 0;
 		}
 
 		for (i=0; i<count; i++) {
@@ -4216,27 +4576,13 @@ retry:
 				sess->file_size = gf_fsize(sess->resource);
 				gf_fseek(sess->resource, sess->file_pos, SEEK_SET);
 			}
-			/*source is not read from disk, write data*/
+			/*source is not read from disk, send from shared buffer*/
 			else {
-				GF_Err e;
-				if (!sess->is_h2) {
-					if (!chunk_hdr_len) {
-						sprintf(szChunkHdr, "%X\r\n", pck_size);
-						chunk_hdr_len = (u32) strlen(szChunkHdr);
-					}
-					e = gf_dm_sess_send(sess->http_sess, szChunkHdr, chunk_hdr_len);
-					e |= gf_dm_sess_send(sess->http_sess, (u8*) pck_data, pck_size);
-					e |= gf_dm_sess_send(sess->http_sess, "\r\n", 2);
-				} else {
-					e = gf_dm_sess_send(sess->http_sess, (u8*) pck_data, pck_size);
-				}
-				if ((e==GF_IP_CONNECTION_CLOSED) || (e==GF_URL_REMOVED)) {
-					httpout_close_session(sess, e);
-				}
-				if (!e)
-					sess->nb_bytes += pck_size;
+				httpout_relay_send(sess, GF_FALSE);
 			}
 		}
+		if (!in->resource)
+			httpout_relay_trim(ctx, in);
 	}
 	//don't reschedule, we will be notified when new packets are ready
 	ctx->next_wake_us = -1;
@@ -4278,22 +4624,24 @@ static Bool httpout_input_write_ready(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in)
 		//file-based upload
 		if (sess->file_in_progress) continue;
 		//direct stream write, check if ready
-
-		if (!gf_sk_group_sock_is_set(ctx->sg, sess->socket, GF_SK_SELECT_WRITE))
-			continue;
-		nb_ready++;
-		//data still pending, flush. If flush not full, check how many btes are still pending
-		if (gf_dm_sess_flush_async(sess->http_sess, GF_TRUE)==GF_IP_NETWORK_EMPTY) {
-			//decide what to do if one source is not reading fast enough
-			u32 bytes_pending = gf_dm_sess_async_pending(sess->http_sess);
-			if (bytes_pending > ctx->max_async_buf) {
-				GF_LOG(GF_LOG_WARNING, GF_LOG_HTTP, ("[HTTPOut] Peer %s not reading fast enough on shared output connection (%d bytes in async buffer), disconnecting it\n", sess->peer_address, bytes_pending ));
-				httpout_del_session(sess);
-				count--;
-				i--;
-			}
+		if (gf_sk_group_sock_is_set(ctx->sg, sess->socket, GF_SK_SELECT_WRITE)) {
+			nb_ready++;
+			//data still pending, flush. If fully flushed, resume sending from shared buffer
+			if (gf_dm_sess_flush_async(sess->http_sess, GF_TRUE) != GF_IP_NETWORK_EMPTY)
+				httpout_relay_send(sess, GF_FALSE);
+			if (sess->done) continue;
+		}
+		//decide what to do if one source is not reading fast enough
+		u64 bytes_pending = in->relay_base + in->relay_size - sess->relay_pos;
+		bytes_pending += gf_dm_sess_async_pending(sess->http_sess);
+		if (bytes_pending > ctx->max_async_buf) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_HTTP, ("[HTTPOut] Peer %s not reading fast enough on shared output connection ("LLU" bytes pending), disconnecting it\n", sess->peer_address, bytes_pending ));
+			httpout_del_session(sess);
+			count--;
+			i--;
 		}
 	}
+	httpout_relay_trim(ctx, in);
 	return nb_ready ? GF_TRUE : GF_FALSE;
 }
 
@@ -4555,6 +4903,9 @@ next_pck:
 			in->hls_chunk_local_path = gf_strdup(szHLSChunk);
 			snprintf(szHLSChunk, GF_MAX_PATH-1, "%s.%d", in->path, p->value.uint);
 			in->hls_chunk_path = gf_strdup(szHLSChunk);
+			in->is_llhls = GF_TRUE;
+			//new part available, check requests on hold
+			ctx->hold_version++;
 
 			if (ctx->mem_url && in->hls_chunk) {
 				GF_HTTPFileIO *hio = gf_fileio_get_udta((GF_FileIO *) in->hls_chunk);
@@ -4774,10 +5125,38 @@ packet_done:
 		gf_filter_post_process_task(ctx->filter);
 }
 
+//resume requests on hold when new content is produced, on deadline or periodically
+static u32 httpout_check_held_requests(GF_HTTPOutCtx *ctx)
+{
+	u32 nb_held = 0;
+	u32 i, count = gf_list_count(ctx->active_sessions);
+	for (i=0; i<count; i++) {
+		u64 now;
+		GF_HTTPOutSession *sess = gf_list_get(ctx->active_sessions, i);
+		if (!sess->hold_until) continue;
+		if (!sess->http_sess) {
+			sess->hold_until = 0;
+			continue;
+		}
+		now = gf_sys_clock_high_res();
+		if ((sess->hold_version != ctx->hold_version) || (now >= sess->hold_until) || (now >= sess->hold_check + 100000)) {
+			GF_NETIO_Parameter par;
+			memset(&par, 0, sizeof(GF_NETIO_Parameter));
+			par.msg_type = GF_NETIO_PARSE_REPLY;
+			par.reply = sess->method_type;
+			sess->last_active_time = now;
+			httpout_sess_io(sess, &par);
+		}
+		if (sess->hold_until) nb_held++;
+		else ctx->next_wake_us = 1;
+	}
+	return nb_held;
+}
+
 static GF_Err httpout_process(GF_Filter *filter)
 {
 	GF_Err e=GF_OK;
-	u32 i, count;
+	u32 i, count, nb_held;
 	GF_HTTPOutCtx *ctx = gf_filter_get_udta(filter);
 
 	if (ctx->done && !ctx->nb_sess_flush_pending)
@@ -4795,6 +5174,7 @@ static GF_Err httpout_process(GF_Filter *filter)
 	ctx->next_wake_us = 50000;
 
 	e = gf_sk_group_select(ctx->sg, 10, GF_SK_SELECT_BOTH);
+	nb_held = httpout_check_held_requests(ctx);
 	if ((e==GF_OK) && ctx->server_sock) {
 		//server mode, check pending connections
 		if (gf_sk_group_sock_is_set(ctx->sg, ctx->server_sock, GF_SK_SELECT_READ)) {
@@ -4823,8 +5203,19 @@ static GF_Err httpout_process(GF_Filter *filter)
 			}
 
 
-			//if true push, don't process
-			if (sess->in_source && !sess->file_in_progress) continue;
+			//request on hold, wait for resume
+			if (sess->hold_until) continue;
+
+			//if true push, don't process - resume sending from shared buffer once pending data is flushed
+			if (sess->in_source && !sess->file_in_progress) {
+				if (sess->http_sess && !sess->done
+					&& gf_sk_group_sock_is_set(ctx->sg, sess->socket, GF_SK_SELECT_WRITE)
+					&& (gf_dm_sess_flush_async(sess->http_sess, GF_TRUE) != GF_IP_NETWORK_EMPTY)
+				) {
+					httpout_relay_send(sess, GF_FALSE);
+				}
+				continue;
+			}
 
 			//regular download
 			if (sess->http_sess)
@@ -4852,6 +5243,10 @@ static GF_Err httpout_process(GF_Filter *filter)
 
 	httpout_process_inputs(ctx);
 
+	//requests on hold, check them periodically
+	if (nb_held && ((ctx->next_wake_us<=0) || (ctx->next_wake_us>10000)))
+		ctx->next_wake_us = 10000;
+
 	if (ctx->timeout && ctx->server_sock) {
 		u32 nb_active=0;
 		count = gf_list_count(ctx->active_sessions);
@@ -5004,7 +5399,7 @@ static const GF_FilterArgs HTTPOutArgs[] =
 	{ OFFS(max_client_errors), "force disconnection after specified number of consecutive errors from HTTTP 1.1 client (ignored in H/2 or when `close` is set)", GF_PROP_UINT, "20", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(max_cache_segs), "maximum number of segments cached per HAS quality (see filter help)", GF_PROP_SINT, "5", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(reopen), "in server mode with no read dir, accept requests on files already over but with input pid not in end of stream", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
-	{ OFFS(max_async_buf), "maximum async buffer size in bytes when sharing output over multiple connection without file IO", GF_PROP_UINT, "100000", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(max_async_buf), "maximum pending data in bytes for a client when sharing output over multiple connection without file IO", GF_PROP_UINT, "100000", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(blockio), "use blocking IO in push or source mode or in server mode with no read dir", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(ka), "keep input alive if failure in push mode", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(hdrs), "additional HTTP headers to inject, even values are names, odd values are values ", GF_PROP_STRING_LIST, NULL, NULL, GF_FS_ARG_HINT_ADVANCED},
@@ -5076,6 +5471,8 @@ GF_FilterRegister HTTPOutRegister = {
 		"EX gpac -i MP3_SOURCE reframer:rt=on -o http://localhost/live.mp3\n"
 		"In this example, the server will push each input packet to all connected clients, or trash the packet if no connected clients.\n"
 		"  \n"
+		"Input packets are stored once in a buffer shared by all clients, each client reading from its own position in this buffer. A client lagging behind by more than [-max_async_buf]() bytes is disconnected.\n"
+		"  \n"
 		"In this mode, ICECast meta-data can be inserted using [-ice](). The default inserted values are `ice-audio-info`, `icy-br`, `icy-pub` (set to 1) and `icy-name` if input `ServiceName` property is set.\n"
 		"The server will also look for any property called `ice-*` on the input PID and inject them.\n"
 		"EX gpac -i source.mp3:#ice-Genre=CoolRock -o http://IP/live.mp3 --ice\n"
@@ -5098,7 +5495,14 @@ GF_FilterRegister HTTPOutRegister = {
 		"In this example, a real-time dynamic DASH session with chunks of 100ms is created, writing files to `temp`. A client connecting to the live edge will receive segments as they are produced using HTTP chunk transfer.\n"
 		"  \n"
 		"The server can store incoming files to memory mode by setting the read directory to `gmem`.\n"
-		"In this mode, [-max_cache_segs]() is always at least 1.\n"
+		"In this mode, [-max_cache_segs]() is always at least 1, and all clients are served from the same memory copy of each file.\n"
+		"  \n"
+		"For LL-HLS, the server supports blocking playlist reload (requests using `_HLS_msn` and `_HLS_part` query parameters) and preload hints:\n"
+		"- a playlist request is held until the playlist contains the requested segment or part, and answered with error 503 after three times the target duration\n"
+		"- a request for a part not yet produced is held until the part is created, or until [-timeout]() expires\n"
+		"  \n"
+		"This is signaled in playlists produced by the dasher using [-ll_can_block](dasher).\n"
+		"EX gpac -i SOURCE reframer:rt=on -o http://localhost:8080/live.m3u8:llhls=sf:ll_can_block --rdirs=gmem --dmode=dynamic --cdur=0.2\n"
 		"  \n"
 		"If [-max_cache_segs]() value `N` is not 0, each incoming PID will store at most:\n"
 		"- `MIN(N, time-shift depth)` files if stored in memory\n"
@@ -5125,6 +5529,8 @@ GF_FilterRegister HTTPOutRegister = {
 		"Both certificate and key must be in PEM format.\n"
 		"The server currently only operates in either HTTPS or HTTP mode and cannot run both modes at the same time. You will need to use two httpout filters for this, one operating in HTTPS and one operating in HTTP.\n"
 		"  \n"
+		"On Linux, kernel TLS offload can be enabled using [-ktls](CORE). When the kernel accepts the session keys, files are sent using `sendfile` without userspace copy and encryption (HTTP/1.1 only, not for chunk transfer or compressed replies). The request log then indicates the amount of bytes sent through kTLS and through userspace TLS.\n"
+		"  \n"
 		"# Multiple destinations on single server\n"
 		"When running in server mode, multiple HTTP outputs with same URL/port may be used:\n"
 		"- the first loaded HTTP output filter with same URL/port will be reused\n"
@@ -29,6 +29,7 @@
 #include <gpac/xml.h>
 #include <gpac/route.h>
 #include <gpac/network.h>
+#include <gpac/internal/reedsolomon.h>
 
 #if !defined(GPAC_DISABLE_ROUTE)
 
@@ -42,7 +43,7 @@ enum
 typedef struct
 {
 	char *dst, *ext, *mime, *ifce, *ip;
-	u32 carousel, first_port, bsid, mtu, splitlct, ttl, brinc, runfor;
+	u32 carousel, first_port, bsid, mtu, splitlct, ttl, brinc, runfor, fec, fecblk;
 	Bool korean, llmode, noreg, nozip;
 
 	GF_FilterCapability in_caps[2];
@@ -65,6 +66,10 @@ typedef struct
 	u64 bytes_sent;
 	u8 *lct_buffer;
 
+	//FEC symbol size and scratch buffer for repair symbols and padded last source symbol
+	u32 fec_sym_size;
+	u8 *fec_buf;
+
 	u64 reschedule_us;
 	u32 next_raw_file_toi;
 
@@ -169,6 +174,10 @@ typedef struct
 	u32 pck_dur_at_frame_start;
 
 	u32 bitrate;
+
+	//object reassembly for FEC encoding when segments are delivered in several packets
+	u8 *fec_obj;
+	u32 fec_obj_size, fec_obj_alloc;
 } ROUTEPid;
 
 
@@ -272,6 +281,7 @@ void routeout_remove_pid(ROUTEPid *rpid, Bool is_rem)
 	if (rpid->hld_child_pl_name) gf_free(rpid->hld_child_pl_name);
 	if (rpid->template) gf_free(rpid->template);
 	if (rpid->seg_name) gf_free(rpid->seg_name);
+	if (rpid->fec_obj) gf_free(rpid->fec_obj);
 
 	if (rpid->current_pck)
 		gf_filter_pck_unref(rpid->current_pck);
@@ -649,6 +659,26 @@ static GF_Err routeout_initialize(GF_Filter *filter)
 	}
 
 	ctx->lct_buffer = gf_malloc(sizeof(u8) * ctx->mtu);
+
+	if (ctx->fec) {
+		//repair packets carry LCT header, FTI extension and FEC payload ID (36 bytes)
+		if (ctx->mtu <= 36 + 16) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] MTU %u too small for FEC repair packets\n", ctx->mtu));
+			return GF_BAD_PARAM;
+		}
+		ctx->fec_sym_size = ctx->mtu - 36;
+		if (!ctx->fecblk) ctx->fecblk = 1;
+		//source and repair symbols of a block must fit in 255 ESIs
+		if (ctx->fecblk * (100 + ctx->fec) > GF_RS_FEC_MAX_SYMBOLS * 100) {
+			u32 max_k = GF_RS_FEC_MAX_SYMBOLS * 100 / (100 + ctx->fec);
+			if (!max_k) max_k = 1;
+			GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] FEC overhead %u%% too high for %u source symbols per block, using %u source symbols\n", ctx->fec, ctx->fecblk, max_k));
+			ctx->fecblk = max_k;
+		}
+		ctx->fec_buf = gf_malloc(sizeof(u8) * ctx->fec_sym_size * (GF_RS_FEC_MAX_SYMBOLS+1));
+		if (!ctx->fec_buf) return GF_OUT_OF_MEM;
+		GF_LOG(GF_LOG_INFO, GF_LOG_ROUTE, ("[ROUTE] FEC enabled: %u%% repair, %u bytes symbols, %u source symbols per block (%s)\n", ctx->fec, ctx->fec_sym_size, ctx->fecblk, gf_rs_fec_get_impl() ));
+	}
 	ctx->clock_init = gf_sys_clock_high_res();
 	ctx->clock_stats = ctx->clock_init;
 
@@ -676,6 +706,7 @@ static void routeout_finalize(GF_Filter *filter)
 		gf_sk_del(ctx->sock_atsc_lls);
 
 	if (ctx->lct_buffer) gf_free(ctx->lct_buffer);
+	if (ctx->fec_buf) gf_free(ctx->fec_buf);
 	if (ctx->lls_slt_table) gf_free(ctx->lls_slt_table);
 	if (ctx->lls_time_table) gf_free(ctx->lls_time_table);
 }
@@ -1222,7 +1253,7 @@ static GF_Err routeout_check_service_updates(GF_ROUTEOutCtx *ctx, ROUTEService *
 				gf_dynstrcat(&payload_text, "/>\n", NULL);
 				gf_dynstrcat(&payload_text, "    </ContentInfo>\n", NULL);
 			}
-			//setup payload format - we remove srcFecPayloadId=\"0\" as there is no FEC support yet
+			//setup payload format - we remove srcFecPayloadId=\"0\": source packets never carry an FEC payload ID, repair packets (if any) use the same TSI and TOI
 			snprintf(temp, 1000,
 					"    <Payload codePoint=\"%d\" formatId=\"%d\" frag=\"0\" order=\"true\"/>\n"
 					, rpid->fmtp, rpid->mode);
@@ -1289,6 +1320,10 @@ u32 routeout_lct_send(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u3
 	} else {
 		send_payl_size = len - offset;
 	}
+	//align source packets on FEC symbols so that a packet loss only erases one symbol
+	if (ctx->fec_sym_size && (send_payl_size > ctx->fec_sym_size))
+		send_payl_size = ctx->fec_sym_size;
+
 	ctx->lct_buffer[0] = 0x12; //V=b0001, C=b00, PSI=b10
 	ctx->lct_buffer[1] = 0xA0; //S=b1, 0=b01, h=b0, res=b00, A=b0, B=X
 	//set close flag only if total_len is known
@@ -1347,6 +1382,107 @@ u32 routeout_lct_send(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u3
 	return send_payl_size;
 }
 
+static void routeout_lct_send_fec(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u32 codepoint, const u8 *payload, u32 len, u32 service_id)
+{
+	u32 nb_blocks, k_large, k_small, nb_large, b, i, r, sym_start, hpos, fpid;
+	u32 E = ctx->fec_sym_size;
+	GF_Err e;
+
+	if (!E || !len) return;
+	gf_rs_fec_partition(len, E, ctx->fecblk, &nb_blocks, &k_large, &k_small, &nb_large);
+	if (nb_blocks > 0xFFFFFF) return;
+
+	sym_start = 0;
+	for (b=0; b<nb_blocks; b++) {
+		const u8 *src[GF_RS_FEC_MAX_SYMBOLS];
+		u8 *repair[GF_RS_FEC_MAX_SYMBOLS];
+		u32 k = (b<nb_large) ? k_large : k_small;
+		u32 nb_repair = (k * ctx->fec + 99) / 100;
+		if (k + nb_repair > GF_RS_FEC_MAX_SYMBOLS) nb_repair = GF_RS_FEC_MAX_SYMBOLS - k;
+
+		for (i=0; i<k; i++) {
+			u64 start = (u64) (sym_start + i) * E;
+			src[i] = payload + start;
+			//zero-pad last symbol, stored after repair symbols
+			if (start + E > len) {
+				u8 *last = ctx->fec_buf + GF_RS_FEC_MAX_SYMBOLS * E;
+				memcpy(last, src[i], (u32) (len - start));
+				memset(last + len - start, 0, (u32) (start + E - len));
+				src[i] = last;
+			}
+		}
+		for (r=0; r<nb_repair; r++)
+			repair[r] = ctx->fec_buf + r * E;
+
+		if (gf_rs_fec_encode(src, k, repair, nb_repair, E) != GF_OK) {
+			sym_start += k;
+			continue;
+		}
+
+		for (r=0; r<nb_repair; r++) {
+			ctx->lct_buffer[0] = 0x10; //V=b0001, C=b00, PSI=b00
+			ctx->lct_buffer[1] = 0xA0; //S=b1, 0=b01, h=b0, res=b00, A=b0, B=0
+			//FEC payload ID is not part of the header
+			ctx->lct_buffer[2] = 8;
+			ctx->lct_buffer[3] = (u8) codepoint;
+			hpos = 4;
+			//CCI=0
+			PUT_U32(0);
+			PUT_U32(tsi);
+			PUT_U32(toi);
+			//FTI for Reed-Solomon over GF(2^8), RFC 5510
+			ctx->lct_buffer[hpos] = GF_LCT_EXT_FTI;
+			ctx->lct_buffer[hpos+1] = 4;
+			ctx->lct_buffer[hpos+2] = 0;
+			ctx->lct_buffer[hpos+3] = 0;
+			hpos+=4;
+			PUT_U32(len);
+			ctx->lct_buffer[hpos] = 8; //m
+			ctx->lct_buffer[hpos+1] = 1; //G
+			ctx->lct_buffer[hpos+2] = (E>>8) & 0xFF;
+			ctx->lct_buffer[hpos+3] = E & 0xFF;
+			hpos+=4;
+			ctx->lct_buffer[hpos] = (ctx->fecblk>>8) & 0xFF;
+			ctx->lct_buffer[hpos+1] = ctx->fecblk & 0xFF;
+			ctx->lct_buffer[hpos+2] = 0;
+			ctx->lct_buffer[hpos+3] = GF_RS_FEC_MAX_SYMBOLS;
+			hpos+=4;
+			//FEC payload ID: SBN and ESI
+			fpid = (b<<8) | (k+r);
+			PUT_U32(fpid);
+
+			memcpy(ctx->lct_buffer + hpos, repair[r], E);
+			e = gf_sk_send(sock, ctx->lct_buffer, E + hpos);
+			if (e) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] Failed to send LCT repair symbol TSI %u TOI %u: %s\n", tsi, toi, gf_error_to_string(e) ));
+			}
+			ctx->bytes_sent += E + hpos;
+		}
+		sym_start += k;
+	}
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] LCT SID %u TSI %u TOI %u sent repair symbols for %u source blocks\n", service_id, tsi, toi, nb_blocks));
+}
+
+static void routeout_send_object_fec(GF_ROUTEOutCtx *ctx, ROUTEService *serv, ROUTEPid *rpid)
+{
+	const u8 *data;
+	u32 size;
+	//object not yet complete
+	if (!rpid->full_frame_size) return;
+
+	if (rpid->raw_file || !rpid->frag_idx) {
+		data = rpid->pck_data;
+		size = rpid->pck_size;
+	} else {
+		if (rpid->cumulated_frag_size != rpid->full_frame_size) return;
+		data = rpid->fec_obj;
+		size = rpid->fec_obj_size;
+	}
+	if (size != rpid->full_frame_size) return;
+
+	routeout_lct_send_fec(ctx, rpid->rlct->sock, rpid->tsi, rpid->current_toi, rpid->raw_file ? rpid->fmtp : 8, data, size, serv->service_id);
+}
+
 static GF_Err routeout_service_send_bundle(GF_ROUTEOutCtx *ctx, ROUTEService *serv)
 {
 	u32 offset = 0;
@@ -1592,6 +1728,23 @@ retry:
 		}
 	}
 
+	//keep a copy of fragmented objects for FEC encoding
+	if (ctx->fec) {
+		if (start) rpid->fec_obj_size = 0;
+		if (!start || !end) {
+			if (rpid->fec_obj_size + rpid->pck_size > rpid->fec_obj_alloc) {
+				rpid->fec_obj_alloc = rpid->fec_obj_size + rpid->pck_size;
+				rpid->fec_obj = gf_realloc(rpid->fec_obj, rpid->fec_obj_alloc);
+			}
+			if (rpid->fec_obj) {
+				memcpy(rpid->fec_obj + rpid->fec_obj_size, rpid->pck_data, rpid->pck_size);
+				rpid->fec_obj_size += rpid->pck_size;
+			} else {
+				rpid->fec_obj_size = rpid->fec_obj_alloc = 0;
+			}
+		}
+	}
+
 
 	pck_dur = gf_filter_pck_get_duration(rpid->current_pck);
 	//check if duration is for the entire segment or this fragment (cf forward=file in dmx_dash.c)
@@ -1757,6 +1910,8 @@ next_packet:
 					}
 					offset += routeout_lct_send(ctx, rpid->rlct->sock, rpid->tsi, ROUTE_INIT_TOI, codepoint, (u8 *) rpid->init_seg_data, rpid->init_seg_size, offset, serv->service_id, rpid->init_seg_size, offset);
 				}
+				if (ctx->fec)
+					routeout_lct_send_fec(ctx, rpid->rlct->sock, rpid->tsi, ROUTE_INIT_TOI, rpid->init_seg_sent ? 7 : 5, rpid->init_seg_data, rpid->init_seg_size, serv->service_id);
 				if (ctx->reporting_on) {
 					ctx->total_size += rpid->init_seg_size;
 					ctx->total_bytes = rpid->init_seg_size;
@@ -1774,6 +1929,8 @@ next_packet:
 				//we use codepoint 1 (NRT - file mode) for subplaylists
 				offset += routeout_lct_send(ctx, rpid->rlct->sock, rpid->tsi, ROUTE_INIT_TOI-1, 1, (u8 *) rpid->hld_child_pl, hls_len, offset, serv->service_id, hls_len, offset);
 			}
+			if (ctx->fec)
+				routeout_lct_send_fec(ctx, rpid->rlct->sock, rpid->tsi, ROUTE_INIT_TOI-1, 1, (u8 *) rpid->hld_child_pl, hls_len, serv->service_id);
 			if (ctx->reporting_on) {
 				ctx->total_size += hls_len;
 				ctx->total_bytes = hls_len;
@@ -1821,6 +1978,9 @@ next_packet:
 		assert (rpid->pck_offset <= rpid->pck_size);
 
 		if (rpid->pck_offset == rpid->pck_size) {
+			if (ctx->fec)
+				routeout_send_object_fec(ctx, serv, rpid);
+
 			//print fragment push info except if single fragment
 			if (rpid->frag_idx || !rpid->full_frame_size) {
 				GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] pushed fragment %s#%d (%d bytes) in "LLU" us - target push "LLU" us\n", rpid->seg_name, rpid->frag_idx+1, rpid->pck_size, ctx->clock - rpid->clock_at_pck, rpid->current_dur_us));
@@ -2191,6 +2351,8 @@ static const GF_FilterArgs ROUTEOutArgs[] =
 
 	{ OFFS(runfor), "run for the given time in ms", GF_PROP_UINT, "0", NULL, 0},
 	{ OFFS(nozip), "do not zip signaling package (STSID+manifest)", GF_PROP_BOOL, "false", NULL, 0},
+	{ OFFS(fec), "send Reed-Solomon repair symbols for each object, in percent of the object size (0 disables FEC)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(fecblk), "maximum number of source symbols per FEC source block", GF_PROP_UINT, "64", "1-254", GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -2265,6 +2427,13 @@ GF_FilterRegister ROUTEOutRegister = {
 		"If this fails, the filter will trigger warnings and send as fast as possible.\n"
 		"Note: The LCT objects are sent with no length (TOL header) assigned until the final segment size is known, potentially leading to a final 0-size LCT fragment signaling only the final size.\n"
 		"\n"
+		"# Forward error correction\n"
+		"When [-fec]() is set, the filter sends Reed-Solomon repair symbols (RFC 5510, GF(2^8)) after the last source packet of each media segment, init segment, HLS child playlist and raw file.\n"
+		"Repair packets use the same TSI and TOI as the object, with PSI=b00, an FTI header extension and a source block number / encoding symbol ID instead of the start offset.\n"
+		"Source packets are aligned on FEC symbols, and objects are split in source blocks of at most [-fecblk]() symbols.\n"
+		"A receiver recovers an object as long as, in each source block, the number of repair symbols received is at least the number of lost source symbols.\n"
+		"EX gpac -i source.mp4 dasher -o route://225.1.1.0:6000/manifest.mpd:fec=20\n"
+		"\n"
 		"# Examples\n"
 		"Since the ROUTE filter only consumes files, it is required to insert:\n"
 		"- the dash demultiplexer in file forwarding mode when loading a DASH session\n"
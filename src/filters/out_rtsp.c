@@ -97,7 +97,8 @@ typedef struct
 	u32 block_size;
 	Bool close, loop, mpeg4, quit, htun, dynurl;
 	u32 mcast, trp;
-	Bool latm;
+	Bool latm, shared;
+	u32 shring;
 
 	GF_Filter *filter;
 	GF_Socket *server_sock;
@@ -113,6 +114,45 @@ typedef struct
 	u32 ms_timeout;
 } GF_RTSPOutCtx;
 
+/*RTP packet of a shared source, with 12 bytes reserved before payload for header rewrite*/
+typedef struct
+{
+	GF_RTPHeader hdr;
+	/*CTS of the AU in microseconds*/
+	u64 us;
+	/*first packet of a SAP AU*/
+	Bool rap;
+	u8 *data;
+	u32 size, alloc;
+} RTSPSharedPacket;
+
+/*ring of packets produced by the streamer of a shared source stream*/
+typedef struct
+{
+	GF_RTPOutStream *stream;
+	RTSPSharedPacket *pcks;
+	u32 nb_pcks;
+	/*number of packets produced, and index of first packet of the last SAP AU*/
+	u64 head, last_rap;
+	Bool has_rap;
+	u32 last_au;
+	u32 clock_rate;
+} RTSPSharedRing;
+
+/*client stream forwarding packets from a shared source ring*/
+typedef struct
+{
+	RTSPSharedRing *ring;
+	GF_RTPChannel *ch;
+	u32 ctrl_id;
+	u32 rtp_id, rtcp_id;
+	Bool selected, started, bye_sent;
+	/*index of next packet to send in ring*/
+	u64 next;
+	u16 seq_offset;
+	u32 ts_offset;
+} RTSPFwdStream;
+
 typedef struct __rtspout_session
 {
 	GF_RTSPOutCtx *ctx;
@@ -168,9 +208,20 @@ typedef struct __rtspout_session
 
 	u32 last_active_time;
 	char *setup_ctrl;
+
+	/*shared mode: source session (no RTSP connection) packetizing the resource once*/
+	Bool shared_src, shared_eos;
+	char *shared_url;
+	u32 nb_followers;
+	GF_List *rings;
+	/*shared mode: client session forwarding packets of the source session*/
+	struct __rtspout_session *shared;
+	GF_List *fwd_streams;
 } GF_RTSPOutSession;
 
 static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess, char *ctrl);
+static void rtspout_shared_init_session(GF_RTSPOutSession *sess);
+static GF_Err rtspout_load_media_service(GF_Filter *filter, GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess, char *src_url);
 
 static void rtspout_send_response(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess)
 {
@@ -229,6 +280,9 @@ static GF_Err rtspout_send_sdp(GF_RTSPOutSession *sess)
 	if (sess->mcast_mirror) {
 		ip = sess->mcast_mirror->multicast_ip;
  		e = rtpout_create_sdp(sess->mcast_mirror->streams, GF_FALSE, ip, sess->ctx->info, "livesession", sess->ctx->url, sess->ctx->email, sess->mcast_mirror->base_pid_id, &sdp_out, &sess->sdp_id);
+	} else if (sess->shared) {
+		rtspout_shared_init_session(sess);
+ 		e = rtpout_create_sdp(sess->shared->streams, GF_TRUE, ip, sess->ctx->info, "livesession", sess->ctx->url, sess->ctx->email, sess->shared->base_pid_id, &sdp_out, &sess->sdp_id);
 	} else {
  		e = rtpout_create_sdp(sess->streams, GF_TRUE, ip, sess->ctx->info, "livesession", sess->ctx->url, sess->ctx->email, sess->base_pid_id, &sdp_out, &sess->sdp_id);
 	}
@@ -266,9 +320,67 @@ static void rtspout_del_stream(GF_RTPOutStream *st)
 	rtpout_del_stream(st);
 }
 
+static void rtspout_shared_del_ring(GF_RTSPOutCtx *ctx, RTSPSharedRing *ring)
+{
+	u32 i, j, count = gf_list_count(ctx->sessions);
+	//detach client streams
+	for (i=0; i<count; i++) {
+		GF_RTSPOutSession *a_sess = gf_list_get(ctx->sessions, i);
+		for (j=0; j<gf_list_count(a_sess->fwd_streams); j++) {
+			RTSPFwdStream *fwd = gf_list_get(a_sess->fwd_streams, j);
+			if (fwd->ring==ring) fwd->ring = NULL;
+		}
+	}
+	if (ring->stream && ring->stream->rtp)
+		gf_rtp_streamer_set_packet_callback(ring->stream->rtp, NULL, NULL);
+	for (i=0; i<ring->nb_pcks; i++) {
+		if (ring->pcks[i].data) gf_free(ring->pcks[i].data);
+	}
+	gf_free(ring->pcks);
+	gf_free(ring);
+}
+
+static void rtspout_shared_detach(GF_RTSPOutSession *src)
+{
+	u32 i, count = gf_list_count(src->ctx->sessions);
+	for (i=0; i<count; i++) {
+		GF_RTSPOutSession *a_sess = gf_list_get(src->ctx->sessions, i);
+		if (a_sess->shared != src) continue;
+		a_sess->shared = NULL;
+		a_sess->play_state = 0;
+		//client still waiting for the source to be loaded
+		if ((a_sess->sdp_state==SDP_WAIT) || a_sess->request_pending) {
+			a_sess->sdp_state = SDP_LOADED;
+			a_sess->request_pending = GF_FALSE;
+			if (a_sess->rtsp) {
+				gf_rtsp_response_reset(a_sess->response);
+				a_sess->response->ResponseCode = NC_RTSP_Service_Unavailable;
+				a_sess->response->CSeq = a_sess->command->CSeq;
+				rtspout_send_response(a_sess->ctx, a_sess);
+			}
+		}
+	}
+}
 
 static void rtspout_del_session(GF_Filter *filter, GF_RTSPOutSession *sess)
 {
+	if (sess->shared_src)
+		rtspout_shared_detach(sess);
+	if (sess->shared && sess->shared->nb_followers)
+		sess->shared->nb_followers--;
+
+	while (gf_list_count(sess->fwd_streams)) {
+		RTSPFwdStream *fwd = gf_list_pop_back(sess->fwd_streams);
+		if (fwd->ch) gf_rtp_del(fwd->ch);
+		gf_free(fwd);
+	}
+	gf_list_del(sess->fwd_streams);
+	while (gf_list_count(sess->rings)) {
+		RTSPSharedRing *ring = gf_list_pop_back(sess->rings);
+		rtspout_shared_del_ring(sess->ctx, ring);
+	}
+	gf_list_del(sess->rings);
+
 	//server mode, cleanup
 	while (gf_list_count(sess->streams)) {
 		GF_RTPOutStream *stream = gf_list_pop_back(sess->streams);
@@ -297,6 +409,7 @@ static void rtspout_del_session(GF_Filter *filter, GF_RTSPOutSession *sess)
 
 	if (sess->multicast_ip) gf_free(sess->multicast_ip);
 	if (sess->setup_ctrl) gf_free(sess->setup_ctrl);
+	if (sess->shared_url) gf_free(sess->shared_url);
 	gf_free(sess);
 }
 
@@ -332,6 +445,81 @@ static void rtspout_on_rtcp(void *udta)
 	sess->last_active_time = gf_sys_clock();
 }
 
+static GF_Err rtspout_shared_on_packet(void *udta, GF_RTPHeader *hdr, u8 *payload, u32 payload_size)
+{
+	RTSPSharedRing *ring = (RTSPSharedRing *)udta;
+	GF_RTPOutStream *stream = ring->stream;
+	RTSPSharedPacket *sp = &ring->pcks[ring->head % ring->nb_pcks];
+
+	if (sp->alloc < payload_size + 12) {
+		sp->alloc = payload_size + 12;
+		sp->data = gf_realloc(sp->data, sp->alloc);
+		if (!sp->data) {
+			sp->alloc = 0;
+			return GF_OUT_OF_MEM;
+		}
+	}
+	memcpy(sp->data + 12, payload, payload_size);
+	sp->size = payload_size + 12;
+	sp->hdr = *hdr;
+	sp->us = gf_timestamp_rescale(stream->current_cts + stream->ts_offset, stream->timescale, 1000000);
+	sp->rap = GF_FALSE;
+	//first packet of a new AU
+	if (ring->last_au != stream->pck_num) {
+		ring->last_au = stream->pck_num;
+		if (stream->current_sap) {
+			sp->rap = GF_TRUE;
+			ring->last_rap = ring->head;
+			ring->has_rap = GF_TRUE;
+		}
+	}
+	ring->head++;
+	//last RAP overwritten, clients will have to wait for the next one
+	if (ring->has_rap && (ring->head - ring->last_rap > ring->nb_pcks))
+		ring->has_rap = GF_FALSE;
+	return GF_OK;
+}
+
+static GF_Err rtspout_shared_init_ring(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess, GF_RTPOutStream *stream)
+{
+	u32 i;
+	RTSPSharedRing *ring = NULL;
+	for (i=0; i<gf_list_count(sess->rings); i++) {
+		ring = gf_list_get(sess->rings, i);
+		if (ring->stream==stream) break;
+		ring = NULL;
+	}
+	if (!ring) {
+		GF_SAFEALLOC(ring, RTSPSharedRing);
+		if (!ring) return GF_OUT_OF_MEM;
+		ring->nb_pcks = ctx->shring ? ctx->shring : 1;
+		ring->pcks = gf_malloc(sizeof(RTSPSharedPacket) * ring->nb_pcks);
+		if (!ring->pcks) {
+			gf_free(ring);
+			return GF_OUT_OF_MEM;
+		}
+		memset(ring->pcks, 0, sizeof(RTSPSharedPacket) * ring->nb_pcks);
+		ring->stream = stream;
+		gf_list_add(sess->rings, ring);
+	}
+	ring->clock_rate = gf_rtp_streamer_get_timescale(stream->rtp);
+	if (!ring->clock_rate) ring->clock_rate = stream->timescale;
+	//the streamer may have been recreated upon reconfiguration
+	return gf_rtp_streamer_set_packet_callback(stream->rtp, rtspout_shared_on_packet, ring);
+}
+
+static void rtspout_shared_remove_ring(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess, GF_RTPOutStream *stream)
+{
+	u32 i;
+	for (i=0; i<gf_list_count(sess->rings); i++) {
+		RTSPSharedRing *ring = gf_list_get(sess->rings, i);
+		if (ring->stream != stream) continue;
+		gf_list_rem(sess->rings, i);
+		rtspout_shared_del_ring(ctx, ring);
+		return;
+	}
+}
+
 static GF_Err rtspout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
 {
 	GF_RTSPOutCtx *ctx = (GF_RTSPOutCtx *) gf_filter_get_udta(filter);
@@ -347,6 +535,7 @@ static GF_Err rtspout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 		if (!sess) return GF_OK;
 		GF_RTPOutStream *t = gf_filter_pid_get_udta(pid);
 		if (t) {
+			rtspout_shared_remove_ring(ctx, sess, t);
 			if (sess->active_stream==t) sess->active_stream = NULL;
 			gf_list_del_item(sess->streams, t);
 			rtspout_del_stream(t);
@@ -369,6 +558,7 @@ static GF_Err rtspout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 	case GF_STREAM_FILE:
 	case GF_STREAM_UNKNOWN:
 		if (stream) {
+			rtspout_shared_remove_ring(ctx, sess, stream);
 			if (sess->active_stream==stream) sess->active_stream = NULL;
 			gf_list_del_item(sess->streams, stream);
 			rtspout_del_stream(stream);
@@ -402,6 +592,12 @@ static GF_Err rtspout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 	e = rtpout_init_streamer(stream, ctx->ifce ? ctx->ifce : "127.0.0.1", ctx->xps, ctx->mpeg4, ctx->latm, payt, ctx->mtu, ctx->ttl, ctx->ifce, GF_TRUE, &sess->base_pid_id, 0, gf_filter_get_netcap_id(filter));
 	if (e) return e;
 
+	//shared source: packets are captured in a ring and forwarded by client sessions
+	if (sess->shared_src) {
+		e = rtspout_shared_init_ring(ctx, sess, stream);
+		if (e) return e;
+	}
+
 	if (ctx->loop) {
 		p = gf_filter_pid_get_property(pid, GF_PROP_PID_PLAYBACK_MODE);
 		if (!p || (p->value.uint<GF_PLAYBACK_MODE_FASTFORWARD)) {
@@ -413,22 +609,11 @@ static GF_Err rtspout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 	return GF_OK;
 }
 
-static GF_Err rtspout_check_new_session(GF_RTSPOutCtx *ctx, Bool single_session)
+static GF_RTSPOutSession *rtspout_new_session(GF_RTSPOutCtx *ctx, GF_RTSPSession *new_sess)
 {
 	GF_RTSPOutSession *sess;
-	GF_RTSPSession *new_sess = NULL;
-
-	if (!single_session) {
-		new_sess = gf_rtsp_session_new_server(ctx->server_sock, ctx->htun, ctx->ssl_ctx);
-		if (!new_sess) return GF_OK;
-		gf_rtsp_session_set_netcap_id(new_sess, gf_filter_get_netcap_id(ctx->filter));
-	}
-
 	GF_SAFEALLOC(sess, GF_RTSPOutSession);
-	if (!sess) {
-		gf_rtsp_session_del(new_sess);
-		return GF_OUT_OF_MEM;
-	}
+	if (!sess) return NULL;
 	sess->rtsp = new_sess;
 	sess->command = gf_rtsp_command_new();
 	sess->response = gf_rtsp_response_new();
@@ -446,6 +631,28 @@ static GF_Err rtspout_check_new_session(GF_RTSPOutCtx *ctx, Bool single_session)
 		seed |= gf_sys_clock();
 		sprintf(sess->ctrl_name, "s%08X", seed);
 	}
+	sess->ctx = ctx;
+	gf_list_add(ctx->sessions, sess);
+	ctx->is_active = GF_TRUE;
+	return sess;
+}
+
+static GF_Err rtspout_check_new_session(GF_RTSPOutCtx *ctx, Bool single_session)
+{
+	GF_RTSPOutSession *sess;
+	GF_RTSPSession *new_sess = NULL;
+
+	if (!single_session) {
+		new_sess = gf_rtsp_session_new_server(ctx->server_sock, ctx->htun, ctx->ssl_ctx);
+		if (!new_sess) return GF_OK;
+		gf_rtsp_session_set_netcap_id(new_sess, gf_filter_get_netcap_id(ctx->filter));
+	}
+
+	sess = rtspout_new_session(ctx, new_sess);
+	if (!sess) {
+		gf_rtsp_session_del(new_sess);
+		return GF_OUT_OF_MEM;
+	}
 
 	if (new_sess) {
 		gf_rtsp_set_buffer_size(new_sess, ctx->block_size);
@@ -455,9 +662,6 @@ static GF_Err rtspout_check_new_session(GF_RTSPOutCtx *ctx, Bool single_session)
 	} else {
 		sess->single_session = GF_TRUE;
 	}
-	sess->ctx = ctx;
-	gf_list_add(ctx->sessions, sess);
-	ctx->is_active = GF_TRUE;
 	return GF_OK;
 }
 
@@ -699,6 +903,9 @@ static Bool rtspout_init_clock(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess)
 			GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[RTSPOut] Session %s: RTP stream %d initial RTP TS set to %d\n", sess->service_name, i+1, stream->rtp_ts_offset));
 		}
 	}
+	//shared source, PLAY responses are sent by client sessions when joining
+	if (sess->shared_src)
+		return GF_TRUE;
 
 
 	gf_rtsp_response_reset(sess->response);
@@ -828,6 +1035,255 @@ static GF_Err rtspout_interleave_packet(void *cbk1, void *cbk2, Bool is_rtcp, u8
 	return gf_rtsp_session_write_interleaved(sess->rtsp, idx, pck, pck_size);
 }
 
+static GF_Err rtspout_shared_interleave_packet(void *cbk1, void *cbk2, Bool is_rtcp, u8 *pck, u32 pck_size)
+{
+	GF_RTSPOutSession *sess = (GF_RTSPOutSession *)cbk1;
+	RTSPFwdStream *fwd = (RTSPFwdStream *)cbk2;
+
+	u32 idx = is_rtcp ? fwd->rtcp_id : fwd->rtp_id;
+	if (!sess->rtsp)
+		return GF_IP_CONNECTION_CLOSED;
+	return gf_rtsp_session_write_interleaved(sess->rtsp, idx, pck, pck_size);
+}
+
+static void rtspout_shared_init_session(GF_RTSPOutSession *sess)
+{
+	u32 i, count;
+	if (!sess->shared || gf_list_count(sess->fwd_streams)) return;
+
+	count = gf_list_count(sess->shared->rings);
+	for (i=0; i<count; i++) {
+		RTSPFwdStream *fwd;
+		RTSPSharedRing *ring = gf_list_get(sess->shared->rings, i);
+		GF_SAFEALLOC(fwd, RTSPFwdStream);
+		if (!fwd) return;
+		fwd->ring = ring;
+		fwd->ctrl_id = ring->stream->ctrl_id;
+		if (!gf_sys_is_test_mode()) {
+			fwd->seq_offset = (u16) gf_rand();
+			if (sess->ctx->tso<0)
+				fwd->ts_offset = gf_rand();
+		}
+		gf_list_add(sess->fwd_streams, fwd);
+	}
+}
+
+static GF_Err rtspout_shared_attach(GF_Filter *filter, GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess, char *src_url)
+{
+	GF_RTSPOutSession *src = NULL;
+	u32 i, count = gf_list_count(ctx->sessions);
+
+	for (i=0; i<count; i++) {
+		GF_RTSPOutSession *a_sess = gf_list_get(ctx->sessions, i);
+		if (a_sess->shared_src && !strcmp(a_sess->shared_url, src_url)) {
+			src = a_sess;
+			break;
+		}
+	}
+	if (!src) {
+		GF_Err e;
+		src = rtspout_new_session(ctx, NULL);
+		if (!src) return GF_OUT_OF_MEM;
+		src->shared_src = GF_TRUE;
+		src->shared_url = gf_strdup(src_url);
+		src->service_name = gf_strdup(sess->command->service_name);
+		src->rings = gf_list_new();
+		src->last_active_time = gf_sys_clock();
+		e = rtspout_load_media_service(filter, ctx, src, src_url);
+		if (e) {
+			rtspout_del_session(filter, src);
+			return e;
+		}
+		GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[RTSPOut] Loading shared source %s\n", src_url));
+	}
+	if (sess->shared != src) {
+		if (sess->shared && sess->shared->nb_followers) sess->shared->nb_followers--;
+		while (gf_list_count(sess->fwd_streams)) {
+			RTSPFwdStream *fwd = gf_list_pop_back(sess->fwd_streams);
+			if (fwd->ch) gf_rtp_del(fwd->ch);
+			gf_free(fwd);
+		}
+		sess->shared = src;
+		src->nb_followers++;
+	}
+	if (!sess->fwd_streams) sess->fwd_streams = gf_list_new();
+	strcpy(sess->ctrl_name, src->ctrl_name);
+	sess->sdp_state = (src->sdp_state==SDP_LOADED) ? SDP_LOADED : SDP_WAIT;
+	return GF_OK;
+}
+
+static GF_Err rtspout_shared_init_channel(GF_RTSPOutCtx *ctx, RTSPFwdStream *fwd, GF_RTSPTransport *transport)
+{
+	GF_Err e;
+	if (!fwd->ring) return GF_SERVICE_ERROR;
+	if (!fwd->ch) {
+		fwd->ch = gf_rtp_new_ex(gf_filter_get_netcap_id(ctx->filter));
+		if (!fwd->ch) return GF_OUT_OF_MEM;
+	}
+	gf_rtp_setup_payload(fwd->ch, gf_rtp_streamer_get_payload_type(fwd->ring->stream->rtp), fwd->ring->clock_rate);
+	e = gf_rtp_setup_transport(fwd->ch, transport, transport->destination);
+	if (!e) e = gf_rtp_initialize(fwd->ch, 0, GF_TRUE, ctx->mtu, 0, 0, ctx->ifce);
+	if (e) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_RTP, ("[RTSPOut] Cannot setup RTP channel for shared stream: %s\n", gf_error_to_string(e) ));
+	}
+	return e;
+}
+
+//locate the last RAP of each selected stream, and start all streams from the oldest one so that RTP-Info maps to a common time
+static Bool rtspout_shared_join(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess)
+{
+	u64 ref_us = (u64) -1;
+	u32 i, count = gf_list_count(sess->fwd_streams);
+
+	for (i=0; i<count; i++) {
+		u64 rap_us;
+		RTSPFwdStream *fwd = gf_list_get(sess->fwd_streams, i);
+		if (!fwd->selected || !fwd->ring) continue;
+		if (!fwd->ring->has_rap) return GF_FALSE;
+		rap_us = fwd->ring->pcks[fwd->ring->last_rap % fwd->ring->nb_pcks].us;
+		if (ref_us > rap_us) ref_us = rap_us;
+	}
+	if (ref_us == (u64) -1) return GF_FALSE;
+
+	gf_rtsp_response_reset(sess->response);
+	sess->response->ResponseCode = NC_RTSP_OK;
+	for (i=0; i<count; i++) {
+		u64 idx;
+		GF_RTPInfo *rtpi;
+		RTSPSharedPacket *sp;
+		RTSPFwdStream *fwd = gf_list_get(sess->fwd_streams, i);
+		RTSPSharedRing *ring = fwd->ring;
+		if (!fwd->selected || !ring) continue;
+
+		//cannot fail, last RAP of this stream is after the reference time
+		idx = (ring->head > ring->nb_pcks) ? ring->head - ring->nb_pcks : 0;
+		for (; idx<ring->head; idx++) {
+			sp = &ring->pcks[idx % ring->nb_pcks];
+			if (sp->rap && (sp->us >= ref_us)) break;
+		}
+		sp = &ring->pcks[idx % ring->nb_pcks];
+		fwd->next = idx;
+		fwd->started = GF_TRUE;
+		fwd->bye_sent = GF_FALSE;
+
+		GF_SAFEALLOC(rtpi, GF_RTPInfo);
+		if (rtpi) {
+			rtpi->url = gf_malloc(sizeof(char) * (strlen(sess->service_name)+50));
+			sprintf(rtpi->url, "%s/%s=%d", sess->service_name, sess->ctrl_name, fwd->ctrl_id);
+			rtpi->seq = (u16) (sp->hdr.SequenceNumber + fwd->seq_offset);
+			rtpi->rtp_time = sp->hdr.TimeStamp + fwd->ts_offset;
+			rtpi->rtp_time -= (u32) gf_timestamp_rescale(sp->us - ref_us, 1000000, ring->clock_rate);
+			gf_list_add(sess->response->RTP_Infos, rtpi);
+		}
+	}
+	GF_SAFEALLOC(sess->response->Range, GF_RTSPRange);
+	if (sess->response->Range)
+		sess->response->Range->start = ((Double) ref_us) / 1000000;
+
+	GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[RTSPOut] Session %s joining shared source at "LLU" us\n", sess->service_name, ref_us));
+	sess->response->CSeq = sess->last_cseq;
+	rtspout_send_response(ctx, sess);
+	sess->request_pending = GF_FALSE;
+	return GF_TRUE;
+}
+
+static void rtspout_shared_play(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess)
+{
+	u32 i, count;
+	GF_RTSPOutSession *src = sess->shared;
+
+	if (!src) {
+		gf_rtsp_response_reset(sess->response);
+		sess->response->ResponseCode = NC_RTSP_Service_Unavailable;
+		sess->response->CSeq = sess->command->CSeq;
+		rtspout_send_response(ctx, sess);
+		return;
+	}
+	//(re)join at last RAP, once available
+	count = gf_list_count(sess->fwd_streams);
+	for (i=0; i<count; i++) {
+		RTSPFwdStream *fwd = gf_list_get(sess->fwd_streams, i);
+		fwd->started = GF_FALSE;
+	}
+	sess->play_state = 1;
+	sess->last_cseq = sess->command->CSeq;
+	sess->request_pending = GF_TRUE;
+
+	if (src->play_state==1) return;
+	//start source, all streams are delivered in the rings
+	count = gf_list_count(src->streams);
+	for (i=0; i<count; i++) {
+		GF_RTPOutStream *stream = gf_list_get(src->streams, i);
+		stream->selected = GF_TRUE;
+	}
+	src->play_state = 1;
+	if (ctx->loop && !src->loop_disabled)
+		src->loop = GF_TRUE;
+	rtspout_send_event(src, GF_FALSE, GF_TRUE, 0);
+}
+
+static GF_Err rtspout_shared_forward(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess)
+{
+	u8 rtcp_buf[2048];
+	u32 i, count = gf_list_count(sess->fwd_streams);
+
+	for (i=0; i<count; i++) {
+		u64 oldest;
+		RTSPFwdStream *fwd = gf_list_get(sess->fwd_streams, i);
+		RTSPSharedRing *ring = fwd->ring;
+		if (!fwd->selected || !fwd->started || !ring || !fwd->ch) continue;
+
+		//any RTCP traffic from client keeps the session alive
+		if (gf_rtp_read_rtcp(fwd->ch, rtcp_buf, sizeof(rtcp_buf)))
+			sess->last_active_time = gf_sys_clock();
+
+		oldest = (ring->head > ring->nb_pcks) ? ring->head - ring->nb_pcks : 0;
+		if (fwd->next < oldest) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_RTP, ("[RTSPOut] Session %s stream %d lost "LLU" packets in shared ring, resyncing\n", sess->service_name, fwd->ctrl_id, oldest - fwd->next));
+			fwd->next = ring->has_rap ? ring->last_rap : ring->head;
+		}
+		//rewrite SN and TS in place and send
+		while (fwd->next < ring->head) {
+			GF_Err e;
+			GF_RTPHeader hdr;
+			RTSPSharedPacket *sp = &ring->pcks[fwd->next % ring->nb_pcks];
+			hdr = sp->hdr;
+			hdr.SequenceNumber += fwd->seq_offset;
+			hdr.TimeStamp += fwd->ts_offset;
+			e = gf_rtp_send_packet(fwd->ch, &hdr, sp->data+12, sp->size-12, GF_TRUE);
+			if ((e==GF_IP_CONNECTION_CLOSED) || (e==GF_IP_CONNECTION_FAILURE))
+				return e;
+			if (e) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_RTP, ("[RTSPOut] Error %s forwarding RTP packet SN %u to %s\n", gf_error_to_string(e), hdr.SequenceNumber, sess->peer_address));
+			}
+			fwd->next++;
+		}
+		if (sess->shared && sess->shared->shared_eos && !fwd->bye_sent) {
+			fwd->bye_sent = GF_TRUE;
+			gf_rtp_send_bye(fwd->ch);
+		}
+	}
+	return GF_OK;
+}
+
+static GF_Err rtspout_process_shared(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess)
+{
+	if (sess->rtsp && sess->interleave) {
+		GF_Err e = gf_rtsp_check_connection(sess->rtsp);
+		if (e==GF_IP_NETWORK_EMPTY) {
+			ctx->next_wake_us = 100;
+			return GF_OK;
+		} else if (e) {
+			return e;
+		}
+	}
+	if (sess->request_pending) {
+		if (!sess->shared || !rtspout_shared_join(ctx, sess))
+			return GF_OK;
+	}
+	return rtspout_shared_forward(ctx, sess);
+}
+
 Bool rtspout_on_filter_setup_error(GF_Filter *f, void *on_setup_error_udta, GF_Err e)
 {
 	GF_RTSPOutSession *sess = (GF_RTSPOutSession *)on_setup_error_udta;
@@ -913,7 +1369,9 @@ static GF_Err rtspout_check_sdp(GF_Filter *filter, GF_RTSPOutSession *sess)
 	//all streams should be ready - note that we don't know handle dynamic pid insertion in source service yet
 	sess->sdp_state = SDP_LOADED;
 	sess->request_pending = GF_FALSE;
-	rtspout_send_sdp(sess);
+	//shared source, SDP is sent by client sessions
+	if (!sess->shared_src)
+		rtspout_send_sdp(sess);
 	return GF_OK;
 }
 
@@ -1087,6 +1545,7 @@ static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess,
 	GF_Err e;
 	char remoteIP[GF_MAX_IP_NAME_LEN];
 	GF_RTPOutStream *stream = NULL;
+	RTSPFwdStream *fwd = NULL;
 	GF_RTSPTransport *transport = gf_list_get(sess->command->Transports, 0);
 	u32 rsp_code=NC_RTSP_OK;
 	Bool enable_multicast = GF_FALSE;
@@ -1109,6 +1568,18 @@ static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess,
 		rsp_code = NC_RTSP_Bad_Request;
 	} else if (sess->sessionID && !sess->command->Session) {
 		rsp_code = NC_RTSP_Not_Implemented;
+	} else if (sess->fwd_streams) {
+		u32 i, count = gf_list_count(sess->fwd_streams);
+		for (i=0; i<count; i++) {
+			fwd = gf_list_get(sess->fwd_streams, i);
+			if (stream_ctrl_id==fwd->ctrl_id)
+				break;
+			fwd=NULL;
+		}
+		if (!stream_ctrl_id || !fwd || !fwd->ring)
+			rsp_code = NC_RTSP_Not_Found;
+		else
+			stream = fwd->ring->stream;
 	} else {
 		u32 i, count = gf_list_count(sess->streams);
 		for (i=0; i<count; i++) {
@@ -1136,13 +1607,14 @@ static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess,
 	gf_rtsp_response_reset(sess->response);
 	sess->response->CSeq = sess->command->CSeq;
 
-	stream->selected = GF_TRUE;
+	if (fwd) fwd->selected = GF_TRUE;
+	else stream->selected = GF_TRUE;
 	if (transport && (rsp_code==NC_RTSP_OK) ) {
 		if (!transport->IsInterleaved) {
 			if (ctx->trp == TRP_TCP_ONLY) {
 				rsp_code = NC_RTSP_Unsupported_Transport;
 			} else {
-				u32 st_idx = gf_list_find(sess->streams, stream);
+				u32 st_idx = fwd ? gf_list_find(sess->fwd_streams, fwd) : gf_list_find(sess->streams, stream);
 				transport->port_first = ctx->firstport + 2 * st_idx;
 				transport->port_last = transport->port_first + 1;
 				if (sess->interleave)
@@ -1176,6 +1648,10 @@ static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess,
 				reset_transport_dest = GF_TRUE;
 			}
 		}
+		//shared source is only forwarded in unicast, multicast uses mirror sessions
+		else if (fwd) {
+			rsp_code = NC_RTSP_Unsupported_Transport;
+		}
 		else {
 			if (transport->destination && !gf_sk_is_multicast_address(transport->destination)) {
 				rsp_code = NC_RTSP_Bad_Request;
@@ -1226,7 +1702,10 @@ static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess,
 			rsp_code = NC_RTSP_OK; //do not delete session
 		}
 	} else {
-		e = gf_rtp_streamer_init_rtsp(stream->rtp, ctx->mtu, transport, ctx->ifce);
+		if (fwd)
+			e = rtspout_shared_init_channel(ctx, fwd, transport);
+		else
+			e = gf_rtp_streamer_init_rtsp(stream->rtp, ctx->mtu, transport, ctx->ifce);
 		if (e) {
 			sess->response->ResponseCode = NC_RTSP_Internal_Server_Error;
 		} else {
@@ -1244,7 +1723,11 @@ static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess,
 			gf_list_add(sess->response->Transports, transport);
 		}
 
-		if (sess->interleave) {
+		if (sess->interleave && fwd) {
+			fwd->rtp_id = transport->rtpID;
+			fwd->rtcp_id = transport->rtcpID;
+			gf_rtp_set_interleave_callbacks(fwd->ch, rtspout_shared_interleave_packet, sess, fwd);
+		} else if (sess->interleave) {
 			stream->rtp_id = transport->rtpID;
 			stream->rtcp_id = transport->rtcpID;
 			gf_rtp_streamer_set_interleave_callbacks(stream->rtp, rtspout_interleave_packet, sess, stream);
@@ -1274,10 +1757,21 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 	GF_RTSPOutSession *sess = *sess_ptr;
 	char *ctrl=NULL;
 
+	if (sess->shared_src) {
+		if (sess->sdp_state==SDP_WAIT)
+			return rtspout_check_sdp(filter, sess);
+		return GF_OK;
+	}
 	//no rtsp connection on this session
 	if (!sess->rtsp) return GF_OK;
 
 	if (sess->sdp_state==SDP_WAIT) {
+		if (sess->fwd_streams) {
+			if (!sess->shared || (sess->shared->sdp_state!=SDP_LOADED)) return GF_OK;
+			sess->sdp_state = SDP_LOADED;
+			sess->request_pending = GF_FALSE;
+			return rtspout_send_sdp(sess);
+		}
 		return rtspout_check_sdp(filter, sess);
 	}
 
@@ -1303,7 +1797,7 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 		for (i=0; i<count; i++) {
 			Bool swap_sess = GF_FALSE;
 			GF_RTSPOutSession *a_sess = gf_list_get(ctx->sessions, i);
-			if (a_sess->rtsp) continue;
+			if (a_sess->rtsp || a_sess->shared_src) continue;
 
 			if (a_sess->sessionID && sess->command->Session && !strcmp(a_sess->sessionID, sess->command->Session) ) {
 				swap_sess = GF_TRUE;
@@ -1512,8 +2006,11 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 			char *src_url = rtspout_get_local_res_path(ctx, res_path, sess->command, &rsp_code, &mcast_mode);
 			if (src_url) {
 				rsp_code = NC_RTSP_OK;
-				//load media service
-				e = rtspout_load_media_service(filter, ctx, sess, src_url);
+				//load media service, or attach to the shared one
+				if (ctx->shared && (mcast_mode==MCAST_OFF))
+					e = rtspout_shared_attach(filter, ctx, sess, src_url);
+				else
+					e = rtspout_load_media_service(filter, ctx, sess, src_url);
 				gf_free(src_url);
 				if (e) {
 					rsp_code = NC_RTSP_Service_Unavailable;
@@ -1613,6 +2110,8 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 			sess->response->CSeq = sess->command->CSeq;
 			rtspout_send_response(ctx, sess);
 			return GF_OK;
+		} else if (sess->fwd_streams) {
+			rtspout_shared_play(ctx, sess);
 		} else {
 			//loop enabled, only if multicast session or single session mode
 			if (ctx->loop && !sess->loop_disabled && (sess->single_session || sess->multicast_ip))
@@ -1734,6 +2233,20 @@ static GF_Err rtspout_process(GF_Filter *filter)
 
 	now = gf_sys_clock();
  	count = gf_list_count(ctx->sessions);
+	//packetize shared sources first so that client sessions forward packets in the same pass
+	for (i=0; i<count; i++) {
+		GF_RTSPOutSession *sess = gf_list_get(ctx->sessions, i);
+		if (!sess->shared_src) continue;
+		//shared source is released after timeout once no more clients
+		if (sess->nb_followers) sess->last_active_time = now;
+		if (sess->play_state==1) {
+			GF_Err sess_err = rtspout_process_rtp(filter, ctx, sess);
+			if (sess_err==GF_EOS) sess->shared_eos = GF_TRUE;
+			else if (sess_err) e |= sess_err;
+			else sess->shared_eos = GF_FALSE;
+		}
+	}
+
 	for (i=0; i<count; i++) {
 		GF_Err sess_err;
 		GF_RTSPOutSession *sess = gf_list_get(ctx->sessions, i);
@@ -1750,7 +2263,18 @@ static GF_Err rtspout_process(GF_Filter *filter)
 		if (sess_err) e |= sess_err;
 		if (!sess) break;
 
-		if (sess->play_state==1) {
+		if (sess->fwd_streams) {
+			if (sess->play_state==1) {
+				sess_err = rtspout_process_shared(ctx, sess);
+				if ((sess_err==GF_IP_CONNECTION_CLOSED) || (sess_err==GF_IP_CONNECTION_FAILURE)) {
+					rtspout_del_session(filter, sess);
+					i--;
+					count--;
+					continue;
+				}
+				if (sess_err) e |= sess_err;
+			}
+		} else if ((sess->play_state==1) && !sess->shared_src) {
 			sess_err = rtspout_process_rtp(filter, ctx, sess);
 			if (sess_err) e |= sess_err;
 		}
@@ -1848,6 +2372,8 @@ static const GF_FilterArgs RTSPOutArgs[] =
 	"- tcp: only allow TCP traffic", GF_PROP_UINT, "both", "both|udp|tcp", GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(cert), "certificate file in PEM format to use for TLS mode", GF_PROP_STRING, NULL, NULL, 0},
 	{ OFFS(pkey), "private key file in PEM format to use for TLS mode", GF_PROP_STRING, NULL, NULL, 0},
+	{ OFFS(shared), "in server mode, packetize each resource once and forward RTP packets to all unicast clients of that resource (see filter help)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(shring), "number of RTP packets kept per stream in shared mode", GF_PROP_UINT, "4096", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -1910,6 +2436,17 @@ GF_FilterRegister RTSPOutRegister = {
 		"\n"
 		"In server mode, multicast can be enabled per read directory using the `mcast` access rule of the directory configuration - see `gpac -h creds`.\n"
 		"\n"
+		"# Shared sources\n"
+		"By default in server mode, each client session loads its own source and packetizer, and starts from the requested range.\n"
+		"When [-shared]() is set, the first DESCRIBE on a mount point resource loads a shared source which is packetized once in real-time, "
+		"each stream keeping its last [-shring]() RTP packets in a ring.\n"
+		"Clients requesting the same resource are attached to this source and only get their own RTP sequence number and timestamp offsets rewritten in the packet header before sending.\n"
+		"On PLAY, a client starts at the last random access point of its streams: the PLAY response is delayed until each selected stream has one, "
+		"and packets from that point on are sent right away. PLAY ranges are ignored.\n"
+		"The shared source keeps running while clients are attached, and is released [-timeout]() seconds after the last client is gone.\n"
+		"Shared sources are only delivered over unicast UDP or interleaved RTP, and are not used for dynamic URLs or multicast sessions.\n"
+		"EX gpac rtspout:mounts=live_dir:shared\n"
+		"\n"
 		"# HTTP Tunnel\n"
 		"The server mode supports handling RTSP over HTTP tunnel by default. This can be disabled using [-htun]().\n"
 		"The tunnel conforms to QT specification, and only HTTP 1.0 and 1.1 tunnels are supported.\n"
@@ -0,0 +1,557 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: agent
+ *			Copyright (c) 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / shared memory output filter
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include "shm_ring.h"
+#include <gpac/constants.h>
+
+#ifdef GPAC_HAS_SHM_RING
+
+//input stream in packet mode
+typedef struct
+{
+	GF_FilterPid *pid;
+	u32 id;
+	Bool config_pending, eos_sent, removed;
+} ShmOutStream;
+
+typedef struct
+{
+	//options
+	char *dst, *mime, *ext;
+	u32 size, poll;
+
+	//file mode: only one input pid, data is written as a byte stream
+	GF_FilterPid *pid;
+	//packet mode: PIDs and packets are carried with their properties
+	Bool pck_mode;
+	GF_List *streams;
+	//stream whose packet is being split over several records, must be completed before any other write
+	ShmOutStream *split_st;
+	u32 next_id;
+	GF_BitStream *bs;
+	u8 *hdr;
+	u32 hdr_alloc;
+
+	GF_ShmRing ring;
+	//local copy of write position
+	u64 write_pos;
+	//bytes of current packet already written
+	u32 pck_offset;
+
+	GF_FilterCapability in_caps[3];
+	char szExt[10];
+
+	u64 nb_bytes, nb_pck;
+	u32 nb_full;
+	Bool was_full;
+} GF_ShmOutCtx;
+
+
+static GF_Err shmout_initialize(GF_Filter *filter)
+{
+	GF_Err e;
+	char *ext;
+	GF_ShmOutCtx *ctx = (GF_ShmOutCtx *) gf_filter_get_udta(filter);
+
+	if (!ctx || !ctx->dst) return GF_OK;
+	ctx->ring.fd = -1;
+
+	if (strnicmp(ctx->dst, "shm://", 6))  {
+		gf_filter_setup_failure(filter, GF_NOT_SUPPORTED);
+		return GF_NOT_SUPPORTED;
+	}
+
+	if (ctx->ext) ext = ctx->ext;
+	else {
+		ext = gf_file_ext_start(ctx->dst);
+		if (ext) ext++;
+	}
+	//no format given, carry PIDs and packets
+	if (!ext && !ctx->mime) {
+		ctx->pck_mode = GF_TRUE;
+		ctx->in_caps[0].code = GF_PROP_PID_STREAM_TYPE;
+		ctx->in_caps[0].val = PROP_UINT(GF_STREAM_FILE);
+		ctx->in_caps[0].flags = GF_CAPS_INPUT_EXCLUDED;
+		ctx->in_caps[1].code = GF_PROP_PID_UNFRAMED;
+		ctx->in_caps[1].val = PROP_BOOL(GF_TRUE);
+		ctx->in_caps[1].flags = GF_CAPS_INPUT_EXCLUDED;
+		ctx->in_caps[2].code = GF_PROP_PID_CODECID;
+		ctx->in_caps[2].val = PROP_UINT(GF_CODECID_NONE);
+		ctx->in_caps[2].flags = GF_CAPS_INPUT_EXCLUDED;
+		gf_filter_override_caps(filter, ctx->in_caps, 3);
+		if (gf_filter_is_temporary(filter)) return GF_OK;
+
+		ctx->streams = gf_list_new();
+		if (!ctx->streams) return GF_OUT_OF_MEM;
+	} else {
+		//static cap, streamtype = file
+		ctx->in_caps[0].code = GF_PROP_PID_STREAM_TYPE;
+		ctx->in_caps[0].val = PROP_UINT(GF_STREAM_FILE);
+		ctx->in_caps[0].flags = GF_CAPS_INPUT_STATIC;
+
+		if (ctx->mime) {
+			ctx->in_caps[1].code = GF_PROP_PID_MIME;
+			ctx->in_caps[1].val = PROP_NAME( ctx->mime );
+			ctx->in_caps[1].flags = GF_CAPS_INPUT;
+		} else {
+			strncpy(ctx->szExt, ext, 9);
+			ctx->szExt[9] = 0;
+			strlwr(ctx->szExt);
+			ctx->in_caps[1].code = GF_PROP_PID_FILE_EXT;
+			ctx->in_caps[1].val = PROP_NAME( ctx->szExt );
+			ctx->in_caps[1].flags = GF_CAPS_INPUT;
+		}
+		gf_filter_override_caps(filter, ctx->in_caps, 2);
+		//only loaded to resolve caps
+		if (gf_filter_is_temporary(filter)) return GF_OK;
+	}
+
+	e = gf_shm_ring_open(&ctx->ring, ctx->dst, ctx->size);
+	if (e) return e;
+	ctx->write_pos = __atomic_load_n(&ctx->ring.hdr->write_pos, __ATOMIC_ACQUIRE);
+	__atomic_and_fetch(&ctx->ring.hdr->state, ~GF_SHM_STATE_EOS, __ATOMIC_SEQ_CST);
+	__atomic_or_fetch(&ctx->ring.hdr->state, GF_SHM_STATE_WRITER, __ATOMIC_SEQ_CST);
+	return GF_OK;
+}
+
+static void shmout_set_eos(GF_ShmOutCtx *ctx)
+{
+	if (!ctx->ring.hdr) return;
+	__atomic_or_fetch(&ctx->ring.hdr->state, GF_SHM_STATE_EOS, __ATOMIC_SEQ_CST);
+	gf_shm_ring_signal(&ctx->ring.hdr->write_seq, &ctx->ring.hdr->reader_waiting);
+}
+
+static void shmout_finalize(GF_Filter *filter)
+{
+	GF_ShmOutCtx *ctx = (GF_ShmOutCtx *) gf_filter_get_udta(filter);
+	if (ctx->streams) {
+		while (gf_list_count(ctx->streams)) {
+			ShmOutStream *st = gf_list_pop_back(ctx->streams);
+			gf_free(st);
+		}
+		gf_list_del(ctx->streams);
+	}
+	if (ctx->bs) gf_bs_del(ctx->bs);
+	if (ctx->hdr) gf_free(ctx->hdr);
+	if (!ctx->ring.hdr) return;
+
+	shmout_set_eos(ctx);
+	__atomic_and_fetch(&ctx->ring.hdr->state, ~GF_SHM_STATE_WRITER, __ATOMIC_SEQ_CST);
+	GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[SHMOut] Wrote "LLU" packets "LLU" bytes, ring full %u times\n", ctx->nb_pck, ctx->nb_bytes, ctx->nb_full));
+	//the reader removes the shared memory object once done
+	gf_shm_ring_close(&ctx->ring, GF_FALSE);
+}
+
+static GF_Err shmout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
+{
+	const GF_PropertyValue *p;
+	GF_ShmOutCtx *ctx = (GF_ShmOutCtx *) gf_filter_get_udta(filter);
+
+	if (ctx->pck_mode) {
+		ShmOutStream *st = gf_filter_pid_get_udta(pid);
+		if (is_remove) {
+			//removal is signaled to the reader in process
+			if (st) {
+				st->removed = GF_TRUE;
+				st->pid = NULL;
+				gf_filter_pid_set_udta(pid, NULL);
+			}
+			return GF_OK;
+		}
+		if (!st) {
+			GF_FilterEvent evt;
+			GF_SAFEALLOC(st, ShmOutStream);
+			if (!st) return GF_OUT_OF_MEM;
+			st->pid = pid;
+			st->id = ++ctx->next_id;
+			gf_list_add(ctx->streams, st);
+			gf_filter_pid_set_udta(pid, st);
+			gf_filter_pid_init_play_event(pid, &evt, 0, 1.0, "SHMOut");
+			gf_filter_pid_send_event(pid, &evt);
+		}
+		st->config_pending = GF_TRUE;
+		return GF_OK;
+	}
+
+	if (is_remove) {
+		ctx->pid = NULL;
+		return GF_OK;
+	}
+	if (ctx->pid && (ctx->pid != pid)) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHMOut] File mode only accepts a single input, remove extension and MIME to carry several PIDs\n"));
+		return GF_NOT_SUPPORTED;
+	}
+	gf_filter_pid_check_caps(pid);
+
+	if (!ctx->pid) {
+		GF_FilterEvent evt;
+		gf_filter_pid_init_play_event(pid, &evt, 0, 1.0, "SHMOut");
+		gf_filter_pid_send_event(pid, &evt);
+	}
+	ctx->pid = pid;
+
+	p = gf_filter_pid_get_property(pid, GF_PROP_PID_DISABLE_PROGRESSIVE);
+	if (p && p->value.uint) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHMOut] Block patching is not supported by shared memory output\n"));
+		return GF_NOT_SUPPORTED;
+	}
+	return GF_OK;
+}
+
+//checks for space, never waits: ring space is freed by the reader process
+static Bool shmout_has_space(GF_ShmOutCtx *ctx, u32 needed)
+{
+	u64 read_pos = __atomic_load_n(&ctx->ring.hdr->read_pos, __ATOMIC_ACQUIRE);
+	if (ctx->ring.size - (ctx->write_pos - read_pos) >= needed) {
+		ctx->was_full = GF_FALSE;
+		return GF_TRUE;
+	}
+	if (!ctx->was_full) ctx->nb_full++;
+	ctx->was_full = GF_TRUE;
+	return GF_FALSE;
+}
+
+//writes one record made of hdr and data, returns GF_FALSE if no space
+static Bool shmout_write_record(GF_ShmOutCtx *ctx, const u8 *hdr, u32 hdr_size, const u8 *data, u32 size, u32 flags)
+{
+	GF_ShmRecord *rec;
+	u32 offset = (u32) (ctx->write_pos % ctx->ring.size);
+	u32 tail = ctx->ring.size - offset;
+	u32 needed = (u32) GF_SHM_REC_SIZE(hdr_size + size);
+	u32 pad = (tail < needed) ? tail : 0;
+
+	if (!shmout_has_space(ctx, pad + needed)) return GF_FALSE;
+
+	if (pad) {
+		rec = (GF_ShmRecord *) (ctx->ring.data + offset);
+		rec->size = pad - sizeof(GF_ShmRecord);
+		rec->flags = GF_SHM_REC_PAD;
+		ctx->write_pos += pad;
+		offset = 0;
+	}
+	rec = (GF_ShmRecord *) (ctx->ring.data + offset);
+	rec->size = hdr_size + size;
+	rec->flags = flags;
+	if (hdr_size) memcpy(ctx->ring.data + offset + sizeof(GF_ShmRecord), hdr, hdr_size);
+	if (size) memcpy(ctx->ring.data + offset + sizeof(GF_ShmRecord) + hdr_size, data, size);
+	ctx->write_pos += needed;
+
+	__atomic_store_n(&ctx->ring.hdr->write_pos, ctx->write_pos, __ATOMIC_RELEASE);
+	gf_shm_ring_signal(&ctx->ring.hdr->write_seq, &ctx->ring.hdr->reader_waiting);
+	return GF_TRUE;
+}
+
+static void shmout_msg_start(GF_ShmOutCtx *ctx, u32 type, ShmOutStream *st)
+{
+	if (!ctx->bs) ctx->bs = gf_bs_new(NULL, 0, GF_BITSTREAM_WRITE);
+	else gf_bs_reassign_buffer(ctx->bs, ctx->hdr, ctx->hdr_alloc);
+	gf_bs_write_u8(ctx->bs, type);
+	gf_bs_write_u32(ctx->bs, st->id);
+}
+
+//gets message header, padded to 8 bytes so that packet data is aligned
+static u32 shmout_msg_end(GF_ShmOutCtx *ctx)
+{
+	u32 size;
+	gf_bs_align(ctx->bs);
+	while (gf_bs_get_position(ctx->bs) % 8) gf_bs_write_u8(ctx->bs, 0);
+	gf_bs_get_content_no_truncate(ctx->bs, &ctx->hdr, &size, &ctx->hdr_alloc);
+	return size;
+}
+
+//writes one packet of a stream, possibly over several records
+static Bool shmout_write_packet(GF_ShmOutCtx *ctx, ShmOutStream *st, GF_FilterPacket *pck)
+{
+	u32 hdr_size=0, pck_size=0, max_rec;
+	u8 flags=0;
+	Bool start, end;
+	const u8 *pck_data = gf_filter_pck_get_data(pck, &pck_size);
+	if (!pck_data) pck_size = 0;
+
+	max_rec = (ctx->ring.size / 4) & ~7;
+	if (ctx->split_st != st) {
+		shmout_msg_start(ctx, GF_SHM_MSG_PCK, st);
+		gf_bs_write_u64(ctx->bs, gf_filter_pck_get_dts(pck));
+		gf_bs_write_u64(ctx->bs, gf_filter_pck_get_cts(pck));
+		gf_bs_write_u32(ctx->bs, gf_filter_pck_get_duration(pck));
+		gf_bs_write_u8(ctx->bs, gf_filter_pck_get_sap(pck));
+		gf_filter_pck_get_framing(pck, &start, &end);
+		if (start) flags |= GF_SHM_PCK_START;
+		if (end) flags |= GF_SHM_PCK_END;
+		if (gf_filter_pck_get_seek_flag(pck)) flags |= GF_SHM_PCK_SEEK;
+		if (gf_filter_pck_get_corrupted(pck)) flags |= GF_SHM_PCK_CORRUPTED;
+		gf_bs_write_u8(ctx->bs, flags);
+		gf_bs_write_u8(ctx->bs, gf_filter_pck_get_interlaced(pck));
+		gf_bs_write_u8(ctx->bs, gf_filter_pck_get_dependency_flags(pck));
+		gf_bs_write_u8(ctx->bs, gf_filter_pck_get_crypt_flags(pck));
+		gf_bs_write_u8(ctx->bs, gf_filter_pck_get_carousel_version(pck));
+		gf_bs_write_u8(ctx->bs, gf_filter_pck_get_clock_type(pck));
+		gf_bs_write_u16(ctx->bs, (u16) gf_filter_pck_get_roll_info(pck));
+		gf_bs_write_u32(ctx->bs, gf_filter_pck_get_seq_num(pck));
+		gf_bs_write_u64(ctx->bs, gf_filter_pck_get_byte_offset(pck));
+		gf_bs_write_u32(ctx->bs, pck_size);
+		gf_shm_write_props(ctx->bs, NULL, pck);
+		hdr_size = shmout_msg_end(ctx);
+		if (hdr_size + 8 > max_rec) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[SHMOut] Packet properties too large for ring (%u bytes), dropping packet\n", hdr_size));
+			return GF_TRUE;
+		}
+	}
+
+	while ((ctx->split_st != st) || (ctx->pck_offset < pck_size)) {
+		u32 rec_flags = GF_SHM_REC_PCK;
+		u32 size = MIN(pck_size - ctx->pck_offset, max_rec - hdr_size);
+		if (ctx->split_st != st) rec_flags |= GF_SHM_REC_START;
+		if (ctx->pck_offset + size == pck_size) rec_flags |= GF_SHM_REC_END;
+
+		if (!shmout_write_record(ctx, (ctx->split_st == st) ? NULL : ctx->hdr, hdr_size, pck_data + ctx->pck_offset, size, rec_flags))
+			return GF_FALSE;
+		ctx->split_st = st;
+		ctx->pck_offset += size;
+		hdr_size = 0;
+	}
+	ctx->nb_bytes += pck_size;
+	ctx->nb_pck++;
+	ctx->pck_offset = 0;
+	ctx->split_st = NULL;
+	return GF_TRUE;
+}
+
+static GF_Err shmout_process_pck_mode(GF_Filter *filter, GF_ShmOutCtx *ctx)
+{
+	u32 i, nb_eos=0, count;
+
+	//records of a split packet must be contiguous in the ring, complete it first
+	if (ctx->split_st) {
+		ShmOutStream *st = ctx->split_st;
+		GF_FilterPacket *pck = st->pid ? gf_filter_pid_get_packet(st->pid) : NULL;
+		if (pck) {
+			if (!shmout_write_packet(ctx, st, pck)) goto ring_full;
+			gf_filter_pid_drop_packet(st->pid);
+		} else {
+			//input removed while sending, close the packet, the reader flags it as corrupted
+			if (!shmout_write_record(ctx, NULL, 0, NULL, 0, GF_SHM_REC_PCK|GF_SHM_REC_END)) goto ring_full;
+			ctx->split_st = NULL;
+			ctx->pck_offset = 0;
+		}
+	}
+
+	count = gf_list_count(ctx->streams);
+	for (i=0; i<count; i++) {
+		u32 size;
+		ShmOutStream *st = gf_list_get(ctx->streams, i);
+
+		if (st->removed) {
+			shmout_msg_start(ctx, GF_SHM_MSG_PID_REMOVE, st);
+			size = shmout_msg_end(ctx);
+			if (!shmout_write_record(ctx, ctx->hdr, size, NULL, 0, GF_SHM_REC_PCK|GF_SHM_REC_START|GF_SHM_REC_END)) break;
+			gf_list_rem(ctx->streams, i);
+			if (ctx->split_st == st) ctx->split_st = NULL;
+			gf_free(st);
+			i--;
+			count--;
+			continue;
+		}
+		while (1) {
+			GF_FilterPacket *pck = gf_filter_pid_get_packet(st->pid);
+			//PID (re)configuration is done when fetching packet, send config before the packet
+			if (st->config_pending) {
+				shmout_msg_start(ctx, GF_SHM_MSG_PID_CONFIG, st);
+				gf_shm_write_props(ctx->bs, st->pid, NULL);
+				size = shmout_msg_end(ctx);
+				if (size + 8 > ctx->ring.size / 4) {
+					GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHMOut] PID properties too large for ring (%u bytes), increase ring size\n", size));
+					return GF_OUT_OF_MEM;
+				}
+				if (!shmout_write_record(ctx, ctx->hdr, size, NULL, 0, GF_SHM_REC_PCK|GF_SHM_REC_START|GF_SHM_REC_END))
+					goto ring_full;
+				st->config_pending = GF_FALSE;
+			}
+			if (!pck) {
+				if (gf_filter_pid_is_eos(st->pid)) {
+					Bool is_flush = gf_filter_pid_is_flush_eos(st->pid);
+					if (!st->eos_sent) {
+						shmout_msg_start(ctx, GF_SHM_MSG_PID_EOS, st);
+						gf_bs_write_u8(ctx->bs, is_flush ? 1 : 0);
+						size = shmout_msg_end(ctx);
+						if (!shmout_write_record(ctx, ctx->hdr, size, NULL, 0, GF_SHM_REC_PCK|GF_SHM_REC_START|GF_SHM_REC_END))
+							goto ring_full;
+						st->eos_sent = GF_TRUE;
+					}
+					if (!is_flush) nb_eos++;
+				}
+				break;
+			}
+			st->eos_sent = GF_FALSE;
+			if (gf_filter_pck_get_frame_interface(pck) && !gf_filter_pck_get_data(pck, &size)) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[SHMOut] Frame interface packets cannot be shared between processes, dropping\n"));
+			} else if (!shmout_write_packet(ctx, st, pck)) {
+				goto ring_full;
+			}
+			gf_filter_pid_drop_packet(st->pid);
+		}
+	}
+	if (count && (nb_eos==count)) {
+		shmout_set_eos(ctx);
+		return GF_EOS;
+	}
+	return GF_OK;
+
+ring_full:
+	//reader is late, try again later without blocking the scheduler
+	gf_filter_ask_rt_reschedule(filter, ctx->poll);
+	return GF_OK;
+}
+
+static GF_Err shmout_process(GF_Filter *filter)
+{
+	GF_FilterPacket *pck;
+	const u8 *pck_data;
+	u32 pck_size, max_rec;
+	GF_ShmOutCtx *ctx = (GF_ShmOutCtx *) gf_filter_get_udta(filter);
+
+	if (!ctx->ring.hdr) return GF_EOS;
+	if (ctx->pck_mode)
+		return shmout_process_pck_mode(filter, ctx);
+
+	pck = gf_filter_pid_get_packet(ctx->pid);
+	if (!pck) {
+		if (gf_filter_pid_is_eos(ctx->pid)) {
+			if (gf_filter_pid_is_flush_eos(ctx->pid)) {
+				if (!shmout_write_record(ctx, NULL, 0, NULL, 0, GF_SHM_REC_FLUSH)) {
+					gf_filter_ask_rt_reschedule(filter, ctx->poll);
+				}
+				return GF_OK;
+			}
+			shmout_set_eos(ctx);
+			return GF_EOS;
+		}
+		return GF_OK;
+	}
+
+	pck_data = gf_filter_pck_get_data(pck, &pck_size);
+	if (!pck_data && pck_size) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[SHMOut] No data associated with packet, cannot write\n"));
+		gf_filter_pid_drop_packet(ctx->pid);
+		return GF_OK;
+	}
+	//large packets are split in several records so that the ring never deadlocks
+	max_rec = (ctx->ring.size / 4) & ~7;
+	while (ctx->pck_offset < pck_size) {
+		u32 size = MIN(pck_size - ctx->pck_offset, max_rec);
+		if (!shmout_write_record(ctx, NULL, 0, pck_data + ctx->pck_offset, size, 0)) {
+			//reader is late, try again later without blocking the scheduler
+			gf_filter_ask_rt_reschedule(filter, ctx->poll);
+			return GF_OK;
+		}
+		ctx->pck_offset += size;
+	}
+	ctx->nb_bytes += pck_size;
+	ctx->nb_pck++;
+	ctx->pck_offset = 0;
+	gf_filter_pid_drop_packet(ctx->pid);
+	return GF_OK;
+}
+
+static GF_FilterProbeScore shmout_probe_url(const char *url, const char *mime)
+{
+	if (!strnicmp(url, "shm://", 6)) return GF_FPROBE_SUPPORTED;
+	return GF_FPROBE_NOT_SUPPORTED;
+}
+
+#define OFFS(_n)	#_n, offsetof(GF_ShmOutCtx, _n)
+
+static const GF_FilterArgs ShmOutArgs[] =
+{
+	{ OFFS(dst), "name of destination shared memory ring", GF_PROP_NAME, NULL, NULL, 0},
+	{ OFFS(ext), "indicate file extension of data", GF_PROP_STRING, NULL, NULL, 0},
+	{ OFFS(mime), "indicate mime type of data", GF_PROP_STRING, NULL, NULL, 0},
+	{ OFFS(size), "size of ring data area if the ring is created", GF_PROP_UINT, "16777216", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(poll), "delay in microseconds before checking again for free space when the ring is full", GF_PROP_UINT, "1000", NULL, GF_FS_ARG_HINT_EXPERT},
+	{0}
+};
+
+static const GF_FilterCapability ShmOutCaps[] =
+{
+	CAP_UINT(GF_CAPS_INPUT,GF_PROP_PID_STREAM_TYPE, GF_STREAM_FILE),
+	CAP_STRING(GF_CAPS_INPUT,GF_PROP_PID_FILE_EXT, "*"),
+	CAP_STRING(GF_CAPS_INPUT,GF_PROP_PID_MIME, "*"),
+	{0},
+	CAP_UINT(GF_CAPS_INPUT_EXCLUDED,GF_PROP_PID_STREAM_TYPE, GF_STREAM_FILE),
+	CAP_BOOL(GF_CAPS_INPUT_EXCLUDED, GF_PROP_PID_UNFRAMED, GF_TRUE),
+	CAP_UINT(GF_CAPS_INPUT_EXCLUDED, GF_PROP_PID_CODECID, GF_CODECID_NONE),
+};
+
+
+GF_FilterRegister ShmOutRegister = {
+	.name = "shmout",
+	GF_FS_SET_DESCRIPTION("Shared memory output")
+	GF_FS_SET_HELP("This filter sends data to another GPAC process through a shared memory ring.\n"
+		"The associated protocol scheme is `shm://` when loaded as a generic output (e.g. -o `shm://NAME` where NAME is the ring name).\n"
+		"\n"
+		"The ring is a POSIX shared memory object (`/dev/shm/gpac_NAME` on Linux) created by whichever of the reader or writer starts first, using the [-size]() of that side.\n"
+		"Data is copied once in the ring and signaled to the reader using futex wake-ups on Linux. "
+		"The reader ([shmin](shmin)) dispatches packets pointing directly in the ring, and ring space is only reused once these packets are released by its filter chain.\n"
+		"\n"
+		"# Packet mode\n"
+		"When no extension or MIME type is given, the filter accepts any number of PIDs and carries PID configurations, packets and their properties. "
+		"Packet properties are serialized in front of the packet payload, and the payload is dispatched by the reader without copy.\n"
+		"Packets larger than a quarter of the ring are split in several records and copied by the reader.\n"
+		"EX gpac -i source.mp4 -o shm://ring\n"
+		"EX gpac -i shm://ring vout aout\n"
+		"\n"
+		"# File mode\n"
+		"When an extension (either in name or through [-ext]() option) or MIME type (through [-mime]()) is given, the filter carries a single file stream of that format, "
+		"which is parsed again by the reader (e.g. `ext=gsf` to use GSF serialization).\n"
+		"\n"
+		"When the ring is full, the filter checks again after [-poll]() microseconds and never blocks the scheduler.\n"
+		"Flush events are forwarded to the reader, and end of stream is signaled when all input PIDs are done.\n"
+	"")
+	.private_size = sizeof(GF_ShmOutCtx),
+	.args = ShmOutArgs,
+	SETCAPS(ShmOutCaps),
+	.probe_url = shmout_probe_url,
+	.initialize = shmout_initialize,
+	.finalize = shmout_finalize,
+	.configure_pid = shmout_configure_pid,
+	.process = shmout_process,
+	.max_extra_pids = (u32) -1,
+	.flags = GF_FS_REG_TEMP_INIT
+};
+
+
+const GF_FilterRegister *shmout_register(GF_FilterSession *session)
+{
+	if (gf_opts_get_bool("temp", "get_proto_schemes")) {
+		gf_opts_set_key("temp_out_proto", ShmOutRegister.name, "shm");
+	}
+	return &ShmOutRegister;
+}
+#else
+const GF_FilterRegister *shmout_register(GF_FilterSession *session)
+{
+	return NULL;
+}
+#endif // GPAC_HAS_SHM_RING
@@ -153,6 +153,8 @@ typedef struct
 
 	u8 *nal_store;
 	u32 nal_store_size, nal_store_alloc;
+	//bytes of the NAL at start of nal_store already scanned for the next start code
+	u32 nal_scan_offset;
 
 	//list of param sets found
 	GF_List *sps, *pps, *vps, *sps_ext, *pps_svc, *vvc_aps_pre, *vvc_dci, *vvc_opi;
@@ -396,6 +398,7 @@ GF_Err naludmx_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remov
 			naludmx_enqueue_or_dispatch(ctx, NULL, GF_TRUE);
 		}
 		ctx->nal_store_size = 0;
+		ctx->nal_scan_offset = 0;
 
 		if (ctx->timescale != 0)
 			ctx->resume_from = 0;
@@ -1968,6 +1971,7 @@ static Bool naludmx_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 			}
 			ctx->resume_from = 0;
 			ctx->nal_store_size = 0;
+			ctx->nal_scan_offset = 0;
 			return GF_FALSE;
 		}
 		if (ctx->start_range && (ctx->index<0)) {
@@ -2008,6 +2012,7 @@ static Bool naludmx_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 		ctx->nb_nalus = 0;
 		ctx->resume_from = 0;
 		ctx->nal_store_size = 0;
+		ctx->nal_scan_offset = 0;
 
 		//post a seek
 		GF_FEVT_INIT(fevt, GF_FEVT_SOURCE_SEEK, ctx->ipid);
@@ -2021,6 +2026,7 @@ static Bool naludmx_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 		//don't cancel event
 		ctx->is_playing = GF_FALSE;
 		ctx->nal_store_size = 0;
+		ctx->nal_scan_offset = 0;
 		ctx->resume_from = 0;
 		ctx->cts = 0;
 		return GF_FALSE;
@@ -3128,7 +3134,8 @@ restart:
 		u32 pck_size;
 		const u8 *data = gf_filter_pck_get_data(pck, &pck_size);
 		if (ctx->nal_store_alloc < ctx->nal_store_size + pck_size) {
-			ctx->nal_store_alloc = ctx->nal_store_size + pck_size;
+			//grow geometrically, large NALs spanning many packets would otherwise realloc and move the store for each packet
+			ctx->nal_store_alloc = MAX(ctx->nal_store_size + pck_size, 2*ctx->nal_store_alloc);
 			ctx->nal_store = gf_realloc(ctx->nal_store, sizeof(char)*ctx->nal_store_alloc);
 			if (!ctx->nal_store) {
 				ctx->nal_store_alloc = 0;
@@ -3342,14 +3349,23 @@ naldmx_flush:
 			nal_ref_idc = (nal_data[0] & 0x60) >> 5;
 		}
 
-		//locate next NAL start
-		next = gf_media_nalu_next_start_code(nal_data, nal_size, &next_sc_size);
+		//locate next NAL start, resuming the scan of a NAL spanning several input packets
+		if (ctx->nal_scan_offset && (start == ctx->nal_store) && (ctx->nal_scan_offset < nal_size)) {
+			next = ctx->nal_scan_offset + gf_media_nalu_next_start_code(nal_data + ctx->nal_scan_offset, nal_size - ctx->nal_scan_offset, &next_sc_size);
+		} else {
+			next = gf_media_nalu_next_start_code(nal_data, nal_size, &next_sc_size);
+		}
+		ctx->nal_scan_offset = 0;
 		if (!is_eos && (next == nal_size) && !ctx->full_au_source) {
 			next = -1;
 		}
 
 		//next nal start not found, wait
 		if (next<0) {
+			//remember scanned bytes, keeping 3 bytes for a start code split across packets
+			//the NAL is moved at the start of nal_store once the loop exits
+			if (nal_size>3)
+				ctx->nal_scan_offset = nal_size - 3;
 			break;
 		}
 
@@ -3914,6 +3930,7 @@ naldmx_flush:
 		if (is_eos && (remain == ctx->nal_store_size)) {
 			GF_LOG(GF_LOG_WARNING, GF_LOG_MEDIA, ("[%s] Incomplete last NAL and eos, discarding\n", ctx->log_name));
 			remain = 0;
+			ctx->nal_scan_offset = 0;
 		} else {
 			gf_assert((u32) remain<=ctx->nal_store_size);
 			memmove(ctx->nal_store, start, remain);
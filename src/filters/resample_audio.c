@@ -33,7 +33,7 @@
 typedef struct
 {
 	//opts
-	u32 och, osr, osfmt;
+	u32 och, osr, osfmt, rq;
 
 	//internal
 	GF_FilterPid *ipid, *opid;
@@ -55,6 +55,8 @@ typedef struct
 	Fixed speed;
 	GF_FilterPacket *in_pck;
 	Bool cfg_changed;
+	//mixer still outputs filter tail after end of stream
+	Bool flush_pending;
 } GF_ResampleCtx;
 
 
@@ -145,6 +147,7 @@ static GF_Err resample_initialize(GF_Filter *filter)
 	ctx->input_ai.GetSpeed = resample_get_speed;
 	ctx->input_ai.GetChannelVolume = resample_get_channel_volume;
 	ctx->speed = FIX_ONE;
+	gf_mixer_set_resample_quality(ctx->mixer, ctx->rq);
 	return GF_OK;
 }
 
@@ -279,7 +282,7 @@ static GF_Err resample_process(GF_Filter *filter)
 
 			if (!ctx->in_pck) {
 				if (gf_filter_pid_is_eos(ctx->ipid)) {
-					if (ctx->passthrough || ctx->input_ai.is_eos) {
+					if (ctx->passthrough || (ctx->input_ai.is_eos && !ctx->flush_pending)) {
 						if (ctx->opid)
 							gf_filter_pid_set_eos(ctx->opid);
 						return GF_EOS;
@@ -324,6 +327,9 @@ static GF_Err resample_process(GF_Filter *filter)
 				while (osize % bytes_per_samp)
 					osize++;
 			}
+		} else if (ctx->rq) {
+			//flush remaining samples from mixer, polyphase tail may be up to a few hundred samples
+			osize = 256*ctx->nb_ch * bps / 8;
 		} else {
 			//flush remaining samples from mixer, use 20 sample buffer
 			osize = 20*ctx->nb_ch * bps / 8;
@@ -336,6 +342,8 @@ static GF_Err resample_process(GF_Filter *filter)
 			gf_filter_pck_merge_properties(ctx->in_pck, dstpck);
 
 		written = gf_mixer_get_output(ctx->mixer, output, osize, 0);
+		//flush buffer filled, call again
+		ctx->flush_pending = (!ctx->in_pck && ctx->rq && (written==osize)) ? GF_TRUE : GF_FALSE;
 		if (!written) {
 			gf_filter_pck_discard(dstpck);
 		} else {
@@ -465,13 +473,23 @@ static GF_FilterArgs ResamplerArgs[] =
 	{ OFFS(osr), "desired sample rate of output audio (0 for auto)", GF_PROP_UINT, "0", NULL, 0},
 	{ OFFS(osfmt), "desired sample format of output audio (`none` for auto)", GF_PROP_PCMFMT, "none", NULL, 0},
 	{ OFFS(olayout), "desired CICP layout of output audio (null for auto)", GF_PROP_CICP_LAYOUT, NULL, NULL, 0},
+	{ OFFS(rq), "resampling quality\n"
+	"- linear: linear interpolation\n"
+	"- fast: 16-tap polyphase windowed-sinc\n"
+	"- std: 32-tap polyphase windowed-sinc\n"
+	"- best: 64-tap polyphase windowed-sinc", GF_PROP_UINT, "linear", "linear|fast|std|best", GF_FS_ARG_HINT_ADVANCED},
 	{0}
 };
 
 GF_FilterRegister ResamplerRegister = {
 	.name = "resample",
 	GF_FS_SET_DESCRIPTION("Audio resampler")
-	GF_FS_SET_HELP("This filter resamples raw audio to a target sample rate, number of channels or audio format.")
+	GF_FS_SET_HELP("This filter resamples raw audio to a target sample rate, number of channels or audio format.\n"
+	"\n"
+	"By default, sample rate conversion uses linear interpolation. The [-rq]() option selects a polyphase windowed-sinc resampler "
+	"with precomputed Kaiser filter banks, giving much lower aliasing and distortion. The filter length is stretched when downsampling, "
+	"so cost grows with the input to output rate ratio.\n"
+	"Channel mapping and speed handling are the same in all modes.")
 	.private_size = sizeof(GF_ResampleCtx),
 	.initialize = resample_initialize,
 	.finalize = resample_finalize,
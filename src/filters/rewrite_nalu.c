@@ -540,6 +540,22 @@ GF_Err nalumx_process(GF_Filter *filter)
 		size += dsi_buf_size;
 	}
 
+	//4-byte length fields, nothing removed nor inserted: rewrite length fields to start codes in place
+	//the clone only copies the source data if it is shared with other filters
+	if ((size == pck_size) && (ctx->nal_hdr_size==4) && has_nalu_delim && !dsi_buf_size) {
+		u32 pos = 0;
+		dst_pck = gf_filter_pck_new_clone(ctx->opid, pck, &output);
+		if (!dst_pck) return GF_OUT_OF_MEM;
+		while (pos + 4 <= size) {
+			u32 nal_size = GF_4CC(output[pos], output[pos+1], output[pos+2], output[pos+3]);
+			output[pos] = output[pos+1] = output[pos+2] = 0;
+			output[pos+3] = 1;
+			pos += 4 + nal_size;
+			ctx->nb_nalu++;
+		}
+		goto send_pck;
+	}
+
 	dst_pck = gf_filter_pck_new_alloc(ctx->opid, size, &output);
 	if (!dst_pck) return GF_OUT_OF_MEM;
 
@@ -630,6 +646,8 @@ GF_Err nalumx_process(GF_Filter *filter)
 		ctx->nb_nalu++;
 	}
 	gf_filter_pck_merge_properties(pck, dst_pck);
+
+send_pck:
 	gf_filter_pck_set_byte_offset(dst_pck, GF_FILTER_NO_BO);
 
 	gf_filter_pck_set_framing(dst_pck, GF_TRUE, GF_TRUE);
@@ -733,7 +751,8 @@ static const GF_FilterArgs NALUMxArgs[] =
 GF_FilterRegister NALUMxRegister = {
 	.name = "ufnalu",
 	GF_FS_SET_DESCRIPTION("AVC/HEVC to AnnexB writer")
-	GF_FS_SET_HELP("This filter converts AVC|H264 and HEVC streams into AnnexB format, with inband parameter sets and start codes.")
+	GF_FS_SET_HELP("This filter converts AVC|H264 and HEVC streams into AnnexB format, with inband parameter sets and start codes.\n"
+	"When the input uses 4-byte NAL length fields and no NAL is removed or inserted in a packet, length fields are rewritten in place and the packet data is only copied if shared with other filters.")
 	.private_size = sizeof(GF_NALUMxCtx),
 	.args = NALUMxArgs,
 	.finalize = nalumx_finalize,
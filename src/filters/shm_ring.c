@@ -0,0 +1,489 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: agent
+ *			Copyright (c) 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / shared memory ring transport
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include "shm_ring.h"
+#include <gpac/network.h>
+
+#ifdef GPAC_HAS_SHM_RING
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#if defined(GPAC_CONFIG_LINUX)
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <time.h>
+#define SHM_HAS_FUTEX
+#endif
+
+GF_Err gf_shm_ring_open(GF_ShmRing *ring, const char *name, u32 size)
+{
+	char szName[GF_MAX_PATH];
+	u32 i, len;
+	GF_ShmRingHeader *hdr;
+	void *ptr;
+
+	memset(ring, 0, sizeof(GF_ShmRing));
+	ring->fd = -1;
+	if (!name || !name[0]) return GF_BAD_PARAM;
+	if (!strnicmp(name, "shm://", 6)) name += 6;
+
+	//POSIX shared memory names are a single path component starting with '/'
+	snprintf(szName, GF_MAX_PATH-1, "/gpac_%s", name);
+	szName[GF_MAX_PATH-1] = 0;
+	len = (u32) strlen(szName);
+	for (i=1; i<len; i++) {
+		if (szName[i]=='/') szName[i] = '_';
+	}
+
+	size = (size + 7) & ~7;
+	if (size < 65536) size = 65536;
+
+	ring->fd = shm_open(szName, O_RDWR | O_CREAT | O_EXCL, 0666);
+	if (ring->fd >= 0) {
+		ring->created = GF_TRUE;
+		if (ftruncate(ring->fd, (off_t) GF_SHM_HDR_SIZE + size) < 0) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHM] Failed to allocate %u bytes for %s: %s\n", size, szName, gf_errno_str(errno)));
+			close(ring->fd);
+			shm_unlink(szName);
+			ring->fd = -1;
+			return GF_IO_ERR;
+		}
+	} else if (errno == EEXIST) {
+		struct stat st;
+		u32 retry = 100;
+		ring->fd = shm_open(szName, O_RDWR, 0666);
+		if (ring->fd < 0) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHM] Failed to open %s: %s\n", szName, gf_errno_str(errno)));
+			return GF_URL_ERROR;
+		}
+		//creator may not have resized the object yet
+		while (retry) {
+			if ((fstat(ring->fd, &st) == 0) && (st.st_size > GF_SHM_HDR_SIZE)) break;
+			gf_sleep(1);
+			retry--;
+		}
+		if (!retry) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHM] Shared memory %s not initialized\n", szName));
+			close(ring->fd);
+			ring->fd = -1;
+			return GF_IO_ERR;
+		}
+		size = (u32) (st.st_size - GF_SHM_HDR_SIZE);
+	} else {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHM] Failed to create %s: %s\n", szName, gf_errno_str(errno)));
+		return GF_IO_ERR;
+	}
+
+	ring->map_size = (u64) GF_SHM_HDR_SIZE + size;
+	ptr = mmap(NULL, (size_t) ring->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, ring->fd, 0);
+	if (ptr == MAP_FAILED) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHM] Failed to map %s: %s\n", szName, gf_errno_str(errno)));
+		close(ring->fd);
+		if (ring->created) shm_unlink(szName);
+		ring->fd = -1;
+		return GF_IO_ERR;
+	}
+	hdr = (GF_ShmRingHeader *) ptr;
+	ring->hdr = hdr;
+	ring->data = (u8 *) ptr + GF_SHM_HDR_SIZE;
+	ring->name = gf_strdup(szName);
+
+	if (ring->created) {
+		hdr->version = GF_SHM_VERSION;
+		hdr->size = size;
+		hdr->hdr_size = GF_SHM_HDR_SIZE;
+		//magic is set last, once header is valid
+		__atomic_store_n(&hdr->magic, GF_SHM_MAGIC, __ATOMIC_RELEASE);
+	} else {
+		u32 retry = 100;
+		while (retry && (__atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) != GF_SHM_MAGIC)) {
+			gf_sleep(1);
+			retry--;
+		}
+		if ((hdr->magic != GF_SHM_MAGIC) || (hdr->version != GF_SHM_VERSION) || (hdr->hdr_size != GF_SHM_HDR_SIZE) || (hdr->size > size)) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHM] Shared memory %s is not a valid GPAC ring\n", szName));
+			gf_shm_ring_close(ring, GF_FALSE);
+			return GF_NON_COMPLIANT_BITSTREAM;
+		}
+		size = hdr->size;
+	}
+	ring->size = size;
+	GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[SHM] %s ring %s size %u\n", ring->created ? "Created" : "Attached to", szName, size));
+	return GF_OK;
+}
+
+void gf_shm_ring_close(GF_ShmRing *ring, Bool do_unlink)
+{
+	if (ring->hdr) munmap(ring->hdr, (size_t) ring->map_size);
+	ring->hdr = NULL;
+	ring->data = NULL;
+	if (ring->fd >= 0) close(ring->fd);
+	ring->fd = -1;
+	if (ring->name) {
+		if (do_unlink) shm_unlink(ring->name);
+		gf_free(ring->name);
+		ring->name = NULL;
+	}
+}
+
+Bool gf_shm_ring_wait(u32 *word, u32 value, u32 timeout_us)
+{
+	if (__atomic_load_n(word, __ATOMIC_ACQUIRE) != value) return GF_TRUE;
+#ifdef SHM_HAS_FUTEX
+	struct timespec ts;
+	ts.tv_sec = timeout_us / 1000000;
+	ts.tv_nsec = (timeout_us % 1000000) * 1000;
+	//shared futex, the word lives in memory mapped by several processes
+	if (syscall(SYS_futex, word, FUTEX_WAIT, value, &ts, NULL, 0) < 0) {
+		if (errno == ETIMEDOUT) return GF_FALSE;
+	}
+	return GF_TRUE;
+#else
+	gf_sleep(timeout_us>=1000 ? 1 : 0);
+	return (__atomic_load_n(word, __ATOMIC_ACQUIRE) != value) ? GF_TRUE : GF_FALSE;
+#endif
+}
+
+void gf_shm_ring_signal(u32 *word, u32 *waiting)
+{
+	__atomic_add_fetch(word, 1, __ATOMIC_SEQ_CST);
+#ifdef SHM_HAS_FUTEX
+	if (__atomic_load_n(waiting, __ATOMIC_SEQ_CST))
+		syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+static Bool shm_can_write_prop(const GF_PropertyValue *p)
+{
+	switch (p->type) {
+	case GF_PROP_POINTER:
+	case GF_PROP_FORBIDDEN:
+		return GF_FALSE;
+	case GF_PROP_DATA:
+	case GF_PROP_DATA_NO_COPY:
+	case GF_PROP_CONST_DATA:
+		return p->value.data.size ? GF_TRUE : GF_FALSE;
+	default:
+		return (p->type<GF_PROP_LAST_DEFINED) ? GF_TRUE : GF_FALSE;
+	}
+}
+
+static void shm_write_prop(GF_BitStream *bs, const GF_PropertyValue *p)
+{
+	u32 i, len;
+	switch (p->type) {
+	case GF_PROP_SINT:
+	case GF_PROP_UINT:
+	case GF_PROP_4CC:
+		gf_bs_write_u32(bs, p->value.uint);
+		break;
+	case GF_PROP_LSINT:
+	case GF_PROP_LUINT:
+		gf_bs_write_u64(bs, p->value.longuint);
+		break;
+	case GF_PROP_BOOL:
+		gf_bs_write_u8(bs, p->value.boolean ? 1 : 0);
+		break;
+	case GF_PROP_FRACTION:
+		gf_bs_write_u32(bs, p->value.frac.num);
+		gf_bs_write_u32(bs, p->value.frac.den);
+		break;
+	case GF_PROP_FRACTION64:
+		gf_bs_write_u64(bs, p->value.lfrac.num);
+		gf_bs_write_u64(bs, p->value.lfrac.den);
+		break;
+	case GF_PROP_FLOAT:
+		gf_bs_write_float(bs, FIX2FLT(p->value.fnumber) );
+		break;
+	case GF_PROP_DOUBLE:
+		gf_bs_write_double(bs, p->value.number);
+		break;
+	case GF_PROP_VEC2I:
+		gf_bs_write_u32(bs, p->value.vec2i.x);
+		gf_bs_write_u32(bs, p->value.vec2i.y);
+		break;
+	case GF_PROP_VEC2:
+		gf_bs_write_double(bs, p->value.vec2.x);
+		gf_bs_write_double(bs, p->value.vec2.y);
+		break;
+	case GF_PROP_VEC3I:
+		gf_bs_write_u32(bs, p->value.vec3i.x);
+		gf_bs_write_u32(bs, p->value.vec3i.y);
+		gf_bs_write_u32(bs, p->value.vec3i.z);
+		break;
+	case GF_PROP_VEC4I:
+		gf_bs_write_u32(bs, p->value.vec4i.x);
+		gf_bs_write_u32(bs, p->value.vec4i.y);
+		gf_bs_write_u32(bs, p->value.vec4i.z);
+		gf_bs_write_u32(bs, p->value.vec4i.w);
+		break;
+	case GF_PROP_STRING:
+	case GF_PROP_STRING_NO_COPY:
+	case GF_PROP_NAME:
+		len = p->value.string ? (u32) strlen(p->value.string) : 0;
+		gf_bs_write_u32(bs, len);
+		if (len) gf_bs_write_data(bs, p->value.string, len);
+		break;
+	case GF_PROP_DATA:
+	case GF_PROP_DATA_NO_COPY:
+	case GF_PROP_CONST_DATA:
+		gf_bs_write_u32(bs, p->value.data.size);
+		gf_bs_write_data(bs, p->value.data.ptr, p->value.data.size);
+		break;
+	case GF_PROP_STRING_LIST:
+		gf_bs_write_u32(bs, p->value.string_list.nb_items);
+		for (i=0; i<p->value.string_list.nb_items; i++) {
+			const char *str = p->value.string_list.vals[i];
+			len = str ? (u32) strlen(str) : 0;
+			gf_bs_write_u32(bs, len);
+			if (len) gf_bs_write_data(bs, str, len);
+		}
+		break;
+	case GF_PROP_UINT_LIST:
+	case GF_PROP_SINT_LIST:
+	case GF_PROP_4CC_LIST:
+		gf_bs_write_u32(bs, p->value.uint_list.nb_items);
+		for (i=0; i<p->value.uint_list.nb_items; i++)
+			gf_bs_write_u32(bs, p->value.uint_list.vals[i]);
+		break;
+	case GF_PROP_VEC2I_LIST:
+		gf_bs_write_u32(bs, p->value.v2i_list.nb_items);
+		for (i=0; i<p->value.v2i_list.nb_items; i++) {
+			gf_bs_write_u32(bs, p->value.v2i_list.vals[i].x);
+			gf_bs_write_u32(bs, p->value.v2i_list.vals[i].y);
+		}
+		break;
+	default:
+		//enums
+		gf_bs_write_u32(bs, p->value.uint);
+		break;
+	}
+}
+
+void gf_shm_write_props(GF_BitStream *bs, GF_FilterPid *pid, GF_FilterPacket *pck)
+{
+	u32 idx=0, p4cc, nb_props=0;
+	const char *pname;
+	const GF_PropertyValue *p;
+	u64 pos = gf_bs_get_position(bs);
+
+	gf_bs_write_u32(bs, 0);
+	while (1) {
+		p = pck ? gf_filter_pck_enum_properties(pck, &idx, &p4cc, &pname) : gf_filter_pid_enum_properties(pid, &idx, &p4cc, &pname);
+		if (!p) break;
+		if (!shm_can_write_prop(p)) continue;
+		gf_bs_write_u32(bs, p4cc);
+		if (!p4cc) {
+			u32 len = pname ? (u32) strlen(pname) : 0;
+			if (len>0xFFFF) len = 0xFFFF;
+			gf_bs_write_u16(bs, len);
+			gf_bs_write_data(bs, pname, len);
+		}
+		gf_bs_write_u8(bs, p->type);
+		shm_write_prop(bs, p);
+		nb_props++;
+	}
+	//patch property count
+	if (nb_props) {
+		u64 end = gf_bs_get_position(bs);
+		gf_bs_seek(bs, pos);
+		gf_bs_write_u32(bs, nb_props);
+		gf_bs_seek(bs, end);
+	}
+}
+
+static char *shm_read_str(GF_BitStream *bs)
+{
+	char *str;
+	u32 len = gf_bs_read_u32(bs);
+	if (len > gf_bs_available(bs)) return NULL;
+	str = gf_malloc(len+1);
+	if (!str) return NULL;
+	gf_bs_read_data(bs, str, len);
+	str[len] = 0;
+	return str;
+}
+
+GF_Err gf_shm_read_props(GF_BitStream *bs, GF_FilterPid *opid, GF_FilterPacket *pck)
+{
+	char szName[1025];
+	u32 i, j, nb_props = gf_bs_read_u32(bs);
+
+	for (i=0; i<nb_props; i++) {
+		GF_PropertyValue p;
+		u32 len, p4cc = gf_bs_read_u32(bs);
+		szName[0] = 0;
+		if (!p4cc) {
+			len = gf_bs_read_u16(bs);
+			if (len>1024) return GF_NON_COMPLIANT_BITSTREAM;
+			gf_bs_read_data(bs, szName, len);
+			szName[len] = 0;
+		}
+		memset(&p, 0, sizeof(GF_PropertyValue));
+		p.type = gf_bs_read_u8(bs);
+
+		switch (p.type) {
+		case GF_PROP_SINT:
+		case GF_PROP_UINT:
+		case GF_PROP_4CC:
+			p.value.uint = gf_bs_read_u32(bs);
+			break;
+		case GF_PROP_LSINT:
+		case GF_PROP_LUINT:
+			p.value.longuint = gf_bs_read_u64(bs);
+			break;
+		case GF_PROP_BOOL:
+			p.value.boolean = gf_bs_read_u8(bs) ? GF_TRUE : GF_FALSE;
+			break;
+		case GF_PROP_FRACTION:
+			p.value.frac.num = gf_bs_read_u32(bs);
+			p.value.frac.den = gf_bs_read_u32(bs);
+			break;
+		case GF_PROP_FRACTION64:
+			p.value.lfrac.num = gf_bs_read_u64(bs);
+			p.value.lfrac.den = gf_bs_read_u64(bs);
+			break;
+		case GF_PROP_FLOAT:
+			p.value.fnumber = FLT2FIX( gf_bs_read_float(bs) );
+			break;
+		case GF_PROP_DOUBLE:
+			p.value.number = gf_bs_read_double(bs);
+			break;
+		case GF_PROP_VEC2I:
+			p.value.vec2i.x = gf_bs_read_u32(bs);
+			p.value.vec2i.y = gf_bs_read_u32(bs);
+			break;
+		case GF_PROP_VEC2:
+			p.value.vec2.x = gf_bs_read_double(bs);
+			p.value.vec2.y = gf_bs_read_double(bs);
+			break;
+		case GF_PROP_VEC3I:
+			p.value.vec3i.x = gf_bs_read_u32(bs);
+			p.value.vec3i.y = gf_bs_read_u32(bs);
+			p.value.vec3i.z = gf_bs_read_u32(bs);
+			break;
+		case GF_PROP_VEC4I:
+			p.value.vec4i.x = gf_bs_read_u32(bs);
+			p.value.vec4i.y = gf_bs_read_u32(bs);
+			p.value.vec4i.z = gf_bs_read_u32(bs);
+			p.value.vec4i.w = gf_bs_read_u32(bs);
+			break;
+		//memory is handed over to the property
+		case GF_PROP_STRING:
+		case GF_PROP_STRING_NO_COPY:
+		case GF_PROP_NAME:
+			p.type = GF_PROP_STRING_NO_COPY;
+			p.value.string = shm_read_str(bs);
+			if (!p.value.string) return GF_NON_COMPLIANT_BITSTREAM;
+			break;
+		case GF_PROP_DATA:
+		case GF_PROP_DATA_NO_COPY:
+		case GF_PROP_CONST_DATA:
+			p.type = GF_PROP_DATA_NO_COPY;
+			p.value.data.size = gf_bs_read_u32(bs);
+			if (!p.value.data.size || (p.value.data.size > gf_bs_available(bs))) return GF_NON_COMPLIANT_BITSTREAM;
+			p.value.data.ptr = gf_malloc(p.value.data.size);
+			if (!p.value.data.ptr) return GF_OUT_OF_MEM;
+			gf_bs_read_data(bs, p.value.data.ptr, p.value.data.size);
+			break;
+		case GF_PROP_STRING_LIST:
+			len = gf_bs_read_u32(bs);
+			if (len > gf_bs_available(bs)) return GF_NON_COMPLIANT_BITSTREAM;
+			p.value.string_list.vals = gf_malloc(sizeof(char*) * (len ? len : 1));
+			if (!p.value.string_list.vals) return GF_OUT_OF_MEM;
+			p.value.string_list.nb_items = len;
+			for (j=0; j<len; j++) {
+				p.value.string_list.vals[j] = shm_read_str(bs);
+				if (!p.value.string_list.vals[j]) {
+					p.value.string_list.nb_items = j;
+					gf_props_reset_single(&p);
+					return GF_NON_COMPLIANT_BITSTREAM;
+				}
+			}
+			break;
+		//lists are copied when assigned
+		case GF_PROP_UINT_LIST:
+		case GF_PROP_SINT_LIST:
+		case GF_PROP_4CC_LIST:
+			len = gf_bs_read_u32(bs);
+			if (4*len > gf_bs_available(bs)) return GF_NON_COMPLIANT_BITSTREAM;
+			p.value.uint_list.vals = gf_malloc(sizeof(u32) * (len ? len : 1));
+			if (!p.value.uint_list.vals) return GF_OUT_OF_MEM;
+			p.value.uint_list.nb_items = len;
+			for (j=0; j<len; j++)
+				p.value.uint_list.vals[j] = gf_bs_read_u32(bs);
+			break;
+		case GF_PROP_VEC2I_LIST:
+			len = gf_bs_read_u32(bs);
+			if (8*len > gf_bs_available(bs)) return GF_NON_COMPLIANT_BITSTREAM;
+			p.value.v2i_list.vals = gf_malloc(sizeof(GF_PropVec2i) * (len ? len : 1));
+			if (!p.value.v2i_list.vals) return GF_OUT_OF_MEM;
+			p.value.v2i_list.nb_items = len;
+			for (j=0; j<len; j++) {
+				p.value.v2i_list.vals[j].x = gf_bs_read_u32(bs);
+				p.value.v2i_list.vals[j].y = gf_bs_read_u32(bs);
+			}
+			break;
+		default:
+			if (!gf_props_type_is_enum(p.type)) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[SHM] Unknown property type %d in ring\n", p.type));
+				return GF_NON_COMPLIANT_BITSTREAM;
+			}
+			p.value.uint = gf_bs_read_u32(bs);
+			break;
+		}
+		if (gf_bs_is_overflow(bs)) {
+			gf_props_reset_single(&p);
+			return GF_NON_COMPLIANT_BITSTREAM;
+		}
+
+		if (pck) {
+			if (p4cc) gf_filter_pck_set_property(pck, p4cc, &p);
+			else gf_filter_pck_set_property_dyn(pck, szName, &p);
+		} else {
+			if (p4cc) gf_filter_pid_set_property(opid, p4cc, &p);
+			else gf_filter_pid_set_property_dyn(opid, szName, &p);
+		}
+		//lists were copied
+		switch (p.type) {
+		case GF_PROP_UINT_LIST:
+		case GF_PROP_SINT_LIST:
+		case GF_PROP_4CC_LIST:
+		case GF_PROP_VEC2I_LIST:
+			gf_free(p.value.uint_list.vals);
+			break;
+		default:
+			break;
+		}
+	}
+	return GF_OK;
+}
+
+#endif //GPAC_HAS_SHM_RING
@@ -0,0 +1,158 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: agent
+ *			Copyright (c) 2026
+ *					All rights reserved
+ *
+ *  This file is part of GPAC / shared memory ring transport
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#ifndef _SHM_RING_H_
+#define _SHM_RING_H_
+
+#include <gpac/filters.h>
+#include <gpac/bitstream.h>
+
+#if !defined(WIN32) && !defined(GPAC_CONFIG_ANDROID) && !defined(GPAC_CONFIG_EMSCRIPTEN) && !defined(GPAC_DISABLE_SHM)
+#define GPAC_HAS_SHM_RING
+#endif
+
+#ifdef GPAC_HAS_SHM_RING
+
+/*
+Ring layout: one header page followed by the data area.
+
+The data area holds records, each starting with a GF_ShmRecord header followed by the payload, padded to 8 bytes.
+Records never wrap: when the remaining space before the end of the data area is too small, a padding record fills it.
+Positions are 64-bit byte counters, the offset in the data area is position % size.
+write_pos is only modified by the writer, read_pos only by the reader once records are released.
+The reader publishes records as shared packets pointing in the data area, so read_pos only moves when
+downstream filters release them.
+write_seq and read_seq are futex words bumped on each publish and each release.
+*/
+
+#define GF_SHM_MAGIC	GF_4CC('G','S','H','M')
+#define GF_SHM_VERSION	1
+#define GF_SHM_HDR_SIZE	4096
+
+typedef struct
+{
+	u32 magic;
+	u32 version;
+	//size of data area, multiple of 8
+	u32 size;
+	u32 hdr_size;
+	//futex words
+	u32 write_seq;
+	u32 read_seq;
+	//waiting flags, wake only done if set
+	u32 reader_waiting;
+	u32 writer_waiting;
+	//GF_SHM_STATE_* flags
+	u32 state;
+	u32 reserved;
+	u64 write_pos;
+	u64 read_pos;
+} GF_ShmRingHeader;
+
+enum
+{
+	GF_SHM_STATE_WRITER = 1,
+	GF_SHM_STATE_EOS = 1<<1,
+	GF_SHM_STATE_READER = 1<<2,
+};
+
+typedef struct
+{
+	//payload size, not including padding
+	u32 size;
+	//GF_SHM_REC_* flags
+	u32 flags;
+} GF_ShmRecord;
+
+enum
+{
+	GF_SHM_REC_PAD = 1,
+	//first and last record of a packet in packet mode
+	GF_SHM_REC_START = 1<<1,
+	GF_SHM_REC_END = 1<<2,
+	GF_SHM_REC_FLUSH = 1<<3,
+	//record is a packet mode message, otherwise a file stream block
+	GF_SHM_REC_PCK = 1<<4,
+};
+
+/*
+Packet mode messages, carried in records with GF_SHM_REC_PCK flag set. A message starts with its type (u8) and the PID ID (u32):
+- PID_CONFIG: u32 number of properties followed by the PID properties
+- PCK: packet header (timing, SAP and flags), u32 data size, u32 number of properties followed by the packet properties.
+The packet data starts at the next 8-byte boundary in the record, so that it can be dispatched in place.
+Packets larger than what fits in a record are split: the first record (GF_SHM_REC_START) holds the message header and the start of the data,
+the following records hold the rest of the data, the last one having GF_SHM_REC_END set.
+- PID_EOS: u8 set to 1 for flush
+- PID_REMOVE: no payload
+Properties are written as u32 4CC (0 for named properties, followed by u16 name length and name), u8 property type and value.
+*/
+enum
+{
+	GF_SHM_MSG_PID_CONFIG = 1,
+	GF_SHM_MSG_PCK,
+	GF_SHM_MSG_PID_EOS,
+	GF_SHM_MSG_PID_REMOVE,
+};
+
+enum
+{
+	GF_SHM_PCK_START = 1,
+	GF_SHM_PCK_END = 1<<1,
+	GF_SHM_PCK_SEEK = 1<<2,
+	GF_SHM_PCK_CORRUPTED = 1<<3,
+};
+
+#define GF_SHM_REC_SIZE(_size)	(sizeof(GF_ShmRecord) + (((_size) + 7) & ~7))
+
+typedef struct
+{
+	GF_ShmRingHeader *hdr;
+	u8 *data;
+	u32 size;
+	u64 map_size;
+	char *name;
+	int fd;
+	Bool created;
+} GF_ShmRing;
+
+/*opens ring with given name, creating it with data area size if not found
+name is the URL without the shm:// scheme*/
+GF_Err gf_shm_ring_open(GF_ShmRing *ring, const char *name, u32 size);
+/*unmaps ring, unlinks shared memory object if do_unlink is set*/
+void gf_shm_ring_close(GF_ShmRing *ring, Bool do_unlink);
+/*waits for futex word to change from value, for at most timeout_us microseconds
+returns GF_FALSE if timeout expired*/
+Bool gf_shm_ring_wait(u32 *word, u32 value, u32 timeout_us);
+/*increases futex word and wakes up waiters if waiting flag is set*/
+void gf_shm_ring_signal(u32 *word, u32 *waiting);
+
+/*writes all properties of a PID, or of a packet if pck is set*/
+void gf_shm_write_props(GF_BitStream *bs, GF_FilterPid *pid, GF_FilterPacket *pck);
+/*reads properties and sets them on the output PID, or on the packet if pck is set*/
+GF_Err gf_shm_read_props(GF_BitStream *bs, GF_FilterPid *opid, GF_FilterPacket *pck);
+
+#endif //GPAC_HAS_SHM_RING
+
+#endif //_SHM_RING_H_
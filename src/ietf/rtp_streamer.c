@@ -52,6 +52,10 @@ struct __rtp_streamer
 
 	const char *netcap_id;
 	GF_Err last_err;
+
+	/*packet capture instead of channel sending, used for RTSP fan-out*/
+	gf_rtp_packet_callback on_packet;
+	void *on_packet_udta;
 };
 
 
@@ -63,8 +67,12 @@ static void rtp_stream_on_new_packet(void *cbk, GF_RTPHeader *header)
 
 static void rtp_stream_on_packet_done(void *cbk, GF_RTPHeader *header)
 {
+	GF_Err e;
 	GF_RTPStreamer *rtp = (GF_RTPStreamer*)cbk;
-	GF_Err e = gf_rtp_send_packet(rtp->channel, header, rtp->buffer+12, rtp->payload_len, GF_TRUE);
+	if (rtp->on_packet)
+		e = rtp->on_packet(rtp->on_packet_udta, header, rtp->buffer+12, rtp->payload_len);
+	else
+		e = gf_rtp_send_packet(rtp->channel, header, rtp->buffer+12, rtp->payload_len, GF_TRUE);
 
 #ifndef GPAC_DISABLE_LOG
 	if (e) {
@@ -843,15 +851,19 @@ GF_EXPORT
 GF_Err gf_rtp_streamer_send_data(GF_RTPStreamer *rtp, u8 *data, u32 size, u32 fullsize, u64 cts, u64 dts, Bool is_rap, Bool au_start, Bool au_end, u32 au_sn, u32 sampleDuration, u32 sampleDescIndex)
 {
 	GF_Err e;
-	if (!rtp->channel) return data ? GF_BAD_PARAM : GF_EOS;
-
-	rtp->packetizer->sl_header.compositionTimeStamp = gf_timestamp_rescale(cts, rtp->in_timescale, rtp->channel->TimeScale);
-	rtp->packetizer->sl_header.decodingTimeStamp = gf_timestamp_rescale(dts, rtp->in_timescale, rtp->channel->TimeScale);
+	u32 timescale;
+	if (rtp->channel) timescale = rtp->channel->TimeScale;
+	//packet capture mode, no channel
+	else if (rtp->on_packet) timescale = rtp->packetizer->sl_config.timestampResolution;
+	else return data ? GF_BAD_PARAM : GF_EOS;
+
+	rtp->packetizer->sl_header.compositionTimeStamp = gf_timestamp_rescale(cts, rtp->in_timescale, timescale);
+	rtp->packetizer->sl_header.decodingTimeStamp = gf_timestamp_rescale(dts, rtp->in_timescale, timescale);
 	rtp->packetizer->sl_header.randomAccessPointFlag = is_rap;
 	rtp->packetizer->sl_header.accessUnitStartFlag = au_start;
 	rtp->packetizer->sl_header.accessUnitEndFlag = au_end;
 	rtp->packetizer->sl_header.AU_sequenceNumber = au_sn;
-	sampleDuration = (u32) gf_timestamp_rescale(sampleDuration, rtp->in_timescale, rtp->channel->TimeScale);
+	sampleDuration = (u32) gf_timestamp_rescale(sampleDuration, rtp->in_timescale, timescale);
 	if (au_start && size) rtp->packetizer->nb_aus++;
 
 	rtp->last_err = GF_OK;
@@ -882,6 +894,8 @@ void gf_rtp_streamer_disable_auto_rtcp(GF_RTPStreamer *streamer)
 GF_EXPORT
 GF_Err gf_rtp_streamer_send_rtcp(GF_RTPStreamer *streamer, Bool force_ts, u32 rtp_ts, u32 force_ntp_type, u32 ntp_sec, u32 ntp_frac)
 {
+	//packet capture mode, no channel
+	if (!streamer->channel) return GF_OK;
 	if (force_ts) streamer->channel->last_pck_ts = rtp_ts;
 	if (force_ntp_type) {
 		streamer->channel->forced_ntp_sec = ntp_sec;
@@ -933,6 +947,15 @@ GF_Err gf_rtp_streamer_set_interleave_callbacks(GF_RTPStreamer *streamer, gf_rtp
  	return gf_rtp_set_interleave_callbacks(streamer->channel, RTP_TCPCallback, cbk1, cbk2);
 }
 
+GF_EXPORT
+GF_Err gf_rtp_streamer_set_packet_callback(GF_RTPStreamer *streamer, gf_rtp_packet_callback on_packet, void *udta)
+{
+	if (!streamer) return GF_BAD_PARAM;
+	streamer->on_packet = on_packet;
+	streamer->on_packet_udta = udta;
+	return GF_OK;
+}
+
 GF_EXPORT
 GF_Err gf_rtp_streamer_read_rtcp(GF_RTPStreamer *streamer, gf_rtcp_rr_callback rtcp_cbk, void *udta)
 {
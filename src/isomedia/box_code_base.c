@@ -35,6 +35,9 @@ void co64_box_del(GF_Box *s)
 	ptr = (GF_ChunkLargeOffsetBox *) s;
 	if (ptr == NULL) return;
 	if (ptr->offsets) gf_free(ptr->offsets);
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	if (ptr->w_col.data) gf_free(ptr->w_col.data);
+#endif
 	gf_free(ptr);
 }
 
@@ -75,6 +78,9 @@ GF_Err co64_box_write(GF_Box *s, GF_BitStream *bs)
 	u32 i;
 	GF_ChunkLargeOffsetBox *ptr = (GF_ChunkLargeOffsetBox *) s;
 
+	e = stbl_FlushColumn(s);
+	if (e) return e;
+
 	e = gf_isom_full_box_write(s, bs);
 	if (e) return e;
 	gf_bs_write_u32(bs, ptr->nb_entries);
@@ -88,6 +94,7 @@ GF_Err co64_box_size(GF_Box *s)
 {
 	GF_ChunkLargeOffsetBox *ptr = (GF_ChunkLargeOffsetBox *) s;
 
+	//nb_entries includes offsets compacted while appending samples
 	ptr->size += 4 + (8 * ptr->nb_entries);
 	return GF_OK;
 }
@@ -390,6 +397,9 @@ void ctts_box_del(GF_Box *s)
 {
 	GF_CompositionOffsetBox *ptr = (GF_CompositionOffsetBox *)s;
 	if (ptr->entries) gf_free(ptr->entries);
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	if (ptr->w_col.data) gf_free(ptr->w_col.data);
+#endif
 	gf_free(ptr);
 }
 
@@ -458,7 +468,10 @@ GF_Err ctts_box_write(GF_Box *s, GF_BitStream *bs)
 
 	e = gf_isom_full_box_write(s, bs);
 	if (e) return e;
-	gf_bs_write_u32(bs, ptr->nb_entries);
+	//entries compacted while appending samples come first
+	gf_bs_write_u32(bs, ptr->w_col.nb_entries + ptr->nb_entries);
+	e = stbl_WriteColumn(s, bs);
+	if (e) return e;
 	for (i=0; i<ptr->nb_entries; i++ ) {
 		gf_bs_write_u32(bs, ptr->entries[i].sampleCount);
 		if (ptr->version) {
@@ -473,8 +486,7 @@ GF_Err ctts_box_write(GF_Box *s, GF_BitStream *bs)
 GF_Err ctts_box_size(GF_Box *s)
 {
 	GF_CompositionOffsetBox *ptr = (GF_CompositionOffsetBox *) s;
-
-	ptr->size += 4 + (8 * ptr->nb_entries);
+	ptr->size += 4 + (8 * (u64) (ptr->w_col.nb_entries + ptr->nb_entries));
 	return GF_OK;
 }
 
@@ -5424,6 +5436,9 @@ void stco_box_del(GF_Box *s)
 	GF_ChunkOffsetBox *ptr = (GF_ChunkOffsetBox *)s;
 	if (ptr == NULL) return;
 	if (ptr->offsets) gf_free(ptr->offsets);
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	if (ptr->w_col.data) gf_free(ptr->w_col.data);
+#endif
 	gf_free(ptr);
 }
 
@@ -5467,6 +5482,10 @@ GF_Err stco_box_write(GF_Box *s, GF_BitStream *bs)
 	GF_Err e;
 	u32 i;
 	GF_ChunkOffsetBox *ptr = (GF_ChunkOffsetBox *)s;
+
+	e = stbl_FlushColumn(s);
+	if (e) return e;
+
 	e = gf_isom_full_box_write(s, bs);
 	if (e) return e;
 	gf_bs_write_u32(bs, ptr->nb_entries);
@@ -5481,6 +5500,7 @@ GF_Err stco_box_size(GF_Box *s)
 {
 	GF_ChunkOffsetBox *ptr = (GF_ChunkOffsetBox *)s;
 
+	//nb_entries includes offsets compacted while appending samples
 	ptr->size += 4 + (4 * ptr->nb_entries);
 	return GF_OK;
 }
@@ -5861,6 +5881,9 @@ void stsz_box_del(GF_Box *s)
 	GF_SampleSizeBox *ptr = (GF_SampleSizeBox *)s;
 	if (ptr == NULL) return;
 	if (ptr->sizes) gf_free(ptr->sizes);
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	if (ptr->w_col.data) gf_free(ptr->w_col.data);
+#endif
 	gf_free(ptr);
 }
 
@@ -5998,6 +6021,12 @@ GF_Err stsz_box_write(GF_Box *s, GF_BitStream *bs)
 	u32 i;
 	GF_SampleSizeBox *ptr = (GF_SampleSizeBox *)s;
 
+	//regular tables are written from their compacted form
+	if (ptr->type != GF_ISOM_BOX_TYPE_STSZ) {
+		e = stbl_FlushColumn(s);
+		if (e) return e;
+	}
+
 	e = gf_isom_full_box_write(s, bs);
 	if (e) return e;
 	//in both versions this is still valid
@@ -6011,8 +6040,11 @@ GF_Err stsz_box_write(GF_Box *s, GF_BitStream *bs)
 
 	if (ptr->type == GF_ISOM_BOX_TYPE_STSZ) {
 		if (ptr->sampleSize) return GF_OK;
-		for (i = 0; i < ptr->sampleCount; i++) {
-			gf_bs_write_u32(bs, ptr->sizes ? ptr->sizes[i] : 0);
+		//sizes compacted while appending samples come first
+		e = stbl_WriteColumn(s, bs);
+		if (e) return e;
+		for (i = ptr->w_col.nb_entries; i < ptr->sampleCount; i++) {
+			gf_bs_write_u32(bs, ptr->sizes ? ptr->sizes[i - ptr->w_col.nb_entries] : 0);
 		}
 	} else {
 		if (!ptr->sizes) return GF_ISOM_INVALID_FILE;
@@ -6042,6 +6074,7 @@ GF_Err stsz_box_size(GF_Box *s)
 {
 	u32 i, fieldSize, size;
 	GF_SampleSizeBox *ptr = (GF_SampleSizeBox *)s;
+	GF_Err e;
 
 	ptr->size += 8;
 	if (!ptr->sampleCount) return GF_OK;
@@ -6052,6 +6085,9 @@ GF_Err stsz_box_size(GF_Box *s)
 		ptr->size += (4 * ptr->sampleCount);
 		return GF_OK;
 	}
+	//compact table, sizes compacted while appending samples must be restored
+	e = stbl_FlushColumn(s);
+	if (e) return e;
 	if (!ptr->sizes) return GF_ISOM_INVALID_FILE;
 
 	//compact size table
@@ -6112,6 +6148,9 @@ void stts_box_del(GF_Box *s)
 {
 	GF_TimeToSampleBox *ptr = (GF_TimeToSampleBox *)s;
 	if (ptr->entries) gf_free(ptr->entries);
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	if (ptr->w_col.data) gf_free(ptr->w_col.data);
+#endif
 	gf_free(ptr);
 }
 
@@ -6195,7 +6234,10 @@ GF_Err stts_box_write(GF_Box *s, GF_BitStream *bs)
 
 	e = gf_isom_full_box_write(s, bs);
 	if (e) return e;
-	gf_bs_write_u32(bs, ptr->nb_entries);
+	//entries compacted while appending samples come first
+	gf_bs_write_u32(bs, ptr->w_col.nb_entries + ptr->nb_entries);
+	e = stbl_WriteColumn(s, bs);
+	if (e) return e;
 	for (i=0; i<ptr->nb_entries; i++) {
 		gf_bs_write_u32(bs, ptr->entries[i].sampleCount);
 		gf_bs_write_u32(bs, ptr->entries[i].sampleDelta);
@@ -6206,7 +6248,7 @@ GF_Err stts_box_write(GF_Box *s, GF_BitStream *bs)
 GF_Err stts_box_size(GF_Box *s)
 {
 	GF_TimeToSampleBox *ptr = (GF_TimeToSampleBox *)s;
-	ptr->size += 4 + (8 * ptr->nb_entries);
+	ptr->size += 4 + (8 * (u64) (ptr->w_col.nb_entries + ptr->nb_entries));
 	return GF_OK;
 }
 
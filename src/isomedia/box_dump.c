@@ -1041,6 +1041,8 @@ GF_Err stts_box_dump(GF_Box *a, FILE * trace)
 
 	if (dump_skip_samples)
 		return GF_OK;
+	if (stbl_FlushColumn(a))
+		return GF_OUT_OF_MEM;
 
 	p = (GF_TimeToSampleBox *)a;
 	gf_isom_box_dump_start(a, "TimeToSampleBox", trace);
@@ -1068,6 +1070,8 @@ GF_Err ctts_box_dump(GF_Box *a, FILE * trace)
 
 	if (dump_skip_samples)
 		return GF_OK;
+	if (stbl_FlushColumn(a))
+		return GF_OUT_OF_MEM;
 
 	gf_isom_box_dump_start(a, "CompositionOffsetBox", trace);
 	gf_fprintf(trace, "EntryCount=\"%d\">\n", p->nb_entries);
@@ -1189,6 +1193,8 @@ GF_Err stsz_box_dump(GF_Box *a, FILE * trace)
 	p = (GF_SampleSizeBox *)a;
 	if (dump_skip_samples)
 		return GF_OK;
+	if (stbl_FlushColumn(a))
+		return GF_OUT_OF_MEM;
 
 	if (a->type == GF_ISOM_BOX_TYPE_STSZ) {
 		gf_isom_box_dump_start(a, "SampleSizeBox", trace);
@@ -1230,6 +1236,8 @@ GF_Err stco_box_dump(GF_Box *a, FILE * trace)
 
 	if (dump_skip_samples)
 		return GF_OK;
+	if (stbl_FlushColumn(a))
+		return GF_OUT_OF_MEM;
 
 	p = (GF_ChunkOffsetBox *)a;
 	gf_isom_box_dump_start(a, "ChunkOffsetBox", trace);
@@ -1380,6 +1388,8 @@ GF_Err co64_box_dump(GF_Box *a, FILE * trace)
 
 	if (dump_skip_samples)
 		return GF_OK;
+	if (stbl_FlushColumn(a))
+		return GF_OUT_OF_MEM;
 
 	p = (GF_ChunkLargeOffsetBox *)a;
 	gf_isom_box_dump_start(a, "ChunkLargeOffsetBox", trace);
@@ -1146,7 +1146,11 @@ GF_TrackBox *gf_isom_get_track_from_id(GF_MovieBox *moov, GF_ISOTrackID trackID)
 	count = gf_list_count(moov->trackList);
 	for (i = 0; i<count; i++) {
 		GF_TrackBox *trak = (GF_TrackBox*)gf_list_get(moov->trackList, i);
-		if (trak->Header->trackID == trackID) return trak;
+		if (trak->Header->trackID == trackID) {
+			if (trak->Media && trak->Media->information && stbl_FlushColumns(trak->Media->information->sampleTable))
+				return NULL;
+			return trak;
+		}
 	}
 	return NULL;
 }
@@ -1165,6 +1169,27 @@ GF_TrackBox *gf_isom_get_track_from_original_id(GF_MovieBox *moov, u32 originalI
 }
 
 GF_TrackBox *gf_isom_get_track_from_file(GF_ISOFile *movie, u32 trackNumber)
+{
+	GF_TrackBox *trak;
+	if (!movie) return NULL;
+	trak = gf_isom_get_track(movie->moov, trackNumber);
+	if (!trak) {
+		movie->LastError = GF_BAD_PARAM;
+		return NULL;
+	}
+	//sample tables may be compacted while appending samples, restore them before any other access
+	if (trak->Media && trak->Media->information) {
+		GF_Err e = stbl_FlushColumns(trak->Media->information->sampleTable);
+		if (e) {
+			movie->LastError = e;
+			return NULL;
+		}
+	}
+	return trak;
+}
+
+#ifndef GPAC_DISABLE_ISOM_WRITE
+GF_TrackBox *gf_isom_get_track_for_append(GF_ISOFile *movie, u32 trackNumber)
 {
 	GF_TrackBox *trak;
 	if (!movie) return NULL;
@@ -1172,6 +1197,7 @@ GF_TrackBox *gf_isom_get_track_from_file(GF_ISOFile *movie, u32 trackNumber)
 	if (!trak) movie->LastError = GF_BAD_PARAM;
 	return trak;
 }
+#endif
 
 
 //WARNING: MOVIETIME IS EXPRESSED IN MEDIA TS
@@ -1070,7 +1070,7 @@ GF_EXPORT
 u64 gf_isom_get_track_duration(GF_ISOFile *movie, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_for_append(movie, trackNumber);
 	if (!trak) return 0;
 
 #ifndef GPAC_DISABLE_ISOM_WRITE
@@ -1410,7 +1410,7 @@ GF_EXPORT
 u64 gf_isom_get_media_duration(GF_ISOFile *movie, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_for_append(movie, trackNumber);
 	if (!trak) return 0;
 
 
@@ -1443,7 +1443,7 @@ GF_EXPORT
 u32 gf_isom_get_media_timescale(GF_ISOFile *the_file, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_for_append(the_file, trackNumber);
 	if (!trak || !trak->Media || !trak->Media->mediaHeader) return 0;
 	return trak->Media->mediaHeader->timeScale;
 }
@@ -1566,7 +1566,7 @@ GF_EXPORT
 u32 gf_isom_get_media_type(GF_ISOFile *movie, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_for_append(movie, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 	return (trak->Media && trak->Media->handler) ? trak->Media->handler->handlerType : 0;
 }
@@ -1747,7 +1747,7 @@ GF_EXPORT
 u32 gf_isom_get_sample_count(GF_ISOFile *the_file, u32 trackNumber)
 {
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_for_append(the_file, trackNumber);
 	if (!trak || !trak->Media || !trak->Media->information || !trak->Media->information->sampleTable || !trak->Media->information->sampleTable->SampleSize) return 0;
 	return trak->Media->information->sampleTable->SampleSize->sampleCount
 #ifndef GPAC_DISABLE_ISOM_FRAGMENTS
@@ -1970,7 +1970,7 @@ u32 gf_isom_get_sample_duration(GF_ISOFile *the_file, u32 trackNumber, u32 sampl
 {
 	u32 dur;
 	u64 dts;
-	GF_TrackBox *trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	GF_TrackBox *trak = gf_isom_get_track_for_append(the_file, trackNumber);
 	if (!trak || !sampleNumber) return 0;
 #ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
 	if (sampleNumber<=trak->sample_count_at_seg_start) return 0;
@@ -1986,7 +1986,7 @@ GF_EXPORT
 u32 gf_isom_get_sample_size(GF_ISOFile *the_file, u32 trackNumber, u32 sampleNumber)
 {
 	u32 size = 0;
-	GF_TrackBox *trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	GF_TrackBox *trak = gf_isom_get_track_for_append(the_file, trackNumber);
 	if (!trak || !sampleNumber) return 0;
 #ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
 	if (sampleNumber<=trak->sample_count_at_seg_start) return 0;
@@ -2080,7 +2080,7 @@ GF_ISOSample *gf_isom_get_sample_info_ex(GF_ISOFile *the_file, u32 trackNumber,
 	GF_Err e;
 	GF_TrackBox *trak;
 	GF_ISOSample *samp;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_for_append(the_file, trackNumber);
 	if (!trak) return NULL;
 
 	if (!sampleNumber) return NULL;
@@ -2121,7 +2121,7 @@ u64 gf_isom_get_sample_dts(GF_ISOFile *the_file, u32 trackNumber, u32 sampleNumb
 {
 	u64 dts;
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_for_append(the_file, trackNumber);
 	if (!trak) return 0;
 
 	if (!sampleNumber) return 0;
@@ -2485,7 +2485,7 @@ Bool gf_isom_get_edit_list_type(GF_ISOFile *the_file, u32 trackNumber, s64 *medi
 	GF_EdtsEntry *ent;
 	GF_TrackBox *trak;
 	u32 count;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_for_append(the_file, trackNumber);
 	if (!trak) return GF_FALSE;
 	*mediaOffset = 0;
 	if (!trak->editBox || !trak->editBox->editList) return GF_FALSE;
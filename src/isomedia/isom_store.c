@@ -193,7 +193,7 @@ GF_Err SetupWriters(MovieWriter *mw, GF_List *writers, u8 interleaving)
 		writer->constant_size = writer->constant_dur = 0;
 		if (writer->stbl->SampleSize->sampleSize)
 			writer->constant_size = writer->stbl->SampleSize->sampleSize;
-		if (writer->stbl->TimeToSample->nb_entries==1) {
+		if ((writer->stbl->TimeToSample->nb_entries==1) && !writer->stbl->TimeToSample->w_col.nb_entries) {
 			writer->constant_dur = writer->stbl->TimeToSample->entries[0].sampleDelta;
 			if (writer->constant_dur>1) writer->constant_dur = 0;
 		}
@@ -1017,7 +1017,7 @@ GF_Err gf_isom_add_sample(GF_ISOFile *movie, u32 trackNumber, u32 StreamDescript
 	e = CanAccessMovie(movie, GF_ISOM_OPEN_WRITE);
 	if (e) return e;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_for_append(movie, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 
 	e = FlushCaptureMode(movie);
@@ -1174,7 +1174,7 @@ GF_Err gf_isom_append_sample_data(GF_ISOFile *movie, u32 trackNumber, u8 *data,
 	e = CanAccessMovie(movie, GF_ISOM_OPEN_WRITE);
 	if (e) return e;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_for_append(movie, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 
 	if (trak->Media->handler->handlerType == GF_ISOM_MEDIA_OD) return GF_BAD_PARAM;
@@ -1224,7 +1224,7 @@ GF_Err gf_isom_add_sample_reference(GF_ISOFile *movie, u32 trackNumber, u32 Stre
 	e = CanAccessMovie(movie, GF_ISOM_OPEN_WRITE);
 	if (e) return e;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_for_append(movie, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 
 	e = unpack_track(trak);
@@ -1280,7 +1280,8 @@ static GF_Err gf_isom_set_last_sample_duration_internal(GF_ISOFile *movie, u32 t
 	e = CanAccessMovie(movie, GF_ISOM_OPEN_WRITE);
 	if (e) return e;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	//only the last two time to sample entries are used, except when patching
+	trak = gf_isom_get_track_for_append(movie, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 
 	if (mode==0) {
@@ -1301,6 +1302,8 @@ static GF_Err gf_isom_set_last_sample_duration_internal(GF_ISOFile *movie, u32 t
 	if (is_patch) {
 		u32 i, avg_dur, nb_samp=0;
 		u64 cum_dur=0;
+		e = stbl_FlushColumn((GF_Box *)stts);
+		if (e) return e;
 		for (i=0; i<stts->nb_entries; i++) {
 			ent = (GF_SttsEntry*) &stts->entries[i];
 			cum_dur += ent->sampleCount*ent->sampleDelta;
@@ -2612,7 +2615,7 @@ static GF_Err gf_isom_set_edit_internal(GF_ISOFile *movie, u32 trackNumber, u64
 	e = CanAccessMovie(movie, GF_ISOM_OPEN_WRITE);
 	if (e) return e;
 
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_for_append(movie, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 
 	edts = trak->editBox;
@@ -2716,7 +2719,7 @@ GF_Err gf_isom_remove_edits(GF_ISOFile *movie, u32 trackNumber)
 {
 	GF_Err e;
 	GF_TrackBox *trak;
-	trak = gf_isom_get_track_from_file(movie, trackNumber);
+	trak = gf_isom_get_track_for_append(movie, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 
 	e = CanAccessMovie(movie, GF_ISOM_OPEN_WRITE);
@@ -4828,7 +4831,7 @@ GF_Err gf_isom_purge_track_reference(GF_ISOFile *the_file, u32 trackNumber)
 	GF_TrackBox *trak;
 	GF_TrackReferenceTypeBox *ref;
 	u32 i=0;
-	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	trak = gf_isom_get_track_for_append(the_file, trackNumber);
 	if (!trak) return GF_BAD_PARAM;
 
 	//no tref, nothing to remove
@@ -4991,6 +4994,7 @@ GF_Err gf_isom_change_sample_desc_index(GF_ISOFile *the_file, u32 trackNumber, u
 		unpack_track(trak);
 	}
 	if (!trak->Media->information->sampleTable->SampleToChunk) return GF_BAD_PARAM;
+	if (stbl_ExpandChunkRuns(trak->Media->information->sampleTable) != GF_OK) return GF_OUT_OF_MEM;
 	if (trak->Media->information->sampleTable->SampleToChunk->nb_entries < sample_number) return GF_BAD_PARAM;
 	trak->Media->information->sampleTable->SampleToChunk->entries[sample_number-1].sampleDescriptionIndex = newSampleDescIndex;
 	return GF_OK;
@@ -6767,7 +6771,7 @@ GF_Err gf_isom_add_subsample(GF_ISOFile *movie, u32 track, u32 sampleNumber, u32
 	e = CanAccessMovie(movie, GF_ISOM_OPEN_WRITE);
 	if (e) return e;
 
-	trak = gf_isom_get_track_from_file(movie, track);
+	trak = gf_isom_get_track_for_append(movie, track);
 	if (!trak || !trak->Media || !trak->Media->information->sampleTable)
 		return GF_BAD_PARAM;
 
@@ -7072,7 +7076,7 @@ static GF_Err gf_isom_set_sample_group_info_internal(GF_ISOFile *movie, u32 trac
 	GF_TrackFragmentBox *traf=NULL;
 #endif
 	if (!trafID && (movie->FragmentsFlags & GF_ISOM_FRAG_WRITE_READY)) {
-		trak = gf_isom_get_track_from_file(movie, track);
+		trak = gf_isom_get_track_for_append(movie, track);
 		if (!trak) return GF_BAD_PARAM;
 		trafID = trak->Header->trackID;
 	}
@@ -7091,7 +7095,7 @@ static GF_Err gf_isom_set_sample_group_info_internal(GF_ISOFile *movie, u32 trac
 		e = CanAccessMovie(movie, GF_ISOM_OPEN_WRITE);
 		if (e) return e;
 
-		trak = gf_isom_get_track_from_file(movie, track);
+		trak = gf_isom_get_track_for_append(movie, track);
 		if (!trak) return GF_BAD_PARAM;
 	}
 
@@ -7122,7 +7126,7 @@ GF_Err gf_isom_add_sample_group_info_internal(GF_ISOFile *movie, u32 track, u32
 	if (sampleGroupDescriptionIndex) *sampleGroupDescriptionIndex = 0;
 
 	if (movie->FragmentsFlags & GF_ISOM_FRAG_WRITE_READY) {
-		trak = gf_isom_get_track_from_file(movie, track);
+		trak = gf_isom_get_track_for_append(movie, track);
 		if (!trak) return GF_BAD_PARAM;
 		trafID = trak->Header->trackID;
 	}
@@ -7142,7 +7146,7 @@ GF_Err gf_isom_add_sample_group_info_internal(GF_ISOFile *movie, u32 track, u32
 			if (e) return e;
 		}
 
-		trak = gf_isom_get_track_from_file(movie, track);
+		trak = gf_isom_get_track_for_append(movie, track);
 	}
 	if (!trak) return GF_BAD_PARAM;
 
@@ -7307,7 +7311,7 @@ GF_Err gf_isom_set_sample_group_description_internal(GF_ISOFile *movie, u32 trac
 	GF_TrackFragmentBox *traf=NULL;
 #endif
 	if (movie->FragmentsFlags & GF_ISOM_FRAG_WRITE_READY) {
-		trak = gf_isom_get_track_from_file(movie, track);
+		trak = gf_isom_get_track_for_append(movie, track);
 		if (!trak) return GF_BAD_PARAM;
 		trafID = trak->Header->trackID;
 	}
@@ -7328,7 +7332,7 @@ GF_Err gf_isom_set_sample_group_description_internal(GF_ISOFile *movie, u32 trac
 			if (e) return e;
 		}
 
-		trak = gf_isom_get_track_from_file(movie, track);
+		trak = gf_isom_get_track_for_append(movie, track);
 		if (!trak) return GF_BAD_PARAM;
 	}
 
@@ -7762,7 +7766,7 @@ GF_Err gf_isom_set_sample_flags(GF_ISOFile *file, u32 track, u32 sampleNumber, u
 	e = CanAccessMovie(file, GF_ISOM_OPEN_WRITE);
 	if (e) return e;
 
-	trak = gf_isom_get_track_from_file(file, track);
+	trak = gf_isom_get_track_for_append(file, track);
 	if (!trak) return GF_BAD_PARAM;
 	return stbl_SetDependencyType(trak->Media->information->sampleTable, sampleNumber, isLeading, dependsOn, dependedOn, redundant);
 }
@@ -8067,7 +8071,7 @@ GF_Err gf_isom_update_edit_list_duration(GF_ISOFile *file, u32 track)
 	e = CanAccessMovie(file, GF_ISOM_OPEN_WRITE);
 	if (e) return e;
 
-	trak = gf_isom_get_track_from_file(file, track);
+	trak = gf_isom_get_track_for_append(file, track);
 	if (!trak) return GF_BAD_PARAM;
 
 
@@ -9003,7 +9007,7 @@ GF_Err gf_isom_add_sample_aux_info(GF_ISOFile *file, u32 track, u32 sampleNumber
 	e = CanAccessMovie(file, GF_ISOM_OPEN_WRITE);
 	if (e) return e;
 
-	trak = gf_isom_get_track_from_file(file, track);
+	trak = gf_isom_get_track_for_append(file, track);
 	if (!trak) return GF_BAD_PARAM;
 
 	return gf_isom_add_sample_aux_info_internal(trak, NULL, sampleNumber, aux_type, aux_info, data, size);
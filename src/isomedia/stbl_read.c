@@ -38,6 +38,7 @@ GF_Err stbl_findEntryForTime(GF_SampleTableBox *stbl, u64 DTS, u8 useCTS, u32 *s
 	(*prevSampleNumber) = 0;
 
 	if (!stbl->TimeToSample) return GF_ISOM_INVALID_FILE;
+	if (stbl_FlushColumn((GF_Box *)stbl->TimeToSample)) return GF_OUT_OF_MEM;
 
 	/*CTS is ALWAYS disabled for now to make sure samples are fetched in decoding order. useCTS is therefore disabled*/
 #if 0
@@ -136,7 +137,24 @@ GF_Err stbl_GetSampleSize(GF_SampleSizeBox *stsz, u32 SampleNumber, u32 *Size)
 
 	if (stsz->sampleSize && (stsz->type != GF_ISOM_BOX_TYPE_STZ2)) {
 		(*Size) = stsz->sampleSize;
-	} else if (stsz->sizes) {
+		return GF_OK;
+	}
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	//sizes compacted while appending samples, sequential reads do not restore the table
+	if (stsz->w_col.nb_entries) {
+		u64 val;
+		if (SampleNumber > stsz->w_col.nb_entries) {
+			(*Size) = stsz->sizes[SampleNumber - 1 - stsz->w_col.nb_entries];
+			return GF_OK;
+		}
+		if (stbl_GetColumnEntry(&stsz->w_col, SampleNumber - 1, GF_FALSE, &val)) {
+			(*Size) = (u32) val;
+			return GF_OK;
+		}
+		if (stbl_FlushColumn((GF_Box *)stsz)) return GF_OUT_OF_MEM;
+	}
+#endif
+	if (stsz->sizes) {
 		(*Size) = stsz->sizes[SampleNumber - 1];
 	} else {
 		(*Size) = 0;
@@ -154,6 +172,17 @@ GF_Err stbl_GetSampleCTS(GF_CompositionOffsetBox *ctts, u32 SampleNumber, s32 *C
 	(*CTSoffset) = 0;
 	//test on SampleNumber is done before
 	if (!ctts || !SampleNumber) return GF_BAD_PARAM;
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	//entries compacted while appending samples, read them without restoring the table
+	if (ctts->w_col.nb_entries) {
+		s64 val;
+		if (stbl_GetColumnSample(&ctts->w_col, GF_TRUE, SampleNumber, NULL, &val)) {
+			(*CTSoffset) = (s32) val;
+			return GF_OK;
+		}
+		if ((SampleNumber <= ctts->w_col.nb_samples) && stbl_FlushColumn((GF_Box *)ctts)) return GF_OUT_OF_MEM;
+	}
+#endif
 
 	if (ctts->r_FirstSampleInEntry && (ctts->r_FirstSampleInEntry < SampleNumber) ) {
 		i = ctts->r_currentEntryIndex;
@@ -161,6 +190,10 @@ GF_Err stbl_GetSampleCTS(GF_CompositionOffsetBox *ctts, u32 SampleNumber, s32 *C
 		ctts->r_FirstSampleInEntry = 1;
 		ctts->r_currentEntryIndex = 0;
 		i = 0;
+#ifndef GPAC_DISABLE_ISOM_WRITE
+		//table starts after the compacted entries
+		ctts->r_FirstSampleInEntry += ctts->w_col.nb_samples;
+#endif
 	}
 	for (; i< ctts->nb_entries; i++) {
 		if (SampleNumber < ctts->r_FirstSampleInEntry + ctts->entries[i].sampleCount) break;
@@ -187,6 +220,18 @@ GF_Err stbl_GetSampleDTS_and_Duration(GF_TimeToSampleBox *stts, u32 SampleNumber
 		*duration = 0;
 	}
 	if (!stts || !SampleNumber) return GF_BAD_PARAM;
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	//entries compacted while appending samples, read them without restoring the table
+	if (stts->w_col.nb_entries) {
+		s64 val;
+		if (stbl_GetColumnSample(&stts->w_col, GF_FALSE, SampleNumber, DTS, &val)) {
+			(*DTS) += stts->cumulated_start_dts;
+			if (duration) *duration = (u32) val;
+			return GF_OK;
+		}
+		if ((SampleNumber <= stts->w_col.nb_samples) && stbl_FlushColumn((GF_Box *)stts)) return GF_OUT_OF_MEM;
+	}
+#endif
 
 	ent = NULL;
 	//use our cache
@@ -201,6 +246,11 @@ GF_Err stbl_GetSampleDTS_and_Duration(GF_TimeToSampleBox *stts, u32 SampleNumber
 		i = stts->r_currentEntryIndex = 0;
 		stts->r_FirstSampleInEntry = 1;
 		stts->r_CurrentDTS = 0;
+#ifndef GPAC_DISABLE_ISOM_WRITE
+		//table starts after the compacted entries
+		stts->r_FirstSampleInEntry += stts->w_col.nb_samples;
+		stts->r_CurrentDTS = stts->w_col.last;
+#endif
 	}
 
 	for (; i < count; i++) {
@@ -396,13 +446,37 @@ void GetGhostNum(GF_StscEntry *ent, u32 EntryIndex, u32 count, GF_SampleTableBox
 	stbl->SampleToChunk->ghostNumber = ghostNum;
 }
 
+static GF_Err stbl_GetChunkOffset(GF_Box *co, u32 chunkNumber, u64 *offset)
+{
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	//offsets compacted while appending samples, sequential reads do not restore the table
+	GF_StblColumn *col = (co->type == GF_ISOM_BOX_TYPE_STCO) ? &((GF_ChunkOffsetBox *)co)->w_col : &((GF_ChunkLargeOffsetBox *)co)->w_col;
+	if (chunkNumber <= col->nb_entries) {
+		if (stbl_GetColumnEntry(col, chunkNumber - 1, GF_TRUE, offset))
+			return GF_OK;
+		if (stbl_FlushColumn(co)) return GF_OUT_OF_MEM;
+	}
+	chunkNumber -= col->nb_entries;
+#endif
+	if (co->type == GF_ISOM_BOX_TYPE_STCO) {
+		GF_ChunkOffsetBox *stco = (GF_ChunkOffsetBox *)co;
+		if (!stco->offsets) return GF_ISOM_INVALID_FILE;
+		if (stco->nb_entries < chunkNumber) return GF_ISOM_INVALID_FILE;
+		(*offset) = (u64) stco->offsets[chunkNumber - 1];
+	} else {
+		GF_ChunkLargeOffsetBox *co64 = (GF_ChunkLargeOffsetBox *)co;
+		if (!co64->offsets) return GF_ISOM_INVALID_FILE;
+		if (co64->nb_entries < chunkNumber) return GF_ISOM_INVALID_FILE;
+		(*offset) = co64->offsets[chunkNumber - 1];
+	}
+	return GF_OK;
+}
+
 //Get the offset, descIndex and chunkNumber of a sample...
 GF_Err stbl_GetSampleInfos(GF_SampleTableBox *stbl, u32 sampleNumber, u64 *offset, u32 *chunkNumber, u32 *descIndex, GF_StscEntry **out_ent)
 {
 	GF_Err e;
 	u32 i, k, offsetInChunk, size, chunk_num;
-	GF_ChunkOffsetBox *stco;
-	GF_ChunkLargeOffsetBox *co64;
 	GF_StscEntry *ent;
 
 	(*offset) = 0;
@@ -417,20 +491,7 @@ GF_Err stbl_GetSampleInfos(GF_SampleTableBox *stbl, u32 sampleNumber, u64 *offse
 		(*descIndex) = ent->sampleDescriptionIndex;
 		(*chunkNumber) = sampleNumber;
 		if (out_ent) *out_ent = ent;
-		if ( stbl->ChunkOffset->type == GF_ISOM_BOX_TYPE_STCO) {
-			stco = (GF_ChunkOffsetBox *)stbl->ChunkOffset;
-			if (!stco->offsets) return GF_ISOM_INVALID_FILE;
-			if (stco->nb_entries < sampleNumber) return GF_ISOM_INVALID_FILE;
-
-			(*offset) = (u64) stco->offsets[sampleNumber - 1];
-		} else {
-			co64 = (GF_ChunkLargeOffsetBox *)stbl->ChunkOffset;
-			if (!co64->offsets) return GF_ISOM_INVALID_FILE;
-			if (co64->nb_entries < sampleNumber) return GF_ISOM_INVALID_FILE;
-
-			(*offset) = co64->offsets[sampleNumber - 1];
-		}
-		return GF_OK;
+		return stbl_GetChunkOffset(stbl->ChunkOffset, sampleNumber, offset);
 	}
 
 	//check our cache: if desired sample is at or above current cache entry, start from here
@@ -531,15 +592,9 @@ sample_found:
 	}
 	//OK, that's the size of our offset in the chunk
 	//now get the chunk
-	if ( stbl->ChunkOffset->type == GF_ISOM_BOX_TYPE_STCO) {
-		stco = (GF_ChunkOffsetBox *)stbl->ChunkOffset;
-		if (stco->nb_entries < (*chunkNumber) ) return GF_ISOM_INVALID_FILE;
-		(*offset) = (u64) stco->offsets[(*chunkNumber) - 1] + (u64) offsetInChunk;
-	} else {
-		co64 = (GF_ChunkLargeOffsetBox *)stbl->ChunkOffset;
-		if (co64->nb_entries < (*chunkNumber) ) return GF_ISOM_INVALID_FILE;
-		(*offset) = co64->offsets[(*chunkNumber) - 1] + (u64) offsetInChunk;
-	}
+	e = stbl_GetChunkOffset(stbl->ChunkOffset, chunk_num, offset);
+	if (e) return e;
+	(*offset) += (u64) offsetInChunk;
 	return GF_OK;
 }
 
@@ -45,6 +45,375 @@ gf_realloc low, which greatly impacts performances for large files*/
 
 #ifndef GPAC_DISABLE_ISOM_WRITE
 
+/*when appending samples, stts, ctts, stsz and stco/co64 entries are moved by blocks of STBL_COL_BLOCK entries
+into a varint column (LEB128, zigzag for signed values, delta for chunk offsets), so that long recordings do not
+keep several u32 per sample in memory. Only the last entries needed by the append code are kept in the tables.
+Sample reads (stbl_GetSample*) decode the columns forward from a read cursor, so that sequential scans such as
+chunk rebuild at write time or bitrate computation do not restore the tables, and stts, ctts and stsz are written
+directly from their column. Tables are otherwise materialized back by stbl_FlushColumn before any other access
+(edit, time lookup, box dump)*/
+#define STBL_COL_BLOCK	4096
+
+#define ZIGZAG_ENC(_v) ( ((u64)(_v) << 1) ^ (u64) ((s64)(_v) >> 63) )
+#define ZIGZAG_DEC(_v) ( (s64) ((_v) >> 1) ^ -(s64) ((_v) & 1) )
+
+static Bool stbl_col_enabled(GF_StblColumn *col)
+{
+	if (col->disabled) return GF_FALSE;
+	if (gf_opts_get_bool("core", "no-stbl-pack")) {
+		col->disabled = GF_TRUE;
+		return GF_FALSE;
+	}
+	return GF_TRUE;
+}
+
+static GF_Err stbl_col_put(GF_StblColumn *col, u64 val)
+{
+	if (col->size + 10 > col->alloc) {
+		u32 new_alloc = col->alloc ? col->alloc*2 : 4*STBL_COL_BLOCK;
+		u8 *data;
+		if (new_alloc < col->alloc) return GF_OUT_OF_MEM;
+		data = gf_realloc(col->data, new_alloc);
+		if (!data) return GF_OUT_OF_MEM;
+		col->data = data;
+		col->alloc = new_alloc;
+	}
+	while (val >= 0x80) {
+		col->data[col->size++] = (u8) (val | 0x80);
+		val >>= 7;
+	}
+	col->data[col->size++] = (u8) val;
+	return GF_OK;
+}
+
+static GFINLINE u64 stbl_col_get(GF_StblColumn *col, u32 *pos)
+{
+	u64 val = 0;
+	u32 shift = 0;
+	while (*pos < col->size) {
+		u8 b = col->data[*pos];
+		(*pos)++;
+		val |= ((u64) (b & 0x7F)) << shift;
+		if (!(b & 0x80)) break;
+		shift += 7;
+	}
+	return val;
+}
+
+static void stbl_col_reset(GF_StblColumn *col)
+{
+	if (col->data) gf_free(col->data);
+	col->data = NULL;
+	col->size = col->alloc = col->nb_entries = 0;
+	col->last = 0;
+	col->nb_samples = 0;
+	col->r_idx = col->r_pos = 0;
+	col->r_val = 0;
+	col->r_count = col->r_sample = 0;
+	col->r_time = 0;
+	//table is now accessed as a whole, don't compact it again
+	col->disabled = GF_TRUE;
+}
+
+static GF_Err stts_compact(GF_TimeToSampleBox *stts)
+{
+	u32 i, nb;
+	GF_Err e;
+	if (stts->nb_entries < STBL_COL_BLOCK) return GF_OK;
+	if (!stbl_col_enabled(&stts->w_col)) return GF_OK;
+	//keep the last two entries, used when adding DTS or patching last sample duration
+	nb = stts->nb_entries - 2;
+	for (i=0; i<nb; i++) {
+		e = stbl_col_put(&stts->w_col, stts->entries[i].sampleCount);
+		if (!e) e = stbl_col_put(&stts->w_col, stts->entries[i].sampleDelta);
+		if (e) return e;
+		stts->w_col.nb_samples += stts->entries[i].sampleCount;
+		stts->w_col.last += (u64) stts->entries[i].sampleCount * stts->entries[i].sampleDelta;
+	}
+	memmove(stts->entries, &stts->entries[nb], sizeof(GF_SttsEntry)*2);
+	stts->nb_entries = 2;
+	stts->w_col.nb_entries += nb;
+	stts->r_FirstSampleInEntry = stts->r_currentEntryIndex = 0;
+	stts->r_CurrentDTS = 0;
+	return GF_OK;
+}
+
+static GF_Err ctts_compact(GF_CompositionOffsetBox *ctts)
+{
+	u32 i, nb;
+	GF_Err e;
+	if (ctts->nb_entries < STBL_COL_BLOCK) return GF_OK;
+	if (!stbl_col_enabled(&ctts->w_col)) return GF_OK;
+	//keep the last entry, used when adding CTS offsets
+	nb = ctts->nb_entries - 1;
+	for (i=0; i<nb; i++) {
+		e = stbl_col_put(&ctts->w_col, ctts->entries[i].sampleCount);
+		if (!e) e = stbl_col_put(&ctts->w_col, ZIGZAG_ENC(ctts->entries[i].decodingOffset));
+		if (e) return e;
+		ctts->w_col.nb_samples += ctts->entries[i].sampleCount;
+	}
+	ctts->entries[0] = ctts->entries[nb];
+	ctts->nb_entries = 1;
+	ctts->w_col.nb_entries += nb;
+	ctts->r_FirstSampleInEntry = ctts->r_currentEntryIndex = 0;
+	return GF_OK;
+}
+
+static GF_Err stsz_compact(GF_SampleSizeBox *stsz)
+{
+	u32 i, nb;
+	GF_Err e;
+	nb = stsz->sampleCount - stsz->w_col.nb_entries;
+	if (nb <= STBL_COL_BLOCK) return GF_OK;
+	if (!stbl_col_enabled(&stsz->w_col)) return GF_OK;
+	//keep the last size, used when appending data to the last sample
+	nb--;
+	for (i=0; i<nb; i++) {
+		e = stbl_col_put(&stsz->w_col, stsz->sizes[i]);
+		if (e) return e;
+	}
+	stsz->sizes[0] = stsz->sizes[nb];
+	stsz->w_col.nb_entries += nb;
+	return GF_OK;
+}
+
+static GF_Err stco_compact(GF_Box *a)
+{
+	u32 i, nb;
+	GF_Err e;
+	GF_StblColumn *col;
+	if (a->type == GF_ISOM_BOX_TYPE_STCO) {
+		GF_ChunkOffsetBox *stco = (GF_ChunkOffsetBox *)a;
+		col = &stco->w_col;
+		nb = stco->nb_entries - col->nb_entries;
+		if (nb < STBL_COL_BLOCK) return GF_OK;
+		if (!stbl_col_enabled(col)) return GF_OK;
+		for (i=0; i<nb; i++) {
+			e = stbl_col_put(col, ZIGZAG_ENC((s64) stco->offsets[i] - (s64) col->last));
+			if (e) return e;
+			col->last = stco->offsets[i];
+		}
+	} else {
+		GF_ChunkLargeOffsetBox *co64 = (GF_ChunkLargeOffsetBox *)a;
+		col = &co64->w_col;
+		nb = co64->nb_entries - col->nb_entries;
+		if (nb < STBL_COL_BLOCK) return GF_OK;
+		if (!stbl_col_enabled(col)) return GF_OK;
+		for (i=0; i<nb; i++) {
+			e = stbl_col_put(col, ZIGZAG_ENC((s64) co64->offsets[i] - (s64) col->last));
+			if (e) return e;
+			col->last = co64->offsets[i];
+		}
+	}
+	col->nb_entries += nb;
+	return GF_OK;
+}
+
+GF_Err stbl_FlushColumn(GF_Box *a)
+{
+	u32 i, pos=0;
+	if (!a) return GF_OK;
+
+	switch (a->type) {
+	case GF_ISOM_BOX_TYPE_STTS:
+	{
+		GF_SttsEntry *entries;
+		GF_TimeToSampleBox *stts = (GF_TimeToSampleBox *)a;
+		if (!stts->w_col.nb_entries) return GF_OK;
+		entries = gf_malloc(sizeof(GF_SttsEntry) * (stts->w_col.nb_entries + stts->nb_entries));
+		if (!entries) return GF_OUT_OF_MEM;
+		for (i=0; i<stts->w_col.nb_entries; i++) {
+			entries[i].sampleCount = (u32) stbl_col_get(&stts->w_col, &pos);
+			entries[i].sampleDelta = (u32) stbl_col_get(&stts->w_col, &pos);
+		}
+		memcpy(&entries[i], stts->entries, sizeof(GF_SttsEntry) * stts->nb_entries);
+		gf_free(stts->entries);
+		stts->entries = entries;
+		stts->nb_entries += stts->w_col.nb_entries;
+		stts->alloc_size = stts->nb_entries;
+		stts->r_FirstSampleInEntry = stts->r_currentEntryIndex = 0;
+		stts->r_CurrentDTS = 0;
+		stbl_col_reset(&stts->w_col);
+		return GF_OK;
+	}
+	case GF_ISOM_BOX_TYPE_CTTS:
+	{
+		GF_DttsEntry *entries;
+		GF_CompositionOffsetBox *ctts = (GF_CompositionOffsetBox *)a;
+		if (!ctts->w_col.nb_entries) return GF_OK;
+		entries = gf_malloc(sizeof(GF_DttsEntry) * (ctts->w_col.nb_entries + ctts->nb_entries));
+		if (!entries) return GF_OUT_OF_MEM;
+		for (i=0; i<ctts->w_col.nb_entries; i++) {
+			u64 v;
+			entries[i].sampleCount = (u32) stbl_col_get(&ctts->w_col, &pos);
+			v = stbl_col_get(&ctts->w_col, &pos);
+			entries[i].decodingOffset = (s32) ZIGZAG_DEC(v);
+		}
+		memcpy(&entries[i], ctts->entries, sizeof(GF_DttsEntry) * ctts->nb_entries);
+		gf_free(ctts->entries);
+		ctts->entries = entries;
+		ctts->nb_entries += ctts->w_col.nb_entries;
+		ctts->alloc_size = ctts->nb_entries;
+		ctts->r_FirstSampleInEntry = ctts->r_currentEntryIndex = 0;
+		stbl_col_reset(&ctts->w_col);
+		return GF_OK;
+	}
+	case GF_ISOM_BOX_TYPE_STSZ:
+	case GF_ISOM_BOX_TYPE_STZ2:
+	{
+		u32 *sizes;
+		GF_SampleSizeBox *stsz = (GF_SampleSizeBox *)a;
+		if (!stsz->w_col.nb_entries) return GF_OK;
+		sizes = gf_malloc(sizeof(u32) * stsz->sampleCount);
+		if (!sizes) return GF_OUT_OF_MEM;
+		for (i=0; i<stsz->w_col.nb_entries; i++) {
+			sizes[i] = (u32) stbl_col_get(&stsz->w_col, &pos);
+		}
+		memcpy(&sizes[i], stsz->sizes, sizeof(u32) * (stsz->sampleCount - i));
+		gf_free(stsz->sizes);
+		stsz->sizes = sizes;
+		stsz->alloc_size = stsz->sampleCount;
+		stbl_col_reset(&stsz->w_col);
+		return GF_OK;
+	}
+	case GF_ISOM_BOX_TYPE_STCO:
+	{
+		u32 *offsets;
+		u64 last = 0;
+		GF_ChunkOffsetBox *stco = (GF_ChunkOffsetBox *)a;
+		if (!stco->w_col.nb_entries) return GF_OK;
+		offsets = gf_malloc(sizeof(u32) * stco->nb_entries);
+		if (!offsets) return GF_OUT_OF_MEM;
+		for (i=0; i<stco->w_col.nb_entries; i++) {
+			u64 v = stbl_col_get(&stco->w_col, &pos);
+			last += ZIGZAG_DEC(v);
+			offsets[i] = (u32) last;
+		}
+		memcpy(&offsets[i], stco->offsets, sizeof(u32) * (stco->nb_entries - i));
+		gf_free(stco->offsets);
+		stco->offsets = offsets;
+		stco->alloc_size = stco->nb_entries;
+		stbl_col_reset(&stco->w_col);
+		return GF_OK;
+	}
+	case GF_ISOM_BOX_TYPE_CO64:
+	{
+		u64 *offsets;
+		u64 last = 0;
+		GF_ChunkLargeOffsetBox *co64 = (GF_ChunkLargeOffsetBox *)a;
+		if (!co64->w_col.nb_entries) return GF_OK;
+		offsets = gf_malloc(sizeof(u64) * co64->nb_entries);
+		if (!offsets) return GF_OUT_OF_MEM;
+		for (i=0; i<co64->w_col.nb_entries; i++) {
+			u64 v = stbl_col_get(&co64->w_col, &pos);
+			last += ZIGZAG_DEC(v);
+			offsets[i] = last;
+		}
+		memcpy(&offsets[i], co64->offsets, sizeof(u64) * (co64->nb_entries - i));
+		gf_free(co64->offsets);
+		co64->offsets = offsets;
+		co64->alloc_size = co64->nb_entries;
+		stbl_col_reset(&co64->w_col);
+		return GF_OK;
+	}
+	}
+	return GF_OK;
+}
+
+GF_Err stbl_FlushColumns(GF_SampleTableBox *stbl)
+{
+	GF_Err e;
+	if (!stbl) return GF_OK;
+	e = stbl_FlushColumn((GF_Box *)stbl->TimeToSample);
+	if (!e) e = stbl_FlushColumn((GF_Box *)stbl->CompositionOffset);
+	if (!e) e = stbl_FlushColumn((GF_Box *)stbl->SampleSize);
+	if (!e) e = stbl_FlushColumn(stbl->ChunkOffset);
+	return e;
+}
+
+Bool stbl_GetColumnEntry(GF_StblColumn *col, u32 idx, Bool is_delta, u64 *val)
+{
+	if (idx >= col->nb_entries) return GF_FALSE;
+	//same entry as last read
+	if (col->r_idx && (idx + 1 == col->r_idx)) {
+		*val = col->r_val;
+		return GF_TRUE;
+	}
+	//going backward, only restart for a new scan from the first entry
+	if (idx < col->r_idx) {
+		if (idx) return GF_FALSE;
+		col->r_idx = col->r_pos = 0;
+		col->r_val = 0;
+	}
+	while (col->r_idx <= idx) {
+		u64 v = stbl_col_get(col, &col->r_pos);
+		if (is_delta) col->r_val += ZIGZAG_DEC(v);
+		else col->r_val = v;
+		col->r_idx++;
+	}
+	*val = col->r_val;
+	return GF_TRUE;
+}
+
+Bool stbl_GetColumnSample(GF_StblColumn *col, Bool is_ctts, u32 SampleNumber, u64 *time, s64 *val)
+{
+	if (!SampleNumber || (SampleNumber > col->nb_samples)) return GF_FALSE;
+	//going backward, only restart for a new scan from the first sample
+	if (!col->r_idx || (SampleNumber < col->r_sample)) {
+		if (col->r_idx && (SampleNumber > 1)) return GF_FALSE;
+		col->r_idx = col->r_pos = 0;
+		col->r_count = 0;
+		col->r_sample = 1;
+		col->r_time = 0;
+		col->r_val = 0;
+	}
+	while (SampleNumber >= col->r_sample + col->r_count) {
+		u64 v;
+		if (!is_ctts) col->r_time += (u64) col->r_count * col->r_val;
+		col->r_sample += col->r_count;
+		col->r_count = (u32) stbl_col_get(col, &col->r_pos);
+		v = stbl_col_get(col, &col->r_pos);
+		col->r_val = is_ctts ? (u64) ZIGZAG_DEC(v) : v;
+		col->r_idx++;
+	}
+	if (time) *time = is_ctts ? 0 : col->r_time + (u64) (SampleNumber - col->r_sample) * col->r_val;
+	*val = (s64) col->r_val;
+	return GF_TRUE;
+}
+
+GF_Err stbl_WriteColumn(GF_Box *a, GF_BitStream *bs)
+{
+	u32 i, pos=0;
+	if (!a) return GF_OK;
+	if (a->type == GF_ISOM_BOX_TYPE_STTS) {
+		GF_StblColumn *col = &((GF_TimeToSampleBox *)a)->w_col;
+		for (i=0; i<col->nb_entries; i++) {
+			gf_bs_write_u32(bs, (u32) stbl_col_get(col, &pos));
+			gf_bs_write_u32(bs, (u32) stbl_col_get(col, &pos));
+		}
+	} else if (a->type == GF_ISOM_BOX_TYPE_CTTS) {
+		GF_CompositionOffsetBox *ctts = (GF_CompositionOffsetBox *)a;
+		for (i=0; i<ctts->w_col.nb_entries; i++) {
+			u64 val;
+			s64 offset;
+			gf_bs_write_u32(bs, (u32) stbl_col_get(&ctts->w_col, &pos));
+			val = stbl_col_get(&ctts->w_col, &pos);
+			offset = ZIGZAG_DEC(val);
+			if (ctts->version) {
+				gf_bs_write_int(bs, (s32) offset, 32);
+			} else {
+				gf_bs_write_u32(bs, (u32) offset);
+			}
+		}
+	} else if ((a->type == GF_ISOM_BOX_TYPE_STSZ) || (a->type == GF_ISOM_BOX_TYPE_STZ2)) {
+		GF_StblColumn *col = &((GF_SampleSizeBox *)a)->w_col;
+		for (i=0; i<col->nb_entries; i++) {
+			gf_bs_write_u32(bs, (u32) stbl_col_get(col, &pos));
+		}
+	}
+	return GF_OK;
+}
+
 
 //adds a DTS in the table and get the sample number of this new sample
 //we could return an error if a sample with the same DTS already exists
@@ -52,6 +421,7 @@ gf_realloc low, which greatly impacts performances for large files*/
 //we assume the authoring tool tries to create a compliant MP4 file.
 GF_Err stbl_AddDTS(GF_SampleTableBox *stbl, u64 DTS, u32 *sampleNumber, u32 LastAUDefDuration, u32 nb_pack)
 {
+	GF_Err e;
 	u32 i, j, sampNum;
 	u64 *DTSs, curDTS;
 	Bool inserted;
@@ -150,7 +520,7 @@ GF_Err stbl_AddDTS(GF_SampleTableBox *stbl, u64 DTS, u32 *sampleNumber, u32 Last
 			stts->w_LastDTS = DTS;
 			(*sampleNumber) = stts->w_currentSampleNum+1;
 			stts->w_currentSampleNum += 1;
-			return GF_OK;
+			return stts_compact(stts);
 		}
 
 		ent->sampleCount = 1;
@@ -164,9 +534,11 @@ GF_Err stbl_AddDTS(GF_SampleTableBox *stbl, u64 DTS, u32 *sampleNumber, u32 Last
 		stts->w_LastDTS = DTS;
 		(*sampleNumber) = stts->w_currentSampleNum + 1;
 		stts->w_currentSampleNum += nb_pack;
-		return GF_OK;
+		return stts_compact(stts);
 	}
 
+	e = stbl_FlushColumn((GF_Box *)stts);
+	if (e) return e;
 
 	//unpack the DTSs and locate new sample...
 	DTSs = (u64*)gf_malloc(sizeof(u64) * (stbl->SampleSize->sampleCount+2) );
@@ -254,6 +626,7 @@ GF_Err AddCompositionOffset(GF_CompositionOffsetBox *ctts, s32 offset)
 //adds a CTS offset for a new sample
 GF_Err stbl_AddCTS(GF_SampleTableBox *stbl, u32 sampleNumber, s32 offset)
 {
+	GF_Err e;
 	u32 i, j, sampNum, *CTSs;
 
 	GF_CompositionOffsetBox *ctts = stbl->CompositionOffset;
@@ -275,11 +648,10 @@ GF_Err stbl_AddCTS(GF_SampleTableBox *stbl, u32 sampleNumber, s32 offset)
 			ctts->max_cts_delta = ABS(offset);
 			//ctts->sample_num_max_cts_delta = ctts->w_LastSampleNumber;
 		}
-		return GF_OK;
+		return ctts_compact(ctts);
 	}
 	//check if we're working in order...
 	if (ctts->w_LastSampleNumber < sampleNumber) {
-		GF_Err e;
 		//add some 0 till we get to the sample
 		while (ctts->w_LastSampleNumber + 1 != sampleNumber) {
 			e = AddCompositionOffset(ctts, 0);
@@ -291,10 +663,12 @@ GF_Err stbl_AddCTS(GF_SampleTableBox *stbl, u32 sampleNumber, s32 offset)
 			ctts->max_cts_delta = ABS(offset);
 			//ctts->sample_num_max_cts_delta = ctts->w_LastSampleNumber;
 		}
-		return GF_OK;
+		return ctts_compact(ctts);
 	}
 
 	//NOPE we are inserting a sample...
+	e = stbl_FlushColumn((GF_Box *)ctts);
+	if (e) return e;
 	CTSs = (u32*)gf_malloc(sizeof(u32) * (stbl->SampleSize->sampleCount+1) );
 	if (!CTSs) return GF_OUT_OF_MEM;
 	sampNum = 0;
@@ -356,6 +730,7 @@ GF_Err stbl_repackCTS(GF_CompositionOffsetBox *ctts)
 	u32 i, j;
 
 	if (!ctts->unpack_mode) return GF_OK;
+	if (stbl_FlushColumn((GF_Box *)ctts)) return GF_OUT_OF_MEM;
 	ctts->unpack_mode = 0;
 
 	j=0;
@@ -381,6 +756,7 @@ GF_Err stbl_unpackCTS(GF_SampleTableBox *stbl)
 	GF_CompositionOffsetBox *ctts;
 	ctts = stbl->CompositionOffset;
 	if (!ctts || ctts->unpack_mode) return GF_OK;
+	if (stbl_FlushColumn((GF_Box *)ctts)) return GF_OUT_OF_MEM;
 	ctts->unpack_mode = 1;
 
 	packed = ctts->entries;
@@ -478,15 +854,21 @@ GF_Err stbl_AddSize(GF_SampleSizeBox *stsz, u32 sampleNumber, u32 size, u32 nb_p
 
 	/*append*/
 	if (stsz->sampleCount + 1 == sampleNumber) {
-		if (!stsz->alloc_size) stsz->alloc_size = stsz->sampleCount;
-		if (stsz->sampleCount == stsz->alloc_size) {
+		//index in sizes, first sizes may be compacted
+		u32 idx = stsz->sampleCount - stsz->w_col.nb_entries;
+		if (!stsz->alloc_size) stsz->alloc_size = idx;
+		if (idx == stsz->alloc_size) {
 			ALLOC_INC(stsz->alloc_size);
 			stsz->sizes = gf_realloc(stsz->sizes, sizeof(u32)*(stsz->alloc_size) );
 			if (!stsz->sizes) return GF_OUT_OF_MEM;
-			memset(&stsz->sizes[stsz->sampleCount], 0, sizeof(u32)*(stsz->alloc_size - stsz->sampleCount) );
+			memset(&stsz->sizes[idx], 0, sizeof(u32)*(stsz->alloc_size - idx) );
 		}
-		stsz->sizes[stsz->sampleCount] = size;
+		stsz->sizes[idx] = size;
+		stsz->sampleCount++;
+		return stsz_compact(stsz);
 	} else {
+		GF_Err e = stbl_FlushColumn((GF_Box *)stsz);
+		if (e) return e;
 		newSizes = (u32*)gf_malloc(sizeof(u32)*(1 + stsz->sampleCount) );
 		if (!newSizes) return GF_OUT_OF_MEM;
 		k = 0;
@@ -750,6 +1132,13 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 //	if (stsc->w_lastSampleNumber + 1 < sampleNumber ) return GF_BAD_PARAM;
 	CHECK_PACK(GF_BAD_PARAM)
 
+	//insertion works on one entry per chunk
+	if (sampleNumber != stsc->w_lastSampleNumber + 1) {
+		GF_Err e = stbl_ExpandChunkRuns(stbl);
+		if (!e) e = stbl_FlushColumn(stbl->ChunkOffset);
+		if (e) return e;
+	}
+
 	if (!stsc->nb_entries || (stsc->nb_entries + 2 >= stsc->alloc_size)) {
 		if (!stsc->alloc_size) stsc->alloc_size = 1;
 		ALLOC_INC(stsc->alloc_size);
@@ -758,13 +1147,28 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 		memset(&stsc->entries[stsc->nb_entries], 0, sizeof(GF_StscEntry)*(stsc->alloc_size-stsc->nb_entries) );
 	}
 	if (sampleNumber == stsc->w_lastSampleNumber + 1) {
-		ent = &stsc->entries[stsc->nb_entries];
+		u8 is_edited = (Media_IsSelfContained(mdia, StreamDescIndex)) ? 1 : 0;
 		stsc->w_lastChunkNumber ++;
-		ent->firstChunk = stsc->w_lastChunkNumber;
-		if (stsc->nb_entries) stsc->entries[stsc->nb_entries-1].nextChunk = stsc->w_lastChunkNumber;
-
 		new_chunk_idx = stsc->w_lastChunkNumber;
 		stsc->w_lastSampleNumber = sampleNumber + nb_pack-1;
+
+		//same properties as the last run of chunks, extend it rather than creating one entry per chunk
+		ent = stsc->nb_entries ? &stsc->entries[stsc->nb_entries-1] : NULL;
+		if (ent && (ent->sampleDescriptionIndex == StreamDescIndex) && (ent->samplesPerChunk == nb_pack)
+			&& (ent->isEdited == is_edited)
+			&& (MAX(ent->nextChunk, ent->firstChunk+1) == new_chunk_idx)
+		) {
+			ent->nextChunk = new_chunk_idx + 1;
+
+			stsc->currentIndex = stsc->nb_entries-1;
+			stsc->firstSampleInCurrentChunk = sampleNumber;
+			stsc->currentChunk = new_chunk_idx + 1 - ent->firstChunk;
+			stsc->ghostNumber = ent->nextChunk - ent->firstChunk;
+			goto add_offset;
+		}
+		ent = &stsc->entries[stsc->nb_entries];
+		ent->firstChunk = stsc->w_lastChunkNumber;
+		if (stsc->nb_entries) stsc->entries[stsc->nb_entries-1].nextChunk = stsc->w_lastChunkNumber;
 		stsc->nb_entries += 1;
 	} else {
 		u32 cur_samp = 1;
@@ -829,8 +1233,7 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 
 		stbl->SampleToChunk->currentIndex = stsc->nb_entries-1;
 		stbl->SampleToChunk->firstSampleInCurrentChunk = sampleNumber;
-		//write - edit mode: sample number = chunk number
-		stbl->SampleToChunk->currentChunk = stsc->w_lastChunkNumber;
+		stbl->SampleToChunk->currentChunk = 1;
 		stbl->SampleToChunk->ghostNumber = 1;
 	} else {
 		/*offset remaining entries*/
@@ -841,12 +1244,14 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 		}
 	}
 
+add_offset:
 	//add the offset to the chunk...
 	//and we change our offset
 	if (stbl->ChunkOffset->type == GF_ISOM_BOX_TYPE_STCO) {
 		stco = (GF_ChunkOffsetBox *)stbl->ChunkOffset;
 		//if the new offset is a large one, we have to rewrite our table entry by entry (32->64 bit conv)...
 		if (offset > 0xFFFFFFFF) {
+			if (stbl_FlushColumn((GF_Box *)stco)) return GF_OUT_OF_MEM;
 			co64 = (GF_ChunkLargeOffsetBox *) gf_isom_box_new_parent(&stbl->child_boxes, GF_ISOM_BOX_TYPE_CO64);
 			if (!co64) return GF_OUT_OF_MEM;
 			co64->nb_entries = stco->nb_entries + 1;
@@ -867,15 +1272,18 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 		} else {
 			//no, we can use this one.
 			if (new_chunk_idx > stco->nb_entries) {
-				if (!stco->alloc_size) stco->alloc_size = stco->nb_entries;
-				if (stco->nb_entries == stco->alloc_size) {
+				//index in offsets, first offsets may be compacted
+				u32 idx = stco->nb_entries - stco->w_col.nb_entries;
+				if (!stco->alloc_size) stco->alloc_size = idx;
+				if (idx == stco->alloc_size) {
 					ALLOC_INC(stco->alloc_size);
 					stco->offsets = (u32*)gf_realloc(stco->offsets, sizeof(u32) * stco->alloc_size);
 					if (!stco->offsets) return GF_OUT_OF_MEM;
-					memset(&stco->offsets[stco->nb_entries], 0, sizeof(u32) * (stco->alloc_size-stco->nb_entries) );
+					memset(&stco->offsets[idx], 0, sizeof(u32) * (stco->alloc_size-idx) );
 				}
-				stco->offsets[stco->nb_entries] = (u32) offset;
+				stco->offsets[idx] = (u32) offset;
 				stco->nb_entries += 1;
+				return stco_compact((GF_Box *)stco);
 			} else {
 				//nope. we're inserting
 				newOff = (u32*)gf_malloc(sizeof(u32) * (stco->nb_entries + 1));
@@ -898,15 +1306,18 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 		//use large offset...
 		co64 = (GF_ChunkLargeOffsetBox *)stbl->ChunkOffset;
 		if (sampleNumber > co64->nb_entries) {
-			if (!co64->alloc_size) co64->alloc_size = co64->nb_entries;
-			if (co64->nb_entries == co64->alloc_size) {
+			//index in offsets, first offsets may be compacted
+			u32 idx = co64->nb_entries - co64->w_col.nb_entries;
+			if (!co64->alloc_size) co64->alloc_size = idx;
+			if (idx == co64->alloc_size) {
 				ALLOC_INC(co64->alloc_size);
 				co64->offsets = (u64*)gf_realloc(co64->offsets, sizeof(u64) * co64->alloc_size);
 				if (!co64->offsets) return GF_OUT_OF_MEM;
-				memset(&co64->offsets[co64->nb_entries], 0, sizeof(u64) * (co64->alloc_size - co64->nb_entries) );
+				memset(&co64->offsets[idx], 0, sizeof(u64) * (co64->alloc_size - idx) );
 			}
-			co64->offsets[co64->nb_entries] = offset;
+			co64->offsets[idx] = offset;
 			co64->nb_entries += 1;
+			return stco_compact((GF_Box *)co64);
 		} else {
 			//nope. we're inserting
 			newLarge = (u64*)gf_malloc(sizeof(u64) * (co64->nb_entries + 1));
@@ -934,6 +1345,7 @@ GF_Err stbl_AddChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u32 StreamDescIn
 
 GF_Err stbl_SetChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u64 offset)
 {
+	GF_Err e;
 	GF_StscEntry *ent;
 	u32 i;
 	GF_ChunkLargeOffsetBox *co64;
@@ -941,6 +1353,9 @@ GF_Err stbl_SetChunkOffset(GF_MediaBox *mdia, u32 sampleNumber, u64 offset)
 
 	if (!sampleNumber || !stbl) return GF_BAD_PARAM;
 
+	e = stbl_ExpandChunkRuns(stbl);
+	if (!e) e = stbl_FlushColumn(stbl->ChunkOffset);
+	if (e) return e;
 	ent = &stbl->SampleToChunk->entries[sampleNumber - 1];
 
 	//we edit our entry if self contained
@@ -978,6 +1393,7 @@ GF_Err stbl_SetSampleCTS(GF_SampleTableBox *stbl, u32 sampleNumber, s32 offset)
 	GF_CompositionOffsetBox *ctts = stbl->CompositionOffset;
 
 	gf_assert(ctts->unpack_mode);
+	if (stbl_FlushColumn((GF_Box *)ctts)) return GF_OUT_OF_MEM;
 
 	//if we're setting the CTS of a sample we've skipped...
 	if (ctts->w_LastSampleNumber < sampleNumber) {
@@ -997,6 +1413,7 @@ GF_Err stbl_SetSampleSize(GF_SampleSizeBox *stsz, u32 SampleNumber, u32 size)
 {
 	u32 i;
 	if (!SampleNumber || (stsz->sampleCount < SampleNumber)) return GF_BAD_PARAM;
+	if (stbl_FlushColumn((GF_Box *)stsz)) return GF_OUT_OF_MEM;
 
 	if (stsz->sampleSize) {
 		if (stsz->sampleSize == size) return GF_OK;
@@ -1102,6 +1519,7 @@ GF_Err stbl_RemoveDTS(GF_SampleTableBox *stbl, u32 sampleNumber, u32 nb_samples,
 	if ((nb_samples>1) && (sampleNumber>1)) return GF_BAD_PARAM;
 
 	stts = stbl->TimeToSample;
+	if (stbl_FlushColumn((GF_Box *)stts)) return GF_OUT_OF_MEM;
 
 	//we're removing the only sample: empty the sample table
 	if (stbl->SampleSize->sampleCount == 1) {
@@ -1228,6 +1646,7 @@ GF_Err stbl_RemoveCTS(GF_SampleTableBox *stbl, u32 sampleNumber, u32 nb_samples)
 
 	gf_assert(ctts->unpack_mode);
 	if ((nb_samples>1) && (sampleNumber>1)) return GF_BAD_PARAM;
+	if (stbl_FlushColumn((GF_Box *)ctts)) return GF_OUT_OF_MEM;
 	ctts->max_cts_delta = 0;
 
 	//last one...
@@ -1261,6 +1680,7 @@ GF_Err stbl_RemoveSize(GF_SampleTableBox *stbl, u32 sampleNumber, u32 nb_samples
 	GF_SampleSizeBox *stsz = stbl->SampleSize;
 
 	if ((nb_samples>1) && (sampleNumber>1)) return GF_BAD_PARAM;
+	if (stbl_FlushColumn((GF_Box *)stsz)) return GF_OUT_OF_MEM;
 	//last sample
 	if (stsz->sampleCount == 1) {
 		if (stsz->sizes) gf_free(stsz->sizes);
@@ -1284,14 +1704,79 @@ GF_Err stbl_RemoveSize(GF_SampleTableBox *stbl, u32 sampleNumber, u32 nb_samples
 	return GF_OK;
 }
 
+//in write mode, consecutive chunks with the same properties share a single SampleToChunk entry
+//this restores one entry per chunk for edit operations working on chunk indexes
+GF_Err stbl_ExpandChunkRuns(GF_SampleTableBox *stbl)
+{
+	u32 i, j, k, nb_chunks, nb_runs;
+	GF_StscEntry *entries;
+	GF_SampleToChunkBox *stsc = stbl ? stbl->SampleToChunk : NULL;
+	if (!stsc || !stsc->nb_entries || !stbl->ChunkOffset) return GF_OK;
+
+	if (stbl->ChunkOffset->type == GF_ISOM_BOX_TYPE_STCO) {
+		nb_chunks = ((GF_ChunkOffsetBox *)stbl->ChunkOffset)->nb_entries;
+	} else {
+		nb_chunks = ((GF_ChunkLargeOffsetBox *)stbl->ChunkOffset)->nb_entries;
+	}
+	//chunk offset is added after sample to chunk when appending
+	if (stsc->w_lastChunkNumber > nb_chunks) nb_chunks = stsc->w_lastChunkNumber;
+	if (stsc->nb_entries >= nb_chunks) return GF_OK;
+
+	nb_runs = 0;
+	for (i=0; i<stsc->nb_entries; i++) {
+		GF_StscEntry *ent = &stsc->entries[i];
+		if (i+1 < stsc->nb_entries) nb_runs = stsc->entries[i+1].firstChunk - ent->firstChunk;
+		else if (ent->nextChunk > ent->firstChunk) nb_runs = ent->nextChunk - ent->firstChunk;
+		else nb_runs = 1;
+		if (nb_runs>1) break;
+	}
+	if (nb_runs<=1) return GF_OK;
+
+	entries = (GF_StscEntry *) gf_malloc(sizeof(GF_StscEntry) * nb_chunks);
+	if (!entries) return GF_OUT_OF_MEM;
+
+	k = 0;
+	for (i=0; i<stsc->nb_entries; i++) {
+		GF_StscEntry *ent = &stsc->entries[i];
+		if (i+1 < stsc->nb_entries) nb_runs = stsc->entries[i+1].firstChunk - ent->firstChunk;
+		else if (ent->nextChunk > ent->firstChunk) nb_runs = ent->nextChunk - ent->firstChunk;
+		else nb_runs = nb_chunks + 1 - ent->firstChunk;
+
+		for (j=0; j<nb_runs; j++) {
+			if (k == nb_chunks) {
+				gf_free(entries);
+				return GF_ISOM_INVALID_FILE;
+			}
+			entries[k] = *ent;
+			entries[k].firstChunk = ent->firstChunk + j;
+			entries[k].nextChunk = ent->firstChunk + j + 1;
+			k++;
+		}
+	}
+	gf_free(stsc->entries);
+	stsc->entries = entries;
+	stsc->nb_entries = stsc->alloc_size = k;
+
+	stsc->currentIndex = 0;
+	stsc->currentChunk = 0;
+	stsc->firstSampleInCurrentChunk = 0;
+	stsc->ghostNumber = 0;
+	return GF_OK;
+}
+
 //always called after removing the sample from SampleSize
 GF_Err stbl_RemoveChunk(GF_SampleTableBox *stbl, u32 sampleNumber, u32 nb_samples)
 {
 	u32 i;
+	GF_Err e;
 	GF_SampleToChunkBox *stsc = stbl->SampleToChunk;
 
 	if ((nb_samples>1) && (sampleNumber>1))
 		return GF_BAD_PARAM;
+
+	e = stbl_ExpandChunkRuns(stbl);
+	if (!e) e = stbl_FlushColumn(stbl->ChunkOffset);
+	if (e) return e;
 	
 	//raw audio or constant sample size and dur
 	if (stsc->nb_entries < stbl->SampleSize->sampleCount) {
@@ -1668,6 +2153,13 @@ GF_Err stbl_SampleSizeAppend(GF_SampleSizeBox *stsz, u32 data_size)
 {
 	u32 i;
 	if (!stsz || !stsz->sampleCount) return GF_BAD_PARAM;
+	//sizes compacted while appending samples, the last size is kept in the table
+	//we don't check if all sizes are now the same, the table is kept as is
+	if (stsz->w_col.nb_entries && (stsz->sampleCount > stsz->w_col.nb_entries)) {
+		stsz->sizes[stsz->sampleCount - 1 - stsz->w_col.nb_entries] += data_size;
+		return GF_OK;
+	}
+	if (stbl_FlushColumn((GF_Box *)stsz)) return GF_OUT_OF_MEM;
 
 	//we must realloc our table
 	if (stsz->sampleSize) {
@@ -1731,6 +2223,7 @@ GF_Err stbl_AppendSize(GF_SampleTableBox *stbl, u32 size, u32 nb_pack)
 {
 	u32 i;
 	CHECK_PACK(GF_ISOM_INVALID_FILE)
+	if (stbl_FlushColumn((GF_Box *)stbl->SampleSize)) return GF_OUT_OF_MEM;
 
 	if (!stbl->SampleSize->sampleCount && size) {
 		stbl->SampleSize->sampleSize = size;
@@ -1776,6 +2269,7 @@ GF_Err stbl_AppendChunk(GF_SampleTableBox *stbl, u64 offset)
 	GF_ChunkOffsetBox *stco;
 	GF_ChunkLargeOffsetBox *co64;
 	u32 i;
+	if (stbl_FlushColumn(stbl->ChunkOffset)) return GF_OUT_OF_MEM;
 	
 	//we may have to convert the table...
 	if (stbl->ChunkOffset->type==GF_ISOM_BOX_TYPE_STCO) {
@@ -1796,24 +2290,26 @@ GF_Err stbl_AppendChunk(GF_SampleTableBox *stbl, u64 offset)
 			return GF_OK;
 		}
 		//we're fine
-		stco->alloc_size = stco->nb_entries + 1;
-		if (stco->alloc_size < stco->nb_entries + 1) return GF_OUT_OF_MEM;
-		stco->offsets = gf_realloc(stco->offsets, sizeof(u32)*stco->alloc_size);
-		if (!stco->offsets) return GF_OUT_OF_MEM;
+		if (stco->nb_entries >= stco->alloc_size) {
+			ALLOC_INC(stco->alloc_size);
+			if (stco->alloc_size <= stco->nb_entries) stco->alloc_size = stco->nb_entries+1;
+			stco->offsets = gf_realloc(stco->offsets, sizeof(u32)*stco->alloc_size);
+			if (!stco->offsets) return GF_OUT_OF_MEM;
+		}
 		stco->offsets[stco->nb_entries] = (u32) offset;
 		stco->nb_entries += 1;
 		return GF_OK;
 	}
 
 	co64 = (GF_ChunkLargeOffsetBox *)stbl->ChunkOffset;
-	co64->alloc_size = co64->nb_entries+1;
-	if (co64->alloc_size < co64->nb_entries + 1) return GF_OUT_OF_MEM;
-
-	co64->offsets = gf_realloc(co64->offsets, sizeof(u64)*co64->alloc_size);
-	if (!co64->offsets) return GF_OUT_OF_MEM;
+	if (co64->nb_entries >= co64->alloc_size) {
+		ALLOC_INC(co64->alloc_size);
+		if (co64->alloc_size <= co64->nb_entries) co64->alloc_size = co64->nb_entries+1;
+		co64->offsets = gf_realloc(co64->offsets, sizeof(u64)*co64->alloc_size);
+		if (!co64->offsets) return GF_OUT_OF_MEM;
+	}
 	co64->offsets[co64->nb_entries] = offset;
-	co64->alloc_size = co64->nb_entries;
-        co64->nb_entries += 1;
+	co64->nb_entries += 1;
 	return GF_OK;
 }
 
@@ -2036,6 +2532,8 @@ GF_Err stbl_UnpackOffsets(GF_SampleTableBox *stbl)
 	GF_SampleToChunkBox *stsc_tmp;
 
 	if (!stbl) return GF_ISOM_INVALID_FILE;
+	e = stbl_FlushColumns(stbl);
+	if (e) return e;
 
 	//we should have none of the mandatory boxes (allowed in the spec)
 	if (!stbl->ChunkOffset && !stbl->SampleDescription && !stbl->SampleSize && !stbl->SampleToChunk && !stbl->TimeToSample)
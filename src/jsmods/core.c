@@ -1632,7 +1632,7 @@ static JSValue js_sys_load_script(JSContext *ctx, JSValueConst this_val, int arg
 		if (!gf_utf8_is_legal(data, data_size)) {
 			res = js_throw_err_msg(ctx, e, "Script file %s is not UTF-8", filename);
 		} else {
-			res = JS_Eval(ctx, (char *)data, data_size, filename, JS_EVAL_TYPE_GLOBAL);
+			res = qjs_eval_cached(ctx, (char *)data, data_size, filename, JS_EVAL_TYPE_GLOBAL);
 		}
 	} else {
 		res = JS_UNDEFINED;
@@ -3659,6 +3659,189 @@ static JSModuleDef *qjs_module_loader_dyn_lib(JSContext *ctx,
 
 #endif // GPAC_STATIC_BIN
 
+/*bytecode cache file layout:
+	u32 magic, u32 cache version, u32 eval type (global or module),
+	u64 source modification time, u32 source size, u32 source CRC32, u32 bytecode size, u32 bytecode CRC32,
+	u16 gpac version string length, gpac version string, bytecode
+*/
+#define QJS_BC_MAGIC	GF_4CC('G','J','B','C')
+#define QJS_BC_VERSION	1
+
+static char *qjs_bc_cache_file(const char *filename)
+{
+	char szPath[GF_MAX_PATH];
+	u8 hash[GF_SHA1_DIGEST_SIZE];
+	char *key=NULL;
+	const char *cache_dir;
+	u32 i, len;
+
+	if (!filename || !gf_opts_get_bool("core", "js-cache")) return NULL;
+	if (!strncmp(filename, "gmem://", 7) || !gf_file_exists(filename)) return NULL;
+	cache_dir = gf_opts_get_key("core", "cache");
+	if (!cache_dir) return NULL;
+
+	if (!gf_dir_exists(cache_dir) && (gf_mkdir(cache_dir)!=GF_OK)) return NULL;
+	len = (u32) strlen(cache_dir);
+	snprintf(szPath, GF_MAX_PATH, "%s%sjscache", cache_dir, (len && (strchr("/\\", cache_dir[len-1]))) ? "" : "/");
+	if (!gf_dir_exists(szPath) && (gf_mkdir(szPath)!=GF_OK)) return NULL;
+
+	//key on script path and gpac version, modification time, size and CRC are checked when loading
+	gf_dynstrcat(&key, filename, NULL);
+	gf_dynstrcat(&key, gf_gpac_version(), "|");
+	if (!key) return NULL;
+	gf_sha1_csum((u8 *) key, (u32) strlen(key), hash);
+	gf_free(key);
+
+	len = (u32) strlen(szPath);
+	szPath[len++] = '/';
+	for (i=0; (i<GF_SHA1_DIGEST_SIZE) && (len+3<GF_MAX_PATH); i++) {
+		sprintf(szPath+len, "%02x", hash[i]);
+		len += 2;
+	}
+	strncat(szPath, ".qjsbc", GF_MAX_PATH-len-1);
+	return gf_strdup(szPath);
+}
+
+static JSValue qjs_bc_cache_load(JSContext *ctx, const char *cache_file, u32 eval_type, u64 mtime, u32 src_size, u32 src_crc)
+{
+	u8 *data=NULL;
+	u32 size, bc_size, bc_crc, vlen, pos;
+	JSValue obj = JS_UNDEFINED;
+	GF_BitStream *bs;
+	Bool valid = GF_FALSE;
+	const char *version = gf_gpac_version();
+
+	if (!gf_file_exists(cache_file) || (gf_file_load_data(cache_file, &data, &size) != GF_OK))
+		return JS_UNDEFINED;
+
+	bs = gf_bs_new(data, size, GF_BITSTREAM_READ);
+	if ((gf_bs_read_u32(bs) == QJS_BC_MAGIC)
+		&& (gf_bs_read_u32(bs) == QJS_BC_VERSION)
+		&& (gf_bs_read_u32(bs) == eval_type)
+		&& (gf_bs_read_u64(bs) == mtime)
+		&& (gf_bs_read_u32(bs) == src_size)
+		&& (gf_bs_read_u32(bs) == src_crc)
+	) {
+		bc_size = gf_bs_read_u32(bs);
+		bc_crc = gf_bs_read_u32(bs);
+		vlen = gf_bs_read_u16(bs);
+		pos = (u32) gf_bs_get_position(bs);
+		if ((vlen == strlen(version)) && (pos + vlen + bc_size == size)
+			&& !memcmp(data+pos, version, vlen)
+			&& (gf_crc_32(data+pos+vlen, bc_size) == bc_crc)
+		) {
+			valid = GF_TRUE;
+			pos += vlen;
+		}
+	}
+	gf_bs_del(bs);
+
+	if (valid) {
+		obj = JS_ReadObject(ctx, data+pos, bc_size, JS_READ_OBJ_BYTECODE);
+		if (JS_IsException(obj)) {
+			//bytecode from another engine version, discard and recompile
+			JSValue exc = JS_GetException(ctx);
+			JS_FreeValue(ctx, exc);
+			obj = JS_UNDEFINED;
+		}
+	}
+	gf_free(data);
+	if (JS_IsUndefined(obj)) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_SCRIPT, ("[JS] Bytecode cache %s outdated or invalid\n", cache_file));
+	}
+	return obj;
+}
+
+static void qjs_bc_cache_store(JSContext *ctx, JSValue obj, const char *cache_file, u32 eval_type, u64 mtime, u32 src_size, u32 src_crc)
+{
+	size_t bc_size;
+	u8 *bc, *hdr;
+	u32 hdr_size;
+	char szTmp[GF_MAX_PATH];
+	FILE *f;
+	GF_BitStream *bs;
+	const char *version = gf_gpac_version();
+
+	bc = JS_WriteObject(ctx, &bc_size, obj, JS_WRITE_OBJ_BYTECODE);
+	if (!bc) {
+		JSValue exc = JS_GetException(ctx);
+		JS_FreeValue(ctx, exc);
+		return;
+	}
+	bs = gf_bs_new(NULL, 0, GF_BITSTREAM_WRITE);
+	gf_bs_write_u32(bs, QJS_BC_MAGIC);
+	gf_bs_write_u32(bs, QJS_BC_VERSION);
+	gf_bs_write_u32(bs, eval_type);
+	gf_bs_write_u64(bs, mtime);
+	gf_bs_write_u32(bs, src_size);
+	gf_bs_write_u32(bs, src_crc);
+	gf_bs_write_u32(bs, (u32) bc_size);
+	gf_bs_write_u32(bs, gf_crc_32(bc, (u32) bc_size));
+	gf_bs_write_u16(bs, (u32) strlen(version));
+	gf_bs_write_data(bs, version, (u32) strlen(version));
+	gf_bs_get_content(bs, &hdr, &hdr_size);
+	gf_bs_del(bs);
+
+	//write to a process-specific temp file then move it, so that concurrent sessions never read a partial file
+	snprintf(szTmp, GF_MAX_PATH, "%s.%u.tmp", cache_file, gf_sys_get_process_id());
+	f = gf_fopen(szTmp, "wb");
+	if (f) {
+		Bool ok = (gf_fwrite(hdr, hdr_size, f) == hdr_size) && (gf_fwrite(bc, (u32) bc_size, f) == bc_size);
+		gf_fclose(f);
+		if (!ok || (gf_file_move(szTmp, cache_file) != GF_OK)) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_SCRIPT, ("[JS] Failed to write bytecode cache %s\n", cache_file));
+			gf_file_delete(szTmp);
+		}
+	}
+	gf_free(hdr);
+	js_free(ctx, bc);
+}
+
+//filename is the script name as seen by the engine, src_path the local file it was loaded from
+static JSValue qjs_eval_cached_ex(JSContext *ctx, const char *buf, u32 buf_len, const char *filename, const char *src_path, u32 flags)
+{
+	JSValue obj;
+	u64 mtime, clock_us;
+	u32 src_crc, eval_type;
+	char *cache_file = qjs_bc_cache_file(src_path);
+	if (!cache_file)
+		return JS_Eval(ctx, buf, buf_len, filename, flags);
+
+	eval_type = flags & JS_EVAL_TYPE_MASK;
+	mtime = gf_file_modification_time(src_path);
+	src_crc = gf_crc_32((u8 *) buf, buf_len);
+
+	clock_us = gf_sys_clock_high_res();
+	obj = qjs_bc_cache_load(ctx, cache_file, eval_type, mtime, buf_len, src_crc);
+	if (!JS_IsUndefined(obj)) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_SCRIPT, ("[JS] Loaded %s from bytecode cache %s in "LLU" us\n", filename, cache_file, gf_sys_clock_high_res() - clock_us));
+		gf_free(cache_file);
+		if (flags & JS_EVAL_FLAG_COMPILE_ONLY)
+			return obj;
+		if ((JS_VALUE_GET_TAG(obj) == JS_TAG_MODULE) && (JS_ResolveModule(ctx, obj) < 0)) {
+			JS_FreeValue(ctx, obj);
+			return JS_EXCEPTION;
+		}
+		return JS_EvalFunction(ctx, obj);
+	}
+
+	obj = JS_Eval(ctx, buf, buf_len, filename, flags | JS_EVAL_FLAG_COMPILE_ONLY);
+	if (!JS_IsException(obj)) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_SCRIPT, ("[JS] Compiled %s in "LLU" us, storing bytecode in %s\n", filename, gf_sys_clock_high_res() - clock_us, cache_file));
+		qjs_bc_cache_store(ctx, obj, cache_file, eval_type, mtime, buf_len, src_crc);
+	}
+	gf_free(cache_file);
+
+	if (JS_IsException(obj) || (flags & JS_EVAL_FLAG_COMPILE_ONLY))
+		return obj;
+	return JS_EvalFunction(ctx, obj);
+}
+
+JSValue qjs_eval_cached(JSContext *ctx, const char *buf, u32 buf_len, const char *filename, u32 flags)
+{
+	return qjs_eval_cached_ex(ctx, buf, buf_len, filename, filename, flags);
+}
+
 JSModuleDef *qjs_module_loader(JSContext *ctx, const char *module_name, void *opaque)
 {
 	JSModuleDef *m;
@@ -3685,15 +3868,16 @@ JSModuleDef *qjs_module_loader(JSContext *ctx, const char *module_name, void *op
 		} else {
 			e = GF_URL_ERROR;
 		}
-		if (url) gf_free(url);
 
 		if (e != GF_OK) {
+			if (url) gf_free(url);
 			JS_ThrowReferenceError(ctx, "could not load module filename '%s': %s", module_name, gf_error_to_string(e) );
 			return NULL;
 		}
 		/* compile the module */
-		func_val = JS_Eval(ctx, buf ? (char *) buf : "", buf_len, module_name, JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY);
+		func_val = qjs_eval_cached_ex(ctx, buf ? (char *) buf : "", buf_len, module_name, url ? url : module_name, JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY);
 		gf_free(buf);
+		if (url) gf_free(url);
 		if (JS_IsException(func_val))
 			return NULL;
 		/* XXX: could propagate the exception */
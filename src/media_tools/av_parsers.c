@@ -4863,6 +4863,98 @@ void gf_bs_write_se(GF_BitStream *bs, s32 num)
 
 #ifndef GPAC_DISABLE_AV_PARSERS
 
+#if defined(WIN32) && !defined(__GNUC__) && (defined(_M_X64) || defined(_M_IX86))
+# include <intrin.h>
+# define NALU_SCAN_SSE2
+static GFINLINE u32 nalu_scan_ctz(u32 v)
+{
+	unsigned long idx;
+	_BitScanForward(&idx, v);
+	return (u32) idx;
+}
+#elif defined(__GNUC__)
+# if defined(__SSE2__)
+#  include <emmintrin.h>
+#  define NALU_SCAN_SSE2
+#  if (defined(__x86_64__) || defined(__i386__)) && !defined(GPAC_CONFIG_EMSCRIPTEN)
+#   include <immintrin.h>
+#   define NALU_SCAN_AVX2
+#  endif
+# elif defined(__aarch64__) && defined(__ARM_NEON)
+#  include <arm_neon.h>
+#  define NALU_SCAN_NEON
+# endif
+# define nalu_scan_ctz(_v) ((u32) __builtin_ctz(_v))
+# define nalu_scan_ctzll(_v) ((u32) __builtin_ctzll(_v))
+#endif
+
+/*locates the first pair of zero bytes in data, returns size if not found
+start codes and emulation prevention sequences always start with such a pair, so this is used to skip payload bytes*/
+#ifdef NALU_SCAN_AVX2
+__attribute__((target("avx2")))
+static Bool nalu_find_zero_pair_avx2(const u8 *data, u32 size, u32 *pos)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	while (*pos + 33 <= size) {
+		__m256i a = _mm256_loadu_si256((const __m256i *) (data + *pos));
+		__m256i b = _mm256_loadu_si256((const __m256i *) (data + *pos + 1));
+		u32 mask = (u32) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, zero), _mm256_cmpeq_epi8(b, zero)));
+		if (mask) {
+			*pos += nalu_scan_ctz(mask);
+			return GF_TRUE;
+		}
+		*pos += 32;
+	}
+	return GF_FALSE;
+}
+static s32 nalu_scan_has_avx2 = -1;
+#endif
+
+static u32 nalu_find_zero_pair(const u8 *data, u32 size)
+{
+	u32 pos = 0;
+#if defined(NALU_SCAN_AVX2)
+	if (nalu_scan_has_avx2<0)
+		nalu_scan_has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+	if (nalu_scan_has_avx2 && (size>=64) && nalu_find_zero_pair_avx2(data, size, &pos))
+		return pos;
+#endif
+
+#if defined(NALU_SCAN_SSE2)
+	{
+	const __m128i zero = _mm_setzero_si128();
+	while (pos + 17 <= size) {
+		__m128i a = _mm_loadu_si128((const __m128i *) (data+pos));
+		__m128i b = _mm_loadu_si128((const __m128i *) (data+pos+1));
+		u32 mask = (u32) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, zero), _mm_cmpeq_epi8(b, zero)));
+		if (mask) return pos + nalu_scan_ctz(mask);
+		pos += 16;
+	}
+	}
+#elif defined(NALU_SCAN_NEON)
+	while (pos + 17 <= size) {
+		uint8x16_t a = vld1q_u8(data+pos);
+		uint8x16_t b = vld1q_u8(data+pos+1);
+		uint8x16_t m = vandq_u8(vceqzq_u8(a), vceqzq_u8(b));
+		if (vmaxvq_u8(m)) {
+			//narrow to 4 bits per byte
+			u64 bits = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+			return pos + (nalu_scan_ctzll(bits) >> 2);
+		}
+		pos += 16;
+	}
+#endif
+
+	while (pos + 1 < size) {
+		const u8 *next_zero = memchr(data+pos, 0, size-pos-1);
+		if (!next_zero) return size;
+		pos = (u32) (next_zero - data);
+		if (!data[pos+1]) return pos;
+		pos += 2;
+	}
+	return size;
+}
+
 GF_EXPORT
 u32 gf_media_nalu_next_start_code(const u8 *data, u32 data_len, u32 *sc_size)
 {
@@ -4871,11 +4963,11 @@ u32 gf_media_nalu_next_start_code(const u8 *data, u32 data_len, u32 *sc_size)
 
 	while (cur) {
 		u32 v, bpos;
-		u8 *next_zero = memchr(cur, 0, avail);
-		if (!next_zero) return data_len;
+		u32 next_zero = nalu_find_zero_pair(cur, avail);
+		if (next_zero == avail) return data_len;
 
 		v = 0xffffff00;
-		bpos = (u32)(next_zero - data) + 1;
+		bpos = (u32)(cur - data) + next_zero + 1;
 		while (1) {
 			u8 cval;
 			if (bpos == (u32)data_len)
@@ -5033,6 +5125,7 @@ u32 gf_media_nalu_add_emulation_bytes(const u8 *buffer_src, u8 *buffer_dst, u32
 }
 
 /*returns the nal_size without emulation prevention bytes*/
+GF_EXPORT
 u32 gf_media_nalu_emulation_bytes_remove_count(const u8 *buffer, u32 nal_size)
 {
 	u32 i = 0, emulation_bytes_count = 0;
@@ -5041,6 +5134,11 @@ u32 gf_media_nalu_emulation_bytes_remove_count(const u8 *buffer, u32 nal_size)
 
 	while (i < nal_size)
 	{
+		//no pending zeros, skip to next pair of zero bytes
+		if (!num_zero) {
+			i += nalu_find_zero_pair(buffer+i, nal_size-i);
+			if (i >= nal_size) break;
+		}
 		/*ISO 14496-10: "Within the NAL unit, any four-byte sequence that starts with 0x000003
 		  other than the following sequences shall not occur at any byte-aligned position:
 		  \96 0x00000300
@@ -5079,6 +5177,16 @@ u32 gf_media_nalu_remove_emulation_bytes(const u8 *buffer_src, u8 *buffer_dst, u
 
 	while (i < nal_size)
 	{
+		//no pending zeros, copy up to next pair of zero bytes
+		if (!num_zero) {
+			u32 skip = nalu_find_zero_pair(buffer_src+i, nal_size-i);
+			if (skip) {
+				if (buffer_dst + i - emulation_bytes_count != buffer_src + i)
+					memmove(buffer_dst + i - emulation_bytes_count, buffer_src + i, skip);
+				i += skip;
+				if (i >= nal_size) break;
+			}
+		}
 		/*ISO 14496-10: "Within the NAL unit, any four-byte sequence that starts with 0x000003
 		  other than the following sequences shall not occur at any byte-aligned position:
 		  0x00000300
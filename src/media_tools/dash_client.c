@@ -168,6 +168,8 @@ struct __dash_client
 	u32 preroll_state;
 
 	u32 llhls_single_range;
+	//max byte size of merged sidx subsegments, 0 if disabled
+	u32 sidx_merge_size;
 	Bool m3u8_reload_master;
 	u32 hls_reload_time;
 
@@ -184,6 +186,8 @@ struct __dash_client
 	GF_DASHTileAdaptationMode tile_adapt_mode;
 	Bool disable_low_quality_tiles;
 	u32 chaining_mode, chain_stack_state;
+	//number of segments queued ahead of the current one for parallel fetch
+	u32 nb_prefetch;
 
 	GF_List *SRDs;
 
@@ -5434,6 +5438,9 @@ GF_Err gf_dash_setup_groups(GF_DashClient *dash)
 			group->cache_duration = dash->mpd->min_buffer_time;
 
 		group->max_cached_segments = (nb_dependent_rep+1);
+		//keep room for segments fetched ahead by the client
+		if (dash->nb_prefetch)
+			group->max_cached_segments *= (1 + dash->nb_prefetch);
 
 		if (!has_dependent_representations)
 			group->base_rep_index_plus_one = 0; // all representations in this group are independent
@@ -5498,13 +5505,14 @@ GF_Err gf_dash_setup_groups(GF_DashClient *dash)
 	return GF_OK;
 }
 
-static GF_Err gf_dash_load_sidx(GF_BitStream *bs, GF_MPD_Representation *rep, Bool separate_index, u64 sidx_offset)
+static GF_Err gf_dash_load_sidx(GF_BitStream *bs, GF_MPD_Representation *rep, Bool separate_index, u64 sidx_offset, u32 merge_size)
 {
 #ifdef GPAC_DISABLE_ISOM
 	return GF_NOT_SUPPORTED;
 #else
 	u64 anchor_position, prev_pos;
 	GF_SegmentIndexBox *sidx = NULL;
+	GF_MPD_SegmentURL *prev_seg = NULL;
 	u32 i, size, type;
 	GF_Err e;
 	u64 offset;
@@ -5533,12 +5541,20 @@ static GF_Err gf_dash_load_sidx(GF_BitStream *bs, GF_MPD_Representation *rep, Bo
 	rep->segment_list->timescale = sidx->timescale;
 	for (i=0; i<sidx->nb_refs; i++) {
 		if (sidx->refs[i].reference_type) {
-			e = gf_dash_load_sidx(bs, rep, separate_index, offset);
+			e = gf_dash_load_sidx(bs, rep, separate_index, offset, merge_size);
 			if (e) {
 				break;
 			}
+			prev_seg = NULL;
 		} else {
 			GF_MPD_SegmentURL *seg;
+			//append subsegment to the previous one if the merged byte range stays below the merge size
+			if (prev_seg && (prev_seg->media_range->end_range + 1 - prev_seg->media_range->start_range + sidx->refs[i].reference_size <= merge_size)) {
+				offset += sidx->refs[i].reference_size;
+				prev_seg->media_range->end_range = offset - 1;
+				prev_seg->duration += sidx->refs[i].subsegment_duration;
+				continue;
+			}
 			GF_SAFEALLOC(seg, GF_MPD_SegmentURL);
 			if (!seg) return GF_OUT_OF_MEM;
 			GF_SAFEALLOC(seg->media_range, GF_MPD_ByteRange);
@@ -5551,6 +5567,7 @@ static GF_Err gf_dash_load_sidx(GF_BitStream *bs, GF_MPD_Representation *rep, Bo
 			seg->media_range->end_range = offset - 1;
 			seg->duration = sidx->refs[i].subsegment_duration;
 			gf_list_add(rep->segment_list->segment_URLs, seg);
+			if (merge_size) prev_seg = seg;
 		}
 	}
 	gf_isom_box_del((GF_Box*)sidx);
@@ -5594,7 +5611,7 @@ static GF_Err gf_dash_load_representation_sidx(GF_DASH_Group *group, GF_MPD_Repr
 			continue;
 		}
 		gf_bs_seek(bs, gf_bs_get_position(bs)-8);
-		e = gf_dash_load_sidx(bs, rep, separate_index, gf_bs_get_position(bs) );
+		e = gf_dash_load_sidx(bs, rep, separate_index, gf_bs_get_position(bs), group->dash->sidx_merge_size);
 
 		/*we could also parse the sub sidx*/
 		break;
@@ -8861,6 +8878,12 @@ void gf_dash_enable_single_range_llhls(GF_DashClient *dash, Bool enable)
 	dash->llhls_single_range = enable ? 1 : 0;
 }
 
+GF_EXPORT
+void gf_dash_set_sidx_merge(GF_DashClient *dash, u32 max_size)
+{
+	dash->sidx_merge_size = max_size;
+}
+
 GF_EXPORT
 void gf_dash_enable_group_selection(GF_DashClient *dash, Bool enable)
 {
@@ -10554,6 +10577,26 @@ void gf_dash_disable_low_quality_tiles(GF_DashClient *dash, Bool disable_tiles)
 	dash->disable_low_quality_tiles = disable_tiles;
 }
 
+GF_EXPORT
+void gf_dash_set_prefetch(GF_DashClient *dash, u32 nb_segs)
+{
+	dash->nb_prefetch = nb_segs;
+}
+
+GF_EXPORT
+GF_Err gf_dash_group_get_queued_segment(GF_DashClient *dash, u32 idx, u32 seg_idx, const char **url, u64 *start_range, u64 *end_range)
+{
+	GF_DASH_Group *group = gf_list_get(dash->groups, idx);
+	if (!group || !url) return GF_BAD_PARAM;
+	if (seg_idx >= group->nb_cached_segments) return GF_BUFFER_TOO_SMALL;
+	if (group->cached[seg_idx].flags & SEG_FLAG_DISABLED) return GF_URL_REMOVED;
+
+	*url = group->cached[seg_idx].url;
+	if (start_range) *start_range = group->cached[seg_idx].start_range;
+	if (end_range) *end_range = group->cached[seg_idx].end_range;
+	return GF_OK;
+}
+
 GF_EXPORT
 void gf_dash_set_chaining_mode(GF_DashClient *dash, u32 chaining_mode)
 {
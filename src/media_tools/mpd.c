@@ -3737,10 +3737,11 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 	if (as->use_hls_ll) {
 		//PART-HOLD-BACK is REQUIRED if the Playlist contains the EXT-X-PART-INF tag
 		//we use the recommended (should) PART-TARGET x 3
+		gf_fprintf(out,"#EXT-X-SERVER-CONTROL:%sPART-HOLD-BACK=", mpd->llhls_can_block ? "CAN-BLOCK-RELOAD=YES," : "");
 		if (mpd->llhls_part_holdback>0) {
-			gf_fprintf(out,"#EXT-X-SERVER-CONTROL:PART-HOLD-BACK=%g\n", mpd->llhls_part_holdback);
+			gf_fprintf(out,"%g\n", mpd->llhls_part_holdback);
 		} else {
-			gf_fprintf(out,"#EXT-X-SERVER-CONTROL:PART-HOLD-BACK=%g\n", 3 * max_part_dur_session);
+			gf_fprintf(out,"%g\n", 3 * max_part_dur_session);
 		}
 		gf_fprintf(out,"#EXT-X-PART-INF:PART-TARGET=%g\n", rep->hls_ll_part_dur);
 	}
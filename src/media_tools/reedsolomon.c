@@ -16,15 +16,14 @@
 #include <gpac/tools.h>
 #include <gpac/internal/reedsolomon.h>
 
-#ifdef GPAC_ENABLE_MPE
-
-
 /* This is one of 14 irreducible polynomials
  * of degree 8 and cycle length 255. (Ch 5, pp. 275, Magnetic Recording)
  * The high order 1 bit is implicit */
 /* x^8 + x^4 + x^3 + x^2 + 1 */
 #define PPOLY 0x1D
 
+#ifdef GPAC_ENABLE_MPE
+
 
 int gexp[512];
 int glog[256];
@@ -575,3 +574,272 @@ encode_data (unsigned char msg[], int nbytes, unsigned char dst[])
 }
 
 #endif //GPAC_ENABLE_MPE
+
+
+/*
+	Reed-Solomon erasure code over GF(2^8) for application-layer FEC
+
+	Source symbol i (0<=i<k) and repair symbol r are associated to field elements y_i=i and x_r=k+r, and repair
+	symbol r is sum_i C[r][i]*S_i with C[r][i] = 1/(x_r+y_i). The generator matrix [I|C] is MDS since every square
+	sub-matrix of a Cauchy matrix is invertible.
+
+	Region operations dst ^= c*src use split 4-bit product tables so that they map to byte shuffles (PSHUFB / TBL),
+	the SIMD variant being selected at run time on x86.
+*/
+
+static u8 rs_fec_exp[512];
+static u8 rs_fec_log[256];
+static u8 rs_fec_mul_tab[256][256];
+//products of c by low and high nibbles, for shuffle-based multiplication
+static u8 rs_fec_mul_lo[256][16];
+static u8 rs_fec_mul_hi[256][16];
+static Bool rs_fec_tables_ready = GF_FALSE;
+
+static void rs_fec_mul_add_c(u8 *dst, const u8 *src, u8 c, u32 len)
+{
+	u32 i;
+	const u8 *mt = rs_fec_mul_tab[c];
+	for (i=0; i<len; i++)
+		dst[i] ^= mt[src[i]];
+}
+
+static void (*rs_fec_mul_add)(u8 *dst, const u8 *src, u8 c, u32 len) = rs_fec_mul_add_c;
+static const char *rs_fec_impl = "C";
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(GPAC_CONFIG_EMSCRIPTEN)
+#include <immintrin.h>
+#define RS_FEC_X86
+
+__attribute__((target("ssse3")))
+static void rs_fec_mul_add_ssse3(u8 *dst, const u8 *src, u8 c, u32 len)
+{
+	u32 i=0;
+	const __m128i tlo = _mm_loadu_si128((const __m128i *) rs_fec_mul_lo[c]);
+	const __m128i thi = _mm_loadu_si128((const __m128i *) rs_fec_mul_hi[c]);
+	const __m128i mask = _mm_set1_epi8(0x0F);
+	for (; i+16<=len; i+=16) {
+		__m128i s = _mm_loadu_si128((const __m128i *) (src+i));
+		__m128i d = _mm_loadu_si128((const __m128i *) (dst+i));
+		__m128i l = _mm_shuffle_epi8(tlo, _mm_and_si128(s, mask));
+		__m128i h = _mm_shuffle_epi8(thi, _mm_and_si128(_mm_srli_epi64(s, 4), mask));
+		_mm_storeu_si128((__m128i *) (dst+i), _mm_xor_si128(d, _mm_xor_si128(l, h)));
+	}
+	if (i<len) rs_fec_mul_add_c(dst+i, src+i, c, len-i);
+}
+
+__attribute__((target("avx2")))
+static void rs_fec_mul_add_avx2(u8 *dst, const u8 *src, u8 c, u32 len)
+{
+	u32 i=0;
+	const __m256i tlo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) rs_fec_mul_lo[c]));
+	const __m256i thi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) rs_fec_mul_hi[c]));
+	const __m256i mask = _mm256_set1_epi8(0x0F);
+	for (; i+32<=len; i+=32) {
+		__m256i s = _mm256_loadu_si256((const __m256i *) (src+i));
+		__m256i d = _mm256_loadu_si256((const __m256i *) (dst+i));
+		__m256i l = _mm256_shuffle_epi8(tlo, _mm256_and_si256(s, mask));
+		__m256i h = _mm256_shuffle_epi8(thi, _mm256_and_si256(_mm256_srli_epi64(s, 4), mask));
+		_mm256_storeu_si256((__m256i *) (dst+i), _mm256_xor_si256(d, _mm256_xor_si256(l, h)));
+	}
+	if (i<len) rs_fec_mul_add_ssse3(dst+i, src+i, c, len-i);
+}
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RS_FEC_NEON
+
+static void rs_fec_mul_add_neon(u8 *dst, const u8 *src, u8 c, u32 len)
+{
+	u32 i=0;
+	const uint8x16_t tlo = vld1q_u8(rs_fec_mul_lo[c]);
+	const uint8x16_t thi = vld1q_u8(rs_fec_mul_hi[c]);
+	const uint8x16_t mask = vdupq_n_u8(0x0F);
+	for (; i+16<=len; i+=16) {
+		uint8x16_t s = vld1q_u8(src+i);
+		uint8x16_t d = vld1q_u8(dst+i);
+		uint8x16_t l = vqtbl1q_u8(tlo, vandq_u8(s, mask));
+		uint8x16_t h = vqtbl1q_u8(thi, vshrq_n_u8(s, 4));
+		vst1q_u8(dst+i, veorq_u8(d, veorq_u8(l, h)));
+	}
+	if (i<len) rs_fec_mul_add_c(dst+i, src+i, c, len-i);
+}
+#endif
+
+static u8 rs_fec_mul(u8 a, u8 b)
+{
+	if (!a || !b) return 0;
+	return rs_fec_exp[rs_fec_log[a] + rs_fec_log[b]];
+}
+
+static u8 rs_fec_inv(u8 a)
+{
+	return rs_fec_exp[255 - rs_fec_log[a]];
+}
+
+static void rs_fec_init(void)
+{
+	u32 i, j, x=1;
+	if (rs_fec_tables_ready) return;
+
+	for (i=0; i<255; i++) {
+		rs_fec_exp[i] = rs_fec_exp[i+255] = (u8) x;
+		rs_fec_log[x] = (u8) i;
+		x <<= 1;
+		if (x & 0x100) x ^= 0x100 | PPOLY;
+	}
+	rs_fec_exp[510] = rs_fec_exp[0];
+	rs_fec_exp[511] = rs_fec_exp[1];
+	for (i=0; i<256; i++) {
+		for (j=0; j<256; j++)
+			rs_fec_mul_tab[i][j] = rs_fec_mul((u8) i, (u8) j);
+		for (j=0; j<16; j++) {
+			rs_fec_mul_lo[i][j] = rs_fec_mul_tab[i][j];
+			rs_fec_mul_hi[i][j] = rs_fec_mul_tab[i][j<<4];
+		}
+	}
+
+#if defined(RS_FEC_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		rs_fec_mul_add = rs_fec_mul_add_avx2;
+		rs_fec_impl = "AVX2";
+	} else if (__builtin_cpu_supports("ssse3")) {
+		rs_fec_mul_add = rs_fec_mul_add_ssse3;
+		rs_fec_impl = "SSSE3";
+	}
+#elif defined(RS_FEC_NEON)
+	rs_fec_mul_add = rs_fec_mul_add_neon;
+	rs_fec_impl = "NEON";
+#endif
+	rs_fec_tables_ready = GF_TRUE;
+}
+
+GF_EXPORT
+void gf_rs_fec_mul_add(u8 *dst, const u8 *src, u8 c, u32 len)
+{
+	rs_fec_init();
+	if (!c) return;
+	rs_fec_mul_add(dst, src, c, len);
+}
+
+GF_EXPORT
+const char *gf_rs_fec_get_impl(void)
+{
+	rs_fec_init();
+	return rs_fec_impl;
+}
+
+GF_EXPORT
+void gf_rs_fec_partition(u64 size, u32 sym_size, u32 max_k, u32 *nb_blocks, u32 *k_large, u32 *k_small, u32 *nb_large)
+{
+	u64 nb_syms;
+	u32 nb_b;
+	*nb_blocks = *k_large = *k_small = *nb_large = 0;
+	if (!size || !sym_size || !max_k) return;
+
+	nb_syms = (size + sym_size - 1) / sym_size;
+	nb_b = (u32) ((nb_syms + max_k - 1) / max_k);
+	*nb_blocks = nb_b;
+	*k_large = (u32) ((nb_syms + nb_b - 1) / nb_b);
+	*k_small = (u32) (nb_syms / nb_b);
+	*nb_large = (u32) (nb_syms - (u64) (*k_small) * nb_b);
+}
+
+GF_EXPORT
+GF_Err gf_rs_fec_encode(const u8 **src, u32 k, u8 **repair, u32 nb_repair, u32 sym_size)
+{
+	u32 i, r;
+	if (!k || !sym_size || (k + nb_repair > GF_RS_FEC_MAX_SYMBOLS)) return GF_BAD_PARAM;
+	rs_fec_init();
+
+	for (r=0; r<nb_repair; r++) {
+		memset(repair[r], 0, sym_size);
+		for (i=0; i<k; i++) {
+			rs_fec_mul_add(repair[r], src[i], rs_fec_inv((u8) ((k+r) ^ i)), sym_size);
+		}
+	}
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_rs_fec_decode(u8 **src, u32 k, const u32 *missing, u32 nb_missing, const u8 **repair, const u32 *repair_idx, u32 sym_size)
+{
+	u32 i, j, t;
+	u8 mat[GF_RS_FEC_MAX_SYMBOLS][GF_RS_FEC_MAX_SYMBOLS];
+	u8 inv[GF_RS_FEC_MAX_SYMBOLS][GF_RS_FEC_MAX_SYMBOLS];
+	u8 is_missing[GF_RS_FEC_MAX_SYMBOLS];
+	u8 *tmp;
+
+	if (!nb_missing) return GF_OK;
+	if (!k || !sym_size || (k > GF_RS_FEC_MAX_SYMBOLS) || (nb_missing > k)) return GF_BAD_PARAM;
+	for (j=0; j<nb_missing; j++) {
+		if (missing[j] >= k) return GF_BAD_PARAM;
+		if (k + repair_idx[j] >= GF_RS_FEC_MAX_SYMBOLS) return GF_BAD_PARAM;
+	}
+	rs_fec_init();
+
+	memset(is_missing, 0, sizeof(u8)*k);
+	for (j=0; j<nb_missing; j++)
+		is_missing[missing[j]] = 1;
+
+	tmp = gf_malloc(sizeof(u8) * nb_missing * sym_size);
+	if (!tmp) return GF_OUT_OF_MEM;
+
+	//remove contribution of received source symbols from each repair symbol
+	for (j=0; j<nb_missing; j++) {
+		u8 *dst = tmp + j*sym_size;
+		u32 x = k + repair_idx[j];
+		memcpy(dst, repair[j], sym_size);
+		for (i=0; i<k; i++) {
+			if (is_missing[i]) continue;
+			rs_fec_mul_add(dst, src[i], rs_fec_inv((u8) (x ^ i)), sym_size);
+		}
+		for (t=0; t<nb_missing; t++) {
+			mat[j][t] = rs_fec_inv((u8) (x ^ missing[t]));
+			inv[j][t] = (j==t) ? 1 : 0;
+		}
+	}
+
+	//invert the Cauchy sub-matrix using Gauss-Jordan elimination
+	for (t=0; t<nb_missing; t++) {
+		u8 p;
+		u32 piv = t;
+		while ((piv<nb_missing) && !mat[piv][t]) piv++;
+		if (piv==nb_missing) {
+			gf_free(tmp);
+			return GF_CORRUPTED_DATA;
+		}
+		if (piv != t) {
+			for (i=0; i<nb_missing; i++) {
+				u8 v = mat[t][i]; mat[t][i] = mat[piv][i]; mat[piv][i] = v;
+				v = inv[t][i]; inv[t][i] = inv[piv][i]; inv[piv][i] = v;
+			}
+		}
+		p = rs_fec_inv(mat[t][t]);
+		for (i=0; i<nb_missing; i++) {
+			mat[t][i] = rs_fec_mul(mat[t][i], p);
+			inv[t][i] = rs_fec_mul(inv[t][i], p);
+		}
+		for (j=0; j<nb_missing; j++) {
+			u8 f;
+			if ((j==t) || !mat[j][t]) continue;
+			f = mat[j][t];
+			for (i=0; i<nb_missing; i++) {
+				mat[j][i] ^= rs_fec_mul(f, mat[t][i]);
+				inv[j][i] ^= rs_fec_mul(f, inv[t][i]);
+			}
+		}
+	}
+
+	//missing symbol t is sum_j inv[t][j]*tmp[j]
+	for (t=0; t<nb_missing; t++) {
+		u8 *dst = src[missing[t]];
+		memset(dst, 0, sym_size);
+		for (j=0; j<nb_missing; j++) {
+			if (inv[t][j])
+				rs_fec_mul_add(dst, tmp + j*sym_size, inv[t][j], sym_size);
+		}
+	}
+	gf_free(tmp);
+	return GF_OK;
+}
@@ -31,6 +31,7 @@
 #include <gpac/bitstream.h>
 #include <gpac/xml.h>
 #include <gpac/thread.h>
+#include <gpac/internal/reedsolomon.h>
 
 #define GF_ROUTE_SOCK_SIZE	0x80000
 
@@ -91,6 +92,12 @@ typedef struct
 
 	u32 prev_start_offset;
 
+	//repair symbols received for this object, identified by (SBN<<8 | ESI)
+	u8 *fec_data;
+	u32 *fec_ids;
+	u32 nb_fec, nb_alloc_fec, fec_data_size;
+	u32 fec_sym_size, fec_max_k;
+
     char solved_path[GF_MAX_PATH];
 
     GF_Blob blob;
@@ -200,6 +207,8 @@ static void gf_route_lct_obj_del(GF_LCTObject *o)
 {
 	if (o->frags) gf_free(o->frags);
 	if (o->payload) gf_free(o->payload);
+	if (o->fec_data) gf_free(o->fec_data);
+	if (o->fec_ids) gf_free(o->fec_ids);
 	gf_free(o);
 }
 
@@ -625,6 +634,8 @@ static void gf_route_obj_to_reservoir(GF_ROUTEDmx *routedmx, GF_ROUTEService *s,
     obj->solved_path[0] = 0;
 	obj->total_length = 0;
 	obj->prev_start_offset = 0;
+	obj->nb_fec = 0;
+	obj->fec_sym_size = obj->fec_max_k = 0;
 	obj->download_time_ms = 0;
 	obj->last_gather_time = 0;
 	obj->status = GF_LCT_OBJ_INIT;
@@ -1086,6 +1097,181 @@ check_done:
 	return gf_route_service_flush_object(s, obj);
 }
 
+//check if source symbol [start, end[ is fully received - frags are sorted and merged
+static Bool gf_route_obj_has_range(GF_LCTObject *obj, u32 *frag_idx, u32 start, u32 end)
+{
+	while (*frag_idx < obj->nb_frags) {
+		GF_LCTFragInfo *frag = &obj->frags[*frag_idx];
+		if (frag->offset + frag->size <= start) {
+			(*frag_idx)++;
+			continue;
+		}
+		return ((frag->offset <= start) && (frag->offset + frag->size >= end)) ? GF_TRUE : GF_FALSE;
+	}
+	return GF_FALSE;
+}
+
+static GF_Err gf_route_obj_fec_decode(GF_ROUTEService *s, GF_LCTObject *obj)
+{
+	u32 nb_blocks, k_large, k_small, nb_large, b, i, frag_idx, sym_start, nb_recovered;
+	u32 E = obj->fec_sym_size;
+	u32 L = obj->total_length;
+	u8 *last_sym = NULL;
+	GF_Err e = GF_OK;
+
+	if (!E || !L || !obj->nb_fec || (obj->nb_bytes >= L)) return GF_NOT_READY;
+	gf_rs_fec_partition(L, E, obj->fec_max_k, &nb_blocks, &k_large, &k_small, &nb_large);
+	if (!nb_blocks || (k_large > GF_RS_FEC_MAX_SYMBOLS)) return GF_NON_COMPLIANT_BITSTREAM;
+
+	//first pass: all blocks must be recoverable, we only dispatch complete objects
+	frag_idx = 0;
+	sym_start = 0;
+	for (b=0; b<nb_blocks; b++) {
+		u32 k = (b<nb_large) ? k_large : k_small;
+		u32 nb_missing = 0, nb_repair = 0;
+		for (i=0; i<k; i++) {
+			u64 start = (u64) (sym_start + i) * E;
+			u64 end = MIN(start + E, L);
+			if (!gf_route_obj_has_range(obj, &frag_idx, (u32) start, (u32) end))
+				nb_missing++;
+		}
+		if (nb_missing) {
+			for (i=0; i<obj->nb_fec; i++) {
+				if (((obj->fec_ids[i]>>8) == b) && ((obj->fec_ids[i] & 0xFF) >= k))
+					nb_repair++;
+			}
+			if (nb_repair < nb_missing) return GF_NOT_READY;
+		}
+		sym_start += k;
+	}
+
+	//second pass: decode
+	frag_idx = 0;
+	sym_start = 0;
+	nb_recovered = 0;
+	for (b=0; b<nb_blocks; b++) {
+		u8 *src[GF_RS_FEC_MAX_SYMBOLS];
+		const u8 *repair[GF_RS_FEC_MAX_SYMBOLS];
+		u32 missing[GF_RS_FEC_MAX_SYMBOLS], repair_idx[GF_RS_FEC_MAX_SYMBOLS];
+		u32 nb_missing = 0, nb_repair = 0;
+		Bool has_last = GF_FALSE, last_missing = GF_FALSE;
+		u32 k = (b<nb_large) ? k_large : k_small;
+
+		for (i=0; i<k; i++) {
+			u64 start = (u64) (sym_start + i) * E;
+			u64 end = MIN(start + E, L);
+			Bool present = gf_route_obj_has_range(obj, &frag_idx, (u32) start, (u32) end);
+			if (!present)
+				missing[nb_missing++] = i;
+			src[i] = obj->payload + start;
+			//last symbol of object is shorter, use a zero-padded copy
+			if (end - start < E) {
+				if (!last_sym) last_sym = gf_malloc(E);
+				if (!last_sym) {
+					e = GF_OUT_OF_MEM;
+					goto exit;
+				}
+				memset(last_sym, 0, E);
+				if (present) memcpy(last_sym, src[i], (u32) (end - start));
+				src[i] = last_sym;
+				has_last = GF_TRUE;
+				last_missing = !present;
+			}
+		}
+		if (nb_missing) {
+			for (i=0; (i<obj->nb_fec) && (nb_repair<nb_missing); i++) {
+				if (((obj->fec_ids[i]>>8) != b) || ((obj->fec_ids[i] & 0xFF) < k)) continue;
+				repair[nb_repair] = obj->fec_data + (u64) i * E;
+				repair_idx[nb_repair] = (obj->fec_ids[i] & 0xFF) - k;
+				nb_repair++;
+			}
+			e = gf_rs_fec_decode(src, k, missing, nb_missing, repair, repair_idx, E);
+			if (e) goto exit;
+			if (has_last && last_missing) {
+				u64 start = (u64) (sym_start + k - 1) * E;
+				memcpy(obj->payload + start, last_sym, (u32) (L - start));
+			}
+			nb_recovered += nb_missing;
+		}
+		sym_start += k;
+	}
+
+	GF_LOG(GF_LOG_INFO, GF_LOG_ROUTE, ("[ROUTE] Service %d object TSI %u TOI %u recovered %u source symbols using %u repair symbols\n", s->service_id, obj->tsi, obj->toi, nb_recovered, obj->nb_fec));
+	obj->frags[0].offset = 0;
+	obj->frags[0].size = L;
+	obj->nb_frags = 1;
+	obj->nb_bytes = L;
+	obj->status = GF_LCT_OBJ_RECEPTION;
+
+exit:
+	if (last_sym) gf_free(last_sym);
+	if (e) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d object TSI %u TOI %u FEC decoding failed: %s\n", s->service_id, obj->tsi, obj->toi, gf_error_to_string(e) ));
+	}
+	return e;
+}
+
+static GF_Err gf_route_service_gather_repair(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, u32 tsi, u32 toi, u32 sbn, u32 esi, char *data, u32 size, u32 total_len, u32 sym_size, u32 max_k, Bool in_order, GF_ROUTELCTChannel *rlct)
+{
+	u32 i, nb_blocks, k_large, k_small, nb_large;
+	GF_Err e;
+	GF_LCTObject *obj = NULL;
+
+	//repair symbols are only used for objects with FEC object transmission information
+	if (!total_len || !sym_size || !max_k || (max_k > GF_RS_FEC_MAX_SYMBOLS) || (size != sym_size)) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] Service %d TSI %u TOI %u repair packet without valid FEC information, ignoring\n", s->service_id, tsi, toi));
+		return GF_OK;
+	}
+	gf_rs_fec_partition(total_len, sym_size, max_k, &nb_blocks, &k_large, &k_small, &nb_large);
+	if ((sbn >= nb_blocks) || (esi < ((sbn<nb_large) ? k_large : k_small))) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d TSI %u TOI %u invalid repair symbol SBN %u ESI %u, ignoring\n", s->service_id, tsi, toi, sbn, esi));
+		return GF_OK;
+	}
+	e = gf_route_service_gather_object(routedmx, s, tsi, toi, 0, NULL, 0, total_len, GF_FALSE, in_order, rlct, &obj);
+	if (e==GF_EOS) {
+		return gf_route_dmx_process_object(routedmx, s, obj);
+	}
+	if (e || !obj) return e;
+
+	if ((obj->fec_sym_size != sym_size) || (obj->fec_max_k != max_k)) {
+		obj->nb_fec = 0;
+		obj->fec_sym_size = sym_size;
+		obj->fec_max_k = max_k;
+	}
+	for (i=0; i<obj->nb_fec; i++) {
+		if (obj->fec_ids[i] == ((sbn<<8) | esi)) return GF_OK;
+	}
+	if (obj->nb_fec == obj->nb_alloc_fec) {
+		obj->nb_alloc_fec = obj->nb_alloc_fec ? 2*obj->nb_alloc_fec : 16;
+		obj->fec_ids = gf_realloc(obj->fec_ids, sizeof(u32) * obj->nb_alloc_fec);
+		if (!obj->fec_ids) {
+			obj->nb_fec = obj->nb_alloc_fec = 0;
+			return GF_OUT_OF_MEM;
+		}
+	}
+	if ((u64) sym_size * (obj->nb_fec+1) > obj->fec_data_size) {
+		obj->fec_data_size = sym_size * obj->nb_alloc_fec;
+		obj->fec_data = gf_realloc(obj->fec_data, obj->fec_data_size);
+		if (!obj->fec_data) {
+			obj->nb_fec = obj->fec_data_size = 0;
+			return GF_OUT_OF_MEM;
+		}
+	}
+	obj->fec_ids[obj->nb_fec] = (sbn<<8) | esi;
+	memcpy(obj->fec_data + (u64) obj->nb_fec * sym_size, data, sym_size);
+	obj->nb_fec++;
+
+	if (gf_route_obj_fec_decode(s, obj) != GF_OK) return GF_OK;
+
+	s->last_active_obj = NULL;
+	if (obj->rlct) {
+		obj->rlct->last_dispatched_tsi = obj->tsi;
+		obj->rlct->last_dispatched_toi = obj->toi;
+	}
+	gf_route_service_flush_object(s, obj);
+	return gf_route_dmx_process_object(routedmx, s, obj);
+}
+
 static GF_Err gf_route_service_setup_dash(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, char *content, char *content_location)
 {
 	u32 len = (u32) strlen(content);
@@ -1621,6 +1807,7 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 	u32 nb_read, v, C, psi, S, O, H, /*Res, A,*/ B, hdr_len, cp, cc, tsi, toi, pos;
 	u32 /*a_G=0, a_U=0,*/ a_S=0, a_M=0/*, a_A=0, a_H=0, a_D=0*/;
 	u64 tol_size=0;
+	u32 fec_sym_size=0, fec_max_k=0;
 	Bool in_order = GF_TRUE;
 	u32 start_offset;
 	GF_ROUTELCTChannel *rlct=NULL;
@@ -1685,11 +1872,6 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 		return GF_NON_COMPLIANT_BITSTREAM;
 	}
 
-	if (psi==0) {
-		GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d : FEC ROUTE not implemented\n", s->service_id));
-		return GF_NOT_SUPPORTED;
-	}
-
 	cc = gf_bs_read_u32(routedmx->bs);
 	tsi = gf_bs_read_u32(routedmx->bs);
 	toi = gf_bs_read_u32(routedmx->bs);
@@ -1698,6 +1880,12 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 	//filter TSI if not 0 (service TSI) and debug mode set
 	if (routedmx->debug_tsi && tsi && (tsi!=routedmx->debug_tsi)) return GF_OK;
 
+	//repair packets are only sent for objects in media TSIs
+	if ((psi==0) && !tsi) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] Service %d : FEC repair packet on signaling TSI not supported, skipping (TOI %u)\n", s->service_id, toi));
+		return GF_OK;
+	}
+
 	//look for TSI 0 first
 	if (tsi!=0) {
 		Bool cp_found = GF_FALSE;
@@ -1796,6 +1984,25 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 			}
 			break;
 
+		//Reed-Solomon over GF(2^8) FTI (RFC 5510): transfer length, m, G, E, B, max_n
+		case GF_LCT_EXT_FTI:
+			if (hel!=4) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d : wrong HEL %d for FTI LCT extension, expecting 4\n", s->service_id, hel));
+				gf_bs_skip_bytes(routedmx->bs, hel ? 4*hel-2 : 0);
+				break;
+			}
+			tol_size = gf_bs_read_long_int(routedmx->bs, 48);
+			if (gf_bs_read_u8(routedmx->bs) != 8) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_ROUTE, ("[ROUTE] Service %d : unsupported FEC field size, ignoring FTI\n", s->service_id));
+				gf_bs_skip_bytes(routedmx->bs, 7);
+				break;
+			}
+			/*G = */gf_bs_read_u8(routedmx->bs);
+			fec_sym_size = gf_bs_read_u16(routedmx->bs);
+			fec_max_k = gf_bs_read_u16(routedmx->bs);
+			/*max_n = */gf_bs_read_u16(routedmx->bs);
+			break;
+
 		default:
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] Service %d : unsupported header extension HEL %d HET %d, ignoring\n", s->service_id, hel, het));
 			break;
@@ -1808,6 +2015,21 @@ static GF_Err gf_route_dmx_process_service(GF_ROUTEDmx *routedmx, GF_ROUTEServic
 		else hdr_len -= 1;
 	}
 
+	if (psi==0) {
+		u32 sbn = gf_bs_read_int(routedmx->bs, 24);
+		u32 esi = gf_bs_read_int(routedmx->bs, 8);
+		if (tol_size>=GF_ROUTE_MAX_SIZE) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] Service %d : wrong ROUTE object size %u\n", s->service_id, tol_size));
+			return GF_NON_COMPLIANT_BITSTREAM;
+		}
+		pos = (u32) gf_bs_get_position(routedmx->bs);
+		if (pos > nb_read) return GF_NON_COMPLIANT_BITSTREAM;
+
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[ROUTE] Service %d : LCT repair packet TSI %u TOI %u size %d SBN %u ESI %u TOL "LLU" (PckNum %d)\n", s->service_id, tsi, toi, nb_read-pos, sbn, esi, tol_size, routedmx->nb_packets));
+		gf_route_service_gather_repair(routedmx, s, tsi, toi, sbn, esi, routedmx->buffer + pos, nb_read-pos, (u32) tol_size, fec_sym_size, fec_max_k, in_order, rlct);
+		return GF_OK;
+	}
+
 	start_offset = gf_bs_read_u32(routedmx->bs);
 	if (start_offset>=GF_ROUTE_MAX_SIZE) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[ROUTE] Service %d : wrong ROUTE start offset %u\n", s->service_id, start_offset));
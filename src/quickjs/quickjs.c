@@ -54261,6 +54261,40 @@ int JS_IsArrayBuffer(JSContext *ctx, JSValueConst val)
 	return FALSE;
 }
 
+/* detach an ArrayBuffer without releasing its memory, ownership of the data is passed to the caller
+which must release it by calling free_func(rt, opaque, data)
+return NULL if the object is not an ArrayBuffer, is shared, detached or does not own its memory */
+uint8_t *JS_TransferArrayBuffer(JSContext *ctx, JSValueConst obj, size_t *psize,
+                                JSFreeArrayBufferDataFunc **free_func, void **opaque)
+{
+    JSArrayBuffer *abuf = JS_GetOpaque(obj, JS_CLASS_ARRAY_BUFFER);
+    struct list_head *el;
+    uint8_t *data;
+
+    if (!abuf || abuf->detached || abuf->shared || !abuf->free_func)
+        return NULL;
+    data = abuf->data;
+    *psize = abuf->byte_length;
+    *free_func = abuf->free_func;
+    *opaque = abuf->opaque;
+    abuf->data = NULL;
+    abuf->byte_length = 0;
+    abuf->detached = TRUE;
+
+    list_for_each(el, &abuf->array_list) {
+        JSTypedArray *ta;
+        JSObject *p;
+
+        ta = list_entry(el, JSTypedArray, link);
+        p = ta->obj;
+        if (p->class_id != JS_CLASS_DATAVIEW) {
+            p->u.array.count = 0;
+            p->u.array.u.ptr = NULL;
+        }
+    }
+    return data;
+}
+
 /* return -1 if exception (proxy case) or TRUE/FALSE */
 int JS_SwitchClassID(JSValue obj, JSClassID class_id)
 {
@@ -1087,6 +1087,8 @@ int JS_IsArrayBuffer(JSContext *ctx, JSValueConst val);
 int JS_SwitchClassID(JSValue obj, JSClassID class_id);
 
 void *JS_GetOpaque_Nocheck(JSValueConst obj);
+uint8_t *JS_TransferArrayBuffer(JSContext *ctx, JSValueConst obj, size_t *psize,
+                                JSFreeArrayBufferDataFunc **free_func, void **opaque);
 /*end GPAC patched*/
 
 #ifdef __cplusplus
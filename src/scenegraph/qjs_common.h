@@ -64,6 +64,9 @@ JSValue js_print(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *
 
 void js_load_constants(JSContext *ctx, JSValue global_obj);
 
+/*evaluates script, using the on-disk bytecode cache if enabled (-js-cache) and filename is a local file*/
+JSValue qjs_eval_cached(JSContext *ctx, const char *buf, u32 buf_len, const char *filename, u32 flags);
+
 /********************************************
 
 	SceneGraph JS tools
@@ -2457,7 +2457,7 @@ Bool svg_js_load_script(GF_Node *script, char *file)
 		svg_js->use_strict = GF_TRUE;
 	}
 
-	ret = JS_Eval(svg_js->js_ctx, jsscript, sizeof(char)*fsize, file, flags);
+	ret = qjs_eval_cached(svg_js->js_ctx, jsscript, sizeof(char)*fsize, file, flags);
 	if (JS_IsException(ret)) {
 		js_dump_error(svg_js->js_ctx);
 		success=GF_FALSE;
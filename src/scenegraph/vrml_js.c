@@ -3935,7 +3935,7 @@ static Bool vrml_js_load_script(M_Script *script, char *file, Bool primary_scrip
 //		flags = JS_EVAL_TYPE_MODULE;
 
 
-	ret = JS_Eval(priv->js_ctx, jsscript, fsize, file, flags);
+	ret = qjs_eval_cached(priv->js_ctx, jsscript, fsize, file, flags);
 	if (JS_IsException(ret)) {
 		success = 0;
 		js_dump_error(priv->js_ctx);
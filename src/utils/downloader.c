@@ -40,6 +40,12 @@
 #include <openssl/x509v3.h>
 #include <openssl/err.h>
 #include <openssl/rand.h>
+
+//kernel TLS offload, only enabled on linux with openssl 3+ built with ktls support
+#if defined(GPAC_CONFIG_LINUX) && defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#define GPAC_HAS_KTLS
+#endif
+
 #endif
 
 #ifdef GPAC_HAS_HTTP2
@@ -80,6 +86,11 @@ typedef SSIZE_T ssize_t;
 #define GF_DOWNLOAD_BUFFER_SIZE		131072
 #define GF_DOWNLOAD_BUFFER_SIZE_LIMIT_RATE		GF_DOWNLOAD_BUFFER_SIZE/20
 
+//max time in ms an idle keep-alive connection is kept for reuse, if server did not indicate a lower timeout
+#define GF_DM_IDLE_CONN_TIMEOUT	30000
+//max time in microseconds a pool thread waits for data on its sockets
+#define GF_DM_POOL_WAIT_US	10000
+
 
 #ifdef GPAC_HAS_HTTP2
 #define HTTP2_BUFFER_SETTINGS_SIZE 128
@@ -150,6 +161,49 @@ typedef struct
 	struct __gf_download_session *sess;
 } GF_SessTask;
 
+/*connection statistics and TLS session cache for a remote host*/
+typedef struct
+{
+	char *server;
+	u16 port;
+	Bool use_ssl;
+	struct __gf_download_manager *dm;
+	//number of TCP connections opened, requests sent on an already opened connection
+	u32 nb_connections, nb_reused;
+	//number of TLS handshakes and of resumed ones
+	u32 nb_handshakes, nb_resumed;
+#ifdef GPAC_HAS_SSL
+	SSL_SESSION *ssl_sess;
+#endif
+} GF_DMHost;
+
+/*idle keep-alive connection available for any session targeting the same host*/
+typedef struct
+{
+	GF_DMHost *host;
+	GF_Socket *sock;
+#ifdef GPAC_HAS_SSL
+	SSL *ssl;
+#endif
+	u64 idle_since;
+	u32 timeout_ms;
+} GF_DMIdleConn;
+
+/*thread of the download pool, driving several sessions*/
+typedef struct
+{
+	struct __gf_download_manager *dm;
+	GF_Thread *th;
+	//protects the session list - held while sessions are processed
+	GF_Mutex *mx;
+	GF_List *sessions;
+	GF_Semaphore *sema;
+	GF_SockGroup *sg;
+	//sessions whose socket is being waited on
+	GF_List *waiting;
+	Bool run;
+} GF_DMWorker;
+
 struct __gf_download_session
 {
 	/*this is always 0 and helps differenciating downloads from other interfaces (interfaceType != 0)*/
@@ -159,6 +213,12 @@ struct __gf_download_session
 	GF_Thread *th;
 	GF_Mutex *mx;
 	GF_SessTask *ftask;
+	//pool thread this session was last assigned to
+	GF_DMWorker *worker;
+	//set while the socket is being waited on by the pool thread
+	volatile Bool pool_wait;
+	//host the current connection is established with
+	GF_DMHost *host;
 
 	Bool in_callback, destroy;
 	u32 proxy_enabled;
@@ -219,6 +279,10 @@ struct __gf_download_session
 	u32 connect_pending;
 #ifdef GPAC_HAS_SSL
 	SSL *ssl;
+	//kTLS state of the connection (1: send offloaded, 2: receive offloaded)
+	u32 ktls;
+	//bytes exchanged with crypto done in kernel or in userspace since last request
+	u64 ktls_bytes, tls_bytes;
 #endif
 
 	void (*do_requests)(struct __gf_download_session *);
@@ -291,6 +355,9 @@ void dm_sess_sk_del(GF_DownloadSession *sess)
 {
 	if (sess->sock) {
 		GF_Socket *sock = sess->sock;
+		//socket may be watched by the pool thread, wait for the wait to be over
+		while (sess->pool_wait)
+			gf_sleep(0);
 		sess->sock = NULL;
 		GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[Downloader] closing socket\n"));
 		if (sess->sock_group) gf_sk_group_unregister(sess->sock_group, sock);
@@ -330,6 +397,15 @@ struct __gf_download_manager
 	Bool disable_http2;
 #endif
 
+	//protects hosts, idle connections and pool threads
+	GF_Mutex *pool_mx;
+	GF_List *hosts;
+	GF_List *idle_conns;
+	GF_List *workers;
+	u32 pool_size;
+	//max number of idle connections kept for reuse, 0 disables connection reuse across sessions
+	u32 max_idle_conns;
+
 	Bool (*local_cache_url_provider_cbk)(void *udta, char *url, Bool cache_destroy);
 	void *lc_udta;
 };
@@ -1265,6 +1341,92 @@ GF_UserCredentials * gf_user_credentials_register(GF_DownloadManager * dm, Bool
 	return creds;
 }
 
+static GF_DMHost *gf_dm_get_host(GF_DownloadManager *dm, const char *server, u16 port, Bool use_ssl)
+{
+	u32 i, count;
+	GF_DMHost *host;
+	if (!dm || !server) return NULL;
+
+	gf_mx_p(dm->pool_mx);
+	count = gf_list_count(dm->hosts);
+	for (i=0; i<count; i++) {
+		host = gf_list_get(dm->hosts, i);
+		if ((host->port==port) && (host->use_ssl==use_ssl) && !strcmp(host->server, server)) {
+			gf_mx_v(dm->pool_mx);
+			return host;
+		}
+	}
+	GF_SAFEALLOC(host, GF_DMHost);
+	if (host) {
+		host->server = gf_strdup(server);
+		host->port = port;
+		host->use_ssl = use_ssl;
+		host->dm = dm;
+		gf_list_add(dm->hosts, host);
+	}
+	gf_mx_v(dm->pool_mx);
+	return host;
+}
+
+static void gf_dm_idle_conn_del(GF_DMIdleConn *conn)
+{
+#ifdef GPAC_HAS_SSL
+	if (conn->ssl) {
+		SSL_shutdown(conn->ssl);
+		SSL_free(conn->ssl);
+	}
+#endif
+	gf_sk_del(conn->sock);
+	gf_free(conn);
+}
+
+/*moves the connection of a session done with its host to the idle pool, so that the next session targeting the same host skips TCP and TLS setup*/
+static Bool gf_dm_sess_park_connection(GF_DownloadSession *sess)
+{
+	GF_DMIdleConn *conn;
+	GF_DownloadManager *dm = sess->dm;
+
+	if (!dm || !dm->max_idle_conns || !sess->sock || !sess->host || sess->server_mode || sess->netcap_id || (sess->proxy_enabled==1))
+		return GF_FALSE;
+	if (!(sess->flags & GF_NETIO_SESSION_PERSISTENT) || sess->connection_close)
+		return GF_FALSE;
+	if ((sess->status != GF_NETIO_DISCONNECTED) && (sess->status != GF_NETIO_DATA_TRANSFERED))
+		return GF_FALSE;
+	if ((sess->last_error<0) || sess->remaining_data_size || sess->pool_wait)
+		return GF_FALSE;
+#ifdef GPAC_HAS_HTTP2
+	if (sess->h2_sess) return GF_FALSE;
+#endif
+#ifdef GPAC_HAS_SSL
+	if (sess->ssl && SSL_pending(sess->ssl)) return GF_FALSE;
+#endif
+
+	GF_SAFEALLOC(conn, GF_DMIdleConn);
+	if (!conn) return GF_FALSE;
+	if (sess->sock_group) gf_sk_group_unregister(sess->sock_group, sess->sock);
+	conn->host = sess->host;
+	conn->sock = sess->sock;
+	sess->sock = NULL;
+#ifdef GPAC_HAS_SSL
+	conn->ssl = sess->ssl;
+	sess->ssl = NULL;
+#endif
+	conn->idle_since = gf_sys_clock_high_res();
+	conn->timeout_ms = GF_DM_IDLE_CONN_TIMEOUT;
+	if (sess->connection_timeout_ms && (sess->connection_timeout_ms < conn->timeout_ms))
+		conn->timeout_ms = sess->connection_timeout_ms;
+
+	gf_mx_p(dm->pool_mx);
+	if (gf_list_count(dm->idle_conns) >= dm->max_idle_conns) {
+		GF_DMIdleConn *old = gf_list_pop_front(dm->idle_conns);
+		gf_dm_idle_conn_del(old);
+	}
+	gf_list_add(dm->idle_conns, conn);
+	gf_mx_v(dm->pool_mx);
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTP] Keeping idle connection to %s:%d for reuse\n", conn->host->server, conn->host->port));
+	return GF_TRUE;
+}
+
 #ifdef GPAC_HAS_SSL
 
 static Bool _ssl_is_initialized = GF_FALSE;
@@ -1430,6 +1592,18 @@ static void ssl_on_log(int write_p, int version, int content_type, const void *b
 }
 #endif //GPAC_DISABLE_LOG
 
+//new TLS session negotiated by the server, keep it for resumption on next connection to this host
+static int gf_dm_ssl_new_session(SSL *ssl, SSL_SESSION *ssl_sess)
+{
+	GF_DMHost *host = SSL_get_app_data(ssl);
+	if (!host) return 0;
+	gf_mx_p(host->dm->pool_mx);
+	if (host->ssl_sess) SSL_SESSION_free(host->ssl_sess);
+	host->ssl_sess = ssl_sess;
+	gf_mx_v(host->dm->pool_mx);
+	return 1;
+}
+
 void *gf_dm_ssl_init(GF_DownloadManager *dm, u32 mode)
 {
 #if OPENSSL_VERSION_NUMBER > 0x00909000
@@ -1479,6 +1653,10 @@ void *gf_dm_ssl_init(GF_DownloadManager *dm, u32 mode)
 	dm->ssl_ctx = SSL_CTX_new(meth);
 	if (!dm->ssl_ctx) goto error;
 	SSL_CTX_set_options(dm->ssl_ctx, SSL_OP_ALL);
+#ifdef GPAC_HAS_KTLS
+	if (gf_opts_get_bool("core", "ktls"))
+		SSL_CTX_set_options(dm->ssl_ctx, SSL_OP_ENABLE_KTLS);
+#endif
 //	SSL_CTX_set_max_proto_version(dm->ssl_ctx, 0);
 
 	SSL_CTX_set_default_verify_paths(dm->ssl_ctx);
@@ -1489,6 +1667,10 @@ void *gf_dm_ssl_init(GF_DownloadManager *dm, u32 mode)
 	 than examining the error stack after a failed SSL_connect.  */
 	SSL_CTX_set_verify(dm->ssl_ctx, SSL_VERIFY_NONE, NULL);
 
+	/*client-side session cache, sessions are stored per host and resumed on next connection*/
+	SSL_CTX_set_session_cache_mode(dm->ssl_ctx, SSL_SESS_CACHE_CLIENT|SSL_SESS_CACHE_NO_INTERNAL_STORE);
+	SSL_CTX_sess_set_new_cb(dm->ssl_ctx, gf_dm_ssl_new_session);
+
 #ifndef GPAC_DISABLE_LOG
 	if (gf_log_tool_level_on(GF_LOG_NETWORK, GF_LOG_DEBUG) ) {
 		SSL_CTX_set_msg_callback(dm->ssl_ctx, ssl_on_log);
@@ -1561,6 +1743,10 @@ void *gf_ssl_server_context_new(const char *cert, const char *key)
 		return NULL;
     }
     SSL_CTX_set_ecdh_auto(ctx, 1);
+#ifdef GPAC_HAS_KTLS
+	if (gf_opts_get_bool("core", "ktls"))
+		SSL_CTX_set_options(ctx, SSL_OP_ENABLE_KTLS);
+#endif
 	if (SSL_CTX_use_certificate_file(ctx, cert, SSL_FILETYPE_PEM) <= 0) {
 		ERR_print_errors_fp(stderr);
 		SSL_CTX_free(ctx);
@@ -1638,6 +1824,20 @@ void gf_ssl_del(void *ssl)
 	if (ssl) SSL_free(ssl);
 }
 
+//check if record layer was offloaded to the kernel after handshake
+static void gf_ssl_check_ktls(GF_DownloadSession *sess)
+{
+	sess->ktls = 0;
+#ifdef GPAC_HAS_KTLS
+	if (!sess->ssl) return;
+	if (BIO_get_ktls_send(SSL_get_wbio(sess->ssl))) sess->ktls |= 1;
+	if (BIO_get_ktls_recv(SSL_get_rbio(sess->ssl))) sess->ktls |= 2;
+	if (gf_opts_get_bool("core", "ktls")) {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[SSL] kTLS send %s receive %s\n", (sess->ktls & 1) ? "enabled" : "disabled", (sess->ktls & 2) ? "enabled" : "disabled"));
+	}
+#endif
+}
+
 static GF_Err gf_ssl_write(GF_DownloadSession *sess, const u8 *buffer, u32 size, u32 *written)
 {
 	u32 idx=0;
@@ -1651,6 +1851,10 @@ static GF_Err gf_ssl_write(GF_DownloadSession *sess, const u8 *buffer, u32 size,
 		len = SSL_write(sess->ssl, buffer + idx*16000, to_write);
 		nb_tls_blocks--;
 		idx++;
+		if ((s32) len > 0) {
+			if (sess->ktls & 1) sess->ktls_bytes += len;
+			else sess->tls_bytes += len;
+		}
 
 		if (len != to_write) {
 			if (sess->flags & GF_NETIO_SESSION_NO_BLOCK) {
@@ -2267,10 +2471,20 @@ void gf_dm_sess_del(GF_DownloadSession *sess)
 
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[Downloader] Destroy session URL %s\n", sess->orig_url));
 	/*self-destruction, let the download manager destroy us*/
-	if ((sess->th || sess->ftask) && sess->in_callback) {
+	if ((sess->th || sess->ftask || sess->worker) && sess->in_callback) {
 		sess->destroy = GF_TRUE;
 		return;
 	}
+	/*if in pool, remove from pool thread - this waits for the session to be processed*/
+	if (sess->worker) {
+		gf_mx_p(sess->worker->mx);
+		gf_list_del_item(sess->worker->sessions, sess);
+		gf_mx_v(sess->worker->mx);
+	}
+	/*keep connection alive for other sessions if possible*/
+	if (!sess->th)
+		gf_dm_sess_park_connection(sess);
+
 	gf_dm_disconnect(sess, HTTP_CLOSE);
 	gf_dm_sess_clear_headers(sess);
 
@@ -2616,6 +2830,7 @@ GF_EXPORT
 GF_Err gf_dm_sess_setup_from_url(GF_DownloadSession *sess, const char *url, Bool allow_direct_reuse)
 {
 	Bool socket_changed = GF_FALSE;
+	Bool keep_alive_ok;
 	GF_URL_Info info;
 	Bool free_proto = GF_FALSE;
 	char *sep_frag=NULL;
@@ -2638,6 +2853,8 @@ GF_Err gf_dm_sess_setup_from_url(GF_DownloadSession *sess, const char *url, Bool
 			socket_changed = GF_TRUE;
 		}
 	}
+	//connection still valid, may be kept for other sessions if we move to another host
+	keep_alive_ok = socket_changed ? GF_FALSE : GF_TRUE;
 
 	gf_fatal_assert(sess->status != GF_NETIO_WAIT_FOR_REPLY);
 	gf_fatal_assert(sess->status != GF_NETIO_DATA_EXCHANGE);
@@ -2749,7 +2966,11 @@ GF_Err gf_dm_sess_setup_from_url(GF_DownloadSession *sess, const char *url, Bool
 		sess->num_retry = SESSION_RETRY_COUNT;
 		sess->start_time = 0;
 		sess->needs_cache_reconfig = 1;
+		if (sess->host) safe_int_inc(&sess->host->nb_reused);
 	} else {
+		if (keep_alive_ok)
+			gf_dm_sess_park_connection(sess);
+		sess->host = NULL;
 
 #ifdef GPAC_HAS_HTTP2
 		if (sess->h2_sess) {
@@ -2891,6 +3112,177 @@ static u32 gf_dm_session_thread(void *par)
 		gf_dm_sess_del(sess);
 	return 1;
 }
+
+//check if session is only waiting for data on its socket
+static Bool gf_dm_sess_can_wait(GF_DownloadSession *sess)
+{
+	if (!sess->sock || sess->sock_group || sess->put_state || sess->remaining_data_size) return GF_FALSE;
+	if ((sess->status != GF_NETIO_WAIT_FOR_REPLY) && (sess->status != GF_NETIO_DATA_EXCHANGE)) return GF_FALSE;
+	if (sess->last_error != GF_IP_NETWORK_EMPTY) return GF_FALSE;
+#ifdef GPAC_HAS_HTTP2
+	//socket shared with other sessions
+	if (sess->h2_sess) return GF_FALSE;
+#endif
+#ifdef GPAC_HAS_SSL
+	if (sess->ssl && SSL_pending(sess->ssl)) return GF_FALSE;
+#endif
+	return GF_TRUE;
+}
+
+static u32 gf_dm_worker_run(void *par)
+{
+	GF_DMWorker *w = (GF_DMWorker *)par;
+
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_CORE, ("[Downloader] Entering pool thread ID %d\n", gf_th_id() ));
+	while (w->run) {
+		GF_DownloadSession *sess;
+		u32 i, count;
+		Bool can_wait = GF_TRUE;
+
+		gf_mx_p(w->mx);
+		i = 0;
+		while ((sess = gf_list_get(w->sessions, i))) {
+			s32 idx;
+			Bool ret = gf_dm_session_do_task(sess);
+			//other sessions may have been removed from callbacks
+			idx = gf_list_find(w->sessions, sess);
+			if (idx<0) continue;
+			i = (u32) idx;
+			if (!ret) {
+				gf_list_rem(w->sessions, i);
+				if (sess->destroy)
+					gf_dm_sess_del(sess);
+				continue;
+			}
+			i++;
+		}
+		count = gf_list_count(w->sessions);
+
+		/*if all sessions are waiting for data, wait on their sockets. Session mutexes are only tried: a session being
+		aborted or destroyed from another thread is not waited on and prevents the wait*/
+		for (i=0; i<count; i++) {
+			sess = gf_list_get(w->sessions, i);
+			if (!gf_mx_try_lock(sess->mx)) {
+				can_wait = GF_FALSE;
+				break;
+			}
+			if (gf_dm_sess_can_wait(sess)) {
+				sess->pool_wait = GF_TRUE;
+				gf_list_add(w->waiting, sess);
+				gf_sk_group_register(w->sg, sess->sock);
+			} else {
+				can_wait = GF_FALSE;
+			}
+			gf_mx_v(sess->mx);
+			if (!can_wait) break;
+		}
+		gf_mx_v(w->mx);
+
+		if (can_wait && count && w->sg) {
+			gf_sk_group_select(w->sg, GF_DM_POOL_WAIT_US, GF_SK_SELECT_READ);
+		}
+		/*sockets may be destroyed as soon as the wait flag is reset (dm_sess_sk_del waits for it with the session mutex held,
+		so the mutex cannot be taken here): unregister them before resetting the flag, in reverse order of registration*/
+		while (gf_list_count(w->waiting)) {
+			sess = gf_list_pop_back(w->waiting);
+			gf_sk_group_unregister(w->sg, sess->sock);
+			sess->pool_wait = GF_FALSE;
+		}
+
+		if (!count) {
+			gf_sema_wait_for(w->sema, 1000);
+		} else if (!can_wait) {
+			gf_sleep(0);
+		}
+	}
+	return 1;
+}
+
+static void gf_dm_worker_del(GF_DMWorker *w)
+{
+	w->run = GF_FALSE;
+	if (w->sema) gf_sema_notify(w->sema, 1);
+	if (w->th) {
+		gf_th_stop(w->th);
+		gf_th_del(w->th);
+	}
+	//pending sessions are destroyed by the download manager
+	gf_list_del(w->sessions);
+	gf_list_del(w->waiting);
+	if (w->sema) gf_sema_del(w->sema);
+	if (w->sg) gf_sk_group_del(w->sg);
+	if (w->mx) gf_mx_del(w->mx);
+	gf_free(w);
+}
+
+static GF_DMWorker *gf_dm_worker_new(GF_DownloadManager *dm)
+{
+	GF_DMWorker *w;
+	GF_SAFEALLOC(w, GF_DMWorker);
+	if (!w) return NULL;
+	w->dm = dm;
+	w->mx = gf_mx_new("DownloadPool");
+	w->sessions = gf_list_new();
+	w->waiting = gf_list_new();
+	w->sema = gf_sema_new(0xFFFF, 0);
+	w->sg = gf_sk_group_new();
+	w->th = gf_th_new("DownloadPool");
+	w->run = GF_TRUE;
+	if (!w->mx || !w->sessions || !w->waiting || !w->sema || !w->sg || !w->th
+		|| (gf_th_run(w->th, gf_dm_worker_run, w) != GF_OK)
+	) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[Downloader] Failed to create download pool thread\n"));
+		gf_dm_worker_del(w);
+		return NULL;
+	}
+	return w;
+}
+
+/*assigns a session to the least loaded pool thread, creating a new thread if all are busy and max pool size is not reached*/
+static GF_Err gf_dm_pool_add_session(GF_DownloadSession *sess)
+{
+	u32 i, count, min_load=0;
+	GF_DMWorker *w = NULL;
+	GF_DownloadManager *dm = sess->dm;
+
+	if (sess->worker) {
+		Bool started;
+		gf_mx_p(sess->worker->mx);
+		started = (gf_list_find(sess->worker->sessions, sess)>=0) ? GF_TRUE : GF_FALSE;
+		gf_mx_v(sess->worker->mx);
+		if (started) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_HTTP, ("[HTTP] Session already started - ignoring start\n"));
+			return GF_OK;
+		}
+	}
+
+	gf_mx_p(dm->pool_mx);
+	count = gf_list_count(dm->workers);
+	for (i=0; i<count; i++) {
+		GF_DMWorker *a_w = gf_list_get(dm->workers, i);
+		u32 load = gf_list_count(a_w->sessions);
+		if (!w || (load < min_load)) {
+			w = a_w;
+			min_load = load;
+		}
+	}
+	if ((!w || min_load) && (count < dm->pool_size)) {
+		GF_DMWorker *new_w = gf_dm_worker_new(dm);
+		if (new_w) {
+			gf_list_add(dm->workers, new_w);
+			w = new_w;
+		}
+	}
+	gf_mx_v(dm->pool_mx);
+	if (!w) return GF_OUT_OF_MEM;
+
+	gf_mx_p(w->mx);
+	sess->worker = w;
+	gf_list_add(w->sessions, sess);
+	gf_mx_v(w->mx);
+	gf_sema_notify(w->sema, 1);
+	return GF_OK;
+}
 #endif
 
 static GF_DownloadSession *gf_dm_sess_new_internal(GF_DownloadManager * dm, const char *url, u32 dl_flags,
@@ -2995,6 +3387,7 @@ GF_DownloadSession *gf_dm_sess_new_server(GF_DownloadManager *dm, GF_Socket *ser
 		sess->ssl = ssl_sock_ctx;
 		if (ssl_sock_ctx && (sess->flags & GF_NETIO_SESSION_NO_BLOCK))
 			SSL_set_mode(sess->ssl, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER|SSL_MODE_ENABLE_PARTIAL_WRITE);
+		gf_ssl_check_ktls(sess);
 
 #if defined(GPAC_HAS_HTTP2)
 		if (h2_negotiated) {
@@ -3020,6 +3413,7 @@ GF_DownloadSession *gf_dm_sess_new_subsession(GF_DownloadSession *sess, u32 stre
 	gf_list_add(sess->h2_sess->sessions, sub_sess);
 #ifdef GPAC_HAS_SSL
 	sub_sess->ssl = sess->ssl;
+	sub_sess->ktls = sess->ktls;
 #endif
 	sub_sess->h2_sess = sess->h2_sess;
 	if (sub_sess->mx) gf_mx_del(sub_sess->mx);
@@ -3055,6 +3449,9 @@ void gf_dm_sess_server_reset(GF_DownloadSession *sess)
 	sess->chunk_bytes = 0;
 	sess->chunk_header_bytes = 0;
 	sess->chunked = GF_FALSE;
+#ifdef GPAC_HAS_SSL
+	sess->ktls_bytes = sess->tls_bytes = 0;
+#endif
 	sess->status = GF_NETIO_CONNECTED;
 }
 
@@ -3154,6 +3551,8 @@ static GF_Err gf_dm_read_data(GF_DownloadSession *sess, char *data, u32 data_siz
 			e = GF_OK;
 			data[size] = 0;
 			*out_read = size;
+			if (sess->ktls & 2) sess->ktls_bytes += size;
+			else sess->tls_bytes += size;
 		}
 	} else
 #endif
@@ -3313,6 +3712,75 @@ Bool gf_ssl_check_cert(SSL *ssl, const char *server_name)
 
 #endif
 
+/*attaches an idle connection to the same host to the session, if any*/
+static Bool gf_dm_sess_reuse_connection(GF_DownloadSession *sess)
+{
+	u32 i, count;
+	u64 now;
+	GF_DMIdleConn *conn = NULL;
+	GF_DownloadManager *dm = sess->dm;
+	Bool use_ssl = (sess->flags & (GF_DOWNLOAD_SESSION_USE_SSL|GF_DOWNLOAD_SESSION_SSL_FORCED)) ? GF_TRUE : GF_FALSE;
+
+	if (!dm || !sess->server_name || sess->server_mode || sess->netcap_id || sess->connect_pending) return GF_FALSE;
+	if (sess->proxy_enabled==1) return GF_FALSE;
+	if (!sess->proxy_enabled && gf_opts_get_bool("core", "proxy-on")) return GF_FALSE;
+	if (!gf_list_count(dm->idle_conns)) return GF_FALSE;
+
+	now = gf_sys_clock_high_res();
+	gf_mx_p(dm->pool_mx);
+	count = gf_list_count(dm->idle_conns);
+	for (i=0; i<count; i++) {
+		GF_DMIdleConn *a_conn = gf_list_get(dm->idle_conns, i);
+		Bool is_dead = ((now - a_conn->idle_since) / 1000 >= a_conn->timeout_ms) ? GF_TRUE : GF_FALSE;
+
+		if (!is_dead) {
+			if ((a_conn->host->port != sess->port) || (a_conn->host->use_ssl != use_ssl) || strcmp(a_conn->host->server, sess->server_name))
+				continue;
+			//probe returns no data on a live idle connection
+			if (gf_sk_probe(a_conn->sock) != GF_IP_NETWORK_EMPTY)
+				is_dead = GF_TRUE;
+		}
+		gf_list_rem(dm->idle_conns, i);
+		i--;
+		count--;
+		if (is_dead) {
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTP] Closing idle connection to %s:%d\n", a_conn->host->server, a_conn->host->port));
+			gf_dm_idle_conn_del(a_conn);
+			continue;
+		}
+		conn = a_conn;
+		break;
+	}
+	gf_mx_v(dm->pool_mx);
+	if (!conn) return GF_FALSE;
+
+	sess->sock = conn->sock;
+	sess->host = conn->host;
+#ifdef GPAC_HAS_SSL
+	sess->ssl = conn->ssl;
+	if (sess->ssl) {
+#ifdef GPAC_HAS_HTTP2
+		//h2 was not negotiated on this connection
+		sess->h2_upgrade_state = 4;
+#endif
+		gf_ssl_check_ktls(sess);
+	}
+#endif
+	gf_free(conn);
+	gf_sk_set_block_mode(sess->sock, (sess->flags & GF_NETIO_SESSION_NO_BLOCK) ? GF_TRUE : GF_FALSE);
+	if (sess->sock_group) gf_sk_group_register(sess->sock_group, sess->sock);
+	safe_int_inc(&sess->host->nb_reused);
+
+	GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[HTTP] Reusing idle connection to %s:%d for URL %s\n", sess->server_name, sess->port, sess->remote_path ? sess->remote_path : "undefined"));
+	sess->connect_time = 0;
+	sess->ssl_setup_time = 0;
+	sess->status = GF_NETIO_CONNECTED;
+	SET_LAST_ERR(GF_OK)
+	gf_dm_sess_notify_state(sess, GF_NETIO_CONNECTED, GF_OK);
+	gf_dm_configure_cache(sess);
+	return GF_TRUE;
+}
+
 static void gf_dm_connect(GF_DownloadSession *sess)
 {
 	GF_Err e;
@@ -3397,6 +3865,8 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 #ifdef GPAC_HAS_SSL
 			sess->ssl = a_sess->ssl;
 #endif
+			sess->host = a_sess->host;
+			if (sess->host) safe_int_inc(&sess->host->nb_reused);
 			sess->data_io.read_callback = h2_data_source_read_callback;
 			sess->data_io.source.ptr = sess;
 			gf_list_add(sess->h2_sess->sessions, sess);
@@ -3415,6 +3885,9 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 	}
 #endif
 
+	if (!sess->sock && gf_dm_sess_reuse_connection(sess))
+		return;
+
 	Bool register_sock = GF_FALSE;
 	if (!sess->sock) {
 		sess->sock = gf_sk_new_ex(GF_SOCK_TYPE_TCP, sess->netcap_id);
@@ -3525,6 +3998,8 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 			return;
 		}
 		if (register_sock) gf_sk_group_register(sess->sock_group, sess->sock);
+		sess->host = gf_dm_get_host(sess->dm, sess->server_name, sess->port, (sess->flags & (GF_DOWNLOAD_SESSION_USE_SSL|GF_DOWNLOAD_SESSION_SSL_FORCED)) ? GF_TRUE : GF_FALSE);
+		if (sess->host) safe_int_inc(&sess->host->nb_connections);
 		if (sess->allow_direct_reuse) {
 			gf_dm_configure_cache(sess);
 			if (sess->from_cache_only) return;
@@ -3555,6 +4030,13 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 				SSL_set_fd(sess->ssl, gf_sk_get_handle(sess->sock));
 				SSL_ctrl(sess->ssl, SSL_CTRL_SET_TLSEXT_HOSTNAME, TLSEXT_NAMETYPE_host_name, (void*) proxy);
 				SSL_set_connect_state(sess->ssl);
+				//resume previous TLS session with this host if any
+				if (sess->host) {
+					SSL_set_app_data(sess->ssl, sess->host);
+					gf_mx_p(sess->dm->pool_mx);
+					if (sess->host->ssl_sess) SSL_set_session(sess->ssl, sess->host->ssl_sess);
+					gf_mx_v(sess->dm->pool_mx);
+				}
 
 				if (sess->flags & GF_NETIO_SESSION_NO_BLOCK)
 					SSL_set_mode(sess->ssl, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER|SSL_MODE_ENABLE_PARTIAL_WRITE);
@@ -3610,7 +4092,12 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 					SET_LAST_ERR(GF_REMOTE_SERVICE_ERROR)
 				}
 			} else {
-				GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[SSL] connected\n"));
+				GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[SSL] connected%s\n", SSL_session_reused(sess->ssl) ? " - session resumed" : ""));
+				gf_ssl_check_ktls(sess);
+				if (sess->host) {
+					safe_int_inc(&sess->host->nb_handshakes);
+					if (SSL_session_reused(sess->ssl)) safe_int_inc(&sess->host->nb_resumed);
+				}
 
 
 #ifdef GPAC_HAS_HTTP2
@@ -3808,6 +4295,9 @@ GF_Err gf_dm_sess_process(GF_DownloadSession *sess)
 			gf_fs_post_user_task(sess->dm->filter_session, gf_dm_session_task, sess->ftask, "download");
 			return GF_OK;
 		}
+		if (sess->dm->pool_size) {
+			return gf_dm_pool_add_session(sess);
+		}
 		if (sess->th) {
 			GF_LOG(GF_LOG_WARNING, GF_LOG_HTTP, ("[HTTP] Session already started - ignoring start\n"));
 			return GF_OK;
@@ -3987,6 +4477,14 @@ GF_DownloadManager *gf_dm_new(GF_FilterSession *fsess)
 	dm->partial_downloads = gf_list_new();
 	dm->cache_mx = gf_mx_new("download_manager_cache_mx");
 	dm->filter_session = fsess;
+	dm->pool_mx = gf_mx_new("download_manager_pool_mx");
+	dm->hosts = gf_list_new();
+	dm->idle_conns = gf_list_new();
+	dm->workers = gf_list_new();
+#ifndef GPAC_DISABLE_THREADS
+	dm->pool_size = gf_opts_get_int("core", "dm-pool");
+#endif
+	dm->max_idle_conns = gf_opts_get_int("core", "dm-idle");
 	default_cache_dir = NULL;
 	gf_mx_p( dm->cache_mx );
 
@@ -4082,10 +4580,28 @@ void gf_dm_set_auth_callback(GF_DownloadManager *dm, gf_dm_get_usr_pass get_user
 GF_EXPORT
 void gf_dm_del(GF_DownloadManager *dm)
 {
+	u32 i;
 	if (!dm)
 		return;
 	gf_assert( dm->sessions);
 	gf_assert( dm->cache_mx );
+
+	/*stop pool threads before destroying sessions*/
+#ifndef GPAC_DISABLE_THREADS
+	while (gf_list_count(dm->workers)) {
+		GF_DMWorker *w = gf_list_pop_back(dm->workers);
+		gf_dm_worker_del(w);
+	}
+#endif
+	gf_mx_p( dm->cache_mx );
+	for (i=0; i<gf_list_count(dm->sessions); i++) {
+		GF_DownloadSession *sess = gf_list_get(dm->sessions, i);
+		sess->worker = NULL;
+	}
+	gf_mx_v( dm->cache_mx );
+	gf_list_del(dm->workers);
+	dm->workers = NULL;
+
 	gf_mx_p( dm->cache_mx );
 
 	while (gf_list_count(dm->partial_downloads)) {
@@ -4146,6 +4662,28 @@ void gf_dm_del(GF_DownloadManager *dm)
 		gf_free(dm->cache_directory);
 	dm->cache_directory = NULL;
 
+	while (gf_list_count(dm->idle_conns)) {
+		GF_DMIdleConn *conn = gf_list_pop_back(dm->idle_conns);
+		gf_dm_idle_conn_del(conn);
+	}
+	gf_list_del(dm->idle_conns);
+	dm->idle_conns = NULL;
+	while (gf_list_count(dm->hosts)) {
+		GF_DMHost *host = gf_list_pop_front(dm->hosts);
+		if (host->nb_connections || host->nb_reused) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[HTTP] Host %s:%d: %d connections opened, %d requests on reused connections, %d TLS handshakes (%d resumed)\n",
+				host->server, host->port, host->nb_connections, host->nb_reused, host->nb_handshakes, host->nb_resumed));
+		}
+#ifdef GPAC_HAS_SSL
+		if (host->ssl_sess) SSL_SESSION_free(host->ssl_sess);
+#endif
+		gf_free(host->server);
+		gf_free(host);
+	}
+	gf_list_del(dm->hosts);
+	dm->hosts = NULL;
+	gf_mx_del(dm->pool_mx);
+
 #ifdef GPAC_HAS_SSL
 	if (dm->ssl_ctx) SSL_CTX_free(dm->ssl_ctx);
 #endif
@@ -4436,6 +4974,12 @@ static void gf_dm_data_received(GF_DownloadSession *sess, u8 *payload, u32 paylo
 
 		GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[HTTP] %s (%d bytes) downloaded in "LLU" us (%d kbps) (%d us since request - got response in %d us)\n", gf_file_basename(gf_cache_get_url(sess->cache_entry)), sess->bytes_done,
 		                                     run_time, 8*sess->bytes_per_sec/1000, sess->total_time_since_req, sess->reply_time));
+#ifdef GPAC_HAS_SSL
+		if (sess->ktls_bytes || sess->tls_bytes) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_HTTP, ("[HTTP] %s TLS traffic: "LLU" bytes kTLS - "LLU" bytes userspace\n", sess->orig_url, sess->ktls_bytes, sess->tls_bytes));
+			sess->ktls_bytes = sess->tls_bytes = 0;
+		}
+#endif
 
 		if (sess->chunked && (payload_size==2))
 			payload_size=0;
@@ -4549,7 +5093,7 @@ GF_Err gf_dm_sess_fetch_data(GF_DownloadSession *sess, char *buffer, u32 buffer_
 		}
 		return GF_BAD_PARAM;
 	}
-	if (sess->th)
+	if (sess->th || sess->worker)
 		return GF_BAD_PARAM;
 	if (sess->status == GF_NETIO_DISCONNECTED) {
 		if (!sess->init_data_size)
@@ -6752,7 +7296,7 @@ const char * gf_cache_get_cache_filename_range( const GF_DownloadSession * sess,
 GF_Err gf_dm_sess_reassign(GF_DownloadSession *sess, u32 flags, gf_dm_user_io user_io, void *cbk)
 {
 	/*shall only be called for non-threaded sessions!! */
-	if (sess->th)
+	if (sess->th || sess->worker)
 		return GF_BAD_PARAM;
 
 	if (flags == 0xFFFFFFFF) {
@@ -6838,6 +7382,25 @@ u32 gf_dm_get_global_rate(GF_DownloadManager *dm)
 	return 8*ret;
 }
 
+GF_EXPORT
+GF_Err gf_dm_get_host_stats(GF_DownloadManager *dm, u32 idx, const char **server, u16 *port, u32 *nb_connections, u32 *nb_reused, u32 *nb_handshakes, u32 *nb_resumed)
+{
+	GF_DMHost *host;
+	if (!dm) return GF_BAD_PARAM;
+	gf_mx_p(dm->pool_mx);
+	host = gf_list_get(dm->hosts, idx);
+	if (host) {
+		if (server) *server = host->server;
+		if (port) *port = host->port;
+		if (nb_connections) *nb_connections = host->nb_connections;
+		if (nb_reused) *nb_reused = host->nb_reused;
+		if (nb_handshakes) *nb_handshakes = host->nb_handshakes;
+		if (nb_resumed) *nb_resumed = host->nb_resumed;
+	}
+	gf_mx_v(dm->pool_mx);
+	return host ? GF_OK : GF_EOS;
+}
+
 Bool gf_dm_sess_is_h2(GF_DownloadSession *sess)
 {
 #ifdef GPAC_HAS_HTTP2
@@ -7171,6 +7734,55 @@ void gf_dm_sess_flush_h2(GF_DownloadSession *sess)
 #endif
 }
 
+GF_Err gf_dm_sess_send_file(GF_DownloadSession *sess, FILE *file, u64 offset, u32 size, u32 *written)
+{
+	*written = 0;
+#ifdef GPAC_HAS_KTLS
+	ossl_ssize_t res;
+	int fd;
+	//only for plain HTTP/1.1 over kTLS from regular files, with nothing pending
+	if (!sess || !sess->ssl || !(sess->ktls & 1) || !file || !size || sess->async_buf_size)
+		return GF_NOT_SUPPORTED;
+#ifdef GPAC_HAS_HTTP2
+	if (sess->h2_sess) return GF_NOT_SUPPORTED;
+#endif
+	if (gf_fileio_check(file)) return GF_NOT_SUPPORTED;
+	fd = fileno(file);
+	if (fd<0) return GF_NOT_SUPPORTED;
+
+	res = SSL_sendfile(sess->ssl, fd, (off_t) offset, size, 0);
+	//end of file reached (file being produced)
+	if (!res) return GF_IP_NETWORK_EMPTY;
+	if (res<0) {
+		int err = SSL_get_error(sess->ssl, (int) res);
+		if ((err==SSL_ERROR_WANT_READ) || (err==SSL_ERROR_WANT_WRITE))
+			return GF_IP_NETWORK_EMPTY;
+		if ((err==SSL_ERROR_ZERO_RETURN) || (err==SSL_ERROR_SYSCALL)) {
+			sess_connection_closed(sess);
+			sess->status = GF_NETIO_STATE_ERROR;
+			return GF_IP_CONNECTION_CLOSED;
+		}
+		GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[SSL] Cannot send file, error %d\n", err));
+		return GF_IP_NETWORK_FAILURE;
+	}
+	*written = (u32) res;
+	sess->ktls_bytes += res;
+	return GF_OK;
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
+void gf_dm_sess_get_tls_stats(GF_DownloadSession *sess, u64 *ktls_bytes, u64 *tls_bytes)
+{
+	*ktls_bytes = *tls_bytes = 0;
+#ifdef GPAC_HAS_SSL
+	if (!sess) return;
+	*ktls_bytes = sess->ktls_bytes;
+	*tls_bytes = sess->tls_bytes;
+#endif
+}
+
 GF_Socket *gf_dm_sess_get_socket(GF_DownloadSession *sess)
 {
 	return sess ? sess->sock : NULL;
@@ -7253,6 +7865,10 @@ u32 gf_dm_get_global_rate(GF_DownloadManager *dm)
 {
 	return 0;
 }
+GF_Err gf_dm_get_host_stats(GF_DownloadManager *dm, u32 idx, const char **server, u16 *port, u32 *nb_connections, u32 *nb_reused, u32 *nb_handshakes, u32 *nb_resumed)
+{
+	return GF_EOS;
+}
 void gf_dm_set_data_rate(GF_DownloadManager *dm, u32 rate_in_bits_per_sec)
 {
 }
@@ -1195,6 +1195,12 @@ static const char *gf_enabled_features()
 #ifdef GPAC_HAS_SOCK_UN
 	                       "GPAC_HAS_SOCK_UN "
 #endif
+#ifdef GPAC_HAS_IO_URING
+	                       "GPAC_HAS_IO_URING "
+#endif
+#ifdef GPAC_HAS_RECVMMSG
+	                       "GPAC_HAS_RECVMMSG "
+#endif
 #ifdef GPAC_ENABLE_COVERAGE
 	                       "GPAC_ENABLE_COVERAGE "
 #endif
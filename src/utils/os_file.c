@@ -1981,3 +1981,343 @@ char* gf_url_colon_suffix(const char *path, char assign_sep)
 	}
 	return sep;
 }
+
+
+#ifdef GPAC_HAS_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+
+//I/O blocks are aligned for O_DIRECT
+#define GF_AIO_ALIGN	4096
+
+enum
+{
+	GF_AIO_IDLE = 0,
+	GF_AIO_PENDING,
+	GF_AIO_DONE
+};
+
+typedef struct
+{
+	u8 *data;
+	u32 state;
+	Bool is_write;
+	s32 fd;
+	u64 offset;
+	u32 size, done;
+	GF_Err e;
+} GF_AIOBlock;
+
+struct __gf_async_io
+{
+	s32 ring_fd;
+	u32 nb_blocks, block_size;
+	u8 *mem;
+	GF_AIOBlock *blocks;
+	//blocks registered as fixed buffers
+	Bool fixed_bufs;
+
+	void *sq_ring, *cq_ring;
+	size_t sq_ring_size, cq_ring_size, sqes_size;
+	struct io_uring_sqe *sqes;
+	u32 *sq_tail, *sq_mask, *sq_array;
+	u32 *cq_head, *cq_tail, *cq_mask;
+	struct io_uring_cqe *cqes;
+	//number of entries in submission queue not yet submitted
+	u32 nb_queued;
+};
+
+GF_EXPORT
+GF_AsyncIO *gf_aio_new(u32 nb_blocks, u32 block_size)
+{
+	u32 i, stride;
+	s32 fd;
+	struct iovec *iov;
+	struct io_uring_params p;
+	GF_AsyncIO *aio;
+
+	if (!nb_blocks || !block_size) return NULL;
+
+	memset(&p, 0, sizeof(p));
+	fd = (s32) syscall(__NR_io_uring_setup, nb_blocks, &p);
+	if (fd<0) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[AIO] io_uring setup failed: %s\n", strerror(errno)));
+		return NULL;
+	}
+	GF_SAFEALLOC(aio, GF_AsyncIO);
+	if (!aio) {
+		close(fd);
+		return NULL;
+	}
+	aio->ring_fd = fd;
+	aio->nb_blocks = nb_blocks;
+	aio->block_size = block_size;
+	aio->sq_ring = aio->cq_ring = MAP_FAILED;
+	aio->sqes = MAP_FAILED;
+
+	aio->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(u32);
+	aio->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		if (aio->cq_ring_size > aio->sq_ring_size) aio->sq_ring_size = aio->cq_ring_size;
+		aio->cq_ring_size = 0;
+	}
+	aio->sq_ring = mmap(NULL, aio->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+	if (aio->sq_ring == MAP_FAILED) goto err_exit;
+	if (aio->cq_ring_size) {
+		aio->cq_ring = mmap(NULL, aio->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+		if (aio->cq_ring == MAP_FAILED) goto err_exit;
+	} else {
+		aio->cq_ring = aio->sq_ring;
+	}
+	aio->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+	aio->sqes = mmap(NULL, aio->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+	if (aio->sqes == MAP_FAILED) goto err_exit;
+
+	aio->sq_tail = (u32 *) ((u8 *) aio->sq_ring + p.sq_off.tail);
+	aio->sq_mask = (u32 *) ((u8 *) aio->sq_ring + p.sq_off.ring_mask);
+	aio->sq_array = (u32 *) ((u8 *) aio->sq_ring + p.sq_off.array);
+	aio->cq_head = (u32 *) ((u8 *) aio->cq_ring + p.cq_off.head);
+	aio->cq_tail = (u32 *) ((u8 *) aio->cq_ring + p.cq_off.tail);
+	aio->cq_mask = (u32 *) ((u8 *) aio->cq_ring + p.cq_off.ring_mask);
+	aio->cqes = (struct io_uring_cqe *) ((u8 *) aio->cq_ring + p.cq_off.cqes);
+
+	//one allocation for all blocks, each block starting on an aligned address
+	stride = block_size + GF_AIO_ALIGN - 1;
+	stride -= stride % GF_AIO_ALIGN;
+	aio->mem = gf_malloc((size_t) stride * nb_blocks + GF_AIO_ALIGN);
+	aio->blocks = gf_malloc(sizeof(GF_AIOBlock) * nb_blocks);
+	iov = gf_malloc(sizeof(struct iovec) * nb_blocks);
+	if (aio->blocks) memset(aio->blocks, 0, sizeof(GF_AIOBlock) * nb_blocks);
+	if (!aio->mem || !aio->blocks || !iov) {
+		if (iov) gf_free(iov);
+		goto err_exit;
+	}
+	for (i=0; i<nb_blocks; i++) {
+		u8 *start = aio->mem + (GF_AIO_ALIGN - ((size_t) aio->mem) % GF_AIO_ALIGN) % GF_AIO_ALIGN;
+		aio->blocks[i].data = start + (size_t) stride * i;
+		iov[i].iov_base = aio->blocks[i].data;
+		iov[i].iov_len = block_size;
+	}
+	//registered buffers avoid mapping pages for each operation, they may fail with low RLIMIT_MEMLOCK on older kernels
+	if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, iov, nb_blocks) == 0) {
+		aio->fixed_bufs = GF_TRUE;
+	} else {
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_MMIO, ("[AIO] Failed to register I/O buffers (%s), using regular buffers\n", strerror(errno)));
+	}
+	gf_free(iov);
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_MMIO, ("[AIO] io_uring engine created with %d blocks of %d bytes\n", nb_blocks, block_size));
+	return aio;
+
+err_exit:
+	GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[AIO] Failed to setup io_uring engine\n"));
+	gf_aio_del(aio);
+	return NULL;
+}
+
+static void gf_aio_push(GF_AsyncIO *aio, u32 idx)
+{
+	GF_AIOBlock *b = &aio->blocks[idx];
+	u32 tail = *aio->sq_tail;
+	u32 sidx = tail & *aio->sq_mask;
+	struct io_uring_sqe *sqe = &aio->sqes[sidx];
+
+	memset(sqe, 0, sizeof(struct io_uring_sqe));
+	if (aio->fixed_bufs) {
+		sqe->opcode = b->is_write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+		sqe->buf_index = idx;
+	} else {
+		sqe->opcode = b->is_write ? IORING_OP_WRITE : IORING_OP_READ;
+	}
+	sqe->fd = b->fd;
+	sqe->off = b->offset + b->done;
+	sqe->addr = (u64) (size_t) (b->data + b->done);
+	sqe->len = b->size - b->done;
+	sqe->user_data = idx;
+	aio->sq_array[sidx] = sidx;
+	//make entry visible to the kernel before the tail update
+	__atomic_store_n(aio->sq_tail, tail+1, __ATOMIC_RELEASE);
+	aio->nb_queued++;
+}
+
+static void gf_aio_reap(GF_AsyncIO *aio)
+{
+	u32 head = *aio->cq_head;
+	u32 tail = __atomic_load_n(aio->cq_tail, __ATOMIC_ACQUIRE);
+
+	while (head != tail) {
+		struct io_uring_cqe *cqe = &aio->cqes[head & *aio->cq_mask];
+		GF_AIOBlock *b = &aio->blocks[cqe->user_data];
+		s32 res = cqe->res;
+		head++;
+
+		if (res<0) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[AIO] %s error at offset "LLU": %s\n", b->is_write ? "Write" : "Read", b->offset + b->done, strerror(-res)));
+			b->e = GF_IO_ERR;
+			b->state = GF_AIO_DONE;
+			continue;
+		}
+		b->done += res;
+		//resume short writes
+		if (b->is_write && res && (b->done < b->size)) {
+			gf_aio_push(aio, (u32) cqe->user_data);
+			continue;
+		}
+		if (b->is_write && (b->done < b->size)) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[AIO] Write error, wrote %d bytes but had %d to write\n", b->done, b->size));
+			b->e = GF_IO_ERR;
+		}
+		b->state = GF_AIO_DONE;
+	}
+	__atomic_store_n(aio->cq_head, head, __ATOMIC_RELEASE);
+}
+
+GF_EXPORT
+void gf_aio_del(GF_AsyncIO *aio)
+{
+	u32 i;
+	if (!aio) return;
+	if (aio->blocks) {
+		for (i=0; i<aio->nb_blocks; i++)
+			gf_aio_wait(aio, i, GF_TRUE, NULL);
+		gf_free(aio->blocks);
+	}
+	if (aio->sqes != MAP_FAILED) munmap(aio->sqes, aio->sqes_size);
+	if ((aio->cq_ring != MAP_FAILED) && (aio->cq_ring != aio->sq_ring)) munmap(aio->cq_ring, aio->cq_ring_size);
+	if (aio->sq_ring != MAP_FAILED) munmap(aio->sq_ring, aio->sq_ring_size);
+	close(aio->ring_fd);
+	if (aio->mem) gf_free(aio->mem);
+	gf_free(aio);
+}
+
+GF_EXPORT
+u8 *gf_aio_block(GF_AsyncIO *aio, u32 idx)
+{
+	if (!aio || (idx >= aio->nb_blocks)) return NULL;
+	return aio->blocks[idx].data;
+}
+
+GF_EXPORT
+GF_Err gf_aio_queue(GF_AsyncIO *aio, u32 idx, s32 fd, Bool is_write, u64 offset, u32 size)
+{
+	GF_AIOBlock *b;
+	if (!aio || (idx >= aio->nb_blocks) || (size > aio->block_size)) return GF_BAD_PARAM;
+	b = &aio->blocks[idx];
+	if (b->state != GF_AIO_IDLE) return GF_BAD_PARAM;
+
+	b->fd = fd;
+	b->is_write = is_write;
+	b->offset = offset;
+	b->size = size;
+	b->done = 0;
+	b->e = GF_OK;
+	b->state = GF_AIO_PENDING;
+	gf_aio_push(aio, idx);
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_aio_submit(GF_AsyncIO *aio)
+{
+	if (!aio) return GF_BAD_PARAM;
+	while (aio->nb_queued) {
+		s32 res = (s32) syscall(__NR_io_uring_enter, aio->ring_fd, aio->nb_queued, 0, 0, NULL, 0);
+		if (res<0) {
+			u32 i, nb_pending = 0;
+			if (errno==EINTR) continue;
+			if ((errno!=EAGAIN) && (errno!=EBUSY)) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[AIO] Failed to submit I/O: %s\n", strerror(errno)));
+				return GF_IO_ERR;
+			}
+			//kernel out of resources or completion queue full, reap completions and wait for one before retrying
+			gf_aio_reap(aio);
+			for (i=0; i<aio->nb_blocks; i++) {
+				if (aio->blocks[i].state == GF_AIO_PENDING) nb_pending++;
+			}
+			//nothing in flight, waiting would block forever
+			if (nb_pending <= aio->nb_queued) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[AIO] Failed to submit I/O: %s\n", strerror(errno)));
+				return GF_IO_ERR;
+			}
+			if ((syscall(__NR_io_uring_enter, aio->ring_fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0) && (errno!=EINTR)) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[AIO] Failed to wait for I/O completion: %s\n", strerror(errno)));
+				return GF_IO_ERR;
+			}
+			continue;
+		}
+		//no entry consumed, retrying would spin forever
+		if (!res) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[AIO] Failed to submit I/O, no entry consumed\n"));
+			return GF_IO_ERR;
+		}
+		aio->nb_queued -= MIN((u32) res, aio->nb_queued);
+	}
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_aio_wait(GF_AsyncIO *aio, u32 idx, Bool blocking, u32 *done)
+{
+	GF_Err e;
+	GF_AIOBlock *b;
+	if (done) *done = 0;
+	if (!aio || (idx >= aio->nb_blocks)) return GF_BAD_PARAM;
+	b = &aio->blocks[idx];
+	if (b->state == GF_AIO_IDLE) return GF_OK;
+
+	while (1) {
+		e = gf_aio_submit(aio);
+		if (e) return e;
+		gf_aio_reap(aio);
+		if (b->state == GF_AIO_DONE) break;
+		//operation resumed while reaping, submit it
+		if (aio->nb_queued) continue;
+		if (!blocking) return GF_NOT_READY;
+
+		if (syscall(__NR_io_uring_enter, aio->ring_fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0) {
+			if (errno==EINTR) continue;
+			GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[AIO] Failed to wait for I/O completion: %s\n", strerror(errno)));
+			return GF_IO_ERR;
+		}
+	}
+	if (done) *done = b->done;
+	b->state = GF_AIO_IDLE;
+	return b->e;
+}
+
+#else
+
+GF_EXPORT
+GF_AsyncIO *gf_aio_new(u32 nb_blocks, u32 block_size)
+{
+	return NULL;
+}
+GF_EXPORT
+void gf_aio_del(GF_AsyncIO *aio)
+{
+}
+GF_EXPORT
+u8 *gf_aio_block(GF_AsyncIO *aio, u32 idx)
+{
+	return NULL;
+}
+GF_EXPORT
+GF_Err gf_aio_queue(GF_AsyncIO *aio, u32 idx, s32 fd, Bool is_write, u64 offset, u32 size)
+{
+	return GF_NOT_SUPPORTED;
+}
+GF_EXPORT
+GF_Err gf_aio_submit(GF_AsyncIO *aio)
+{
+	return GF_NOT_SUPPORTED;
+}
+GF_EXPORT
+GF_Err gf_aio_wait(GF_AsyncIO *aio, u32 idx, Bool blocking, u32 *done)
+{
+	if (done) *done = 0;
+	return GF_NOT_SUPPORTED;
+}
+
+#endif //GPAC_HAS_IO_URING
@@ -23,6 +23,9 @@
  *
  */
 
+#if defined(__GNUC__) && __GNUC__ >= 4 && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
 #include <gpac/network.h>
 
 #ifndef GPAC_DISABLE_NETWORK
@@ -373,6 +376,12 @@ static u32 ipv6_check_state = 0;
 #include <sys/un.h>
 #endif
 
+#ifdef GPAC_HAS_RECVMMSG
+#include <linux/net_tstamp.h>
+//max number of datagrams per recvmmsg call
+#define GF_SK_MAX_BATCH	64
+#endif
+
 /*internal flags*/
 enum
 {
@@ -385,6 +394,7 @@ enum
 	GF_SOCK_HAS_PEER = 1<<14,
 	GF_SOCK_IS_UN = 1<<15,
 	GF_SOCK_HAS_CONNECT = 1<<16,
+	GF_SOCK_RX_TIMESTAMP = 1<<17,
 };
 
 #ifndef GPAC_DISABLE_NETCAP
@@ -3853,6 +3863,122 @@ GF_Err gf_sk_receive_no_select(GF_Socket *sock, u8 *buffer, u32 length, u32 *Byt
 	return gf_sk_receive_internal(sock, buffer, length, BytesRead, GF_FALSE);
 }
 
+GF_EXPORT
+GF_Err gf_sk_enable_rx_timestamps(GF_Socket *sock)
+{
+	if (!sock || !sock->socket) return GF_BAD_PARAM;
+#ifdef GPAC_HAS_RECVMMSG
+	int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+	if (setsockopt(sock->socket, SOL_SOCKET, SO_TIMESTAMPING, (const void *) &flags, sizeof(flags)) == SOCKET_ERROR) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] cannot enable reception timestamps: %s\n", gf_errno_str(LASTSOCKERROR) ));
+		return GF_NOT_SUPPORTED;
+	}
+	sock->flags |= GF_SOCK_RX_TIMESTAMP;
+	return GF_OK;
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
+GF_EXPORT
+GF_Err gf_sk_receive_batch(GF_Socket *sock, u8 *buffer, u32 max_size, u32 *nb_pck, u32 *sizes, u64 *arrival_ntp)
+{
+	u32 i, max_pck;
+	if (!sock || !buffer || !nb_pck || !*nb_pck || !sizes) return GF_BAD_PARAM;
+	max_pck = *nb_pck;
+	*nb_pck = 0;
+
+#ifdef GPAC_HAS_RECVMMSG
+	//netcap record and playback work on single datagrams
+	if (sock->socket && !(sock->flags & GF_SOCK_IS_TCP)
+#ifndef GPAC_DISABLE_NETCAP
+		&& !sock->cap_info
+#endif
+	) {
+		struct mmsghdr msgs[GF_SK_MAX_BATCH];
+		struct iovec iovs[GF_SK_MAX_BATCH];
+		u8 ctrl[GF_SK_MAX_BATCH][CMSG_SPACE(sizeof(struct timespec)*3)];
+		s32 res;
+		u64 now = 0;
+		Bool use_ts = (arrival_ntp && (sock->flags & GF_SOCK_RX_TIMESTAMP)) ? GF_TRUE : GF_FALSE;
+
+		if (max_pck > GF_SK_MAX_BATCH) max_pck = GF_SK_MAX_BATCH;
+		memset(msgs, 0, sizeof(struct mmsghdr)*max_pck);
+		for (i=0; i<max_pck; i++) {
+			iovs[i].iov_base = buffer + i*max_size;
+			iovs[i].iov_len = max_size;
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+			if (sock->flags & GF_SOCK_HAS_PEER) {
+				msgs[i].msg_hdr.msg_name = &sock->dest_addr;
+				msgs[i].msg_hdr.msg_namelen = sizeof(sock->dest_addr);
+			}
+			if (use_ts) {
+				msgs[i].msg_hdr.msg_control = ctrl[i];
+				msgs[i].msg_hdr.msg_controllen = sizeof(ctrl[i]);
+			}
+		}
+		res = recvmmsg(sock->socket, msgs, max_pck, MSG_DONTWAIT, NULL);
+		if (res == SOCKET_ERROR) {
+			switch (LASTSOCKERROR) {
+			case EAGAIN:
+				return GF_IP_NETWORK_EMPTY;
+			case ENOTCONN:
+			case ECONNRESET:
+			case ECONNABORTED:
+				GF_LOG(GF_LOG_DEBUG, GF_LOG_NETWORK, ("[socket] error reading: %s\n", gf_errno_str(LASTSOCKERROR)));
+				return GF_IP_CONNECTION_CLOSED;
+			default:
+				GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[socket] error reading: %s\n", gf_errno_str(LASTSOCKERROR) ));
+				return GF_IP_NETWORK_FAILURE;
+			}
+		}
+		if (!res) return GF_IP_NETWORK_EMPTY;
+		if (sock->flags & GF_SOCK_HAS_PEER)
+			sock->dest_addr_len = msgs[res-1].msg_hdr.msg_namelen;
+
+		if (arrival_ntp) now = gf_net_get_ntp_ts();
+		for (i=0; i<(u32) res; i++) {
+			sizes[i] = msgs[i].msg_len;
+			if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] datagram larger than %u bytes, truncated\n", max_size));
+			}
+			if (!arrival_ntp) continue;
+			arrival_ntp[i] = now;
+			if (use_ts) {
+				struct cmsghdr *cmsg;
+				for (cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg; cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+					struct timespec ts[3], *t;
+					if ((cmsg->cmsg_level != SOL_SOCKET) || (cmsg->cmsg_type != SCM_TIMESTAMPING)) continue;
+					memcpy(ts, CMSG_DATA(cmsg), sizeof(ts));
+					//software timestamp, or raw hardware one if only NIC timestamping is active
+					t = ts[0].tv_sec ? &ts[0] : &ts[2];
+					if (!t->tv_sec) break;
+					arrival_ntp[i] = ((u64) (t->tv_sec + GF_NTP_SEC_1900_TO_1970)) << 32;
+					arrival_ntp[i] |= (u32) ( ((u64) t->tv_nsec << 32) / 1000000000 );
+					break;
+				}
+			}
+		}
+		*nb_pck = res;
+		return GF_OK;
+	}
+#endif
+
+	for (i=0; i<max_pck; i++) {
+		u32 read = 0;
+		GF_Err e = gf_sk_receive_internal(sock, buffer + i*max_size, max_size, &read, GF_FALSE);
+		if (e) {
+			if (i) break;
+			return e;
+		}
+		sizes[i] = read;
+		if (arrival_ntp) arrival_ntp[i] = gf_net_get_ntp_ts();
+		*nb_pck = i+1;
+	}
+	return GF_OK;
+}
+
 GF_EXPORT
 GF_Err gf_sk_listen(GF_Socket *sock, u32 MaxConnection)
 {